@@ -138,6 +138,7 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS  1     /* The level the log messages of a task are tagged with, see logger_port_freertos.h */
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -28,7 +28,7 @@
 #include "mqtt_client_port.h"
 #include "mqtt_manager_paho.h"
 #include "cli.h"
-#include "logger.h"
+#include "config_logger.h"
 #include <string.h>
 
 /************************************************** Consts ****************************************************/
@@ -66,6 +66,9 @@ extern "C" void vApplicationStackOverflowHook( xTaskHandle xTask, signed char *p
  */
 void MX_FREERTOS_Init(void) 
 {
+   //!< Before any task runs, as every log message is time stamped with it
+   LIB_COMMON_initTimestamp( SystemCoreClock );
+
    const osThreadDef_t defaultTaskDef = { const_cast<char*>( "defaultTask" ), taskDefault, osPriorityNormal, 0, configMINIMAL_STACK_SIZE, nullptr, nullptr };
    defaultTaskHandle = osThreadCreate( &defaultTaskDef, nullptr );
    
@@ -76,11 +79,16 @@ void MX_FREERTOS_Init(void)
 
 /**
  * @brief Get the current tick count
+ * @details This can be called in the interrupt context as well, where the ISR version of the API has to be used.
  * 
  * @return uint32_t a tick count in milliseconds
  */
 uint32_t LIB_COMMON_getTickMS( void )
 {
+   if ( xPortIsInsideInterrupt() )
+   {
+      return static_cast<uint32_t>( xTaskGetTickCountFromISR() );
+   }
    return static_cast<uint32_t>( xTaskGetTickCount() );
 }
 
@@ -151,13 +159,21 @@ static void taskCli( void const * argument )
 
    for(;;)
    {
-      if ( cli.getNewCommandLine( buffer, sizeof( buffer ), 30000 ) == LibErrorCodes::eOK )
+      result = cli.getNewCommandLine( buffer, sizeof( buffer ), 30000 );
+      if ( result == LibErrorCodes::eCLI_LINE_TOO_LONG )
+      {
+         //!< Not executed, as a truncated line could be taken as a different command
+         LOGGING( "CLI: line too long, ignored: %s", buffer );
+      }
+      else if ( result == LibErrorCodes::eOK )
       {
          LOGGING( "Received command line: %s", buffer );
-         cli.processInput( buffer );
+         result = cli.processInput( buffer );
+         if ( result != LibErrorCodes::eOK )
+         {
+            LOGGING( "CLI: command failed, ret=0x%lx", result );
+         }
       }
-
-      osDelay( 10 );
    }
 }
 
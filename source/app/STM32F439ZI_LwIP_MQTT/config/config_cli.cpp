@@ -13,19 +13,45 @@
 /************************************************ Includes **************************************************/ 
 #include "config_cli.h"
 #include "cli.h"
-#include "semaphore_FreeRTOS.h"
+#include "semaphore_freertos.h"
 #include "common.h"
+#include "cli_batch.h"
+#include <string.h>
 
 /************************************************* Consts **************************************************/ 
-constexpr size_t CLI_BUFFER_SIZE = 128;
+constexpr size_t CLI_BUFFER_SIZE = 512;        //!< A few lines pasted at once, while the CLI task is busy with one
+
+/************************************************* Types ****************************************************/
+/**
+ * @brief Script stored in flash, which is executed with the 'run' command.
+ */
+struct CliScript
+{
+   const char* name;
+   const char* lines;
+};
 
 /******************************************* Function Declarations ******************************************/    
 static void commandTest( int argc, char* argv[] );
+static void commandLogLevel( int argc, char* argv[] );
+static void logLine( void* context, const char* line );
+static void commandRun( int argc, char* argv[] );
+static void logBatchResult( void* context, uint32_t lineNumber, ErrorCode result );
 
 /********************************************* Local Variables **********************************************/    
-static lib::CLI::CommandEntry cliCommands[] = 
+//!< Sorted at compile time, and placed in flash
+static constexpr auto cliCommands = lib::CLI::makeCommandTable(
 {
    { "test", commandTest },
+   { "loglevel", commandLogLevel },
+   { "run", commandRun },
+} );
+
+//!< Scripts for the 'run' command, e.g., to provision a board
+static constexpr CliScript cliScripts[] =
+{
+   { "defaults", "loglevel all info\n" },
+   { "debug",    "loglevel all debug\n" },
 };
 
 /******************************************* Function Definitions *******************************************/    
@@ -40,7 +66,7 @@ CLI& CLI::getInstance()
 {
    static char buffer[CLI_BUFFER_SIZE];
    static lib::Semaphore_FreeRTOS semaphoreCli;
-   static lib::CLI instance{ buffer, sizeof(buffer), "\r\n", cliCommands, sizeof(cliCommands) / sizeof(cliCommands[0]), semaphoreCli };
+   static lib::CLI instance{ buffer, sizeof(buffer), "\r\n", cliCommands.data(), cliCommands.size(), semaphoreCli };
    return instance; 
 }
 } /* namespace lib */
@@ -71,3 +97,84 @@ static void commandTest( int argc, char* argv[] )
       LOGGING( "CLI: arg[%d]: %s", i, argv[i] );
    }
 }
+
+/**
+ * @brief Process the 'loglevel' command
+ * @details Usage: loglevel [<module>|all <level>]
+ *          The runtime threshold of a module, or of all modules, is set if given, and the thresholds of all modules are shown.
+ *          Levels are none, error, warn, info, debug and trace, where the ones above LOG_LEVEL_COMPILE have no effect.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandLogLevel( int argc, char* argv[] )
+{
+   if ( !LIB_COMMON_commandLogLevel( argc, argv, logLine, nullptr ) )
+   {
+      lib::CLI::getInstance().setCommandError( LibErrorCodes::eCLI_INVALID_ARGUMENT );
+   }
+}
+
+/**
+ * @brief Log a line of a command, as the output of the CLI goes to the log.
+ * 
+ * @param context not used
+ * @param line the line
+ */
+static void logLine( void* context, const char* line )
+{
+   PARAM_NOT_USED( context );
+   LOGGING( "%s", line );
+}
+
+/**
+ * @brief Process the 'run' command
+ * @details Usage: run [<script> [continue]]
+ *          A script stored in flash is executed back to back, and it stops at the first line failing unless 'continue' is given.
+ *          The scripts are listed without any argument.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandRun( int argc, char* argv[] )
+{
+   if ( argc < 2 )
+   {
+      for ( const auto& script : cliScripts )
+      {
+         LOGGING( "CLI: script [%s]", script.name );
+      }
+      return;
+   }
+
+   for ( const auto& script : cliScripts )
+   {
+      if ( strcmp( script.name, argv[1] ) == 0 )
+      {
+         const bool isStopOnError = ( argc < 3 ) || ( strcmp( argv[2], "continue" ) != 0 );
+         const auto summary = lib::CliBatch::run( lib::CLI::getInstance(), script.lines, isStopOnError, logBatchResult );
+         LOGGING( "CLI: batch done, %lu executed, %lu failed, %lu skipped", summary.executed, summary.failed, summary.skipped );
+         return;
+      }
+   }
+
+   LOGGING( "CLI: unknown script [%s]", argv[1] );
+   lib::CLI::getInstance().setCommandError( LibErrorCodes::eCLI_INVALID_ARGUMENT );
+}
+
+/**
+ * @brief Log the result of a line of a batch
+ * 
+ * @param context not used
+ * @param lineNumber the line number in the batch
+ * @param result the result of the line
+ */
+static void logBatchResult( void* context, uint32_t lineNumber, ErrorCode result )
+{
+   PARAM_NOT_USED( context );
+
+   if ( result != LibErrorCodes::eOK )
+   {
+      LOGGING( "CLI: line %lu failed, ret=0x%lx", lineNumber, result );
+   }
+}
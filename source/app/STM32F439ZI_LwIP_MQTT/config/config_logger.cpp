@@ -0,0 +1,175 @@
+/************************************************************************************************************
+ * 
+ * @file config_logger.cpp
+ * @brief Configuration of the logger, i.e., its sizes, its sink and the hooks of the C library and lib_common.
+ * @details The logger sinks the messages to the USART3, which is driven by the HAL directly.
+ *          The C library is hooked with '_write', which is called whenever printf is called across the application,
+ *          which decouples the logging implementation from the application code.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/ 
+#include "config_logger.h"
+#include "common.h"
+#include "cmsis_os.h"
+#include "usart.h"
+
+/********************************************* Local Variables **********************************************/ 
+static lib::LockableFreeRTOS     lock;                      //!< Mutex for protecting access to the shared staging buffer and the registration
+static lib::Semaphore_FreeRTOS   semLogAvailable;           //!< Semaphore for log availability to signal the logging thread
+static lib::Semaphore_FreeRTOS   semTxComplete;             //!< Semaphore for UART transmission completion check to signal the logging thread
+static osThreadId                taskHandle;                //!< Handle for the logging task
+
+static LoggerUart                uart;
+static UartLogSink               uartSink{ "uart", {}, uart };
+
+/****************************************** Function Declarations *******************************************/ 
+static void taskLogging       ( void const * argument );
+
+/****************************************** Function Definitions ********************************************/ 
+/**
+ * @brief Initializes the logger with the UART as its sink, and starts the logging task.
+ */
+void LOGGER_init( )
+{
+   semTxComplete.initialize( 1, 0 );                        //!< it works as a binary semaphore
+
+   auto& logger = LOGGER_get();
+   if ( logger.initialize() != LibErrorCodes::eOK )
+   {
+      return;
+   }
+   (void)logger.addSink( uartSink );
+
+   osThreadDef( loggingTask, taskLogging, osPriorityNormal, 0, 512 );
+   taskHandle = osThreadCreate( osThread(loggingTask), nullptr );
+}
+
+/**
+ * @brief Get the singleton instance of the logger.
+ * 
+ * @return AppLogger& 
+ */
+AppLogger& LOGGER_get( )
+{
+   static AppLogger instance{ lock, semLogAvailable };
+   return instance;
+}
+
+/**
+ * @brief Logging task function.
+ *
+ * @param argument thread argument
+ */
+static void taskLogging( void const * argument )
+{
+   PARAM_NOT_USED( argument );
+
+   LOGGER_get().run();
+}
+
+/**
+ * @brief Starts the transmission of a buffer, which is sent in place and released on the completion.
+ * 
+ * @param data pointer to the data
+ * @param length length of the data
+ * @param release function called with the buffer once it's transmitted, in the interrupt context
+ * @param context context passed to the release function
+ * @return ErrorCode 
+ */
+ErrorCode LoggerUart::sendOwned( const uint8_t* data, size_t length, ReleaseFunction release, void* context )
+{
+   if ( length > UINT16_MAX )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_TX_MSG_TOO_LONG;
+   }
+
+   //!< Take out the completion of a transmission given up on, which came after the timeout, so that it isn't taken as this one's
+   while ( semTxComplete.get( 0 ) == LibErrorCodes::eOK )
+   { }
+
+   txData = data;
+   this->release = release;
+   releaseContext = context;
+   if ( HAL_UART_Transmit_IT( &huart3, const_cast<uint8_t*>( data ), static_cast<uint16_t>( length ) ) != HAL_OK )
+   {
+      this->release = nullptr;
+      return LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE;
+   }
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Waits for the completion of the transmission.
+ * 
+ * @param timeout_ms timeout in milliseconds
+ * @return ErrorCode 
+ */
+ErrorCode LoggerUart::waitSendComplete( uint32_t timeout_ms )
+{
+   return semTxComplete.get( timeout_ms );
+}
+
+/**
+ * @brief Writes a binary log record to the logger.
+ * 
+ * @param record pointer to the record
+ * @param length length of the record
+ */
+void LIB_COMMON_writeLogRecord( const uint8_t* record, size_t length )
+{
+   LOGGER_get().writeRecord( record, length );
+}
+
+/**
+ * @brief Tags the messages the calling task logs from now on with a level, which the sink filters them by.
+ * 
+ * @param level the level
+ */
+void LIB_COMMON_tagLogLevel( uint8_t level )
+{
+   lib::LoggerPortFreeRTOS::setLevel( level );
+}
+
+/**
+ * @brief Redirects the C library printf function to the logger.
+ * 
+ * @param file: File descriptor (not used)
+ * @param ptr: Pointer to the data to be sent
+ * @param len: Length of the data to be sent
+ * @retval Number of bytes written
+ */
+extern "C" int _write( int file, char *ptr, int len )
+{
+   PARAM_NOT_USED( file );
+
+   //!< The data is taken with its length, as ptr points into the buffer of the C library, which may have no room for a terminating null.
+   if ( len > 0 )
+   {
+      LOGGER_get().write( reinterpret_cast<const uint8_t*>( ptr ), static_cast<size_t>( len ) );
+   }
+
+   return len;
+}
+
+/**
+ * @brief UART transmission complete callback.
+ * @details This function is called when the UART transmission is complete in the interrupt context through the HAL,
+ *          and it signals the logging thread on the completion of the transmission.
+ */
+extern "C" void HAL_UART_TxCpltCallback( UART_HandleTypeDef *huart )
+{
+   if ( huart->Instance == USART3 )
+   {
+      if ( uart.release != nullptr )
+      {
+         uart.release( uart.txData, uart.releaseContext );
+      }
+      semTxComplete.putISR();
+   }
+}
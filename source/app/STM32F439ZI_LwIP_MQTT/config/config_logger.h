@@ -0,0 +1,57 @@
+/************************************************************************************************************
+ * 
+ * @file config_logger.h
+ * @brief Configuration of the logger, i.e., its sizes, its sink and the hooks of the C library and lib_common.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "logger.h"
+#include "log_sink.h"
+#include "lockable_freertos.h"
+#include "semaphore_freertos.h"
+#include "logger_port_freertos.h"
+
+/************************************************* Consts ***************************************************/
+constexpr size_t LOGGER_SERIAL_BUFFER_SIZE = 256;
+
+/************************************************* Types ****************************************************/
+/**
+ * @brief The UART of the logger, driven by the HAL directly, as this application has no serial device.
+ */
+struct LoggerUart
+{
+   using ReleaseFunction = void(*)( const uint8_t* data, void* context );
+
+   ErrorCode   sendOwned         ( const uint8_t* data, size_t length, ReleaseFunction release, void* context = nullptr );
+   ErrorCode   waitSendComplete  ( uint32_t timeout_ms );
+
+   const uint8_t*    txData{ nullptr };         //!< Buffer being transmitted, released on the completion
+   ReleaseFunction   release{ nullptr };
+   void*             releaseContext{ nullptr };
+};
+
+/**
+ * @brief Sizes of the logger of this application, which has the UART as its only sink.
+ */
+struct AppLoggerConfig : lib::LoggerConfig
+{
+   constexpr static size_t NUM_STAGING_BUFFERS  = 2;
+   constexpr static size_t MAX_SINKS            = 1;
+};
+
+/**
+ * @brief Logger type of this application, whose only sink is of a final type, so that it's called without a virtual dispatch.
+ */
+using UartLogSink = lib::SerialLogSink<LoggerUart, LOGGER_SERIAL_BUFFER_SIZE>;
+using AppLogger   = lib::BasicLogger<lib::LockableFreeRTOS, lib::Semaphore_FreeRTOS, UartLogSink, lib::LoggerPortFreeRTOS, AppLoggerConfig>;
+
+/******************************************* Function Declarations ******************************************/    
+void        LOGGER_init          ( );
+AppLogger&  LOGGER_get           ( );
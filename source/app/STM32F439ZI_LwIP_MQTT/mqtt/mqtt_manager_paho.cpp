@@ -11,6 +11,7 @@
  *************************************************************************************************************/
 
  /************************************************** Includes ************************************************/
+#define LOG_MODULE LOG_MODULE_MQTT   //!< Defined before the includes, as lib_common.h gives a default otherwise
 #include "mqtt_manager_paho.h"
 #include "stm32f4xx_hal.h"
 
@@ -36,13 +37,13 @@ bool MqttManagerPaho::connectToBroker( const MqttBroker& broker, uint32_t timeou
 {
    if ( m_mqttClient.isconnected )
    {
-      LOGGING( "MQTT: Already connected" );
+      LOG_WARN( "MQTT: Already connected" );
       return true;
    }
 
    if ( waitNetworkRunning( timeout_ms ) == false )
    {
-      LOGGING( "MQTT: Network not ready" );
+      LOG_WARN( "MQTT: Network not ready" );
       return false;
    }
 
@@ -50,13 +51,13 @@ bool MqttManagerPaho::connectToBroker( const MqttBroker& broker, uint32_t timeou
 
    if ( !connectToNetwork( broker ) )
    {
-      LOGGING( "MQTT: Network connection failed" );
+      LOG_ERROR( "MQTT: Network connection failed" );
       return false;
    }
 
    if ( m_lock.initialize() != true )
    {
-      LOGGING( "MQTT: Lock initialization failed" );
+      LOG_ERROR( "MQTT: Lock initialization failed" );
       return false;
    }
 
@@ -83,14 +84,14 @@ bool MqttManagerPaho::connectToBroker( const MqttBroker& broker, uint32_t timeou
 
    if( MQTTConnect( &m_mqttClient, &data ) != MQTT_SUCCESS )
    {
-      LOGGING( "MQTT: Connect failed." );
+      LOG_ERROR( "MQTT: Connect failed." );
       disconnect();
       return false;
    }
 
    m_connected = true;
 
-   LOGGING( "MQTT: Connect to the broker succeeded" );
+   LOG_INFO( "MQTT: Connect to the broker succeeded" );
 
    return true;
 }
@@ -126,7 +127,7 @@ bool MqttManagerPaho::connectToNetwork( const MqttBroker& broker )
 		goto ERROR_EXIT;
 	}
 
-   LOGGING( "MQTT: Connect to the network succeeded" );
+   LOG_INFO( "MQTT: Connect to the network succeeded" );
 	return true;
 
 ERROR_EXIT:
@@ -144,7 +145,7 @@ ERROR_EXIT:
  */
 bool MqttManagerPaho::waitNetworkRunning( uint32_t timeout_ms /* = 5000 */ ) const
 {
-   LOGGING( "MQTT: Waiting for network to be ready..." );
+   LOG_INFO( "MQTT: Waiting for network to be ready..." );
    auto tick_started = osKernelSysTick();
    while ( 1 )
    {
@@ -163,7 +164,7 @@ bool MqttManagerPaho::waitNetworkRunning( uint32_t timeout_ms /* = 5000 */ ) con
       }
    }
 
-   LOGGING( "MQTT: Waiting ... done" );
+   LOG_INFO( "MQTT: Waiting ... done" );
    return true;
 }
 
@@ -185,7 +186,7 @@ void MqttManagerPaho::disconnect()
    MQTTCloseSession( &m_mqttClient );
    m_network.disconnect( &m_network );
 
-   LOGGING( "MQTT: Disconnected" );
+   LOG_INFO( "MQTT: Disconnected" );
 }
 
 /**
@@ -199,7 +200,7 @@ bool MqttManagerPaho::publish( const char* topic, const char* payload )
 {
    if ( !m_mqttClient.isconnected )
    {
-      LOGGING( "MQTT: Not connected" );
+      LOG_WARN( "MQTT: Not connected" );
       return false;
    }
 
@@ -212,7 +213,7 @@ bool MqttManagerPaho::publish( const char* topic, const char* payload )
 
    if( MQTTPublish( &m_mqttClient, topic, &message ) != MQTT_SUCCESS )
    {
-      LOGGING( "MQTT: Publish failed." );
+      LOG_ERROR( "MQTT: Publish failed." );
       disconnect();
    }
 
@@ -230,7 +231,7 @@ bool MqttManagerPaho::subscribe( const char* topic, MessageArrivedCallback callb
 {
    if ( !m_mqttClient.isconnected )
    {
-      LOGGING( "MQTT: Not connected" );
+      LOG_WARN( "MQTT: Not connected" );
       return false;
    }
    
@@ -239,7 +240,7 @@ bool MqttManagerPaho::subscribe( const char* topic, MessageArrivedCallback callb
    auto result = MQTTSubscribe( &m_mqttClient, topic, QOS0, callback );
    if( result != MQTT_SUCCESS )
    {
-      LOGGING( "MQTT: Subscribe failed." );
+      LOG_ERROR( "MQTT: Subscribe failed." );
       disconnect();
       return false;
    }
@@ -138,6 +138,22 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS  1     /* The level the log messages of a task are tagged with, see logger_port_freertos.h */
+
+/* The tasks and their run time for the 'tasks' command, see stats_freertos.h. The run time is counted in units of 2^14 cycles, about 91 us at 180 MHz,
+   from the cycle counter of the time stamps, which is enabled by LIB_COMMON_initTimestamp() before the scheduler starts.
+   It's read on every context switch, so it's only shifted rather than divided into microseconds as the time stamps of the logs are,
+   and it's taken extended to 64 bits, as the 32 bits of the counter itself wrap after about 24 s, where it wraps only after about 4.5 days. */
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #if defined(__cplusplus)
+  extern "C"
+  #endif
+  uint64_t LIB_COMMON_getCycleCount( void );
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()         ( ( uint32_t )( LIB_COMMON_getCycleCount() >> 14 ) )
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
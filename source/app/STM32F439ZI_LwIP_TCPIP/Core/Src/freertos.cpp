@@ -13,6 +13,7 @@
  ************************************************************************************************************/
 
 /************************************************** Includes **************************************************/
+#define LOG_MODULE LOG_MODULE_TCPIP   //!< Defined before the includes, as lib_common.h gives a default otherwise
 #include "FreeRTOS.h"
 #include "task.h"
 #include "main.h"
@@ -21,9 +22,13 @@
 #include "lwip.h"
 #include "lwip/tcp.h"
 #include "stm32f4xx_nucleo_144.h"
-#include "logger.h"
+#include "config_logger.h"
+#include "udp_log_sink.h"
 #include "config_cli.h"
+#include "config_stats.h"
 #include "config_serial_wifi.h"
+#include "config_serial_device.h"
+#include <string.h>
 
 /************************************************** Consts ****************************************************/
 #define ECHO_SERVER_ADDR_0    192
@@ -32,7 +37,13 @@
 #define ECHO_SERVER_ADDR_3    3
 #define ECHO_SERVER_PORT      7
 
-constexpr size_t CLI_BUFFER_SIZE = 128;
+#define LOG_COLLECTOR_ADDR_0  192
+#define LOG_COLLECTOR_ADDR_1  168
+#define LOG_COLLECTOR_ADDR_2  1
+#define LOG_COLLECTOR_ADDR_3  2
+#define LOG_COLLECTOR_PORT    5140
+
+#define CLI_UART_CHUNK_SIZE   32      //!< Bytes handed over to the CLI server at most at once
 
 /*********************************************** Local Variables **********************************************/
 static struct tcp_pcb   *echoServerPcb;
@@ -40,6 +51,7 @@ static struct tcp_pcb   *clientPcb;
 static osThreadId       defaultTaskHandle;
 static osThreadId       cliTaskHandle;
 static osThreadId       serialWifiTaskHandle;
+static UdpLogSink       udpLogSink{ "udp", {} };   //!< No rate limit, as the network is way faster than the logs
 
 static StaticTask_t     xIdleTaskTCBBuffer;
 static StackType_t      xIdleStack[configMINIMAL_STACK_SIZE];
@@ -64,6 +76,14 @@ extern "C" void vApplicationStackOverflowHook   ( xTaskHandle xTask, signed char
  */
 void MX_FREERTOS_Init(void) 
 {
+   //!< Before any task runs, as every log message is time stamped with it
+   LIB_COMMON_initTimestamp( SystemCoreClock );
+
+   if ( SERIAL_DEVICE_init() != LibErrorCodes::eOK )
+   {
+      Error_Handler();
+   }
+
    const osThreadDef_t defaultTaskDef = { const_cast<char*>( "defaultTask" ), taskDefault, osPriorityNormal, 0, configMINIMAL_STACK_SIZE, nullptr, nullptr };
    defaultTaskHandle = osThreadCreate( &defaultTaskDef, nullptr );
    
@@ -78,11 +98,16 @@ void MX_FREERTOS_Init(void)
 
 /**
  * @brief Get the current tick count
+ * @details This can be called in the interrupt context as well, where the ISR version of the API has to be used.
  * 
  * @return uint32_t a tick count in milliseconds
  */
 uint32_t LIB_COMMON_getTickMS( void )
 {
+   if ( xPortIsInsideInterrupt() )
+   {
+      return static_cast<uint32_t>( xTaskGetTickCountFromISR() );
+   }
    return static_cast<uint32_t>( xTaskGetTickCount() );
 }
 
@@ -96,8 +121,25 @@ static void taskDefault( void const * argument )
    PARAM_NOT_USED( argument );
 
    MX_LWIP_Init();
+
+   //!< The echo server logs in the lwIP thread, which is registered in the thread itself
+   (void)tcpip_callback( []( void* ) { (void)LOGGER_get().registerTask(); }, nullptr );
+
+   ip_addr_t collector;
+   IP4_ADDR( &collector, LOG_COLLECTOR_ADDR_0, LOG_COLLECTOR_ADDR_1, LOG_COLLECTOR_ADDR_2, LOG_COLLECTOR_ADDR_3 );
+   if ( !udpLogSink.open( collector, LOG_COLLECTOR_PORT ) || !LOGGER_get().addSink( udpLogSink ) )
+   {
+      LOG_WARN( "TCPIP: Logs are not sent over UDP" );
+   }
    
    initTcpEchoServer();
+   (void)tcpip_callback( []( void* )
+   {
+      if ( !CLI_SERVER_listenTcp() )
+      {
+         LOG_WARN( "TCPIP: CLI is not served over TCP" );
+      }
+   }, nullptr );
    SERIAL_WIFI_get().initialize();
 
    for(;;)
@@ -115,27 +157,53 @@ static void taskCli( void const * argument )
 {
    PARAM_NOT_USED( argument );
 
+   (void)LOGGER_get().registerTask();
+
    LOGGING( "Welcome to STM32F439ZI LwIP TCP/IP Application" );
    LOGGING( "CLI: Task Started..." );
 
    auto& cli = lib::CLI::getInstance();
    auto result = cli.initialize();
+   if ( result == LibErrorCodes::eOK )
+   {
+      result = CLI_EXECUTOR_init();
+   }
+   if ( result == LibErrorCodes::eOK )
+   {
+      result = STATS_init();
+   }
+   if ( result == LibErrorCodes::eOK )
+   {
+      result = CLI_SERVER_init();
+   }
    if ( result != LibErrorCodes::eOK )
    {
       LOGGING( "CLI: initialization failed, ret=0x%lx", result );
       return;
    }
 
-   char buffer[CLI_BUFFER_SIZE] = {0};
+   auto& serialDevice = SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 );
 
    for(;;)
    {
-      if ( cli.getNewCommandLine( buffer, sizeof( buffer ), 30000 ) == LibErrorCodes::eOK )
+      //!< The input arrives through the serial device shared with the logger, and it is handed over to the UART session of the CLI server,
+      //!< which executes the lines of every session in its own task
+      //!< Whatever has arrived with the first byte is taken at once, so that the server is woken up once per chunk rather than per byte
+      char data[CLI_UART_CHUNK_SIZE];
+      uint8_t byte = 0;
+      if ( serialDevice.getRxByte( byte, 30000 ) != LibErrorCodes::eOK )
+      {
+         continue;
+      }
+
+      size_t length = 0;
+      data[length++] = static_cast<char>( byte );
+      while ( ( length < sizeof( data ) ) && ( serialDevice.getRxByte( byte, 0 ) == LibErrorCodes::eOK ) )
       {
-         cli.processInput( buffer );
+         data[length++] = static_cast<char>( byte );
       }
 
-      osDelay( 10 );
+      CLI_SERVER_receiveUart( data, length );
    }
 }
 
@@ -150,7 +218,7 @@ static void initTcpEchoServer( )
    echoServerPcb = tcp_new();
    if ( echoServerPcb == nullptr ) 
    {
-      LOGGING( "Failed to create PCB." );
+      LOG_ERROR( "Failed to create PCB." );
       return;
    }
 
@@ -158,11 +226,11 @@ static void initTcpEchoServer( )
    {
       echoServerPcb = tcp_listen( echoServerPcb );
       tcp_accept( echoServerPcb, echoAcceptCallback );
-      LOGGING( "TCPIP: Echo Server is listening on port %d...", ECHO_SERVER_PORT );
+      LOG_INFO( "TCPIP: Echo Server is listening on port %d...", ECHO_SERVER_PORT );
    }
    else
    {
-      LOGGING( "TCPIP: Failed to bind PCB." );
+      LOG_ERROR( "TCPIP: Failed to bind PCB." );
       tcp_abort( echoServerPcb );
       echoServerPcb = nullptr;
    }
@@ -181,7 +249,7 @@ static err_t echoAcceptCallback( void *arg, struct tcp_pcb *newpcb, err_t err )
    (void)arg;
    (void)err;
 
-   LOGGING( "TCPIP: Client connected." );
+   LOG_INFO( "TCPIP: Client connected." );
    clientPcb = newpcb;
 
    //!< Set the receive callback for the new PCB
@@ -205,7 +273,7 @@ static err_t echoRecvCallback( void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 
    if ( err != ERR_OK )
    {
-      LOGGING( "TCPIP: Receive error: %d", err );
+      LOG_WARN( "TCPIP: Receive error: %d", err );
       if ( p != nullptr )
       {
          goto EXIT;
@@ -217,11 +285,11 @@ static err_t echoRecvCallback( void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
    if ( p == nullptr )
    {
       tcp_close( tpcb );
-      LOGGING( "TCPIP: Client disconnected." );
+      LOG_INFO( "TCPIP: Client disconnected." );
       return ERR_OK;
    }
 
-   LOGGING( "TCPIP: Received data: len=%d", p->len );
+   LOG_DEBUG( "TCPIP: Received data: len=%d", p->len );
 
    //!< Echo the received data back to the client
    tcp_write( tpcb, p->payload, p->len, 1 );
@@ -248,6 +316,8 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
 
 /**
  * @brief Stack overflow hook
+ * @details The logs are saved to be sent on the next boot, and it resets right away as the memory next to the stack can't be trusted any more,
+ *          and there is no watchdog to do it.
  * 
  * @param xTask a task handle
  * @param pcTaskName a pointer to the task name
@@ -255,5 +325,10 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
 void vApplicationStackOverflowHook( xTaskHandle xTask, signed char *pcTaskName )
 {
    PARAM_NOT_USED( xTask );
-   PARAM_NOT_USED( pcTaskName ); 
+
+   char reason[32] = "stack overflow in ";
+   strncat( reason, reinterpret_cast<const char*>( pcTaskName ), sizeof( reason ) - strlen( reason ) - 1 );
+   LOGGER_saveOnCrash( reason );
+
+   NVIC_SystemReset();
 }
@@ -1,149 +0,0 @@
-/************************************************************************************************************
- * 
- * @file logger.cpp
- * @brief Implementation of Logger module for logging messages.
- * @details This module implements sinking logs to a UART interface in multi-thread environment so that 
- *             1. log messages can be pushed to the logging buffer from different tasks without blocking them,
- *             2. log messages from each thread are not mixed, and
- *             3. log messages are transmitted over UART in the interrupt context, which is way more efficient than polling.
- *          The external interface of this module is to provide an override to '_write' function, which is called whenever printf is called across the application.
- *          This helps decouple the logging implementation from the application code.
- *          For threading support, it makes use of FreeRTOS APIs.
- *  
- * @author Sungsu Kim
- * @copyright 2025 Sungsu Kim
- * @date 2025-08-20
- * @version 1.0
- * 
- ************************************************************************************************************/
-
-/************************************************ Includes **************************************************/ 
-#include "logger.h"
-#include "FreeRTOS.h"
-#include "task.h"
-#include "cmsis_os.h"
-#include "common.h"
-#include "lockable_freertos.h"
-#include "semaphore_freertos.h"
-#include "lockguard.h"
-#include "ring_buffer.h"
-#include "config_serial_device.h"
-#include <string.h>
-
-/************************************************ Consts ****************************************************/ 
-constexpr size_t   LOGGING_BUFFER_SIZE = 512;
-constexpr size_t   SERIAL_BUFFER_SIZE  = 256;
-constexpr uint32_t TIMEOUT_MS          = 10000;
-
-/********************************************* Local Variables **********************************************/ 
-static uint8_t buffer[LOGGING_BUFFER_SIZE];
-static lib::RingBuffer<uint8_t>  logBuffer{ buffer, sizeof( buffer ) };
-
-static osThreadId                taskHandle;                //!< Handle for the logging task
-static lib::LockableFreeRTOS     lock;                      //!< Mutex for protecting access to the logging buffer
-static lib::Semaphore_FreeRTOS   semLogAvailable;           //!< Semaphore for log availability to signal the logging thread
-static bool                      loggerInit = false;
-
-/****************************************** Function Declarations *******************************************/ 
-static void taskLogging ( void const * argument );
-static void writeLog    ( const char *message );
-
-/****************************************** Function Definitions ********************************************/ 
-/**
- * @brief Initializes the Logger module.
- */
-void LOGGER_init( )
-{
-   semLogAvailable.initialize( LOGGING_BUFFER_SIZE, 0 );    //!< it works as a counting semaphore
-   lock.initialize();
-
-   auto& serialDevice = SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 );
-   serialDevice.initialize();
-
-   osThreadDef( loggingTask, taskLogging, osPriorityNormal, 0, 512 );
-   taskHandle = osThreadCreate( osThread(loggingTask), nullptr );
-
-   loggerInit = true;
-}
-
-/**
- * @brief Writes a log message to the logging buffer.
- * @details As this can be called in multiple threads, pushing the message is protected by a mutex.
- *          Once the message is pushed to the logging buffer, a semaphore is released to notify the logging task.
- * 
- * @param message a const pointer to the log message
- */
-static void writeLog( const char *message )
-{
-   if ( !loggerInit )
-   {
-      return;
-   }
-
-   uint32_t countWritten = 0;
-
-   lib::lock_guard guard( lock );
-   logBuffer.pushBulk( reinterpret_cast<const uint8_t*>( message ), strlen( message ), &countWritten );
-   semLogAvailable.put();
-}
-
-/**
- * @brief Logging task function.
- * @details This function runs in a separate thread and processes log messages from the logging buffer.
- *          Once there is a certain amount of data in the buffer, it is transmitted over UART.
- *          And, as the transmission is done in the interrupt context asynchronously, the thread waits until the transmission is complete so that the next transmission can begin in a safe manner.
- *
- * @param argument thread argument
- */
-static void taskLogging( void const * argument )
-{
-   PARAM_NOT_USED( argument );
-
-   for(;;)
-   {
-      /* NOTE: It's possible that the it can try to pop more data once it gets signaled, but it shouldn't matter;
-               on the next iteration, it will just check again if there's more data available, 
-               and if there's none, which means it popped all available data, it can just wait for next signal.*/
-      if ( semLogAvailable.get( TIMEOUT_MS ) != LibErrorCodes::eOK )
-      {
-         continue;
-      }
-
-      uint8_t txBuffer[SERIAL_BUFFER_SIZE] = {0};      
-      uint32_t countRead = 0;
-
-      //!< Try to pop as much data as possible from the log buffer.
-      {
-         lib::lock_guard guard( lock );
-         logBuffer.popBulk( txBuffer, sizeof( txBuffer ), &countRead );
-      }
-
-      if ( countRead )
-      {
-         txBuffer[countRead] = '\0';
-
-         auto& serialDevice = SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 );
-
-         serialDevice.sendAsync( txBuffer, countRead );
-         serialDevice.waitSendComplete( 2000 );
-      }
-   }
-}
-
-/**
- * @brief Redirects the C library printf function to the USART2.
- * 
- * @param file: File descriptor (not used)
- * @param ptr: Pointer to the data to be sent
- * @param len: Length of the data to be sent
- * @retval Number of bytes written
- */
-extern "C" int _write( int file, char *ptr, int len )
-{
-   PARAM_NOT_USED( file );
-
-   ptr[len] = '\0';
-   writeLog( ptr );
-
-   return len;
-}
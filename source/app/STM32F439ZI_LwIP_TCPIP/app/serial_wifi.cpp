@@ -11,9 +11,11 @@
  ************************************************************************************************************/
 
 /************************************************ Includes **************************************************/
+#define LOG_MODULE LOG_MODULE_SERIAL_WIFI   //!< Defined before the includes, as lib_common.h gives a default otherwise
 #include "serial_wifi.h"
 #include "common.h"
 #include "cmsis_os.h"
+#include "config_logger.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -47,7 +49,9 @@ void SerialWifi::runTask( void const* argument )
 {
    auto& serialWifi = *reinterpret_cast<SerialWifi*>( const_cast<void*>( argument ) );
 
-   LOGGING( "SerialWiFi: Task Started..." );
+   (void)LOGGER_get().registerTask();
+
+   LOG_INFO( "SerialWiFi: Task Started..." );
 
    while( serialWifi.isInitialized() )
    {
@@ -64,7 +68,7 @@ void SerialWifi::runTask( void const* argument )
       }
 
       const auto length = strlen( reinterpret_cast<const char*>( message ) );
-      LOGGING( "SerialWifi: Async Resp.[%d] [%s] ", length, message  );
+      LOG_DEBUG( "SerialWifi: Async Resp.[%d] [%s] ", length, message  );
 
       (void)serialWifi.parseResponse( message );
    }
@@ -83,12 +87,12 @@ bool SerialWifi::parseResponse( const char* message )
    switch ( msgType )
    {
       case eRxMessageType::IP_DATA:
-         LOGGING( "SerialWifi: Received IP Data" );
+         LOG_DEBUG( "SerialWifi: Received IP Data" );
          
          if ( convertToIpData( message, m_ipDataCached ) == true )
          {
             #if defined (ECHO_SERVER_TEST)
-            LOGGING( "SerialWifi: Echo the message" );
+            LOG_DEBUG( "SerialWifi: Echo the message" );
             char echoMessage[IPData::MAX_DATA_LENGTH] = {0};
             snprintf( echoMessage, sizeof(echoMessage), "AT+CIPSEND=%d,%d", m_ipDataCached.linkId, m_ipDataCached.length );
             result = sendWait( echoMessage );
@@ -97,7 +101,7 @@ bool SerialWifi::parseResponse( const char* message )
          break;
 
       case eRxMessageType::IP_DATA_SEND_READY:
-         LOGGING( "SerialWifi: IP Data Send Ready" );
+         LOG_DEBUG( "SerialWifi: IP Data Send Ready" );
          
          #if defined (ECHO_SERVER_TEST)
          result = sendWait( m_ipDataCached.data );
@@ -177,20 +181,54 @@ bool SerialWifi::convertToIpData( const char* message, IPData& ipData )
       *posEnd = '\0';
    }
 
-   LOGGING( "SerialWifi: IP Data - linkId:[%d], length:[%d], data:[%s]", ipData.linkId, ipData.length, ipData.data );
+   //!< Structured, as it's collected per connection on the host
+   if ( LIB_COMMON_isLogEnabled( LOG_MODULE, LOG_LEVEL_DEBUG ) )
+   {
+      LOG_KV( "wifi.ip_data", "linkId", ipData.linkId, "length", ipData.length, "data", ipData.data );
+   }
    return true;
 }
 
 /**
  * @brief Send a message over the Wi-Fi serial device.
  * @details At the end of the message given, "<CR><LF>" will be appended as it's required by the protocol.
+ *          While another sender holds the device, e.g., the SerialWifi task waiting for a response, the lock is tried in slices of LOCK_SLICE_MS,
+ *          and the caller gives up as soon as isCancelled returns true.
+ *          Once the transmission is started it's not cut, as the message is sent in place, and it only takes the time on the wire.
  * 
  * @param message The message to be sent.
+ * @param isCancelled Checked between the slices, or nullptr to wait for the device without a limit.
+ * @return true if the message was sent, false if it failed or was cancelled.
  */
-bool SerialWifi::sendWait( const char* message )
+bool SerialWifi::sendWait( const char* message, CancelFunction isCancelled )
 {
-   lib::lock_guard lock( m_lockable );
+   if ( isCancelled == nullptr )
+   {
+      lib::lock_guard lock( m_lockable );
+      return sendWaitPrivate( message );
+   }
 
+   while ( !isCancelled() )
+   {
+      lib::lock_guard lock( m_lockable, LOCK_SLICE_MS );
+      if ( lock.owns_lock() )
+      {
+         return sendWaitPrivate( message );
+      }
+   }
+
+   LOG_DEBUG( "SerialWifi: Send cancelled [%s]", message );
+   return false;
+}
+
+/**
+ * @brief Send a message and wait until it's transmitted.
+ * @note This must be called under the lock.
+ * 
+ * @param message The message to be sent.
+ */
+bool SerialWifi::sendWaitPrivate( const char* message )
+{
    auto result = sendAsyncPrivate( message );
    if ( result != true )
    {
@@ -200,7 +238,7 @@ bool SerialWifi::sendWait( const char* message )
    result = m_serialDevice.waitSendComplete( 1000 );
    if ( result != LibErrorCodes::eOK )
    {
-      LOGGING( "SerialWifi: Wait failed, ret=0x%lx", result );
+      LOG_WARN( "SerialWifi: Wait failed, ret=0x%lx", result );
       return false;
    }
 
@@ -210,6 +248,7 @@ bool SerialWifi::sendWait( const char* message )
 /**
  * @brief Send a message over the Wi-Fi serial device asynchronously.
  * @details This method will not block and will return immediately after queuing the message for sending.
+ *          As the message is transmitted in place, it must stay valid until waitSendComplete() returns.
  * 
  * @param message The message to be sent.
  */
@@ -223,21 +262,26 @@ bool SerialWifi::sendAsync( const char* message )
 /**
  * @brief Send a message over the Wi-Fi serial device asynchronously.
  * @details This method will not block and will return immediately after queuing the message for sending.
+ *          The message and the delimiter are handed over as two segments, so neither of them is copied nor limited in length.
  * 
  * @param message The message to be sent.
  */
 bool SerialWifi::sendAsyncPrivate( const char* message )
 {
-   LOGGING( "SerialWifi: Send Async.(%d) [%s]", strlen( message ), message );
+   const auto length = strlen( message );
+   LOG_TRACE( "SerialWifi: Send Async.(%d) [%s]", length, message );
    
-   const char* DELIMITER = "\r\n";
-   char buffer[IPData::MAX_DATA_LENGTH] = {0};
-   snprintf( buffer, sizeof(buffer), "%s%s", message, DELIMITER );
+   static constexpr char DELIMITER[] = "\r\n";
+   const AppSerialDevice::TxSegment segments[] =
+   {
+      { reinterpret_cast<const uint8_t*>( message ), length },
+      { reinterpret_cast<const uint8_t*>( DELIMITER ), sizeof( DELIMITER ) - 1 },
+   };
 
-   auto result = m_serialDevice.sendAsync( reinterpret_cast<const uint8_t*>( buffer ), strlen( buffer ) );
+   auto result = m_serialDevice.sendv( segments, sizeof( segments ) / sizeof( segments[0] ) );
    if ( result != LibErrorCodes::eOK )
    {
-      LOGGING( "SerialWifi: sendAsyncPrivate failed, ret=0x%lx", result );
+      LOG_ERROR( "SerialWifi: sendAsyncPrivate failed, ret=0x%lx", result );
       return false;
    }
 
@@ -279,7 +323,7 @@ void SerialWifi::waitResponse( uint32_t timeout_ms )
       {
          if ( i >= sizeof(rxBuffer) )
          {
-            LOGGING( "SerialWifi: Response buffer overflow", rxBuffer );
+            LOG_WARN( "SerialWifi: Response buffer overflow", rxBuffer );
             break;
          }
          rxBuffer[i++] = byte;
@@ -293,7 +337,7 @@ void SerialWifi::waitResponse( uint32_t timeout_ms )
       timeoutRemaining = timeout_ms - elapsed;
    }
 
-   LOGGING( "SerialWifi: Response: %s", rxBuffer );
+   LOG_DEBUG( "SerialWifi: Response: %s", rxBuffer );
 }
 
 /**
@@ -324,7 +368,7 @@ bool SerialWifi::waitAsyncResponse( char* buffer, uint32_t bufferSize )
 
       if ( i >= bufferSize )
       {
-         LOGGING( "SerialWifi: Async Resp. buffer overflow", buffer );
+         LOG_WARN( "SerialWifi: Async Resp. buffer overflow", buffer );
          break;
       }
 
@@ -12,7 +12,7 @@
 #pragma once
 
 /************************************************ Includes **************************************************/
-#include "serial_device.h"
+#include "config_serial_device.h"
 #include "lockable_interface.h"
 
 /************************************************* Types ****************************************************/
@@ -23,15 +23,18 @@ class SerialWifi
 {
 public:
    constexpr static size_t TX_BUFFER_SIZE = 128;
+   constexpr static uint32_t LOCK_SLICE_MS = 50;      //!< How often a cancellable sender checks if it's cancelled, while the device is busy
 
-   SerialWifi( lib::SerialDevice& serialDevice, lib::ILockable& lockable ) 
+   using CancelFunction = bool (*)( );                //!< Returns true if the caller is asked to stop, e.g., a job being cancelled
+
+   SerialWifi( AppSerialDevice& serialDevice, lib::ILockable& lockable ) 
    : m_serialDevice( serialDevice )
    , m_lockable( lockable ) 
    { }
    ~SerialWifi() = default;
 
    void        initialize           ( );
-   bool        sendWait             ( const char* message );
+   bool        sendWait             ( const char* message, CancelFunction isCancelled = nullptr );
    bool        sendAsync            ( const char* message );
    bool        waitSendComplete     ( );
    void        waitResponse         ( uint32_t timeout_ms );
@@ -70,12 +73,13 @@ private:
    };
 
    //!< Messaging interface
+   bool                 sendWaitPrivate      ( const char* message );
    bool                 sendAsyncPrivate     ( const char* message );
    bool                 parseResponse        ( const char* message );
    eRxMessageType       getMessageType       ( const char* message );
    bool                 convertToIpData      ( const char* message, IPData& ipData );
 
-   lib::SerialDevice&   m_serialDevice;
+   AppSerialDevice&     m_serialDevice;
    lib::ILockable&      m_lockable;
    bool                 m_isInitialized{ false };
    IPData               m_ipDataCached{};
@@ -0,0 +1,340 @@
+/************************************************************************************************************
+ *
+ * @file tcp_cli_transport.cpp
+ * @brief Implementation of the TcpCliTransport class, which serves the CLI over TCP with the raw API of lwIP.
+ * @note The callbacks run in the lwIP thread, and the raw API is never called in any other, as it's not thread-safe.
+ *       The serving task only touches the buffers of a connection, and it hands the sending over to the lwIP thread with tcpip_try_callback().
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "tcp_cli_transport.h"
+#include "common.h"
+#include "cmsis_os.h"
+#include "lwip/tcpip.h"
+
+/************************************************** Consts **************************************************/
+static constexpr const char* PROMPT = "> ";
+
+static_assert( TcpCliTransport::MAX_CONNECTIONS == 2, "The connections are listed one by one in the constructor" );
+static_assert( TcpCliTransport::RX_BUFFER_SIZE >= TCP_MSS, "A segment refused has to fit once the receive buffer is drained" );
+
+/****************************************** Function Definitions ********************************************/
+/**
+ * @brief Constructor
+ *
+ * @param notify the function waking up the serving task
+ */
+TcpCliTransport::TcpCliTransport( NotifyFunction notify )
+: m_notify{ notify }
+, m_connections{ Connection{ *this, "tcp0" }, Connection{ *this, "tcp1" } }
+{ }
+
+/**
+ * @brief Constructor of a connection
+ *
+ * @param owner the transport which the connection belongs to
+ * @param name the name of the session, e.g., for the stats, which is kept as it is
+ */
+TcpCliTransport::Connection::Connection( TcpCliTransport& owner, const char* name )
+: owner{ owner }
+, tx{ txBuffer, TX_BUFFER_SIZE }
+, session{ name, *this, rxBuffer, RX_BUFFER_SIZE, line, LINE_SIZE, PROMPT }
+{ }
+
+/**
+ * @brief Listen for the connections.
+ * @note This is called in the lwIP thread, e.g., with tcpip_callback().
+ *
+ * @param port the port to listen on, e.g., 23 for telnet
+ * @return true if listening
+ */
+bool TcpCliTransport::listen( uint16_t port )
+{
+   auto* pcb = tcp_new();
+   if ( pcb == nullptr )
+   {
+      return false;
+   }
+
+   if ( tcp_bind( pcb, IP_ADDR_ANY, port ) != ERR_OK )
+   {
+      tcp_abort( pcb );
+      return false;
+   }
+
+   m_listenPcb = tcp_listen( pcb );
+   if ( m_listenPcb == nullptr )
+   {
+      tcp_abort( pcb );
+      return false;
+   }
+
+   tcp_arg( m_listenPcb, this );
+   tcp_accept( m_listenPcb, acceptCallback );
+   return true;
+}
+
+/**
+ * @brief Get the bytes of the output dropped, across every connection, as the client didn't take them fast enough.
+ *
+ * @return uint32_t the bytes dropped
+ */
+uint32_t TcpCliTransport::getDropped( ) const
+{
+   uint32_t dropped = 0;
+   for ( const auto& connection : m_connections )
+   {
+      dropped += connection.dropped.load( std::memory_order_relaxed );
+   }
+   return dropped;
+}
+
+/**
+ * @brief Buffer the output, which waits up to WRITE_TIMEOUT_MS for the room, e.g., for a long listing over a slow link.
+ * @note This is called only by the serving task.
+ */
+void TcpCliTransport::Connection::write( const char* data, size_t length )
+{
+   uint32_t waited_ms = 0;
+   while ( length > 0 )
+   {
+      uint32_t count = 0;
+      tx.pushBulk( data, static_cast<uint32_t>( length ), &count );
+      data += count;
+      length -= count;
+
+      if ( length == 0 )
+      {
+         break;
+      }
+
+      if ( ( waited_ms >= WRITE_TIMEOUT_MS ) || ( session.getState() != lib::CliSession::eState::OPEN ) )
+      {
+         dropped.fetch_add( static_cast<uint32_t>( length ), std::memory_order_relaxed );
+         break;
+      }
+
+      flush();
+      osDelay( 1 );
+      waited_ms++;
+   }
+}
+
+/**
+ * @brief Hand the output over to the lwIP thread, unless it's already scheduled to send.
+ * @note This is called only by the serving task.
+ */
+void TcpCliTransport::Connection::flush( )
+{
+   if ( tx.isEmpty() || isSendScheduled.exchange( true, std::memory_order_acq_rel ) )
+   {
+      return;
+   }
+
+   //!< Retried on the next flush if the mailbox of lwIP is full, or whenever the data sent is acknowledged
+   if ( tcpip_try_callback( sendCallback, this ) != ERR_OK )
+   {
+      isSendScheduled.store( false, std::memory_order_release );
+   }
+}
+
+/**
+ * @brief Callback accepting a connection, which takes a free one, or is refused if there is none.
+ *
+ * @param arg the transport
+ * @param newpcb pointer to the new TCP PCB
+ * @param err error code
+ * @return err_t ERR_OK, or ERR_ABRT if aborted
+ */
+err_t TcpCliTransport::acceptCallback( void* arg, struct tcp_pcb* newpcb, err_t err )
+{
+   auto& transport = *static_cast<TcpCliTransport*>( arg );
+   if ( ( err != ERR_OK ) || ( newpcb == nullptr ) )
+   {
+      return ERR_VAL;
+   }
+
+   for ( auto& connection : transport.m_connections )
+   {
+      if ( ( connection.pcb != nullptr ) || ( connection.session.getState() != lib::CliSession::eState::FREE ) )
+      {
+         continue;
+      }
+
+      //!< Nothing is written while the session is free, so the output left over is cleared safely here
+      connection.tx.clear();
+      connection.pcb = newpcb;
+      tcp_arg( newpcb, &connection );
+      tcp_recv( newpcb, recvCallback );
+      tcp_sent( newpcb, sentCallback );
+      tcp_err( newpcb, errCallback );
+
+      (void)connection.session.open();
+      transport.m_notify();
+      return ERR_OK;
+   }
+
+   tcp_abort( newpcb );
+   return ERR_ABRT;
+}
+
+/**
+ * @brief Callback receiving data, which is pushed into the session as a whole, or refused if it doesn't fit, for lwIP to retry later.
+ *
+ * @param arg the connection
+ * @param tpcb pointer to the TCP PCB
+ * @param p pointer to the received pbuf, or nullptr if closed by the client
+ * @param err error code
+ * @return err_t ERR_OK, or ERR_MEM if refused
+ */
+err_t TcpCliTransport::recvCallback( void* arg, struct tcp_pcb* tpcb, struct pbuf* p, err_t err )
+{
+   auto& connection = *static_cast<Connection*>( arg );
+
+   if ( p == nullptr )
+   {
+      close( connection );
+      return ERR_OK;
+   }
+
+   if ( err != ERR_OK )
+   {
+      pbuf_free( p );
+      return err;
+   }
+
+   if ( p->tot_len > connection.session.getSpace() )
+   {
+      return ERR_MEM;
+   }
+
+   for ( auto* q = p; q != nullptr; q = q->next )
+   {
+      (void)connection.session.receive( static_cast<const char*>( q->payload ), q->len );
+   }
+   tcp_recved( tpcb, p->tot_len );
+   pbuf_free( p );
+
+   connection.owner.m_notify();
+   return ERR_OK;
+}
+
+/**
+ * @brief Callback of the data acknowledged, which makes room for the rest of the output.
+ *
+ * @param arg the connection
+ * @param tpcb pointer to the TCP PCB
+ * @param length the bytes acknowledged
+ * @return err_t ERR_OK
+ */
+err_t TcpCliTransport::sentCallback( void* arg, struct tcp_pcb* tpcb, u16_t length )
+{
+   PARAM_NOT_USED( tpcb );
+   PARAM_NOT_USED( length );
+
+   send( *static_cast<Connection*>( arg ) );
+   return ERR_OK;
+}
+
+/**
+ * @brief Callback of a fatal error, e.g., a reset by the client, where the pcb is already freed by lwIP.
+ *
+ * @param arg the connection
+ * @param err error code
+ */
+void TcpCliTransport::errCallback( void* arg, err_t err )
+{
+   PARAM_NOT_USED( err );
+
+   auto& connection = *static_cast<Connection*>( arg );
+   connection.pcb = nullptr;
+   connection.session.close();
+   connection.owner.m_notify();
+}
+
+/**
+ * @brief Callback of tcpip_try_callback(), sending the output in the lwIP thread.
+ *
+ * @param arg the connection
+ */
+void TcpCliTransport::sendCallback( void* arg )
+{
+   auto& connection = *static_cast<Connection*>( arg );
+   connection.isSendScheduled.store( false, std::memory_order_release );
+   send( connection );
+}
+
+/**
+ * @brief Write as much of the output as the send buffer takes, in chunks, and send it at once.
+ * @details The output of a closed connection is just dropped.
+ *
+ * @param connection the connection
+ */
+void TcpCliTransport::send( Connection& connection )
+{
+   char chunk[SEND_CHUNK_SIZE];
+   uint32_t count = 0;
+   auto* pcb = connection.pcb;
+
+   if ( pcb == nullptr )
+   {
+      do
+      {
+         connection.tx.popBulk( chunk, sizeof( chunk ), &count );
+      } while ( count > 0 );
+      return;
+   }
+
+   bool isWritten = false;
+   while ( !connection.tx.isEmpty() && ( tcp_sndqueuelen( pcb ) < TCP_SND_QUEUELEN ) )
+   {
+      const uint32_t room = tcp_sndbuf( pcb );
+      if ( room == 0 )
+      {
+         break;
+      }
+
+      connection.tx.popBulk( chunk, ( room < sizeof( chunk ) ) ? room : sizeof( chunk ), &count );
+      const u8_t flags = TCP_WRITE_FLAG_COPY | ( connection.tx.isEmpty() ? 0 : TCP_WRITE_FLAG_MORE );
+      if ( tcp_write( pcb, chunk, static_cast<u16_t>( count ), flags ) != ERR_OK )
+      {
+         connection.dropped.fetch_add( count, std::memory_order_relaxed );
+         break;
+      }
+      isWritten = true;
+   }
+
+   if ( isWritten )
+   {
+      (void)tcp_output( pcb );
+   }
+}
+
+/**
+ * @brief Close a connection, which is freed once the serving task resets its session.
+ *
+ * @param connection the connection
+ */
+void TcpCliTransport::close( Connection& connection )
+{
+   auto* pcb = connection.pcb;
+   connection.pcb = nullptr;
+
+   tcp_arg( pcb, nullptr );
+   tcp_recv( pcb, nullptr );
+   tcp_sent( pcb, nullptr );
+   tcp_err( pcb, nullptr );
+   if ( tcp_close( pcb ) != ERR_OK )
+   {
+      tcp_abort( pcb );
+   }
+
+   connection.session.close();
+   connection.owner.m_notify();
+}
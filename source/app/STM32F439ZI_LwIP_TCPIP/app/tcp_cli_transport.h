@@ -0,0 +1,89 @@
+/************************************************************************************************************
+ *
+ * @file tcp_cli_transport.h
+ * @brief Header file for the TcpCliTransport class.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "cli_session.h"
+#include "ring_buffer.h"
+#include "lwip/tcp.h"
+#include <atomic>
+
+/************************************************* Types ****************************************************/
+/**
+ * @brief Transport of the CLI over TCP, e.g., for telnet or netcat, with the raw API of lwIP.
+ * @details Every connection accepted takes a session of its own, up to MAX_CONNECTIONS, and a connection beyond them is refused.
+ *          The bytes received are pushed into the session in the lwIP thread, and a segment which doesn't fit is refused,
+ *          so that lwIP holds it back along with the window until the serving task catches up.
+ *          The output is buffered by the serving task, and it's handed over to the lwIP thread on flush(),
+ *          which writes as much of it as the send buffer takes, and the rest whenever the sent data is acknowledged.
+ */
+class TcpCliTransport
+{
+public:
+   constexpr static size_t    MAX_CONNECTIONS   = 2;
+   constexpr static size_t    RX_BUFFER_SIZE    = 1024;     //!< At least a segment, which is taken in as a whole
+   constexpr static size_t    LINE_SIZE         = 128;
+   constexpr static size_t    TX_BUFFER_SIZE    = 1024;     //!< A few screens of output of a command, which is held until acknowledged
+   constexpr static size_t    SEND_CHUNK_SIZE   = 256;      //!< Bytes handed over to tcp_write() at once, on the stack of the lwIP thread
+   constexpr static uint32_t  WRITE_TIMEOUT_MS  = 100;      //!< Wait time of the serving task for the output to be sent, after which it's dropped
+
+   //!< Alias for the function waking up the serving task, e.g., BasicCliServer::notifyReceived()
+   using NotifyFunction = void (*)( );
+
+   explicit TcpCliTransport( NotifyFunction notify );
+
+   //!< Disable copy and move operations
+   TcpCliTransport( const TcpCliTransport& ) = delete;
+   TcpCliTransport& operator=( const TcpCliTransport& ) = delete;
+   TcpCliTransport( TcpCliTransport&& ) = delete;
+   TcpCliTransport& operator=( TcpCliTransport&& ) = delete;
+
+   bool              listen         ( uint16_t port );
+   lib::CliSession&  getSession     ( size_t index )     { return m_connections[index].session; }
+   lib::RingBuffer<char>& getTxBuffer ( size_t index )  { return m_connections[index].tx; }     //!< For monitoring, e.g., with RingBufferStats
+   uint32_t          getDropped     ( ) const;
+
+private:
+   /**
+    * @brief Connection, which is free while its pcb is nullptr and its session is reset.
+    */
+   class Connection final : public lib::ICliTransport
+   {
+   public:
+      Connection( TcpCliTransport& owner, const char* name );
+
+      void  write    ( const char* data, size_t length ) override;
+      void  flush    ( ) override;
+
+      TcpCliTransport&        owner;
+      struct tcp_pcb*         pcb{ nullptr };                  //!< Used only in the lwIP thread
+      char                    rxBuffer[RX_BUFFER_SIZE]{};
+      char                    line[LINE_SIZE]{};
+      char                    txBuffer[TX_BUFFER_SIZE]{};
+      lib::RingBuffer<char>   tx;                              //!< Pushed by the serving task, and popped by the lwIP thread
+      lib::CliSession         session;
+      std::atomic<bool>       isSendScheduled{ false };
+      std::atomic<uint32_t>   dropped{ 0 };                    //!< Bytes of the output dropped
+   };
+
+   static err_t   acceptCallback ( void* arg, struct tcp_pcb* newpcb, err_t err );
+   static err_t   recvCallback   ( void* arg, struct tcp_pcb* tpcb, struct pbuf* p, err_t err );
+   static err_t   sentCallback   ( void* arg, struct tcp_pcb* tpcb, u16_t length );
+   static void    errCallback    ( void* arg, err_t err );
+   static void    sendCallback   ( void* arg );
+   static void    send           ( Connection& connection );
+   static void    close          ( Connection& connection );
+
+   NotifyFunction    m_notify;
+   struct tcp_pcb*   m_listenPcb{ nullptr };
+   Connection        m_connections[MAX_CONNECTIONS];
+};
@@ -0,0 +1,94 @@
+/************************************************************************************************************
+ * 
+ * @file udp_log_sink.cpp
+ * @brief Implementation of the UdpLogSink class, which sends the log messages over UDP with the netconn API of lwIP.
+ * @note This is used only by the logging task, after lwIP is initialized.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-16
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "udp_log_sink.h"
+#include "lwip/netbuf.h"
+
+/****************************************** Function Definitions ********************************************/ 
+/**
+ * @brief Opens the connection to the collector.
+ * 
+ * @param collector IP address of the collector
+ * @param port port of the collector
+ * @return true if opened
+ */
+bool UdpLogSink::open( const ip_addr_t& collector, uint16_t port )
+{
+   m_conn = netconn_new( NETCONN_UDP );
+   if ( m_conn == nullptr )
+   {
+      return false;
+   }
+
+   m_collector = collector;
+   m_port = port;
+   return true;
+}
+
+/**
+ * @brief Adds a message to the datagram, which is sent every time it gets full.
+ */
+void UdpLogSink::write( const uint8_t* data, size_t length )
+{
+   while ( length > 0 )
+   {
+      if ( m_count == 0 )
+      {
+         m_firstWriteMs = LIB_COMMON_getTickMS();
+      }
+
+      const size_t count = ( length < ( DATAGRAM_SIZE - m_count ) ) ? length : ( DATAGRAM_SIZE - m_count );
+      memcpy( &m_datagram[m_count], data, count );
+      m_count += count;
+      data += count;
+      length -= count;
+
+      if ( m_count == DATAGRAM_SIZE )
+      {
+         send();
+      }
+   }
+}
+
+/**
+ * @brief Sends the datagram once it's been held back for FLUSH_INTERVAL_MS, so that a few messages in a row share a datagram.
+ */
+void UdpLogSink::flush( )
+{
+   if ( ( m_count > 0 ) && ( ( LIB_COMMON_getTickMS() - m_firstWriteMs ) >= FLUSH_INTERVAL_MS ) )
+   {
+      send();
+   }
+}
+
+/**
+ * @brief Sends the datagram, which is referenced rather than copied, as netconn_sendto() returns only after lwIP is done with it.
+ * @details The datagram is dropped if it can't be sent, e.g., before the link is up, as no message may hold back the others.
+ */
+void UdpLogSink::send( )
+{
+   if ( m_conn != nullptr )
+   {
+      struct netbuf* buf = netbuf_new();
+      if ( buf != nullptr )
+      {
+         if ( netbuf_ref( buf, m_datagram, static_cast<u16_t>( m_count ) ) == ERR_OK )
+         {
+            (void)netconn_sendto( m_conn, buf, &m_collector, m_port );
+         }
+         netbuf_delete( buf );
+      }
+   }
+   m_count = 0;
+}
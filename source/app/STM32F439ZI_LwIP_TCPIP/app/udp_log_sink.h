@@ -0,0 +1,49 @@
+/************************************************************************************************************
+ * 
+ * @file udp_log_sink.h
+ * @brief Header file for the UdpLogSink class.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-16
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "log_sink.h"
+#include "lwip/api.h"
+
+/************************************************* Types ****************************************************/
+/**
+ * @brief Log sink sending the messages to a collector over UDP, e.g., netcat or a syslog server.
+ * @details The messages are batched into a datagram, which is sent once it's full, or once it's been held back for FLUSH_INTERVAL_MS,
+ *          so that the network is not flooded with a datagram for every message.
+ */
+class UdpLogSink : public lib::LogSink
+{
+public:
+   constexpr static size_t    DATAGRAM_SIZE     = 512;      //!< Well under the MTU, so that a datagram is never fragmented
+   constexpr static uint32_t  FLUSH_INTERVAL_MS = 100;
+
+   UdpLogSink( const char* name, const Config& config )
+   : LogSink{ name, config }
+   { }
+
+   bool        open           ( const ip_addr_t& collector, uint16_t port );
+
+   void        write          ( const uint8_t* data, size_t length ) override;
+   void        flush          ( ) override;
+   bool        isPending      ( ) const override { return m_count > 0; }
+
+private:
+   void        send           ( );
+
+   struct netconn*   m_conn{ nullptr };
+   ip_addr_t         m_collector{};
+   uint16_t          m_port{ 0 };
+   uint8_t           m_datagram[DATAGRAM_SIZE];
+   size_t            m_count{ 0 };
+   uint32_t          m_firstWriteMs{ 0 };    //!< When the datagram being filled got its first message
+};
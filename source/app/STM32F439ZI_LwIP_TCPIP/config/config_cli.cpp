@@ -2,6 +2,7 @@
  * 
  * @file config_cli.cpp
  * @brief Configuration of CLI module and user-defined commands
+ * @details The CLI is served over the UART and over TCP, e.g., with telnet, where the output of a command is printed on the session it's entered in.
  *  
  * @author Sungsu Kim
  * @copyright 2025 Sungsu Kim
@@ -17,40 +18,340 @@
 #include "common.h"
 #include "cmsis_os.h"
 #include "config_serial_wifi.h"
+#include "config_serial_device.h"
+#include "config_logger.h"
+#include "tcp_cli_transport.h"
+#include "cli_batch.h"
+#include "config_stats.h"
 #include <stdlib.h>
 
 /************************************************* Consts ***************************************************/
-constexpr size_t CLI_BUFFER_SIZE = 128;
+constexpr size_t CLI_BUFFER_SIZE    = 128;
+constexpr size_t UART_RX_SIZE       = 256;
+
+/************************************************* Types ****************************************************/
+/**
+ * @brief Script stored in flash, which is executed with the 'run' command.
+ */
+struct CliScript
+{
+   const char* name;
+   const char* lines;
+};
+
+/**
+ * @brief Transport of the CLI over the UART, which is shared with the logger, so the output is batched into a message of it.
+ */
+class UartCliTransport final : public lib::ICliTransport
+{
+public:
+   void write( const char* data, size_t length ) override
+   {
+      while ( length > 0 )
+      {
+         const size_t count = ( length < ( sizeof( m_buffer ) - m_count ) ) ? length : ( sizeof( m_buffer ) - m_count );
+         memcpy( &m_buffer[m_count], data, count );
+         m_count += count;
+         data += count;
+         length -= count;
+
+         if ( m_count == sizeof( m_buffer ) )
+         {
+            flush();
+         }
+      }
+   }
+
+   void flush( ) override
+   {
+      if ( m_count > 0 )
+      {
+         LOGGER_get().write( m_buffer, m_count );
+         m_count = 0;
+      }
+   }
+
+private:
+   uint8_t  m_buffer[CLI_BUFFER_SIZE];
+   size_t   m_count{ 0 };
+};
 
 /******************************************* Function Declarations ******************************************/    
 static void showArgs          ( int argc, char* argv[] );
 static void commandTest       ( int argc, char* argv[] );
 static void commandSerialWifi ( int argc, char* argv[] );
+static bool isJobCancelled    ( );
+static void commandSerialStats( int argc, char* argv[] );
+static void commandLogLevel   ( int argc, char* argv[] );
+static void commandJobs       ( int argc, char* argv[] );
+static void commandCancel     ( int argc, char* argv[] );
+static void commandRun        ( int argc, char* argv[] );
+static void commandBatch      ( int argc, char* argv[] );
+static void showBatchResult   ( void* context, uint32_t lineNumber, ErrorCode result );
+static void showBatchSummary  ( const lib::CliBatch::Summary& summary );
+static void commandTasks      ( int argc, char* argv[] );
+static void commandHeap       ( int argc, char* argv[] );
+static void commandBuffers    ( int argc, char* argv[] );
+static void commandStats      ( int argc, char* argv[] );
+static void printLine         ( void* context, const char* line );
+static void showSerialStats   ( const char* name, AppSerialDevice& serialDevice, bool reset );
+static void taskCliWorker     ( void const * argument );
+static void taskCliServer     ( void const * argument );
+static ErrorCode handleLine   ( char* line );
+static lib::CliSession* getJobSession ( );
+static void notifyServer      ( );
 
 /********************************************* Local Variables **********************************************/    
-static lib::CLI::CommandEntry cliCommands[] = 
+//!< Sorted at compile time, and placed in flash
+static constexpr auto cliCommands = lib::CLI::makeCommandTable(
 {
    { "test", commandTest },
-   { "wifi", commandSerialWifi }
+   { "wifi", commandSerialWifi, lib::CLI::eExecution::ASYNC },      //!< Blocks while the module is busy, until cancelled
+   { "serialstats", commandSerialStats },
+   { "loglevel", commandLogLevel },
+   { "jobs", commandJobs },
+   { "cancel", commandCancel },
+   { "run", commandRun },
+   { "batch", commandBatch },
+   { "tasks", commandTasks },
+   { "heap", commandHeap },
+   { "buffers", commandBuffers },
+   { "stats", commandStats },
+} );
+
+//!< Scripts for the 'run' command, e.g., to provision a board
+static constexpr CliScript cliScripts[] =
+{
+   { "defaults", "loglevel all info\n"
+                 "serialstats reset\n" },
+   { "debug",    "loglevel all debug\n"
+                 "serialstats\n"
+                 "jobs\n" },
 };
 
+static osThreadId workerTaskHandles[CLI_NUM_WORKERS];
+static osThreadId serverTaskHandle;
+
+static UartCliTransport uartTransport;
+static char uartRxBuffer[UART_RX_SIZE];
+static char uartLine[CLI_BUFFER_SIZE];
+static lib::CliSession uartSession{ "uart", uartTransport, uartRxBuffer, sizeof( uartRxBuffer ), uartLine, sizeof( uartLine ) };
+static TcpCliTransport tcpTransport{ notifyServer };
+
+static char batchLine[CLI_BUFFER_SIZE];
+static lib::CliBatch streamedBatch{ lib::CLI::getInstance(), batchLine, sizeof( batchLine ), showBatchResult };
+static lib::CliSession* batchSession{ nullptr };       //!< The session streaming a batch, used only by the serving task
+
+//!< Buffers of the sessions, reported by the 'buffers' command
+static lib::RingBufferStats<char> uartSessionStats{ "cli.uart.rx", uartSession.getRxBuffer() };
+static lib::RingBufferStats<char> tcpSessionStats[] =
+{
+   { "cli.tcp0.rx", tcpTransport.getSession( 0 ).getRxBuffer() },
+   { "cli.tcp0.tx", tcpTransport.getTxBuffer( 0 ) },
+   { "cli.tcp1.rx", tcpTransport.getSession( 1 ).getRxBuffer() },
+   { "cli.tcp1.tx", tcpTransport.getTxBuffer( 1 ) },
+};
+static_assert( sizeof( tcpSessionStats ) / sizeof( tcpSessionStats[0] ) == 2 * TcpCliTransport::MAX_CONNECTIONS, "Buffers of every connection must be given" );
+
 /******************************************* Function Definitions *******************************************/    
 namespace lib
 {
 /**
  * @brief Get the singleton instance of the CLI
+ * @details It has no input of its own, as the sessions of the CLI server assemble the lines.
  * 
  * @return CLI& 
  */
 CLI& CLI::getInstance()
 {
-   static char buffer[CLI_BUFFER_SIZE];
-   static lib::Semaphore_FreeRTOS semaphoreCli;
-   static lib::CLI instance{ buffer, sizeof(buffer), "\r\n", cliCommands, sizeof(cliCommands) / sizeof(cliCommands[0]), semaphoreCli };
+   static lib::CLI instance{ "\r\n", cliCommands.data(), cliCommands.size() };
    return instance; 
 }
 } /* namespace lib */
 
+/**
+ * @brief Initialize the command executor, and start its worker tasks.
+ * 
+ * @return ErrorCode 
+ */
+ErrorCode CLI_EXECUTOR_init( )
+{
+   auto result = CLI_EXECUTOR_get().initialize();
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   for ( auto& handle : workerTaskHandles )
+   {
+      const osThreadDef_t workerTaskDef = { const_cast<char*>( "cliWorkerTask" ), taskCliWorker, osPriorityNormal, 0, configMINIMAL_STACK_SIZE, nullptr, nullptr };
+      handle = osThreadCreate( &workerTaskDef, nullptr );
+   }
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Get the singleton instance of the command executor
+ * 
+ * @return AppCommandExecutor& 
+ */
+AppCommandExecutor& CLI_EXECUTOR_get( )
+{
+   static lib::LockableFreeRTOS lockable;
+   static lib::Semaphore_FreeRTOS semJobQueued;
+   static AppCommandExecutor instance{ lib::CLI::getInstance(), lockable, semJobQueued };
+   return instance;
+}
+
+/**
+ * @brief Initialize the CLI server with its sessions, and start its serving task.
+ * @details The TCP sessions are opened as the connections are accepted, once listening with CLI_SERVER_listenTcp().
+ * 
+ * @return ErrorCode 
+ */
+ErrorCode CLI_SERVER_init( )
+{
+   auto& server = CLI_SERVER_get();
+   auto result = server.initialize();
+   if ( result == LibErrorCodes::eOK )
+   {
+      result = server.addSession( uartSession );
+   }
+   for ( size_t i = 0; ( i < TcpCliTransport::MAX_CONNECTIONS ) && ( result == LibErrorCodes::eOK ); i++ )
+   {
+      result = server.addSession( tcpTransport.getSession( i ) );
+   }
+   if ( result == LibErrorCodes::eOK )
+   {
+      result = STATS_get().add( uartSessionStats );
+   }
+   for ( size_t i = 0; ( i < sizeof( tcpSessionStats ) / sizeof( tcpSessionStats[0] ) ) && ( result == LibErrorCodes::eOK ); i++ )
+   {
+      result = STATS_get().add( tcpSessionStats[i] );
+   }
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   (void)uartSession.open();
+
+   //!< Twice the minimum, as a line is formatted on the stack of the command printing it
+   const osThreadDef_t serverTaskDef = { const_cast<char*>( "cliServerTask" ), taskCliServer, osPriorityNormal, 0, 2 * configMINIMAL_STACK_SIZE, nullptr, nullptr };
+   serverTaskHandle = osThreadCreate( &serverTaskDef, nullptr );
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Get the singleton instance of the CLI server
+ * 
+ * @return AppCliServer& 
+ */
+AppCliServer& CLI_SERVER_get( )
+{
+   static lib::LockableFreeRTOS lockable;
+   static lib::Semaphore_FreeRTOS semReceived;
+   static AppCliServer instance{ lib::CLI::getInstance(), lockable, semReceived, handleLine, getJobSession };
+   return instance;
+}
+
+/**
+ * @brief Hand the bytes received over the UART to its session.
+ * 
+ * @param data pointer to the bytes received
+ * @param length number of the bytes
+ */
+void CLI_SERVER_receiveUart( const char* data, size_t length )
+{
+   (void)uartSession.receive( data, length );
+   notifyServer();
+}
+
+/**
+ * @brief Listen for the TCP connections of the CLI.
+ * @note This is called in the lwIP thread, e.g., with tcpip_callback().
+ * 
+ * @return true if listening
+ */
+bool CLI_SERVER_listenTcp( )
+{
+   return tcpTransport.listen( CLI_TCP_PORT );
+}
+
+/**
+ * @brief Function implementing the serving task of the CLI server.
+ * @param argument Not used
+ */
+static void taskCliServer( void const * argument )
+{
+   PARAM_NOT_USED( argument );
+
+   (void)LOGGER_get().registerTask();
+   CLI_SERVER_get().run();
+}
+
+/**
+ * @brief Handle a line of any session, where a command which may block is queued to the workers, so that the sessions keep being served.
+ * @details The lines of the session streaming a batch are executed in order in the serving task instead, until the line "end".
+ * 
+ * @param line the line
+ * @return ErrorCode the error of the line, which is printed on its session
+ */
+static ErrorCode handleLine( char* line )
+{
+   if ( ( batchSession != nullptr ) && ( batchSession == CLI_SERVER_get().getCurrentSession() ) )
+   {
+      if ( strcmp( line, "end" ) == 0 )
+      {
+         showBatchSummary( streamedBatch.getSummary() );
+         batchSession = nullptr;
+      }
+      else
+      {
+         (void)streamedBatch.executeLine( line );
+      }
+      return LibErrorCodes::eOK;
+   }
+
+   uint32_t jobId = 0;
+   const auto result = CLI_EXECUTOR_get().submit( line, &jobId, CLI_SERVER_get().getCurrentSession() );
+   if ( ( result == LibErrorCodes::eOK ) && ( jobId != 0 ) )
+   {
+      CLI_SERVER_get().print( "CLI: job %lu queued", jobId );
+   }
+   return result;
+}
+
+/**
+ * @brief Look up the session of the job running in the calling task, so that the output of a command queued is printed on its session.
+ * 
+ * @return lib::CliSession* the session, or nullptr if not called by a job
+ */
+static lib::CliSession* getJobSession( )
+{
+   return CLI_EXECUTOR_get().getCurrentSession();
+}
+
+/**
+ * @brief Wake up the serving task, once any session has received.
+ */
+static void notifyServer( )
+{
+   CLI_SERVER_get().notifyReceived();
+}
+
+/**
+ * @brief Function implementing a worker task of the command executor.
+ * @param argument Not used
+ */
+static void taskCliWorker( void const * argument )
+{
+   PARAM_NOT_USED( argument );
+
+   (void)LOGGER_get().registerTask();
+   CLI_EXECUTOR_get().runWorker();
+}
+
 /**
  * @brief Show the command-line arguments
  * 
@@ -59,11 +360,11 @@ CLI& CLI::getInstance()
  */
 static void showArgs( int argc, char* argv[] )
 {
-   LOGGING( "CLI: [%s] command executed", argv[0] );
+   CLI_SERVER_get().print( "CLI: [%s] command executed", argv[0] );
 
    for( int i = 0; i < argc; ++i )
    {
-      LOGGING( "CLI: arg[%d]: %s", i, argv[i] );
+      CLI_SERVER_get().print( "CLI: arg[%d]: %s", i, argv[i] );
    }
 }
 
@@ -80,6 +381,8 @@ static void commandTest( int argc, char* argv[] )
 
 /**
  * @brief Process the 'wifi' command
+ * @details Usage: wifi <AT command>
+ *          An AT command with spaces or quotes in it is quoted, e.g., wifi "AT+CWJAP=\"my ssid\",\"password\""
  * 
  * @param argc the number of arguments
  * @param argv the argument values
@@ -88,7 +391,7 @@ static void commandSerialWifi( int argc, char* argv[] )
 {
    if ( argc < 2 )
    {
-      LOGGING( "CLI: 'wifi' command requires at least 2 arguments" );
+      CLI_SERVER_get().print( "CLI: 'wifi' command requires at least 2 arguments" );
       return;
    }
 
@@ -97,5 +400,321 @@ static void commandSerialWifi( int argc, char* argv[] )
    /* NOTE: Responses are checked through the SerialWifi thread 
     */
    auto& serialWifi = SERIAL_WIFI_get();
-   (void)serialWifi.sendWait( reinterpret_cast<const char*>(atCommand) );
-}
\ No newline at end of file
+   if ( !serialWifi.sendWait( reinterpret_cast<const char*>(atCommand), isJobCancelled ) && isJobCancelled() )
+   {
+      CLI_SERVER_get().print( "CLI: 'wifi' cancelled" );
+   }
+}
+
+/**
+ * @brief Check if the job running the command in the calling worker is asked to stop, e.g., with the 'cancel' command
+ */
+static bool isJobCancelled( )
+{
+   return CLI_EXECUTOR_get().isCancelRequested();
+}
+
+/**
+ * @brief Process the 'serialstats' command
+ * @details Usage: serialstats [reset]
+ *          The counters of every serial device are shown, and reset afterwards if requested.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandSerialStats( int argc, char* argv[] )
+{
+   const bool reset = ( argc >= 2 ) && ( strcmp( argv[1], "reset" ) == 0 );
+
+   showSerialStats( "logger", SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 ), reset );
+   showSerialStats( "wifi",   SERIAL_DEVICE_get( eSerialDevice::DEVICE_2 ), reset );
+}
+
+/**
+ * @brief Process the 'loglevel' command
+ * @details Usage: loglevel [<module>|all <level>]
+ *          The runtime threshold of a module, or of all modules, is set if given, and the thresholds of all modules are shown.
+ *          Levels are none, error, warn, info, debug and trace, where the ones above LOG_LEVEL_COMPILE have no effect.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandLogLevel( int argc, char* argv[] )
+{
+   if ( !LIB_COMMON_commandLogLevel( argc, argv, printLine, nullptr ) )
+   {
+      lib::CLI::getInstance().setCommandError( LibErrorCodes::eCLI_INVALID_ARGUMENT );
+   }
+}
+
+/**
+ * @brief Process the 'jobs' command
+ * @details Usage: jobs
+ *          The jobs of the commands executed in the worker tasks are shown, along with how long they've been waiting or running.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandJobs( int argc, char* argv[] )
+{
+   PARAM_NOT_USED( argc );
+   PARAM_NOT_USED( argv );
+
+   AppCommandExecutor::JobInfo jobs[AppCommandExecutorConfig::NUM_JOBS];
+   const auto count = CLI_EXECUTOR_get().getJobs( jobs, AppCommandExecutorConfig::NUM_JOBS );
+   const auto now = LIB_COMMON_getTickMS();
+
+   for ( size_t i = 0; i < count; i++ )
+   {
+      const auto& job = jobs[i];
+      const bool isFinished = ( job.status == AppCommandExecutor::eJobStatus::DONE ) || ( job.status == AppCommandExecutor::eJobStatus::CANCELLED );
+      const auto end = isFinished ? job.finishedMs : now;
+      CLI_SERVER_get().print( "CLI: job %lu [%s] %s, waited %lu ms, ran %lu ms", job.id, job.command, AppCommandExecutor::getStatusName( job.status ),
+                              ( ( job.startedMs != 0 ) ? job.startedMs : end ) - job.submittedMs, ( job.startedMs != 0 ) ? ( end - job.startedMs ) : 0 );
+   }
+}
+
+/**
+ * @brief Process the 'cancel' command
+ * @details Usage: cancel <job id>
+ *          A queued job is cancelled at once, whereas a running one is asked to stop, which is up to its command.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandCancel( int argc, char* argv[] )
+{
+   if ( argc < 2 )
+   {
+      CLI_SERVER_get().print( "CLI: usage: cancel <job id>" );
+      return;
+   }
+
+   const auto jobId = static_cast<uint32_t>( strtoul( argv[1], nullptr, 10 ) );
+   const auto result = CLI_EXECUTOR_get().cancel( jobId );
+   if ( result != LibErrorCodes::eOK )
+   {
+      CLI_SERVER_get().print( "CLI: job %lu not cancelled, ret=0x%lx", jobId, result );
+   }
+}
+
+/**
+ * @brief Process the 'run' command
+ * @details Usage: run [<script> [continue]]
+ *          A script stored in flash is executed back to back, and it stops at the first line failing unless 'continue' is given.
+ *          The scripts are listed without any argument.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandRun( int argc, char* argv[] )
+{
+   if ( argc < 2 )
+   {
+      for ( const auto& script : cliScripts )
+      {
+         CLI_SERVER_get().print( "CLI: script [%s]", script.name );
+      }
+      return;
+   }
+
+   for ( const auto& script : cliScripts )
+   {
+      if ( strcmp( script.name, argv[1] ) == 0 )
+      {
+         const bool isStopOnError = ( argc < 3 ) || ( strcmp( argv[2], "continue" ) != 0 );
+         const auto summary = lib::CliBatch::run( lib::CLI::getInstance(), script.lines, isStopOnError, showBatchResult );
+         showBatchSummary( summary );
+         return;
+      }
+   }
+
+   CLI_SERVER_get().print( "CLI: unknown script [%s]", argv[1] );
+   lib::CLI::getInstance().setCommandError( LibErrorCodes::eCLI_INVALID_ARGUMENT );
+}
+
+/**
+ * @brief Process the 'batch' command
+ * @details Usage: batch [continue]
+ *          The lines following it on the same session are executed back to back as a script, until the line "end",
+ *          e.g., a provisioning script pasted or piped into a TCP session. It stops at the first line failing unless 'continue' is given.
+ *          The lines are executed in the serving task in order, including the commands which are queued to the workers otherwise.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandBatch( int argc, char* argv[] )
+{
+   auto* session = CLI_SERVER_get().getCurrentSession();
+   if ( session == nullptr )
+   {
+      CLI_SERVER_get().print( "CLI: 'batch' is not available here" );
+      return;
+   }
+
+   //!< A batch left by a session closed since is taken over
+   if ( ( batchSession != nullptr ) && ( batchSession != session ) && ( batchSession->getState() == lib::CliSession::eState::OPEN ) )
+   {
+      CLI_SERVER_get().print( "CLI: a batch is running on [%s]", batchSession->getName() );
+      return;
+   }
+
+   streamedBatch.start( ( argc < 2 ) || ( strcmp( argv[1], "continue" ) != 0 ) );
+   batchSession = session;
+   CLI_SERVER_get().print( "CLI: batch started, 'end' to finish" );
+}
+
+/**
+ * @brief Show the result of a line of a batch
+ * 
+ * @param context not used
+ * @param lineNumber the line number in the batch
+ * @param result the result of the line
+ */
+static void showBatchResult( void* context, uint32_t lineNumber, ErrorCode result )
+{
+   PARAM_NOT_USED( context );
+
+   if ( result == LibErrorCodes::eOK )
+   {
+      CLI_SERVER_get().print( "CLI: line %lu ok", lineNumber );
+   }
+   else
+   {
+      CLI_SERVER_get().print( "CLI: line %lu failed, ret=0x%lx", lineNumber, result );
+   }
+}
+
+/**
+ * @brief Show the summary of a batch
+ * 
+ * @param summary the summary
+ */
+static void showBatchSummary( const lib::CliBatch::Summary& summary )
+{
+   CLI_SERVER_get().print( "CLI: batch done, %lu executed, %lu failed, %lu skipped", summary.executed, summary.failed, summary.skipped );
+   if ( summary.failed > 0 )
+   {
+      CLI_SERVER_get().print( "CLI: first failure at line %lu, ret=0x%lx", summary.firstFailedLine, summary.firstError );
+   }
+}
+
+/**
+ * @brief Process the 'tasks' command
+ * @details Usage: tasks
+ *          The state, the priority, the free stack at its lowest and the CPU usage since the previous 'tasks' of every task are shown.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandTasks( int argc, char* argv[] )
+{
+   PARAM_NOT_USED( argc );
+   PARAM_NOT_USED( argv );
+
+   lib::StatsOutput output{ printLine };
+   (void)STATS_get().report( "tasks", output );
+}
+
+/**
+ * @brief Process the 'heap' command
+ * @details Usage: heap
+ *          The free heap, now and at its lowest, and its fragmentation are shown.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandHeap( int argc, char* argv[] )
+{
+   PARAM_NOT_USED( argc );
+   PARAM_NOT_USED( argv );
+
+   lib::StatsOutput output{ printLine };
+   (void)STATS_get().report( "heap", output );
+}
+
+/**
+ * @brief Process the 'buffers' command
+ * @details Usage: buffers
+ *          The occupancy, the peak and the overflows of every buffer registered are shown.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandBuffers( int argc, char* argv[] )
+{
+   PARAM_NOT_USED( argc );
+   PARAM_NOT_USED( argv );
+
+   lib::StatsOutput output{ printLine };
+   STATS_get().reportGroup( lib::eStatsGroup::BUFFERS, output );
+}
+
+/**
+ * @brief Process the 'stats' command
+ * @details Usage: stats [<name>|all|reset]
+ *          The stats providers are listed without any argument, and the one given, or all of them, is reported.
+ *          'reset' resets the peaks and the counters of all of them, e.g., before a test run.
+ * 
+ * @param argc the number of arguments
+ * @param argv the argument values
+ */
+static void commandStats( int argc, char* argv[] )
+{
+   lib::StatsOutput output{ printLine };
+   if ( argc < 2 )
+   {
+      STATS_get().list( output );
+   }
+   else if ( strcmp( argv[1], "all" ) == 0 )
+   {
+      STATS_get().reportAll( output );
+   }
+   else if ( strcmp( argv[1], "reset" ) == 0 )
+   {
+      STATS_get().resetAll();
+      CLI_SERVER_get().print( "CLI: stats reset" );
+   }
+   else if ( STATS_get().report( argv[1], output ) != LibErrorCodes::eOK )
+   {
+      CLI_SERVER_get().print( "CLI: unknown stats [%s]", argv[1] );
+      lib::CLI::getInstance().setCommandError( LibErrorCodes::eSTATS_PROVIDER_NOT_FOUND );
+   }
+}
+
+/**
+ * @brief Print a line of a command, e.g., of a report of the stats, on the session the command is entered in
+ * 
+ * @param context not used
+ * @param line the line
+ */
+static void printLine( void* context, const char* line )
+{
+   PARAM_NOT_USED( context );
+   CLI_SERVER_get().print( "%s", line );
+}
+
+/**
+ * @brief Show the statistics of a serial device
+ * 
+ * @param name the name of the device to be shown
+ * @param serialDevice the serial device
+ * @param reset true to reset the counters after showing them
+ */
+static void showSerialStats( const char* name, AppSerialDevice& serialDevice, bool reset )
+{
+   const auto stats = serialDevice.getStatistics();
+   const auto elapsed_ms = LIB_COMMON_getTickMS() - stats.sinceTick_ms;
+   const auto seconds = ( elapsed_ms / 1000 ) > 0 ? ( elapsed_ms / 1000 ) : 1;
+
+   CLI_SERVER_get().print( "CLI: [%s] for %lu ms", name, elapsed_ms );
+   CLI_SERVER_get().print( "CLI:   rx %lu B (%lu B/s), drops %lu", stats.bytesIn, stats.bytesIn / seconds, stats.rxDrops );
+   CLI_SERVER_get().print( "CLI:   tx %lu B (%lu B/s), frames %lu, busy %lu, timeouts %lu", stats.bytesOut, stats.bytesOut / seconds, stats.framesOut, stats.txBusy, stats.txTimeouts );
+   CLI_SERVER_get().print( "CLI:   tx latency last/avg/max %lu/%lu/%lu ms, wait total %lu ms", 
+                           stats.txLatencyLast_ms, ( stats.framesOut > 0 ) ? ( stats.txLatencyTotal_ms / stats.framesOut ) : 0, stats.txLatencyMax_ms, stats.txWaitTotal_ms );
+
+   if ( reset )
+   {
+      serialDevice.resetStatistics();
+   }
+}
@@ -12,4 +12,48 @@
 
 #pragma once
 
+/************************************************ Includes **************************************************/
 #include "cli.h"
+#include "command_executor.h"
+#include "cli_server.h"
+#include "lockable_freertos.h"
+#include "semaphore_freertos.h"
+#include "logger_port_freertos.h"
+
+/************************************************* Consts ***************************************************/
+#ifndef CLI_NUM_WORKERS
+#define CLI_NUM_WORKERS    2        //!< Worker tasks executing the commands marked eExecution::ASYNC
+#endif
+
+#ifndef CLI_TCP_PORT
+#define CLI_TCP_PORT       23       //!< Telnet
+#endif
+
+/************************************************* Types ****************************************************/
+/**
+ * @brief Sizes of the command executor of this application.
+ */
+struct AppCommandExecutorConfig : lib::CommandExecutorConfig
+{
+   constexpr static size_t NUM_JOBS = 4;
+};
+
+using AppCommandExecutor = lib::BasicCommandExecutor<lib::LockableFreeRTOS, lib::Semaphore_FreeRTOS, lib::LoggerPortFreeRTOS, AppCommandExecutorConfig>;
+
+/**
+ * @brief Sessions of the CLI server of this application, i.e., the UART and the TCP connections.
+ */
+struct AppCliServerConfig : lib::CliServerConfig
+{
+   constexpr static size_t MAX_SESSIONS = 3;
+};
+
+using AppCliServer = lib::BasicCliServer<lib::LockableFreeRTOS, lib::Semaphore_FreeRTOS, lib::LoggerPortFreeRTOS, AppCliServerConfig>;
+
+/******************************************* Function Declarations ******************************************/
+ErrorCode            CLI_EXECUTOR_init       ( );
+AppCommandExecutor&  CLI_EXECUTOR_get        ( );
+ErrorCode            CLI_SERVER_init         ( );
+AppCliServer&        CLI_SERVER_get          ( );
+void                 CLI_SERVER_receiveUart  ( const char* data, size_t length );
+bool                 CLI_SERVER_listenTcp    ( );
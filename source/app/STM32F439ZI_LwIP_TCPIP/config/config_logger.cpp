@@ -0,0 +1,149 @@
+/************************************************************************************************************
+ * 
+ * @file config_logger.cpp
+ * @brief Configuration of the logger, i.e., its sizes, its sinks and the hooks of the C library and lib_common.
+ * @details The logger sinks the messages to the UART, and mirrors them into the RAM area retained over a reset,
+ *          whose logs, along with what's left in the staging buffers on a crash, are sent first on the next boot.
+ *          More sinks, e.g., the network, can be added with LOGGER_get().addSink() once they're up.
+ *          The C library is hooked with '_write', which is called whenever printf is called across the application,
+ *          which decouples the logging implementation from the application code.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/ 
+#include "config_logger.h"
+#include "config_serial_device.h"
+#include "retained_log.h"
+#include "common.h"
+#include "cmsis_os.h"
+
+/************************************************ Consts ****************************************************/ 
+#ifndef LOGGER_RETAINED_LOG_SIZE
+#define LOGGER_RETAINED_LOG_SIZE      2048      //!< Size of the retained area, which holds the last logs before a reset
+#endif
+
+#ifndef LOGGER_UART_BYTES_PER_SECOND
+#define LOGGER_UART_BYTES_PER_SECOND  11520     //!< The line rate of 115200 baud, over which the UART drops messages instead of holding back the other sinks
+#endif
+
+constexpr size_t SERIAL_BUFFER_SIZE = 256;
+
+/********************************************* Local Variables **********************************************/ 
+static lib::LockableFreeRTOS     lock;                      //!< Mutex for protecting access to the shared staging buffer and the registration
+static lib::Semaphore_FreeRTOS   semLogAvailable;           //!< Semaphore for log availability to signal the logging thread
+static osThreadId                taskHandle;                //!< Handle for the logging task
+
+//!< Placed in the section left alone by the startup code, see STM32F439ZITX_FLASH.ld
+__attribute__(( section( ".retained" ) )) static uint8_t retainedArea[LOGGER_RETAINED_LOG_SIZE];
+static lib::RetainedLog          retainedLog{ retainedArea, sizeof( retainedArea ) };
+
+using UartLogSink = lib::SerialLogSink<AppSerialDevice, SERIAL_BUFFER_SIZE>;
+static UartLogSink               uartSink{ "uart", { .bytesPerSecond = LOGGER_UART_BYTES_PER_SECOND, .burstBytes = 2 * AppLogger::ENTRY_BUFFER_SIZE }, SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 ) };
+static lib::RetainedLogSink      retainedSink{ "retained", {}, retainedLog };
+
+/****************************************** Function Declarations *******************************************/ 
+static void taskLogging       ( void const * argument );
+
+/****************************************** Function Definitions ********************************************/ 
+/**
+ * @brief Initializes the logger with the UART and the retained log as its sinks, and starts the logging task.
+ */
+void LOGGER_init( )
+{
+   auto& serialDevice = SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 );
+   serialDevice.initialize();
+
+   auto& logger = LOGGER_get();
+   if ( logger.initialize() != LibErrorCodes::eOK )
+   {
+      return;
+   }
+   (void)logger.addSink( uartSink );
+   (void)logger.addSink( retainedSink );
+
+   osThreadDef( loggingTask, taskLogging, osPriorityNormal, 0, 512 );
+   taskHandle = osThreadCreate( osThread(loggingTask), nullptr );
+}
+
+/**
+ * @brief Get the singleton instance of the logger.
+ * 
+ * @return AppLogger& 
+ */
+AppLogger& LOGGER_get( )
+{
+   static AppLogger instance{ lock, semLogAvailable };
+   return instance;
+}
+
+/**
+ * @brief Logging task function, which sends the logs recovered from the last run before any other.
+ *
+ * @param argument thread argument
+ */
+static void taskLogging( void const * argument )
+{
+   PARAM_NOT_USED( argument );
+
+   auto& logger = LOGGER_get();
+   logger.sendRecovered( retainedLog, uartSink );
+   logger.run();
+}
+
+/**
+ * @brief Saves the logs left in the staging buffers, along with the reason, into the retained log on a crash.
+ * @details They are sent first on the next boot, which follows a reset that doesn't clear the RAM, e.g., the one the fault handlers do right after saving them.
+ * 
+ * @param reason what happened, e.g., "hard fault"
+ */
+extern "C" void LOGGER_saveOnCrash( const char* reason )
+{
+   LOGGER_get().saveOnCrash( retainedSink, reason );
+}
+
+/**
+ * @brief Writes a binary log record to the logger.
+ * 
+ * @param record pointer to the record
+ * @param length length of the record
+ */
+void LIB_COMMON_writeLogRecord( const uint8_t* record, size_t length )
+{
+   LOGGER_get().writeRecord( record, length );
+}
+
+/**
+ * @brief Tags the messages the calling task logs from now on with a level, which the sinks filter them by.
+ * 
+ * @param level the level
+ */
+void LIB_COMMON_tagLogLevel( uint8_t level )
+{
+   lib::LoggerPortFreeRTOS::setLevel( level );
+}
+
+/**
+ * @brief Redirects the C library printf function to the logger.
+ * 
+ * @param file: File descriptor (not used)
+ * @param ptr: Pointer to the data to be sent
+ * @param len: Length of the data to be sent
+ * @retval Number of bytes written
+ */
+extern "C" int _write( int file, char *ptr, int len )
+{
+   PARAM_NOT_USED( file );
+
+   //!< The data is taken with its length, as ptr points into the buffer of the C library, which may have no room for a terminating null.
+   if ( len > 0 )
+   {
+      LOGGER_get().write( reinterpret_cast<const uint8_t*>( ptr ), static_cast<size_t>( len ) );
+   }
+
+   return len;
+}
@@ -0,0 +1,59 @@
+/************************************************************************************************************
+ * 
+ * @file config_logger.h
+ * @brief Configuration of the logger, i.e., its sizes, its sinks and the hooks of the C library and lib_common.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "logger.h"
+#include "log_sink.h"
+#include "lockable_freertos.h"
+#include "semaphore_freertos.h"
+#include "logger_port_freertos.h"
+
+/************************************************* Consts ***************************************************/
+#ifndef LOGGER_NUM_STAGING_BUFFERS
+#define LOGGER_NUM_STAGING_BUFFERS  4           //!< Staging buffers for the tasks registered with registerTask()
+#endif
+
+#ifndef LOGGER_STAGING_BUFFER_SIZE
+#define LOGGER_STAGING_BUFFER_SIZE  256         //!< Size of every staging buffer for a registered task
+#endif
+
+#ifndef LOGGER_MAX_SINKS
+#define LOGGER_MAX_SINKS            4           //!< Sinks including the UART and the retained log
+#endif
+
+#ifndef LOGGER_OVERFLOW_POLICY
+#define LOGGER_OVERFLOW_POLICY      DROP_NEWEST //!< One of lib::LoggerBase::eOverflowPolicy
+#endif
+
+/************************************************* Types ****************************************************/
+/**
+ * @brief Sizes of the logger of this application, which are set in the build.
+ */
+struct AppLoggerConfig : lib::LoggerConfig
+{
+   constexpr static size_t                            NUM_STAGING_BUFFERS  = LOGGER_NUM_STAGING_BUFFERS;
+   constexpr static size_t                            STAGING_BUFFER_SIZE  = LOGGER_STAGING_BUFFER_SIZE;
+   constexpr static size_t                            MAX_SINKS            = LOGGER_MAX_SINKS;
+   constexpr static lib::LoggerBase::eOverflowPolicy  OVERFLOW_POLICY      = lib::LoggerBase::eOverflowPolicy::LOGGER_OVERFLOW_POLICY;
+};
+
+/**
+ * @brief Logger type of this application, which fans the messages out to any kind of sinks, i.e., the UART, the retained log and the network.
+ */
+using AppLogger = lib::BasicLogger<lib::LockableFreeRTOS, lib::Semaphore_FreeRTOS, lib::LogSink, lib::LoggerPortFreeRTOS, AppLoggerConfig>;
+
+/******************************************* Function Declarations ******************************************/    
+void        LOGGER_init          ( );
+AppLogger&  LOGGER_get           ( );
+
+extern "C" void LOGGER_saveOnCrash ( const char* reason );
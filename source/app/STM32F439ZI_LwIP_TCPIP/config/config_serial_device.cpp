@@ -4,6 +4,8 @@
  * @brief Configuration for the serial device.
  * @details This file contains the interrupt handlers for the UART as well, and thus, 
  *          callback functions that need to be called within those interrupt contexts are referenced here.
+ *          Every UART is mapped to its serial device through a registry keyed by the UART instance,
+ *          so the interrupt handlers look up the device in constant time instead of comparing the instance with every UART.
  *  
  * @author Sungsu Kim
  * @copyright 2025 Sungsu Kim
@@ -14,44 +16,70 @@
 
 /************************************************ Includes **************************************************/
 #include "config_serial_device.h"
-#include "config_cli.h"
-#include "config_serial_wifi.h"
-#include "lockable_freertos.h"
-#include "semaphore_freertos.h"
-#include "usart.h"
-
-/************************************************* Consts ***************************************************/
-constexpr size_t RX_BUFFER_SIZE = 128;
+#include "serial_device_registry.h"
 
 /******************************************* Function Declarations ******************************************/    
+static void handleUartIrq     ( UART_HandleTypeDef *huart );
 static bool isNewUartRxData   ( UART_HandleTypeDef *huart );
-static void sendUart1         ( const uint8_t* data, size_t length );
-static void sendUart2         ( const uint8_t* data, size_t length );
 
 /********************************************* Local Variables **********************************************/    
-//!< For SerialDevice #1 (Logger module)
-static uint8_t                 rxBuffer1[RX_BUFFER_SIZE] = {0};
+//!< For SerialDevice #1 (Logger module and CLI)
 static lib::LockableFreeRTOS   lockable1;
 static lib::Semaphore_FreeRTOS semTxComplete1;
 static lib::Semaphore_FreeRTOS semNewRxBytes1;
-static lib::SerialDevice       serialDevice1{ sendUart1, rxBuffer1, sizeof(rxBuffer1), lockable1, semTxComplete1, semNewRxBytes1 };
+static AppSerialDevice         serialDevice1{ UartSender{ &huart3 }, lockable1, semTxComplete1, semNewRxBytes1 };
 
 //!< For SerialDevice #2 (SerialWifi module)
-static uint8_t                 rxBuffer2[RX_BUFFER_SIZE] = {0};
 static lib::LockableFreeRTOS   lockable2;
 static lib::Semaphore_FreeRTOS semTxComplete2;
 static lib::Semaphore_FreeRTOS semNewRxBytes2;
-static lib::SerialDevice       serialDevice2{ sendUart2, rxBuffer2, sizeof(rxBuffer2), lockable2, semTxComplete2, semNewRxBytes2 };
+static AppSerialDevice         serialDevice2{ UartSender{ &huart2 }, lockable2, semTxComplete2, semNewRxBytes2 };
+
+/**
+ * @brief Table of the serial devices with their UARTs, in the order of eSerialDevice.
+ * @details The instance is given with the peripheral macro, as huart->Instance is set only once the UART is initialized.
+ */
+static const struct
+{
+   const USART_TypeDef* instance;
+   AppSerialDevice*     device;
+} serialDevices[] =
+{
+   { USART3, &serialDevice1 },
+   { USART2, &serialDevice2 },
+};
+static_assert( sizeof( serialDevices ) / sizeof( serialDevices[0] ) == static_cast<size_t>( eSerialDevice::COUNT ), "A UART must be given for every serial device" );
+
+static lib::SerialDeviceRegistry<AppSerialDevice> registry;
 
 /******************************************* Function Definitions *******************************************/    
+/**
+ * @brief Register the serial devices for their UARTs.
+ * @note This must be called before the UART interrupts are enabled.
+ *
+ * @return ErrorCode eSERIAL_REGISTRY_COLLISION if two UARTs fall into the same slot of the registry
+ */
+ErrorCode SERIAL_DEVICE_init( )
+{
+   for ( const auto& entry : serialDevices )
+   {
+      const auto result = registry.add( entry.instance, *entry.device );
+      if ( result != LibErrorCodes::eOK )
+      {
+         return result;
+      }
+   }
+   return LibErrorCodes::eOK;
+}
+
 /**
  * @brief Get the serial device instance.
  * @param device The serial device type.
  * @return Reference to the serial device.
  */
-lib::SerialDevice& SERIAL_DEVICE_get( eSerialDevice device )
+AppSerialDevice& SERIAL_DEVICE_get( eSerialDevice device )
 {
-   return ( device == eSerialDevice::DEVICE_1 ) ? serialDevice1 : serialDevice2;
+   return *serialDevices[ static_cast<size_t>( device ) ].device;
 }
 
 /**
@@ -59,12 +87,7 @@ lib::SerialDevice& SERIAL_DEVICE_get( eSerialDevice device )
  */
 extern "C" void USART2_IRQHandler(void)
 {
-   HAL_UART_IRQHandler( &huart2 );
-   if ( isNewUartRxData( &huart2 ) )
-   {
-      auto &serialDevice = SERIAL_DEVICE_get( eSerialDevice::DEVICE_2 );
-      serialDevice.pushRxByte( static_cast<uint8_t>( huart2.Instance->DR ) );
-   }
+   handleUartIrq( &huart2 );
 }
 
 /**
@@ -72,54 +95,41 @@ extern "C" void USART2_IRQHandler(void)
  */
 extern "C" void USART3_IRQHandler(void)
 {
-   HAL_UART_IRQHandler( &huart3 );
-   if ( isNewUartRxData( &huart3 ) )
-   {
-      auto& cli = lib::CLI::getInstance();
-      cli.putCharIntoBuffer( static_cast<uint8_t>( huart3.Instance->DR ) );
-   }
+   handleUartIrq( &huart3 );
 }
 
 /**
  * @brief UART transmission complete callback.
  * @details This function is called when the UART transmission is complete in the interrupt context through the HAL,
- *          and it signals the logging thread on the completion of the transmission.
+ *          and it signals the serial device of the UART on the completion of the transmission.
  */
 extern "C" void HAL_UART_TxCpltCallback( UART_HandleTypeDef *huart )
 {
-   if ( huart->Instance == USART2 )
-   {
-      auto &serialDevice = SERIAL_DEVICE_get( eSerialDevice::DEVICE_2 );
-      serialDevice.notifySendComplete();
-   }
-
-   if ( huart->Instance == USART3 )
+   auto* serialDevice = registry.find( huart->Instance );
+   if ( serialDevice != nullptr )
    {
-      auto &serialDevice = SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 );
-      serialDevice.notifySendComplete();
+      serialDevice->notifySendComplete();
    }
 }
 
 /**
- * @brief Send data over UART.
- * 
- * @param data Pointer to the data to be sent.
- * @param length Length of the data to be sent.
- */
-static void sendUart1( const uint8_t* data, size_t length )
-{
-   HAL_UART_Transmit_IT( &huart3, (uint8_t*)data, length );
-}
-
-/**
- * @brief Send data over UART.
- * 
- * @param data Pointer to the data to be sent.
- * @param length Length of the data to be sent.
+ * @brief Handle a UART interrupt, which is common to every UART.
+ * @details A byte received is pushed into the serial device of the UART, and the data register is read regardless to clear the flag.
+ *
+ * @param huart Pointer to the UART handle.
  */
-static void sendUart2( const uint8_t* data, size_t length )
+static void handleUartIrq( UART_HandleTypeDef *huart )
 {
-   HAL_UART_Transmit_IT( &huart2, (uint8_t*)data, length );
+   HAL_UART_IRQHandler( huart );
+   if ( isNewUartRxData( huart ) )
+   {
+      const auto data = static_cast<uint8_t>( huart->Instance->DR );
+      auto* serialDevice = registry.find( huart->Instance );
+      if ( serialDevice != nullptr )
+      {
+         (void)serialDevice->pushRxByte( data );
+      }
+   }
 }
 
 /**
@@ -13,6 +13,12 @@
 
 /************************************************ Includes **************************************************/
 #include "serial_device.h"
+#include "lockable_freertos.h"
+#include "semaphore_freertos.h"
+#include "usart.h"
+
+/************************************************* Consts ***************************************************/
+constexpr size_t SERIAL_DEVICE_RX_BUFFER_SIZE = 128;
 
 /************************************************* Types ****************************************************/
 /**
@@ -20,9 +26,30 @@
  */
 enum class eSerialDevice
 {
-   DEVICE_1,   //!< LOGGER
+   DEVICE_1,   //!< LOGGER and CLI
    DEVICE_2,   //!< SerialWifi
+   COUNT
+};
+
+/**
+ * @brief Sender for every UART, which transmits through the UART handle it holds, so no trampoline is needed per UART.
+ */
+struct UartSender
+{
+   UART_HandleTypeDef* huart;
+
+   //!< The length fits, as the serial device rejects a segment longer than MAX_SEGMENT_LENGTH
+   void operator()( const uint8_t* data, size_t length ) const
+   {
+      HAL_UART_Transmit_IT( huart, const_cast<uint8_t*>( data ), static_cast<uint16_t>( length ) );
+   }
 };
 
+/**
+ * @brief Serial device type of this application, whose hooks are resolved at compile time.
+ */
+using AppSerialDevice = lib::BasicSerialDevice<lib::LockableFreeRTOS, lib::Semaphore_FreeRTOS, UartSender, SERIAL_DEVICE_RX_BUFFER_SIZE>;
+
 /******************************************* Function Declarations ******************************************/    
-lib::SerialDevice& SERIAL_DEVICE_get( eSerialDevice device );
\ No newline at end of file
+ErrorCode         SERIAL_DEVICE_init   ( );
+AppSerialDevice&  SERIAL_DEVICE_get    ( eSerialDevice device );
\ No newline at end of file
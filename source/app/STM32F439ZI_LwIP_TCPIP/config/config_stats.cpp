@@ -0,0 +1,55 @@
+/************************************************************************************************************
+ * 
+ * @file config_stats.cpp
+ * @brief Configuration of the stats providers, which the introspection commands of the CLI report.
+ * @details The providers of the system and of the serial devices are registered here, and the other modules register their own,
+ *          e.g., the CLI server registers the buffers of its sessions.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-23
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/ 
+#include "config_stats.h"
+#include "config_serial_device.h"
+#include "stats_freertos.h"
+
+/******************************************* Function Definitions *******************************************/    
+/**
+ * @brief Register the stats providers of the tasks, the heap and the serial devices.
+ * @note This must be called before any report, and it's called only once.
+ * 
+ * @return ErrorCode eSTATS_REGISTRY_FULL if STATS_MAX_PROVIDERS is too small
+ */
+ErrorCode STATS_init( )
+{
+   static lib::TaskStats_FreeRTOS<>        tasks;
+   static lib::HeapStats_FreeRTOS          heap;
+   static lib::RingBufferStats<uint8_t>    uartRx{ "uart.rx", SERIAL_DEVICE_get( eSerialDevice::DEVICE_1 ).getRxBuffer() };
+   static lib::RingBufferStats<uint8_t>    wifiRx{ "wifi.rx", SERIAL_DEVICE_get( eSerialDevice::DEVICE_2 ).getRxBuffer() };
+
+   lib::IStatsProvider* const providers[] = { &tasks, &heap, &uartRx, &wifiRx };
+   for ( auto* provider : providers )
+   {
+      const auto result = STATS_get().add( *provider );
+      if ( result != LibErrorCodes::eOK )
+      {
+         return result;
+      }
+   }
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Get the registry of the stats providers
+ * 
+ * @return AppStatsRegistry& 
+ */
+AppStatsRegistry& STATS_get( )
+{
+   static AppStatsRegistry instance;
+   return instance;
+}
@@ -0,0 +1,25 @@
+/************************************************************************************************************
+ * 
+ * @file config_stats.h
+ * @brief Configuration of the stats providers, which the introspection commands of the CLI report.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-23
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "stats_registry.h"
+
+/************************************************* Consts ***************************************************/
+constexpr size_t STATS_MAX_PROVIDERS = 12;
+
+/************************************************* Types ****************************************************/
+using AppStatsRegistry = lib::StatsRegistry<STATS_MAX_PROVIDERS>;
+
+/******************************************* Function Declarations ******************************************/    
+ErrorCode            STATS_init  ( );
+AppStatsRegistry&    STATS_get   ( );
@@ -2,7 +2,7 @@
  * 
  * @file Utilities.h
  * @brief This file contains utility functions and macros for logging and tick count retrieval.
- * @details It provides a simple logging mechanism that can be used throughout the application for debugging and tracing.
+ * @details The logging is provided by lib_common.h, and this file only silences it for the unit tests.
  * 
  * @author Sungsu Kim
  * @copyright 2025 Sungsu Kim
@@ -15,12 +15,13 @@
 
 /************************************************** Includes ************************************************/
 #include "FreeRTOS.h"
+#include "lib_common.h"
 #include <cstdio>
 
 /************************************************** Macros **************************************************/
-#if !defined ( UNIT_TESTING )
-#define LOGGING( format, ... ) printf( "%08d: " format, GET_TICK(), ##__VA_ARGS__ )
-#else 
+//!< LOGGING and the leveled LOG_* macros come from lib_common.h, and they are silenced for the unit tests
+#if defined ( UNIT_TESTING )
+#undef LOGGING
 #define LOGGING( format, ... )
 #endif
 
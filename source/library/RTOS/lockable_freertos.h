@@ -24,7 +24,7 @@ namespace lib
  * @brief A class that implements a lockable resource using FreeRTOS mutexes.
  * @details This class provides a simple interface for locking and unlocking resources in a FreeRTOS
  */
-class LockableFreeRTOS : public ILockable
+class LockableFreeRTOS final : public ILockable
 {
 public:
    constexpr static uint32_t DEFAULT_TIMEOUT_MS = 2000;
@@ -0,0 +1,69 @@
+/************************************************************************************************************
+ *
+ * @file lockable_std.h
+ * @brief A class that implements a lockable resource using the C++ standard library, e.g., for host builds.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+#include "lockable_interface.h"
+#include <chrono>
+#include <mutex>
+#include <cstdint>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+/**
+ * @brief A class that implements a lockable resource using std::timed_mutex.
+ * @details This allows the library modules to run on a host, e.g., Linux or Windows, with real threads instead of mocks.
+ */
+class LockableStd final : public ILockable
+{
+public:
+   constexpr static uint32_t DEFAULT_TIMEOUT_MS = 2000;
+
+   //!< Constructor and destructor
+   LockableStd( ) = default;
+   ~LockableStd() override = default;
+
+   //!< Disable copy and move operations
+   LockableStd(const LockableStd&) = delete;
+   LockableStd& operator=(const LockableStd&) = delete;
+   LockableStd(LockableStd&&) = delete;
+   LockableStd& operator=(LockableStd&&) = delete;
+
+   //!< Initialize the lockable resource, which is ready on construction
+   ErrorCode initialize() override
+   {
+      return LibErrorCodes::eOK;
+   }
+
+   //!< Lock the resource
+   void lock() override
+   {
+      m_mutex.lock();
+   }
+
+   //!< Try to lock the resource with a timeout
+   bool try_lock( uint32_t timeout_ms = DEFAULT_TIMEOUT_MS ) override
+   {
+      return m_mutex.try_lock_for( std::chrono::milliseconds( timeout_ms ) );
+   }
+
+   //!< Unlock the resource
+   void unlock() override
+   {
+      m_mutex.unlock();
+   }
+
+private:
+   std::timed_mutex m_mutex;  //!< Mutex used for locking
+};
+} // namespace lib
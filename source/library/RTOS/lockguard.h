@@ -12,18 +12,27 @@
 
 #pragma once
 
+/************************************************** Includes *************************************************/
+#include "lockable_interface.h"
+#include "rtos_concepts.h"
+#include <stdint.h>
+
 namespace lib 
 {
 /************************************************** Types ***************************************************/
 /**
  * @brief A simple lock guard class that locks a resource upon construction and unlocks it upon destruction.
  * @details This class is used to manage locks in a RAII (Resource Acquisition Is Initialization) style, ensuring that the lock is released when the guard goes out of scope.
+ *          The type of the lockable is deduced from the constructor argument, so a concrete, e.g., final, lockable is called directly without a virtual call.
+ * 
+ * @tparam Lock Type of the lockable satisfying Lockable, e.g., ILockable or one of its implementations
  */
+template<Lockable Lock = ILockable>
 class lock_guard
 {
 public:
    //!< Constructor that locks the resource
-   explicit lock_guard( ILockable& lockable, uint32_t timeout_ms = 0 )
+   explicit lock_guard( Lock& lockable, uint32_t timeout_ms = 0 )
     : m_lockable( lockable )
     , m_locked( false )
    {
@@ -48,6 +57,9 @@ public:
       m_locked = false;
    }
 
+   //!< Check if the lock was taken, which may not be when a timeout is given
+   bool owns_lock() const { return m_locked; }
+
    //!< Disable copy and move operations
    lock_guard(const lock_guard&) = delete;
    lock_guard& operator=(const lock_guard&) = delete;
@@ -55,7 +67,7 @@ public:
    lock_guard& operator=(lock_guard&&) = delete;
 
 private:
-   ILockable& m_lockable;  //!< Reference to the lockable resource
+   Lock& m_lockable;       //!< Reference to the lockable resource
    bool m_locked;          //!< Flag indicating if the resource is locked   
 };
 } // namespace lib
\ No newline at end of file
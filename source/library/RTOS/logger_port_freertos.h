@@ -0,0 +1,79 @@
+/************************************************************************************************************
+ * 
+ * @file logger_port_freertos.h
+ * @brief FreeRTOS hooks of the logger, see BasicLogger.
+ *  
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/ 
+#include "lib_common.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+/************************************************* Consts ***************************************************/
+#ifndef LOGGER_TLS_INDEX
+#define LOGGER_TLS_INDEX   0     //!< Thread local storage pointer of every task holding the level its messages are tagged with
+#endif
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+/**
+ * @brief FreeRTOS hooks of the logger.
+ * @details The level a task tags its messages with is kept in a thread local storage pointer of the task,
+ *          which needs configNUM_THREAD_LOCAL_STORAGE_POINTERS greater than LOGGER_TLS_INDEX.
+ */
+struct LoggerPortFreeRTOS
+{
+   using TaskId = TaskHandle_t;
+
+   static TaskId currentTask( )
+   {
+      return xTaskGetCurrentTaskHandle();
+   }
+
+   static bool isInsideInterrupt( )
+   {
+      return xPortIsInsideInterrupt() != pdFALSE;
+   }
+
+   static void delay( uint32_t ms )
+   {
+      vTaskDelay( pdMS_TO_TICKS( ms ) );
+   }
+
+   /**
+    * @brief Tag the messages the calling task logs from now on with a level.
+    * @details Nothing is done in the interrupt context, where the messages are dropped anyway, 
+    *          nor before the scheduler starts, where there is no task to keep the level for.
+    */
+   static void setLevel( uint8_t level )
+   {
+      if ( isInsideInterrupt() || ( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED ) )
+      {
+         return;
+      }
+      vTaskSetThreadLocalStoragePointer( nullptr, LOGGER_TLS_INDEX, reinterpret_cast<void*>( static_cast<uintptr_t>( level ) ) );
+   }
+
+   /**
+    * @brief Get the level the calling task tags its messages with.
+    */
+   static uint8_t getLevel( )
+   {
+      if ( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+      {
+         return LOG_LEVEL_NONE;
+      }
+      return static_cast<uint8_t>( reinterpret_cast<uintptr_t>( pvTaskGetThreadLocalStoragePointer( nullptr, LOGGER_TLS_INDEX ) ) );
+   }
+};
+} /* namespace lib */
@@ -0,0 +1,63 @@
+/************************************************************************************************************
+ * @file logger_port_std.h
+ * @brief C++ standard library hooks of the logger, see BasicLogger, e.g., for host builds.
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "lib_common.h"
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+/**
+ * @brief C++ standard library hooks of the logger, where every thread is a task.
+ * @details There is no interrupt context on a host, so a thread simulating an ISR marks itself with setInsideInterrupt().
+ */
+struct LoggerPortStd
+{
+   using TaskId = std::thread::id;
+
+   static TaskId currentTask( )
+   {
+      return std::this_thread::get_id();
+   }
+
+   static bool isInsideInterrupt( )
+   {
+      return m_isInsideInterrupt;
+   }
+
+   static void setInsideInterrupt( bool isInside )
+   {
+      m_isInsideInterrupt = isInside;
+   }
+
+   static void delay( uint32_t ms )
+   {
+      std::this_thread::sleep_for( std::chrono::milliseconds( ms ) );
+   }
+
+   static void setLevel( uint8_t level )
+   {
+      m_level = level;
+   }
+
+   static uint8_t getLevel( )
+   {
+      return m_level;
+   }
+
+private:
+   inline static thread_local bool     m_isInsideInterrupt{ false };
+   inline static thread_local uint8_t  m_level{ LOG_LEVEL_NONE };
+};
+} // namespace lib
@@ -0,0 +1,55 @@
+/************************************************************************************************************
+ *
+ * @file rtos_concepts.h
+ * @brief Concepts of the RTOS primitives, which the library templates are instantiated with as policy types.
+ * @details A template constrained with Lockable or CountingSemaphore, e.g., BasicSerialDevice or lock_guard, calls the type given directly,
+ *          so that a final implementation, e.g., LockableFreeRTOS or Semaphore_FreeRTOS, is inlined even into the interrupt paths.
+ *          ILockable and ISemaphore satisfy them as well, so that an instance over the interfaces, e.g., with the mocks, is still available.
+ *          A type not fitting is rejected where the template is named, rather than deep inside its implementation.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-24
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "lockable_interface.h"
+#include "semaphore_interface.h"
+#include "error_codes_lib.h"
+#include <stdint.h>
+#include <concepts>
+
+namespace lib
+{
+/************************************************* Concepts *************************************************/
+/**
+ * @brief A lockable resource, e.g., a mutex, as ILockable describes it.
+ */
+template<typename T>
+concept Lockable = requires( T& lockable, uint32_t timeout_ms )
+{
+   { lockable.initialize() } -> std::convertible_to<ErrorCode>;
+   { lockable.lock() };
+   { lockable.try_lock( timeout_ms ) } -> std::convertible_to<bool>;
+   { lockable.unlock() };
+};
+
+/**
+ * @brief A counting semaphore, which can be given from an interrupt as well, as ISemaphore describes it.
+ */
+template<typename T>
+concept CountingSemaphore = requires( T& semaphore, uint32_t count, uint32_t timeout_ms )
+{
+   { semaphore.initialize( count, count ) } -> std::convertible_to<ErrorCode>;
+   { semaphore.put() };
+   { semaphore.putISR() };
+   { semaphore.get( timeout_ms ) } -> std::convertible_to<ErrorCode>;
+};
+
+static_assert( Lockable<ILockable>, "ILockable must stay usable as a policy, e.g., for the mocks" );
+static_assert( CountingSemaphore<ISemaphore>, "ISemaphore must stay usable as a policy, e.g., for the mocks" );
+} // namespace lib
@@ -24,7 +24,7 @@ namespace lib
 /**
  * @brief FreeRTOS implementation of the ISemaphore interface.
  */
-class Semaphore_FreeRTOS : public ISemaphore
+class Semaphore_FreeRTOS final : public ISemaphore
 {
 public:
    Semaphore_FreeRTOS()
@@ -0,0 +1,111 @@
+/************************************************************************************************************
+ *
+ * @file semaphore_std.h
+ * @brief C++ standard library implementation of the ISemaphore interface, e.g., for host builds.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "semaphore_interface.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+/**
+ * @brief C++ standard library implementation of the ISemaphore interface over a mutex and a condition variable.
+ * @details Giving a semaphore that is already at its maximum count is ignored as FreeRTOS does, so the count is kept under the mutex,
+ *          where the clamp in put() and the decrement in get() are atomic together, and no give is lost to a take in progress.
+ *          There is no interrupt context on a host, so putISR() is the same as put(); a thread simulating an ISR can call either.
+ */
+class Semaphore_Std final : public ISemaphore
+{
+public:
+   Semaphore_Std()
+   {  }
+
+   ~Semaphore_Std()
+   {  }
+
+   //!< Disable copy and move operations
+   Semaphore_Std(const Semaphore_Std&) = delete;
+   Semaphore_Std& operator=(const Semaphore_Std&) = delete;
+   Semaphore_Std(Semaphore_Std&&) = delete;
+   Semaphore_Std& operator=(Semaphore_Std&&) = delete;
+
+   /**
+    * @inheritDoc
+    */
+   ErrorCode initialize( uint32_t maxCount, uint32_t initialCount ) override
+   {
+      if ( ( maxCount == 0 ) || ( initialCount > maxCount ) )
+      {
+         return LibErrorCodes::eSEMAPHORE_INIT_FAILED;
+      }
+
+      std::lock_guard<std::mutex> guard( m_mutex );
+      m_maxCount = maxCount;
+      m_count = initialCount;
+      return LibErrorCodes::eOK;
+   }
+
+   /**
+    * @inheritDoc
+    */
+   void put( ) override
+   {
+      {
+         std::lock_guard<std::mutex> guard( m_mutex );
+         if ( m_count >= m_maxCount )
+         {
+            return;
+         }
+         m_count++;
+      }
+      m_condition.notify_one();
+   }
+
+   /**
+    * @inheritDoc
+    */
+   void putISR( ) override
+   {
+      put();
+   }
+
+   /**
+    * @inheritDoc
+    */
+   ErrorCode get( uint32_t timeout_ms ) override
+   {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      if ( m_maxCount == 0 )
+      {
+         return LibErrorCodes::eSEMAPHORE_NOT_INITIALIZED;
+      }
+
+      if ( !m_condition.wait_for( lock, std::chrono::milliseconds( timeout_ms ), [this]() { return m_count > 0; } ) )
+      {
+         return LibErrorCodes::eSEMAPHORE_GET_TIME_OUT;
+      }
+
+      m_count--;
+      return LibErrorCodes::eOK;
+   }
+
+private:
+   std::mutex                 m_mutex;             //!< Guards the count, along with the maximum
+   std::condition_variable    m_condition;         //!< Notified on every give
+   uint32_t                   m_count{ 0 };
+   uint32_t                   m_maxCount{ 0 };     //!< 0 until initialized
+};
+}
\ No newline at end of file
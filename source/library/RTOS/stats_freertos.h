@@ -0,0 +1,165 @@
+/************************************************************************************************************
+ *
+ * @file stats_freertos.h
+ * @brief FreeRTOS stats providers of the tasks and the heap, see StatsRegistry.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-23
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "stats_registry.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <atomic>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+/**
+ * @brief Stats provider of the FreeRTOS tasks, which reports the state, the priority, the stack high water mark and the CPU usage of every task.
+ * @details The tasks are taken with uxTaskGetSystemState(), which needs configUSE_TRACE_FACILITY, and holds the scheduler only for the copy,
+ *          where every stack is scanned for its high water mark. The lines are formatted from the copy afterwards, with the scheduler running.
+ *          The CPU usage needs configGENERATE_RUN_TIME_STATS, and it's the share of the run time since the previous report, or since the boot at first,
+ *          so that a task busy right now stands out rather than being averaged over the uptime.
+ *          The copy is kept in the provider, not on the stack of the reporting task, and a report at the same time as another one is refused.
+ * @note The name of a task deleted while it's reported may no longer be valid, as it's taken by the pointer.
+ *
+ * @tparam MaxTasks Maximum number of the tasks reported, where none is reported if there are more
+ */
+template<size_t MaxTasks = 16>
+class TaskStats_FreeRTOS final : public IStatsProvider
+{
+public:
+   const char*  getName     ( ) const override   { return "tasks"; }
+   eStatsGroup  getGroup    ( ) const override   { return eStatsGroup::SYSTEM; }
+   void         report      ( StatsOutput& output ) override;
+
+private:
+   static const char* getStateName( eTaskState state );
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+   TaskStatus_t         m_tasks[MaxTasks];
+#endif
+   UBaseType_t          m_previousNumbers[MaxTasks]{};      //!< Task numbers of the previous report, along with their run times
+   uint32_t             m_previousRunTimes[MaxTasks]{};
+   size_t               m_numPrevious{ 0 };
+   uint32_t             m_previousTotal{ 0 };
+   std::atomic_flag     m_isBusy = ATOMIC_FLAG_INIT;
+};
+
+/**
+ * @brief Stats provider of the FreeRTOS heap
+ * @details The fragmentation is reported as well if USE_FREERTOS_HEAP_STATS is defined, which needs heap_4 or heap_5 for vPortGetHeapStats().
+ */
+class HeapStats_FreeRTOS final : public IStatsProvider
+{
+public:
+   const char*  getName     ( ) const override   { return "heap"; }
+   eStatsGroup  getGroup    ( ) const override   { return eStatsGroup::SYSTEM; }
+
+   void report( StatsOutput& output ) override
+   {
+      output.print( "heap             free %lu/%lu, min ever free %lu",
+                    static_cast<unsigned long>( xPortGetFreeHeapSize() ), static_cast<unsigned long>( configTOTAL_HEAP_SIZE ),
+                    static_cast<unsigned long>( xPortGetMinimumEverFreeHeapSize() ) );
+
+#if defined ( USE_FREERTOS_HEAP_STATS )
+      HeapStats_t stats{};
+      vPortGetHeapStats( &stats );
+      output.print( "heap             free blocks %lu, largest %lu, allocs %lu, frees %lu",
+                    static_cast<unsigned long>( stats.xNumberOfFreeBlocks ), static_cast<unsigned long>( stats.xSizeOfLargestFreeBlockInBytes ),
+                    static_cast<unsigned long>( stats.xNumberOfSuccessfulAllocations ), static_cast<unsigned long>( stats.xNumberOfSuccessfulFrees ) );
+#endif
+   }
+};
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Report the tasks, a line per task.
+ *
+ * @param output the output
+ */
+template<size_t MaxTasks>
+void TaskStats_FreeRTOS<MaxTasks>::report( StatsOutput& output )
+{
+#if ( configUSE_TRACE_FACILITY == 1 )
+   if ( m_isBusy.test_and_set( std::memory_order_acquire ) )
+   {
+      output.print( "tasks: being reported, try again" );
+      return;
+   }
+
+   uint32_t totalRunTime = 0;
+   const auto numTasks = static_cast<size_t>( uxTaskGetSystemState( m_tasks, MaxTasks, &totalRunTime ) );
+   if ( numTasks == 0 )
+   {
+      output.print( "tasks: more than %u tasks", static_cast<unsigned>( MaxTasks ) );
+      m_isBusy.clear( std::memory_order_release );
+      return;
+   }
+
+   const uint32_t elapsed = totalRunTime - m_previousTotal;
+   output.print( "%-16s %-9s %4s %10s %5s", "task", "state", "prio", "stack free", "cpu" );
+   for ( size_t i = 0; i < numTasks; i++ )
+   {
+      const auto& task = m_tasks[i];
+
+      //!< A task created since the previous report is counted from its start
+      uint32_t runTime = task.ulRunTimeCounter;
+      for ( size_t j = 0; j < m_numPrevious; j++ )
+      {
+         if ( m_previousNumbers[j] == task.xTaskNumber )
+         {
+            runTime -= m_previousRunTimes[j];
+            break;
+         }
+      }
+
+      const uint32_t percent = ( elapsed >= 100 ) ? ( runTime / ( elapsed / 100 ) ) : 0;
+      output.print( "%-16s %-9s %4lu %10lu %4lu%%", task.pcTaskName, getStateName( task.eCurrentState ),
+                    static_cast<unsigned long>( task.uxCurrentPriority ),
+                    static_cast<unsigned long>( task.usStackHighWaterMark * sizeof( StackType_t ) ),
+                    static_cast<unsigned long>( percent ) );
+   }
+
+   for ( size_t i = 0; i < numTasks; i++ )
+   {
+      m_previousNumbers[i] = m_tasks[i].xTaskNumber;
+      m_previousRunTimes[i] = m_tasks[i].ulRunTimeCounter;
+   }
+   m_numPrevious = numTasks;
+   m_previousTotal = totalRunTime;
+
+   m_isBusy.clear( std::memory_order_release );
+#else
+   output.print( "tasks: configUSE_TRACE_FACILITY is required" );
+#endif
+}
+
+/**
+ * @brief Get the name of a task state
+ *
+ * @param state the state
+ * @return const char* the name
+ */
+template<size_t MaxTasks>
+const char* TaskStats_FreeRTOS<MaxTasks>::getStateName( eTaskState state )
+{
+   switch ( state )
+   {
+      case eRunning:    return "running";
+      case eReady:      return "ready";
+      case eBlocked:    return "blocked";
+      case eSuspended:  return "suspended";
+      case eDeleted:    return "deleted";
+      default:          return "invalid";
+   }
+}
+} /* namespace lib */
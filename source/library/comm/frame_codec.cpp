@@ -0,0 +1,246 @@
+/************************************************************************************************************
+ *
+ * @file frame_codec.cpp
+ * @brief Implementation of the byte-stream framing codec, i.e., COBS with CRC16 frame checks.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-06
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "frame_codec.h"
+
+/******************************************* Function Definitions *******************************************/
+namespace lib
+{
+/**
+ * @brief Begin encoding a new frame.
+ * @details The first byte of the buffer is reserved for the code byte of the first block.
+ */
+void FrameEncoder::begin( )
+{
+   m_position  = 0;
+   m_codeIndex = 0;
+   m_code      = 1;
+   m_crc       = Crc16::INITIAL_VALUE;
+   m_overflow  = ( m_buffer == nullptr ) || ( m_size == 0 );
+
+   if ( !m_overflow )
+   {
+      m_position = 1;
+   }
+}
+
+/**
+ * @brief Feed a chunk of the payload to the encoder.
+ *
+ * @param data pointer to the payload bytes
+ * @param length number of bytes
+ * @return ErrorCode eFRAME_BUFFER_TOO_SMALL if the output buffer has run out, which sticks until begin() is called again.
+ */
+ErrorCode FrameEncoder::feed( const uint8_t* data, size_t length )
+{
+   for ( size_t i = 0; i < length; i++ )
+   {
+      m_crc = Crc16::update( m_crc, data[i] );
+      put( data[i] );
+   }
+
+   return m_overflow ? LibErrorCodes::eFRAME_BUFFER_TOO_SMALL : LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Feed a payload given as segments, e.g., header, body and trailer, to the encoder.
+ *
+ * @param segments array of segments, in order
+ * @param numSegments number of segments
+ * @return ErrorCode
+ */
+ErrorCode FrameEncoder::feed( const SerialDevice::TxSegment segments[], size_t numSegments )
+{
+   for ( size_t i = 0; i < numSegments; i++ )
+   {
+      (void)feed( segments[i].data, segments[i].length );
+   }
+
+   return m_overflow ? LibErrorCodes::eFRAME_BUFFER_TOO_SMALL : LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Finish the frame by appending the CRC and the delimiter.
+ *
+ * @param frame the encoded frame ready to be sent, if successful
+ * @return ErrorCode
+ */
+ErrorCode FrameEncoder::finish( SerialDevice::TxSegment& frame )
+{
+   //!< The CRC goes out in big-endian order so that the CRC over the payload and the CRC is zero.
+   const auto crc = m_crc;
+   put( static_cast<uint8_t>( crc >> 8 ) );
+   put( static_cast<uint8_t>( crc & 0xFF ) );
+
+   if ( m_overflow || ( m_position >= m_size ) )
+   {
+      m_overflow = true;
+      return LibErrorCodes::eFRAME_BUFFER_TOO_SMALL;
+   }
+
+   m_buffer[m_codeIndex] = m_code;
+   m_buffer[m_position++] = DELIMITER;
+
+   frame = { m_buffer, m_position };
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Put a byte into the current block.
+ */
+inline void FrameEncoder::put( uint8_t data )
+{
+   if ( data == 0 )
+   {
+      closeBlock();
+      return;
+   }
+
+   if ( m_position >= m_size )
+   {
+      m_overflow = true;
+      return;
+   }
+
+   m_buffer[m_position++] = data;
+   if ( ++m_code == 0xFF )
+   {
+      closeBlock();
+   }
+}
+
+/**
+ * @brief Close the current block by writing its code byte, and reserve a code byte for the next block.
+ */
+inline void FrameEncoder::closeBlock( )
+{
+   if ( m_position >= m_size )
+   {
+      m_overflow = true;
+      return;
+   }
+
+   m_buffer[m_codeIndex] = m_code;
+   m_codeIndex = m_position++;
+   m_code = 1;
+}
+
+/**
+ * @brief Decode a chunk of bytes received.
+ * @details The decoding stops at the end of a frame, i.e., when a delimiter is found, and 'consumed' tells how many bytes were used including the delimiter.
+ *          Then, the user is expected to call this again with the remaining bytes if any.
+ *          Frames with errors are dropped and reported with their error code so that the user can count them.
+ *          Empty frames, i.e., consecutive delimiters, are skipped silently as they're used to flush the line.
+ *
+ * @param data pointer to the received bytes
+ * @param length number of bytes
+ * @param consumed the number of bytes used from the chunk
+ * @return ErrorCode eOK if a frame was decoded successfully, eFRAME_INCOMPLETE if more bytes are required, or an error for a frame dropped.
+ */
+ErrorCode FrameDecoder::decode( const uint8_t* data, size_t length, size_t& consumed )
+{
+   for ( size_t i = 0; i < length; i++ )
+   {
+      const auto byte = data[i];
+
+      if ( byte == FrameEncoder::DELIMITER )
+      {
+         if ( !m_inFrame )
+         {
+            continue;
+         }
+
+         consumed = i + 1;
+         return completeFrame();
+      }
+
+      m_inFrame = true;
+
+      if ( m_blockRemaining == 0 )
+      {
+         //!< A code byte, which starts a new block.
+         if ( m_zeroPending )
+         {
+            if ( m_length >= m_size )
+            {
+               m_error = LibErrorCodes::eFRAME_BUFFER_TOO_SMALL;
+            }
+            else
+            {
+               m_buffer[m_length++] = 0;
+               m_crc = Crc16::update( m_crc, 0 );
+            }
+         }
+         m_zeroPending = ( byte != 0xFF );
+         m_blockRemaining = static_cast<uint8_t>( byte - 1 );
+         continue;
+      }
+
+      m_blockRemaining--;
+
+      if ( m_length >= m_size )
+      {
+         m_error = LibErrorCodes::eFRAME_BUFFER_TOO_SMALL;
+         continue;
+      }
+
+      m_buffer[m_length++] = byte;
+      m_crc = Crc16::update( m_crc, byte );
+   }
+
+   consumed = length;
+   return LibErrorCodes::eFRAME_INCOMPLETE;
+}
+
+/**
+ * @brief Reset the decoder, dropping any partial frame.
+ */
+void FrameDecoder::reset( )
+{
+   m_length         = 0;
+   m_blockRemaining = 0;
+   m_zeroPending    = false;
+   m_inFrame        = false;
+   m_crc            = Crc16::INITIAL_VALUE;
+   m_error          = LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Complete the current frame on a delimiter, and get ready for the next one.
+ *
+ * @return ErrorCode
+ */
+ErrorCode FrameDecoder::completeFrame( )
+{
+   ErrorCode result = m_error;
+
+   if ( result == LibErrorCodes::eOK )
+   {
+      if ( ( m_blockRemaining != 0 ) || ( m_length < FrameEncoder::CRC_SIZE ) )
+      {
+         result = LibErrorCodes::eFRAME_INVALID_ENCODING;
+      }
+      else if ( m_crc != 0 )
+      {
+         result = LibErrorCodes::eFRAME_CRC_MISMATCH;
+      }
+      else
+      {
+         m_frameLength = m_length - FrameEncoder::CRC_SIZE;
+      }
+   }
+
+   reset();
+   return result;
+}
+} /* namespace lib */
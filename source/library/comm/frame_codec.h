@@ -0,0 +1,127 @@
+/************************************************************************************************************
+ *
+ * @file frame_codec.h
+ * @brief Header file for the byte-stream framing codec, i.e., COBS with CRC16 frame checks.
+ * @details A frame on the wire is the COBS-encoded payload followed by its CRC16 in big-endian order, terminated with a zero byte.
+ *          As COBS removes every zero byte from the encoded data, the zero byte delimits frames unambiguously,
+ *          and a receiver can resynchronize on the next delimiter after any corruption.
+ *          Both the encoder and the decoder work incrementally, so data can be fed in chunks as it becomes available,
+ *          e.g., header, payload and trailer segments on the Tx side, or bytes popped from an Rx ring buffer on the Rx side.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-06
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "serial_device.h"
+#include "crc16.h"
+#include "error_codes_lib.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/************************************************* Types ****************************************************/
+namespace lib
+{
+/**
+ * @brief Streaming frame encoder.
+ * @details The encoded frame is written into a buffer given by the user in a single pass; COBS code bytes are patched in place as each block closes,
+ *          so no intermediate copy of the payload is made. The resulting frame is handed out as a SerialDevice::TxSegment,
+ *          which can be sent with SerialDevice::sendv() or SerialDevice::sendOwned() as it is.
+ *          Usage: begin() -> feed() as many times as needed -> finish().
+ */
+class FrameEncoder
+{
+public:
+   constexpr static uint8_t DELIMITER = 0x00;
+   constexpr static size_t  CRC_SIZE  = 2;
+
+   /**
+    * @brief Get the worst-case size of an encoded frame, including the CRC and the delimiter.
+    *
+    * @param payloadLength length of the payload to be encoded
+    * @return size_t the number of bytes required for the output buffer
+    */
+   constexpr static size_t maxEncodedSize( size_t payloadLength )
+   {
+      const auto length = payloadLength + CRC_SIZE;
+      return length + ( length / 254 ) + 1 + 1;
+   }
+
+   FrameEncoder( uint8_t buffer[], size_t sizeBuffer )
+   : m_buffer( buffer )
+   , m_size( sizeBuffer )
+   { }
+
+   ~FrameEncoder() = default;
+
+   //!< Disable copy and move operations
+   FrameEncoder( const FrameEncoder& ) = delete;
+   FrameEncoder& operator=( const FrameEncoder& ) = delete;
+   FrameEncoder( FrameEncoder&& ) = delete;
+   FrameEncoder& operator=( FrameEncoder&& ) = delete;
+
+   void        begin          ( );
+   ErrorCode   feed           ( const uint8_t* data, size_t length );
+   ErrorCode   feed           ( const SerialDevice::TxSegment segments[], size_t numSegments );
+   ErrorCode   finish         ( SerialDevice::TxSegment& frame );
+
+private:
+   inline void put            ( uint8_t data );
+   inline void closeBlock     ( );
+
+   uint8_t*    m_buffer;
+   size_t      m_size;
+   size_t      m_position{ 0 };        //!< Next position to write in the buffer
+   size_t      m_codeIndex{ 0 };       //!< Position of the code byte of the current block
+   uint8_t     m_code{ 1 };            //!< Code of the current block, i.e., the number of non-zero bytes + 1
+   uint16_t    m_crc{ Crc16::INITIAL_VALUE };
+   bool        m_overflow{ false };
+};
+
+/**
+ * @brief Streaming frame decoder.
+ * @details Bytes can be fed in chunks of any size; a chunk may contain a part of a frame, or several frames.
+ *          The decoder stops at the end of every frame so that the user can consume it before the next one overwrites the buffer.
+ *          The CRC is calculated on the fly while decoding, so a frame is checked without a second pass over its bytes.
+ */
+class FrameDecoder
+{
+public:
+   FrameDecoder( uint8_t buffer[], size_t sizeBuffer )
+   : m_buffer( buffer )
+   , m_size( sizeBuffer )
+   { }
+
+   ~FrameDecoder() = default;
+
+   //!< Disable copy and move operations
+   FrameDecoder( const FrameDecoder& ) = delete;
+   FrameDecoder& operator=( const FrameDecoder& ) = delete;
+   FrameDecoder( FrameDecoder&& ) = delete;
+   FrameDecoder& operator=( FrameDecoder&& ) = delete;
+
+   ErrorCode         decode         ( const uint8_t* data, size_t length, size_t& consumed );
+   void              reset          ( );
+
+   //!< Getters for the last frame decoded successfully
+   const uint8_t*    frame          ( ) const { return m_buffer; }
+   size_t            frameLength    ( ) const { return m_frameLength; }
+
+private:
+   ErrorCode         completeFrame  ( );
+
+   uint8_t*          m_buffer;
+   size_t            m_size;
+   size_t            m_length{ 0 };           //!< Number of bytes decoded for the current frame, including the CRC
+   size_t            m_frameLength{ 0 };      //!< Payload length of the last frame decoded successfully
+   uint8_t           m_blockRemaining{ 0 };   //!< Number of data bytes left in the current COBS block
+   bool              m_zeroPending{ false };  //!< Whether a zero byte has to be inserted when the next block starts
+   bool              m_inFrame{ false };      //!< Whether any byte of the current frame has been received
+   uint16_t          m_crc{ Crc16::INITIAL_VALUE };
+   ErrorCode         m_error{ LibErrorCodes::eOK };   //!< Error found in the current frame, reported at its delimiter
+};
+} /* namespace lib */
@@ -4,6 +4,7 @@
  * @brief Source file for the MessagePasser class, which provides a message passing mechanism between tasks or threads.
  * @details This class allows for the creation, sending, receiving, and deletion of messages in a thread-safe manner.
  *          This file is part of a larger project that implements a message passing system for FreeRTOS.
+ *          The class template is defined here and instantiated for the lockables declared in message_passer.h, so that its users don't compile it again.
  * 
  * @author Sungsu Kim
  * @copyright 2025 Sungsu Kim
@@ -13,6 +14,7 @@
  ************************************************************************************************************/
 
 /************************************************** Includes ************************************************/
+#define LOG_MODULE LOG_MODULE_MESSAGE_PASSER   //!< Defined before the includes, as lib_common.h gives a default otherwise
 #include "message_passer.h"
 
 /********************************************* Function Definitions *****************************************/
@@ -21,13 +23,14 @@
  * @details This function sets up the message passer by initializing the lockable resource, allocating semaphores for each receiver, and preparing the message buffer.
  *          The buffer used must solely be used by the MessagePasser, and it should not be modified by other parts of the code.
  * 
- * @param lockable a reference to an ILockable object that will be used for synchronization.
+ * @param lockable a reference to the lockable object that will be used for synchronization.
  * @param buffer a pointer to the message buffer that will be used to store messages.
  * @param size_buffer the size of the message buffer.
  * @param num_receivers the number of receivers that will be able to receive messages.
  * @return int an error code indicating the result of the initialization.
  */
-int MessagePasser::initialize( lib::ILockable& lockable, messsage_t* buffer, uint32_t size_buffer, uint32_t num_receivers )
+template<lib::Lockable Lock>
+int BasicMessagePasser<Lock>::initialize( Lock& lockable, messsage_t* buffer, uint32_t size_buffer, uint32_t num_receivers )
 {
    if ( m_initialized )
    {
@@ -89,11 +92,12 @@ int MessagePasser::initialize( lib::ILockable& lockable, messsage_t* buffer, uin
  * 
  * @return messsage_t* a pointer to a message structure in the buffer, or nullptr if the buffer is full or the passer is not initialized.
  */
-messsage_t* MessagePasser::new_message( )
+template<lib::Lockable Lock>
+messsage_t* BasicMessagePasser<Lock>::new_message( )
 {
    if ( !m_initialized )
    {
-      LOGGING( "Passer not initialized\r\n" );
+      LOG_ERROR( "Passer not initialized" );
       return nullptr;
    }
 
@@ -101,7 +105,8 @@ messsage_t* MessagePasser::new_message( )
 
    if ( m_num_buffer_used >= m_size_buffer )
    {
-      LOGGING( "Msg. buffer is full\r\n" );
+      m_num_alloc_failures++;
+      LOG_WARN( "Msg. buffer is full" );
       return nullptr;
    }
    
@@ -111,11 +116,16 @@ messsage_t* MessagePasser::new_message( )
       {         
          m_tbl_buffer_state[ i ] = MsgState::ALLOCATED;
          m_num_buffer_used++;
+         if ( m_num_buffer_used > m_peak_used )
+         {
+            m_peak_used = m_num_buffer_used;
+         }
          return &m_buffer[ i ];
       }
    }
 
-   LOGGING( "Msg. buffer is full.\r\n" );
+   m_num_alloc_failures++;
+   LOG_WARN( "Msg. buffer is full." );
    return nullptr;
 }
 
@@ -126,17 +136,18 @@ messsage_t* MessagePasser::new_message( )
  * 
  * @param msg a pointer to the message to be deleted. It must be a valid pointer that was obtained from new_message().
  */
-void MessagePasser::delete_message( messsage_t* msg )
+template<lib::Lockable Lock>
+void BasicMessagePasser<Lock>::delete_message( messsage_t* msg )
 {
    if ( !m_initialized )
    {
-      LOGGING( "Passer not initialized\r\n" );
+      LOG_ERROR( "Passer not initialized" );
       return;
    }
 
    if ( msg == nullptr )
    {
-      LOGGING( "Null message pointer\r\n" );
+      LOG_ERROR( "Null message pointer" );
       return;
    }
 
@@ -168,11 +179,12 @@ void MessagePasser::delete_message( messsage_t* msg )
  * @param msg a pointer to the message to be sent. It must be a valid pointer that was obtained from new_message().
  * @return int an error code indicating the result of the send operation.
  */
-int MessagePasser::send( ReceiverId destination_id, messsage_t* msg )
+template<lib::Lockable Lock>
+int BasicMessagePasser<Lock>::send( ReceiverId destination_id, messsage_t* msg )
 {
    if ( !m_initialized )
    {
-      LOGGING( "Passer not initialized\r\n" );
+      LOG_ERROR( "Passer not initialized" );
       return ErrorCodes::NOT_INITIALIZED;
    }
 
@@ -193,12 +205,13 @@ int MessagePasser::send( ReceiverId destination_id, messsage_t* msg )
 
    if ( m_tbl_buffer_state[ index ] != MsgState::ALLOCATED )
    {
-      LOGGING( "Message not in use\r\n" );
+      LOG_WARN( "Message not in use" );
       return ErrorCodes::INVALID_MESSAGE_POINTER;
    }
 
    m_tbl_buffer_state[ index ] = MsgState::SENT;
    m_tbl_buffer_destination[ index ] = destination_id;
+   m_num_sent++;
 
 #if defined (PRINT_BUFFER_STATUS)
    print_buffer_status();
@@ -215,11 +228,12 @@ int MessagePasser::send( ReceiverId destination_id, messsage_t* msg )
  * @param msg a pointer to a pointer where the received message will be stored. If a message is found, it will point to the message structure in the buffer.
  * @return int an error code indicating the result of the receive operation.
  */
-int MessagePasser::recv( ReceiverId receiver_id, messsage_t** msg )
+template<lib::Lockable Lock>
+int BasicMessagePasser<Lock>::recv( ReceiverId receiver_id, messsage_t** msg )
 {
    if ( !m_initialized )
    {
-      LOGGING( "Passer not initialized\r\n" );
+      LOG_ERROR( "Passer not initialized" );
       return ErrorCodes::NOT_INITIALIZED;
    }
 
@@ -233,6 +247,11 @@ int MessagePasser::recv( ReceiverId receiver_id, messsage_t** msg )
    auto result = take_message_sem( receiver_id );
    if ( result != ErrorCodes::OK )
    {
+      if ( result == ErrorCodes::MSG_SEMAPHORE_TAKE_TIMEOUT )
+      {
+         lib::lock_guard lock( *m_lockable );
+         m_num_recv_timeouts++;
+      }
       return result;
    }
 
@@ -245,6 +264,7 @@ int MessagePasser::recv( ReceiverId receiver_id, messsage_t** msg )
            ( m_tbl_buffer_destination[i] == receiver_id ) )
       {
          m_tbl_buffer_state[i] = MsgState::RECEIVED;
+         m_num_received++;
          *msg = &m_buffer[i];
          return ErrorCodes::OK;
       }
@@ -253,6 +273,43 @@ int MessagePasser::recv( ReceiverId receiver_id, messsage_t** msg )
    return NO_MESSAGE_FOUND_FOR_DESTINATION;
 }
 
+/**
+ * @brief Gets the statistics of the message buffer.
+ * @details They are copied under the lock, so that they are consistent with each other.
+ * 
+ * @return statistics_t the statistics, which are all zero if the passer is not initialized.
+ */
+template<lib::Lockable Lock>
+typename BasicMessagePasser<Lock>::statistics_t BasicMessagePasser<Lock>::get_statistics( )
+{
+   if ( !m_initialized )
+   {
+      return statistics_t{};
+   }
+
+   lib::lock_guard lock( *m_lockable );
+   return statistics_t{ m_num_buffer_used, m_size_buffer, m_peak_used, m_num_sent, m_num_received, m_num_alloc_failures, m_num_recv_timeouts };
+}
+
+/**
+ * @brief Resets the statistics, where the peak restarts from the messages currently in use.
+ */
+template<lib::Lockable Lock>
+void BasicMessagePasser<Lock>::reset_statistics( )
+{
+   if ( !m_initialized )
+   {
+      return;
+   }
+
+   lib::lock_guard lock( *m_lockable );
+   m_peak_used = m_num_buffer_used;
+   m_num_sent = 0;
+   m_num_received = 0;
+   m_num_alloc_failures = 0;
+   m_num_recv_timeouts = 0;
+}
+
 /**
  * @brief Gets the index of a message in the buffer.
  * @details This function is used to validate if the message poitner given is within the buffer and to find its index.
@@ -260,7 +317,8 @@ int MessagePasser::recv( ReceiverId receiver_id, messsage_t** msg )
  * @param msg a pointer to the message whose index is to be found.
  * @return int the index of the message in the buffer, or -1 if the message is not found.
  */
-int MessagePasser::get_message_index( messsage_t* msg )
+template<lib::Lockable Lock>
+int BasicMessagePasser<Lock>::get_message_index( messsage_t* msg )
 {
    for( unsigned i = 0; i < m_size_buffer; ++i )
    {
@@ -271,16 +329,17 @@ int MessagePasser::get_message_index( messsage_t* msg )
       }
    }
 
-   LOGGING( "No message index found" );
+   LOG_WARN( "No message index found" );
    return -1;
 }
 
 /**
  * @brief Prints the current status of the message buffer.
  */
-void MessagePasser::print_buffer_status( )
+template<lib::Lockable Lock>
+void BasicMessagePasser<Lock>::print_buffer_status( )
 {
-    LOGGING( "  Buffer usage: %d/%d, Rem:%d\r\n", m_num_buffer_used, m_size_buffer, ( m_size_buffer - m_num_buffer_used ) );
+    LOG_DEBUG( "  Buffer usage: %d/%d, Rem:%d", m_num_buffer_used, m_size_buffer, ( m_size_buffer - m_num_buffer_used ) );
 }
 
 /**
@@ -291,11 +350,12 @@ void MessagePasser::print_buffer_status( )
  * @param receiver_id 
  * @return int 
  */
-int MessagePasser::give_message_sem( ReceiverId receiver_id )
+template<lib::Lockable Lock>
+int BasicMessagePasser<Lock>::give_message_sem( ReceiverId receiver_id )
 {
    if ( receiver_id >= m_num_receivers )
    {
-      LOGGING( "Destination out of range\r\n" );
+      LOG_ERROR( "Destination out of range" );
       return ErrorCodes::DESTINATION_ID_OUT_OF_RANGE;
    }
 
@@ -309,11 +369,12 @@ int MessagePasser::give_message_sem( ReceiverId receiver_id )
  * @details This function waits for a message to be available for the specified receiver by taking the semaphore. 
  *          If the semaphore is not available within the specified timeout, it returns an error. 
  */
-int MessagePasser::take_message_sem( ReceiverId receiver_id, uint32_t timeout_ms /* = 2000 */ )
+template<lib::Lockable Lock>
+int BasicMessagePasser<Lock>::take_message_sem( ReceiverId receiver_id, uint32_t timeout_ms /* = 2000 */ )
 {
    if ( receiver_id >= m_num_receivers )
    {
-      LOGGING( "Destination out of range\r\n" );
+      LOG_ERROR( "Destination out of range" );
       return ErrorCodes::DESTINATION_ID_OUT_OF_RANGE;
    }
 
@@ -323,4 +384,8 @@ int MessagePasser::take_message_sem( ReceiverId receiver_id, uint32_t timeout_ms
    }
 
    return ErrorCodes::OK;
-}
\ No newline at end of file
+}
+
+/******************************************* Template Instantiations ****************************************/
+template class BasicMessagePasser<lib::ILockable>;
+template class BasicMessagePasser<lib::LockableFreeRTOS>;
@@ -22,7 +22,10 @@
 #include "task.h"
 #include "semphr.h"
 #include "lockable_interface.h"
+#include "lockable_freertos.h"
 #include "lockguard.h"
+#include "rtos_concepts.h"
+#include "stats_registry.h"
 #include <stdint.h>
 
 /************************************************** Types ***************************************************/
@@ -41,8 +44,13 @@ using ReceiverId = uint8_t;
 /**
  * @brief A class that provides a message passing mechanism between different tasks or threads in a system.
  * @details Note that the the maximum number of messages that can be passed is defined by NUM_BUFFER_MAX, and the maximum number of receivers is defined by NUM_RECEIVER_MAX.
+ *          The lockable is a policy type, so that a final one, e.g., LockableFreeRTOS, is locked with direct calls; MessagePasser is the instance over ILockable.
+ *          The implementation stays in message_passer.cpp, which instantiates it for ILockable and LockableFreeRTOS only.
+ *
+ * @tparam Lock Type of the lockable satisfying Lockable, i.e., ILockable or LockableFreeRTOS
  */
-class MessagePasser
+template<lib::Lockable Lock = lib::ILockable>
+class BasicMessagePasser
 {
 public:
    //!< Compile-time config parameters, which can be template arguments for more of flexibility as required
@@ -50,16 +58,16 @@ public:
    constexpr static uint32_t NUM_RECEIVER_MAX = 5; 
 
    //!< Constructor and destructor
-   MessagePasser( ) = default;
-   ~MessagePasser( ) = default;
+   BasicMessagePasser( ) = default;
+   ~BasicMessagePasser( ) = default;
 
    //!< Disable copy and move operations
-   MessagePasser( const MessagePasser& ) = delete;
-   MessagePasser& operator=( const MessagePasser& ) = delete;
-   MessagePasser( MessagePasser&& ) = delete;
-   MessagePasser& operator=( MessagePasser&& ) = delete;
+   BasicMessagePasser( const BasicMessagePasser& ) = delete;
+   BasicMessagePasser& operator=( const BasicMessagePasser& ) = delete;
+   BasicMessagePasser( BasicMessagePasser&& ) = delete;
+   BasicMessagePasser& operator=( BasicMessagePasser&& ) = delete;
 
-   int               initialize           ( lib::ILockable& lockable, messsage_t* buffer, uint32_t size_buffer, uint32_t num_receivers );
+   int               initialize           ( Lock& lockable, messsage_t* buffer, uint32_t size_buffer, uint32_t num_receivers );
 
    //!< Message management
    messsage_t*       new_message          ( );
@@ -67,8 +75,24 @@ public:
    int               send                 ( ReceiverId receiver_id, messsage_t* msg );
    int               recv                 ( ReceiverId receiver_id, messsage_t** msg );
 
+   /**
+    * @brief Statistics of the message buffer, e.g., to be reported by MessagePasserStats.
+    */
+   struct statistics_t
+   {
+      uint32_t used;                //!< Messages currently in use
+      uint32_t size;
+      uint32_t peak_used;           //!< Most messages in use at once since the reset
+      uint32_t sent;
+      uint32_t received;
+      uint32_t alloc_failures;      //!< Calls of new_message() failed as the buffer is full
+      uint32_t recv_timeouts;
+   };
+
    //!< Getters
    uint32_t          get_buffer_available ( ) const { return m_size_buffer - m_num_buffer_used; }
+   statistics_t      get_statistics       ( );
+   void              reset_statistics     ( );
 
 private:
    /**
@@ -102,7 +126,53 @@ private:
    MsgState          m_tbl_buffer_state[NUM_BUFFER_MAX];          //!< Table to track the state of each message in the buffer
    uint8_t           m_tbl_buffer_destination[NUM_BUFFER_MAX];    //!< Table to track the destination ID of each message in the buffer
 
+   //!< Statistics, updated under the lock
+   uint32_t          m_peak_used{ 0 };
+   uint32_t          m_num_sent{ 0 };
+   uint32_t          m_num_received{ 0 };
+   uint32_t          m_num_alloc_failures{ 0 };
+   uint32_t          m_num_recv_timeouts{ 0 };
+
    //!< Synchronization
-   lib::ILockable*   m_lockable;                                  //!< Pointer to the lockable object used for synchronization
+   Lock*             m_lockable;                                  //!< Pointer to the lockable object used for synchronization
    SemaphoreHandle_t m_sem_messages[NUM_RECEIVER_MAX];            //!< Semaphore handles for each receiver to signal when a message is available
-};
\ No newline at end of file
+};
+
+//!< Message passer over the lockable interface, e.g., for the mocks
+using MessagePasser = BasicMessagePasser<lib::ILockable>;
+
+extern template class BasicMessagePasser<lib::ILockable>;
+extern template class BasicMessagePasser<lib::LockableFreeRTOS>;
+
+/**
+ * @brief Stats provider of a message passer, which reports the occupancy of its message buffer and its traffic.
+ * @details The statistics are copied under the lock of the passer, and formatted afterwards.
+ *
+ * @tparam Lock Type of the lockable of the message passer, which is deduced from the constructor argument
+ */
+template<lib::Lockable Lock = lib::ILockable>
+class MessagePasserStats final : public lib::IStatsProvider
+{
+public:
+   MessagePasserStats( const char* name, BasicMessagePasser<Lock>& passer )
+   : m_name{ name }
+   , m_passer{ passer }
+   { }
+
+   const char*       getName  ( ) const override   { return m_name; }
+   lib::eStatsGroup  getGroup ( ) const override   { return lib::eStatsGroup::BUFFERS; }
+   void              reset    ( ) override         { m_passer.reset_statistics(); }
+
+   void report( lib::StatsOutput& output ) override
+   {
+      const auto stats = m_passer.get_statistics();
+      output.print( "%-16s used %lu/%lu, peak %lu, sent %lu, received %lu, alloc failures %lu, recv timeouts %lu", m_name,
+                    static_cast<unsigned long>( stats.used ), static_cast<unsigned long>( stats.size ), static_cast<unsigned long>( stats.peak_used ),
+                    static_cast<unsigned long>( stats.sent ), static_cast<unsigned long>( stats.received ),
+                    static_cast<unsigned long>( stats.alloc_failures ), static_cast<unsigned long>( stats.recv_timeouts ) );
+   }
+
+private:
+   const char*                   m_name;
+   BasicMessagePasser<Lock>&     m_passer;
+};
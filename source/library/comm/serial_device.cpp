@@ -2,6 +2,8 @@
  * 
  * @file serial_device.cpp
  * @brief Implementation of the SerialDevice class.
+ * @details The implementation is a template in serial_device.h, and this file instantiates it for SerialDevice,
+ *          i.e., over the lockable and semaphore interfaces, once for all the users of that type.
  *  
  * @author Sungsu Kim
  * @copyright 2025 Sungsu Kim
@@ -12,181 +14,9 @@
 
 /************************************************ Includes **************************************************/
 #include "serial_device.h"
-#include "lib_common.h"
 
-/******************************************* Function Definitions *******************************************/    
+/******************************************* Template Instantiations ****************************************/
 namespace lib
 {
-/**
- * @brief Initialize the serial device.
- * 
- * @return ErrorCode 
- */
-ErrorCode SerialDevice::initialize()
-{
-   if ( m_isInitialized )
-   {
-      return LibErrorCodes::eOK;
-   }
-
-   ZERO_BUFFER( m_txBuffer );
-
-   auto result = m_lockable.initialize();
-
-   if ( result != LibErrorCodes::eOK )
-   {
-      return result;
-   }
-
-   result = m_semTxComplete.initialize( 1, 0 );
-   if ( result != LibErrorCodes::eOK )
-   {
-      return result;
-   }
-
-   result = m_semNewRxBytes.initialize( m_rxBuffer.size(), 0 );
-   if ( result != LibErrorCodes::eOK )
-   {
-      return result;
-   }
-
-   m_isInitialized = true;
-
-   return LibErrorCodes::eOK;
-}
-
-/**
- * @brief Send data over UART and wait for completion.
- * 
- * @param data Pointer to the data to be sent.
- * @param length Length of the data to be sent.
- * @param timeout_ms Timeout in milliseconds.
- * @return ErrorCode 
- */
-ErrorCode SerialDevice::sendWait( const uint8_t* data, size_t length, uint32_t timeout_ms )
-{
-   auto result = sendAsync( data, length );
-   if ( result != LibErrorCodes::eOK )
-   {
-      return result;
-   }
-   return waitSendComplete( timeout_ms );
-}
-
-/**
- * @brief Send data over UART.
- * @details This function is non-blocking and returns immediately after initiating the send operation.
- *          However, sending is allowed only if the previous sending has completed, which is confirmed through the waitSendComplete() function.
- * 
- * @param data Pointer to the data to be sent.
- * @param length Length of the data to be sent.
- * @return ErrorCode 
- */
-ErrorCode SerialDevice::sendAsync( const uint8_t* data, size_t length )
-{
-   lib::lock_guard lock( m_lockable );
-
-   if ( !m_isInitialized )
-   {
-      return LibErrorCodes::eSERIAL_DEVICE_NOT_INITIALIZED;
-   }
-
-   if ( length > TX_BUFFER_SIZE )
-   {
-      return LibErrorCodes::eSERIAL_DEVICE_TX_MSG_TOO_LONG;
-   }
-
-   if ( m_isSending )
-   {
-      return LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE;
-   }
-   
-   m_isSending = true;
-
-   ZERO_BUFFER( m_txBuffer );
-   memcpy( m_txBuffer, data, length );
-
-   //!< Send the message through the sender function, that is passed through the constructor
-   m_sender( m_txBuffer, length );
-
-   return LibErrorCodes::eOK;
-}
-
-/**
- * @brief Wait for the UART transmission to complete.
- * 
- * @param timeout_ms Timeout in milliseconds.
- * @return ErrorCode 
- */
-ErrorCode SerialDevice::waitSendComplete( uint32_t timeout_ms )
-{
-   if ( !m_isSending )
-   {
-      return LibErrorCodes::eSERIAL_DEVICE_NO_SEND_ACTIVE;
-   }
-
-   const auto result = m_semTxComplete.get( timeout_ms );
-
-   //!< Set the flag to false, regardless of the result
-   m_isSending = false;
-
-   return result;
-}
-
-/**
- * @brief Notify that the UART transmission is complete.
- */
-void SerialDevice::notifySendComplete( )
-{
-   m_semTxComplete.putISR();
-}
-
-/**
- * @brief Flush the RX buffer.
- */
-void SerialDevice::flushRxBuffer( )
-{
-   lib::lock_guard lock( m_lockable );
-   m_rxBuffer.clear();
-}
-
-/**
- * @brief Push a byte into the RX buffer.
- * 
- * @param data The byte to be pushed.
- * @return ErrorCode 
- */
-ErrorCode SerialDevice::pushRxByte( uint8_t data )
-{
-   if ( !m_isInitialized )
-   {
-      return LibErrorCodes::eSERIAL_DEVICE_NOT_INITIALIZED;
-   }
-
-   auto result = m_rxBuffer.push( data );
-   if ( result != LibErrorCodes::eOK )
-   {
-      return result;
-   }
-
-   m_semNewRxBytes.putISR();
-   return LibErrorCodes::eOK;
-}
-
-/**
- * @brief Push a byte into the RX buffer.
- * 
- * @param data The byte to be pushed.
- * @param timeout_ms Timeout in milliseconds.
- * @return ErrorCode 
- */
-ErrorCode SerialDevice::getRxByte( uint8_t& data, uint32_t timeout_ms )
-{
-   const auto result = m_semNewRxBytes.get( timeout_ms );
-   if ( result != LibErrorCodes::eOK )
-   {
-      return result;
-   }
-   return m_rxBuffer.pop( data );
-}
-} /* namespace lib */
\ No newline at end of file
+template class BasicSerialDevice<ILockable, ISemaphore>;
+} /* namespace lib */
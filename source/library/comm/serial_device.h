@@ -12,30 +12,99 @@
 #pragma once
 
 /************************************************ Includes **************************************************/
-#include "serial_device.h"
 #include "ring_buffer.h"
 #include "lockable_interface.h"
 #include "semaphore_interface.h"
 #include "lockguard.h"
+#include "rtos_concepts.h"
+#include "lib_common.h"
 #include <stddef.h>
 
 /************************************************* Types ****************************************************/
 namespace lib
 {
 /**
- * @brief Serial device class for handling asynchronous communication.
+ * @brief Types and constants shared by every serial device, regardless of its template parameters.
+ * @details These are kept out of the template so that, e.g., a TxSegment is the same type for any serial device.
+ */
+class SerialDeviceBase
+{
+public:
+   constexpr static size_t TX_BUFFER_SIZE       = 256;
+   constexpr static size_t MAX_TX_SEGMENTS      = 8;
+   constexpr static size_t MAX_SEGMENT_LENGTH   = UINT16_MAX;    //!< Longest segment handed over to the sender at once, as the HAL UART takes a 16-bit length
+   using SendFunction    = void(*)( const uint8_t* data, size_t length );
+   using ReleaseFunction = void(*)( const uint8_t* data, void* context );
+
+   /**
+    * @brief A segment of a frame to be sent by sendv(), similar to 'struct iovec'.
+    */
+   struct TxSegment
+   {
+      const uint8_t* data;       //!< Pointer to the bytes of the segment, which must stay valid until the send completes
+      size_t         length;     //!< Number of bytes in the segment
+   };
+
+   /**
+    * @brief Traffic and error counters of a serial device.
+    * @details The counters are updated in both the thread and the interrupt contexts without locking, so a snapshot may be slightly inconsistent,
+    *          but it's good enough for monitoring. Times are in milliseconds based on LIB_COMMON_getTickMS().
+    */
+   struct Statistics
+   {
+      uint32_t bytesIn;             //!< Rx bytes pushed into the Rx buffer
+      uint32_t bytesOut;            //!< Tx bytes handed over to the sender
+      uint32_t framesOut;           //!< Transmissions completed, where a frame sent with sendv() counts as one
+      uint32_t rxDrops;             //!< Rx bytes dropped as the Rx buffer was full
+      uint32_t txBusy;              //!< Send requests rejected as the previous transmission was still active
+      uint32_t txTimeouts;          //!< Calls to waitSendComplete() that timed out
+      uint32_t txWaitTotal_ms;      //!< Total time blocked in waitSendComplete()
+      uint32_t txLatencyLast_ms;    //!< Time from the start of the last transmission to its completion
+      uint32_t txLatencyMax_ms;     //!< Maximum of the above since the last reset
+      uint32_t txLatencyTotal_ms;   //!< Sum of the above since the last reset, to get the average with framesOut
+      uint32_t sinceTick_ms;        //!< Tick when the counters were reset, to get the rates
+   };
+
+protected:
+   /**
+    * @brief Storage of the Rx buffer, which is a member array for a fixed capacity, or nothing when the buffer is given by the user.
+    */
+   template<size_t Capacity>
+   struct RxStorage
+   {
+      uint8_t data[Capacity] = {};
+   };
+};
+
+template<>
+struct SerialDeviceBase::RxStorage<0>
+{ };
+
+/**
+ * @brief Serial device class template for handling asynchronous communication.
  * @details This class provides an interface for sending and receiving data over a serial connection.
  *          For the actual transmision of bytes, it utilizes a Sender function, which should be provided by the user, e.g., a UART driver function.
  *          For the reception of bytes, the pushRxByte method is expected to be called in a UART interrupt handler, so a rx byte can be pushed into the receive buffer in real time.
  *          Then the user can retrieve the Rx bytes by calling the getRxByte method in an application thread.
+ *          A frame made of several parts, e.g., header, payload and trailer, can be sent with sendv() without concatenating them first;
+ *          the segments are handed over to the Sender function one by one from the Tx-complete interrupt.
+ *          A buffer owned by the caller, e.g., a pooled one, can be sent in place with sendOwned(), and it's given back through a release callback on completion.
+ *          Traffic and error counters are kept per device, and can be read with getStatistics() to spot saturated links before data is lost.
+ *
+ *          The hooks are resolved at compile time from the template parameters, so that they can be inlined into the interrupt paths,
+ *          e.g., pushRxByte() and notifySendComplete(), when concrete types such as LockableFreeRTOS and Semaphore_FreeRTOS are given.
+ *          SerialDevice is the instance over the interfaces, which keeps the original runtime-polymorphic class as it was.
+ *
+ * @tparam Lock Type of the lockable satisfying Lockable, e.g., ILockable or a final implementation of it
+ * @tparam Sem Type of the semaphores satisfying CountingSemaphore, e.g., ISemaphore or a final implementation of it
+ * @tparam Sender Type of the sender, i.e., SendFunction or a function object called with ( data, length )
+ * @tparam RxCapacity Size of the Rx buffer held in the device, or 0 for a buffer given by the user through the constructor
  */
-class SerialDevice
+template<Lockable Lock, CountingSemaphore Sem, typename Sender = SerialDeviceBase::SendFunction, size_t RxCapacity = 0>
+class BasicSerialDevice : public SerialDeviceBase
 {
 public:
-   constexpr static size_t TX_BUFFER_SIZE = 256;
-   using SendFunction = void(*)( const uint8_t* data, size_t length );
-
-   SerialDevice( SendFunction sender, uint8_t rxBuffer[], size_t rxBufferSize, lib::ILockable& lockable, lib::ISemaphore& semTxComplete, lib::ISemaphore& semNewRxBytes )
+   BasicSerialDevice( Sender sender, uint8_t rxBuffer[], size_t rxBufferSize, Lock& lockable, Sem& semTxComplete, Sem& semNewRxBytes ) requires ( RxCapacity == 0 )
    : m_sender( sender )
    , m_rxBuffer( rxBuffer, rxBufferSize )
    , m_lockable( lockable )
@@ -43,7 +112,15 @@ public:
    , m_semNewRxBytes( semNewRxBytes )
    { }
 
-   ~SerialDevice()
+   BasicSerialDevice( Sender sender, Lock& lockable, Sem& semTxComplete, Sem& semNewRxBytes ) requires ( RxCapacity > 0 )
+   : m_sender( sender )
+   , m_rxBuffer( m_rxStorage.data, RxCapacity )
+   , m_lockable( lockable )
+   , m_semTxComplete( semTxComplete )
+   , m_semNewRxBytes( semNewRxBytes )
+   { }
+
+   ~BasicSerialDevice()
    { }
 
    ErrorCode   initialize           ( );
@@ -51,6 +128,8 @@ public:
    //!< For Tx
    ErrorCode   sendWait             ( const uint8_t* data, size_t length, uint32_t timeout_ms );
    ErrorCode   sendAsync            ( const uint8_t* data, size_t length );
+   ErrorCode   sendv                ( const TxSegment segments[], size_t numSegments );
+   ErrorCode   sendOwned            ( const uint8_t* data, size_t length, ReleaseFunction release, void* context = nullptr );
    ErrorCode   waitSendComplete     ( uint32_t timeout_ms );
    void        notifySendComplete   ( );
 
@@ -59,15 +138,405 @@ public:
    ErrorCode   pushRxByte           ( uint8_t data );
    ErrorCode   getRxByte            ( uint8_t& data, uint32_t timeout_ms );
 
+   //!< For monitoring
+   Statistics  getStatistics        ( ) const { return m_statistics; }
+   void        resetStatistics      ( );
+   lib::RingBuffer<uint8_t>& getRxBuffer ( )   { return m_rxBuffer; }     //!< For monitoring, e.g., with RingBufferStats
+
 private:
-   SendFunction                     m_sender;
+   void        startTransmission    ( size_t numSegments, ReleaseFunction release = nullptr, void* context = nullptr );
+
+   Sender                           m_sender;
    uint8_t                          m_txBuffer[TX_BUFFER_SIZE];
+   TxSegment                        m_txSegments[MAX_TX_SEGMENTS];
+   size_t                           m_numTxSegments{ 0 };
+   size_t                           m_txSegmentIndex{ 0 };
+   ReleaseFunction                  m_release{ nullptr };
+   void*                            m_releaseContext{ nullptr };
+   uint32_t                         m_txStartTick{ 0 };
+   Statistics                       m_statistics{};
+   RxStorage<RxCapacity>            m_rxStorage;      //!< Declared before m_rxBuffer, which points into it
    lib::RingBuffer<uint8_t>         m_rxBuffer;
-   lib::ILockable&                  m_lockable;
-   lib::ISemaphore&                 m_semTxComplete;
-   lib::ISemaphore&                 m_semNewRxBytes;
+   Lock&                            m_lockable;
+   Sem&                             m_semTxComplete;
+   Sem&                             m_semNewRxBytes;
 
    bool                             m_isInitialized{ false };
    bool                             m_isSending{ false };
+   bool                             m_isTxAbandoned{ false };   //!< A transmission was given up on by waitSendComplete(), whose completion may still be signaled
 };
+
+/**
+ * @brief Serial device over the lockable and semaphore interfaces, with a sender function and an Rx buffer given by the user.
+ * @details It's instantiated once in serial_device.cpp, so the users of this type don't compile the template again.
+ */
+using SerialDevice = BasicSerialDevice<ILockable, ISemaphore>;
+
+extern template class BasicSerialDevice<ILockable, ISemaphore>;
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Initialize the serial device.
+ *
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::initialize()
+{
+   if ( m_isInitialized )
+   {
+      return LibErrorCodes::eOK;
+   }
+
+   ZERO_BUFFER( m_txBuffer );
+
+   auto result = m_lockable.initialize();
+
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   result = m_semTxComplete.initialize( 1, 0 );
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   result = m_semNewRxBytes.initialize( m_rxBuffer.size(), 0 );
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   m_statistics.sinceTick_ms = LIB_COMMON_getTickMS();
+   m_isInitialized = true;
+
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Send data over UART and wait for completion.
+ *
+ * @param data Pointer to the data to be sent.
+ * @param length Length of the data to be sent.
+ * @param timeout_ms Timeout in milliseconds.
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::sendWait( const uint8_t* data, size_t length, uint32_t timeout_ms )
+{
+   auto result = sendAsync( data, length );
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+   return waitSendComplete( timeout_ms );
+}
+
+/**
+ * @brief Send data over UART.
+ * @details This function is non-blocking and returns immediately after initiating the send operation.
+ *          However, sending is allowed only if the previous sending has completed, which is confirmed through the waitSendComplete() function.
+ *
+ * @param data Pointer to the data to be sent.
+ * @param length Length of the data to be sent.
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::sendAsync( const uint8_t* data, size_t length )
+{
+   lib::lock_guard lock( m_lockable );
+
+   if ( !m_isInitialized )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_NOT_INITIALIZED;
+   }
+
+   if ( length > TX_BUFFER_SIZE )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_TX_MSG_TOO_LONG;
+   }
+
+   if ( m_isSending )
+   {
+      m_statistics.txBusy++;
+      return LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE;
+   }
+
+   m_isSending = true;
+
+   //!< Only the bytes to be sent are copied; the rest of the buffer is never transmitted, so it's not cleared.
+   memcpy( m_txBuffer, data, length );
+
+   m_txSegments[0] = { m_txBuffer, length };
+
+   //!< Send the message through the sender function, that is passed through the constructor
+   startTransmission( 1 );
+
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Send a frame made of multiple segments over UART.
+ * @details The segments are transmitted in sequence without being copied into the internal Tx buffer;
+ *          the first one is handed over to the sender here, and the following ones are chained from notifySendComplete() in the interrupt context.
+ *          Therefore, the frame is not limited by TX_BUFFER_SIZE, but the memory the segments point to must stay valid until waitSendComplete() returns.
+ *          Only the segment descriptors are copied, so the array itself may be a temporary one.
+ *
+ * @param segments Array of segments to be sent in order, each up to MAX_SEGMENT_LENGTH.
+ * @param numSegments Number of segments in the array, up to MAX_TX_SEGMENTS.
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::sendv( const TxSegment segments[], size_t numSegments )
+{
+   lib::lock_guard lock( m_lockable );
+
+   if ( !m_isInitialized )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_NOT_INITIALIZED;
+   }
+
+   if ( numSegments > MAX_TX_SEGMENTS )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_TX_SEG_OVERFLOW;
+   }
+
+   if ( m_isSending )
+   {
+      m_statistics.txBusy++;
+      return LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE;
+   }
+
+   //!< Empty segments are dropped here so that the interrupt context never has to skip them.
+   size_t count = 0;
+   for ( size_t i = 0; i < numSegments; i++ )
+   {
+      if ( segments[i].length > MAX_SEGMENT_LENGTH )
+      {
+         return LibErrorCodes::eSERIAL_DEVICE_TX_MSG_TOO_LONG;
+      }
+
+      if ( ( segments[i].data != nullptr ) && ( segments[i].length > 0 ) )
+      {
+         m_txSegments[count++] = segments[i];
+      }
+   }
+
+   if ( count == 0 )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_TX_MSG_EMPTY;
+   }
+
+   m_isSending = true;
+
+   startTransmission( count );
+
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Send a buffer owned by the caller over UART without copying it.
+ * @details The buffer is transmitted in place, and the ownership is handed over to the serial device until the transmission completes.
+ *          Then the release function is called with the buffer and the context given, so the caller can return the buffer to its pool.
+ *          Note that the release function is called in the interrupt context from notifySendComplete(), so it must be ISR-safe.
+ *
+ * @param data Pointer to the buffer to be sent.
+ * @param length Length of the data to be sent, up to MAX_SEGMENT_LENGTH.
+ * @param release Function to be called on completion to release the buffer, or nullptr if not required.
+ * @param context User context to be passed to the release function.
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::sendOwned( const uint8_t* data, size_t length, ReleaseFunction release, void* context /* = nullptr */ )
+{
+   lib::lock_guard lock( m_lockable );
+
+   if ( !m_isInitialized )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_NOT_INITIALIZED;
+   }
+
+   if ( m_isSending )
+   {
+      m_statistics.txBusy++;
+      return LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE;
+   }
+
+   if ( ( data == nullptr ) || ( length == 0 ) )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_TX_MSG_EMPTY;
+   }
+
+   if ( length > MAX_SEGMENT_LENGTH )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_TX_MSG_TOO_LONG;
+   }
+
+   m_isSending = true;
+
+   m_txSegments[0] = { data, length };
+
+   startTransmission( 1, release, context );
+
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Start transmitting the segments prepared, beginning with the first one.
+ *
+ * @param numSegments Number of segments prepared in m_txSegments.
+ * @param release Function to release the buffer on completion, if any.
+ * @param context User context for the release function.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+void BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::startTransmission( size_t numSegments, ReleaseFunction release /* = nullptr */, void* context /* = nullptr */ )
+{
+   //!< The late completion of a transmission given up on is taken out, so that it doesn't end the wait for this one early
+   if ( m_isTxAbandoned && ( m_semTxComplete.get( 0 ) == LibErrorCodes::eOK ) )
+   {
+      m_isTxAbandoned = false;
+   }
+
+   m_numTxSegments = numSegments;
+   m_txSegmentIndex = 0;
+   m_release = release;
+   m_releaseContext = context;
+   m_txStartTick = LIB_COMMON_getTickMS();
+   m_statistics.bytesOut += m_txSegments[0].length;
+   m_sender( m_txSegments[0].data, m_txSegments[0].length );
+}
+
+/**
+ * @brief Wait for the UART transmission to complete.
+ * @details On a timeout the transmission is given up on, and the device can be armed again, but the buffer of a sendOwned() is still read
+ *          until it's released, so its owner has to wait for the release before filling it again, as SerialLogSink does.
+ *
+ * @param timeout_ms Timeout in milliseconds.
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::waitSendComplete( uint32_t timeout_ms )
+{
+   if ( !m_isSending )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_NO_SEND_ACTIVE;
+   }
+
+   const auto tickStarted = LIB_COMMON_getTickMS();
+   const auto result = m_semTxComplete.get( timeout_ms );
+
+   m_statistics.txWaitTotal_ms += LIB_COMMON_getTickMS() - tickStarted;
+   if ( result != LibErrorCodes::eOK )
+   {
+      m_statistics.txTimeouts++;
+      m_isTxAbandoned = true;
+   }
+
+   //!< Set the flag to false, regardless of the result
+   m_isSending = false;
+
+   return result;
+}
+
+/**
+ * @brief Notify that the UART transmission is complete.
+ * @details If there are segments left for the frame being sent, the next one is handed over to the sender,
+ *          and the thread waiting for the completion is signaled only after the last segment.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+void BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::notifySendComplete( )
+{
+   if ( ++m_txSegmentIndex < m_numTxSegments )
+   {
+      m_statistics.bytesOut += m_txSegments[m_txSegmentIndex].length;
+      m_sender( m_txSegments[m_txSegmentIndex].data, m_txSegments[m_txSegmentIndex].length );
+      return;
+   }
+
+   //!< Give the buffer back to the owner before the waiting thread can start another transmission.
+   if ( m_release != nullptr )
+   {
+      const auto release = m_release;
+      m_release = nullptr;
+      release( m_txSegments[0].data, m_releaseContext );
+   }
+
+   const auto latency = LIB_COMMON_getTickMS() - m_txStartTick;
+   m_statistics.framesOut++;
+   m_statistics.txLatencyLast_ms   = latency;
+   m_statistics.txLatencyTotal_ms += latency;
+   if ( latency > m_statistics.txLatencyMax_ms )
+   {
+      m_statistics.txLatencyMax_ms = latency;
+   }
+
+   m_semTxComplete.putISR();
+}
+
+/**
+ * @brief Flush the RX buffer.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+void BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::flushRxBuffer( )
+{
+   lib::lock_guard lock( m_lockable );
+   m_rxBuffer.clear();
+}
+
+/**
+ * @brief Push a byte into the RX buffer.
+ *
+ * @param data The byte to be pushed.
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::pushRxByte( uint8_t data )
+{
+   if ( !m_isInitialized )
+   {
+      return LibErrorCodes::eSERIAL_DEVICE_NOT_INITIALIZED;
+   }
+
+   auto result = m_rxBuffer.push( data );
+   if ( result != LibErrorCodes::eOK )
+   {
+      //!< The byte is lost, which is counted so that an overrun can be noticed.
+      m_statistics.rxDrops++;
+      return result;
+   }
+
+   m_statistics.bytesIn++;
+   m_semNewRxBytes.putISR();
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Push a byte into the RX buffer.
+ *
+ * @param data The byte to be pushed.
+ * @param timeout_ms Timeout in milliseconds.
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+ErrorCode BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::getRxByte( uint8_t& data, uint32_t timeout_ms )
+{
+   const auto result = m_semNewRxBytes.get( timeout_ms );
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+   return m_rxBuffer.pop( data );
+}
+
+/**
+ * @brief Reset the statistics, and start measuring the rates from now.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sender, size_t RxCapacity>
+void BasicSerialDevice<Lock, Sem, Sender, RxCapacity>::resetStatistics( )
+{
+   m_statistics = Statistics{};
+   m_statistics.sinceTick_ms = LIB_COMMON_getTickMS();
+}
 } /* namespace lib */
@@ -0,0 +1,96 @@
+/************************************************************************************************************
+ *
+ * @file serial_device_registry.h
+ * @brief Registry mapping peripherals, e.g., UARTs, to serial device instances for interrupt dispatching.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-10
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "error_codes_lib.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/************************************************* Types ****************************************************/
+namespace lib
+{
+/**
+ * @brief Registry mapping a peripheral to its serial device, looked up in constant time from interrupt handlers.
+ * @details The key is the address of the peripheral registers, e.g., huart->Instance, and the slot is taken from its bits directly,
+ *          which works as a perfect hash for peripherals laid out at a regular stride in the memory map.
+ *          For example, all USART/UART instances of STM32F4 are 1 KB apart, so with the default parameters, i.e., ( address >> 10 ) % 32,
+ *          USART1..6 and UART4..8 fall into distinct slots. A collision is reported on registration, so it can never go unnoticed at runtime.
+ *          The key is stored in its slot and compared on lookup, so an unregistered peripheral is never mistaken for another one.
+ *          Registration is expected to be done at initialization before the interrupts are enabled; lookups are read-only afterwards.
+ *
+ * @tparam Device Type of the serial devices, e.g., SerialDevice
+ * @tparam NumSlots Number of slots, which must be a power of two
+ * @tparam KeyShift Number of the low bits of the key to be ignored, i.e., log2 of the stride of the peripherals
+ */
+template<typename Device, size_t NumSlots = 32, unsigned KeyShift = 10>
+class SerialDeviceRegistry
+{
+   static_assert( ( NumSlots > 0 ) && ( ( NumSlots & ( NumSlots - 1 ) ) == 0 ), "NumSlots must be a power of two" );
+
+public:
+   SerialDeviceRegistry() = default;
+   ~SerialDeviceRegistry() = default;
+
+   //!< Disable copy and move operations
+   SerialDeviceRegistry( const SerialDeviceRegistry& ) = delete;
+   SerialDeviceRegistry& operator=( const SerialDeviceRegistry& ) = delete;
+   SerialDeviceRegistry( SerialDeviceRegistry&& ) = delete;
+   SerialDeviceRegistry& operator=( SerialDeviceRegistry&& ) = delete;
+
+   /**
+    * @brief Register a serial device for a peripheral.
+    *
+    * @param key address of the peripheral
+    * @param device the serial device handling the peripheral
+    * @return ErrorCode eSERIAL_REGISTRY_COLLISION if the slot is taken by another peripheral
+    */
+   ErrorCode add( const volatile void* key, Device& device )
+   {
+      auto& slot = m_slots[ slotOf( key ) ];
+      if ( ( slot.device != nullptr ) && ( slot.key != key ) )
+      {
+         return LibErrorCodes::eSERIAL_REGISTRY_COLLISION;
+      }
+
+      slot.key    = key;
+      slot.device = &device;
+      return LibErrorCodes::eOK;
+   }
+
+   /**
+    * @brief Find the serial device for a peripheral.
+    *
+    * @param key address of the peripheral
+    * @return Device* the serial device, or nullptr if none is registered for the peripheral
+    */
+   Device* find( const volatile void* key ) const
+   {
+      const auto& slot = m_slots[ slotOf( key ) ];
+      return ( slot.key == key ) ? slot.device : nullptr;
+   }
+
+private:
+   struct Slot
+   {
+      const volatile void* key{ nullptr };
+      Device*              device{ nullptr };
+   };
+
+   static size_t slotOf( const volatile void* key )
+   {
+      return ( reinterpret_cast<uintptr_t>( key ) >> KeyShift ) & ( NumSlots - 1 );
+   }
+
+   Slot m_slots[NumSlots];
+};
+} /* namespace lib */
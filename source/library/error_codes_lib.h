@@ -53,6 +53,33 @@ enum LibErrorCodes
    eSERIAL_DEVICE_SEND_ACTIVE      = ( eLIBRARY | 0x0000000B ),
    eSERIAL_DEVICE_TX_MSG_TOO_LONG  = ( eLIBRARY | 0x0000000C ),
    eSERIAL_DEVICE_NO_SEND_ACTIVE   = ( eLIBRARY | 0x0000000D ),
-   eSERIAL_DEVICE_SEND_TIMEOUT     = ( eLIBRARY | 0x0000000E )
+   eSERIAL_DEVICE_SEND_TIMEOUT     = ( eLIBRARY | 0x0000000E ),
+   eSERIAL_DEVICE_TX_SEG_OVERFLOW  = ( eLIBRARY | 0x0000000F ),
+   eSERIAL_DEVICE_TX_MSG_EMPTY     = ( eLIBRARY | 0x00000010 ),
+
+   eFRAME_INCOMPLETE               = ( eLIBRARY | 0x00000011 ),
+   eFRAME_BUFFER_TOO_SMALL         = ( eLIBRARY | 0x00000012 ),
+   eFRAME_CRC_MISMATCH             = ( eLIBRARY | 0x00000013 ),
+   eFRAME_INVALID_ENCODING         = ( eLIBRARY | 0x00000014 ),
+
+   eSERIAL_REGISTRY_COLLISION      = ( eLIBRARY | 0x00000015 ),
+
+   eRETAINED_LOG_EMPTY             = ( eLIBRARY | 0x00000016 ),
+   eRETAINED_LOG_CORRUPTED         = ( eLIBRARY | 0x00000017 ),
+   eRETAINED_LOG_TOO_LONG          = ( eLIBRARY | 0x00000018 ),
+
+   eCLI_COMMAND_TABLE_UNSORTED     = ( eLIBRARY | 0x00000019 ),
+   eCLI_TOO_MANY_ARGS              = ( eLIBRARY | 0x0000001A ),
+   eCLI_UNTERMINATED_QUOTE         = ( eLIBRARY | 0x0000001B ),
+   eCLI_UNKNOWN_COMMAND            = ( eLIBRARY | 0x0000001C ),
+   eCLI_LINE_TOO_LONG              = ( eLIBRARY | 0x0000001D ),
+   eCLI_EXECUTOR_BUSY              = ( eLIBRARY | 0x0000001E ),
+   eCLI_JOB_NOT_FOUND              = ( eLIBRARY | 0x0000001F ),
+   eCLI_JOB_FINISHED               = ( eLIBRARY | 0x00000020 ),
+   eCLI_TOO_MANY_SESSIONS          = ( eLIBRARY | 0x00000021 ),
+   eCLI_INVALID_ARGUMENT           = ( eLIBRARY | 0x00000022 ),
+
+   eSTATS_REGISTRY_FULL            = ( eLIBRARY | 0x00000023 ),
+   eSTATS_PROVIDER_NOT_FOUND       = ( eLIBRARY | 0x00000024 )
 };
 
@@ -0,0 +1,284 @@
+/************************************************************************************************************
+ *
+ * @file lib_common.cpp
+ * @brief Implementation of the common functions of the library, i.e., the runtime thresholds of the log levels and the time stamps
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "lib_common.h"
+#include <ctype.h>
+#include <stdarg.h>
+
+#if defined (__ARM_ARCH_7M__) || defined (__ARM_ARCH_7EM__)
+#include "counter_extender.h"
+#else
+#include <chrono>
+#endif
+
+/************************************************* Consts ***************************************************/
+static const char* const MODULE_NAMES[] =
+{
+   "app",
+   "cli",
+   "passer",
+   "wifi",
+   "tcpip",
+   "mqtt",
+};
+static_assert( sizeof( MODULE_NAMES ) / sizeof( MODULE_NAMES[0] ) == LOG_MODULE_COUNT, "A name must be given for every module" );
+
+static const char* const LEVEL_NAMES[] =
+{
+   "none",
+   "error",
+   "warn",
+   "info",
+   "debug",
+   "trace",
+};
+static_assert( sizeof( LEVEL_NAMES ) / sizeof( LEVEL_NAMES[0] ) == LOG_LEVEL_TRACE + 1, "A name must be given for every level" );
+
+#if defined (__ARM_ARCH_7M__) || defined (__ARM_ARCH_7EM__)
+//!< Architectural registers of ARMv7-M, so that no device header is needed
+static volatile uint32_t* const DEMCR       = reinterpret_cast<volatile uint32_t*>( 0xE000EDFC );
+static volatile uint32_t* const DWT_CTRL    = reinterpret_cast<volatile uint32_t*>( 0xE0001000 );
+static volatile uint32_t* const DWT_CYCCNT  = reinterpret_cast<volatile uint32_t*>( 0xE0001004 );
+constexpr uint32_t DEMCR_TRCENA             = ( 1u << 24 );
+constexpr uint32_t DWT_CTRL_CYCCNTENA       = ( 1u << 0 );
+#endif
+
+/******************************************** Local Variables ***********************************************/
+#if defined (__ARM_ARCH_7M__) || defined (__ARM_ARCH_7EM__)
+static lib::CounterExtender   cycleCounter;
+static uint32_t               cyclesPerUs = 1;
+#else
+static uint32_t               cyclesPerUs = 1000;     //!< The host counter runs at 1 GHz
+#endif
+
+/******************************************** Global Variables **********************************************/
+uint8_t LIB_COMMON_logThresholds[LOG_MODULE_COUNT] =
+{
+   LOG_LEVEL_RUNTIME,
+   LOG_LEVEL_RUNTIME,
+   LOG_LEVEL_RUNTIME,
+   LOG_LEVEL_RUNTIME,
+   LOG_LEVEL_RUNTIME,
+   LOG_LEVEL_RUNTIME,
+};
+static_assert( sizeof( LIB_COMMON_logThresholds ) / sizeof( LIB_COMMON_logThresholds[0] ) == LOG_MODULE_COUNT, "A threshold must be given for every module" );
+
+/******************************************* Function Declarations ******************************************/
+static bool equalsIgnoreCase  ( const char* a, const char* b );
+static void printLine         ( LIB_COMMON_LineFunction print, void* context, const char* format, ... );
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Set the runtime threshold of a module.
+ * @note A level above LOG_LEVEL_COMPILE can be set, but it has no effect as the messages at that level are compiled out.
+ *
+ * @param module the module
+ * @param level the threshold, which is clamped to LOG_LEVEL_TRACE
+ */
+void LIB_COMMON_setLogLevel( eLogModule module, uint8_t level )
+{
+   if ( module >= LOG_MODULE_COUNT )
+   {
+      return;
+   }
+   LIB_COMMON_logThresholds[module] = ( level > LOG_LEVEL_TRACE ) ? LOG_LEVEL_TRACE : level;
+}
+
+/**
+ * @brief Get the runtime threshold of a module.
+ */
+uint8_t LIB_COMMON_getLogLevel( eLogModule module )
+{
+   return ( module < LOG_MODULE_COUNT ) ? LIB_COMMON_logThresholds[module] : LOG_LEVEL_NONE;
+}
+
+/**
+ * @brief Get the name of a module, as used in the CLI.
+ */
+const char* LIB_COMMON_getLogModuleName( eLogModule module )
+{
+   return ( module < LOG_MODULE_COUNT ) ? MODULE_NAMES[module] : "?";
+}
+
+/**
+ * @brief Get the name of a level, as used in the CLI.
+ */
+const char* LIB_COMMON_getLogLevelName( uint8_t level )
+{
+   return ( level <= LOG_LEVEL_TRACE ) ? LEVEL_NAMES[level] : "?";
+}
+
+/**
+ * @brief Find a module by its name, case-insensitively.
+ *
+ * @param name the name of the module
+ * @param module the module found
+ * @return true if found
+ */
+bool LIB_COMMON_findLogModule( const char* name, eLogModule* module )
+{
+   for ( int i = 0; i < LOG_MODULE_COUNT; i++ )
+   {
+      if ( equalsIgnoreCase( name, MODULE_NAMES[i] ) )
+      {
+         *module = static_cast<eLogModule>( i );
+         return true;
+      }
+   }
+   return false;
+}
+
+/**
+ * @brief Find a level by its name, case-insensitively.
+ *
+ * @param name the name of the level
+ * @param level the level found
+ * @return true if found
+ */
+bool LIB_COMMON_findLogLevel( const char* name, uint8_t* level )
+{
+   for ( uint8_t i = 0; i <= LOG_LEVEL_TRACE; i++ )
+   {
+      if ( equalsIgnoreCase( name, LEVEL_NAMES[i] ) )
+      {
+         *level = i;
+         return true;
+      }
+   }
+   return false;
+}
+
+/**
+ * @brief Process the 'loglevel' command, which is the same for every app but the output.
+ * @details Usage: loglevel [<module>|all <level>]
+ *          The level of the module given, or of all of them, is set, and the levels of all the modules are printed afterwards.
+ *
+ * @param argc the number of arguments
+ * @param argv the argument values
+ * @param print the sink of the lines printed
+ * @param context the context given to the sink
+ * @return true if done, or false if the arguments are invalid, which the caller can fail the command for
+ */
+bool LIB_COMMON_commandLogLevel( int argc, char* argv[], LIB_COMMON_LineFunction print, void* context )
+{
+   if ( argc == 2 )
+   {
+      printLine( print, context, "CLI: usage: loglevel [<module>|all <level>]" );
+      return false;
+   }
+
+   if ( argc >= 3 )
+   {
+      uint8_t level = LOG_LEVEL_NONE;
+      eLogModule module = LOG_MODULE_APP;
+      if ( !LIB_COMMON_findLogLevel( argv[2], &level ) )
+      {
+         printLine( print, context, "CLI: unknown log level [%s]", argv[2] );
+         return false;
+      }
+
+      if ( strcmp( argv[1], "all" ) == 0 )
+      {
+         for ( int i = 0; i < LOG_MODULE_COUNT; i++ )
+         {
+            LIB_COMMON_setLogLevel( static_cast<eLogModule>( i ), level );
+         }
+      }
+      else if ( LIB_COMMON_findLogModule( argv[1], &module ) )
+      {
+         LIB_COMMON_setLogLevel( module, level );
+      }
+      else
+      {
+         printLine( print, context, "CLI: unknown log module [%s]", argv[1] );
+         return false;
+      }
+   }
+
+   for ( int i = 0; i < LOG_MODULE_COUNT; i++ )
+   {
+      const auto module = static_cast<eLogModule>( i );
+      printLine( print, context, "CLI: [%s] %s", LIB_COMMON_getLogModuleName( module ), LIB_COMMON_getLogLevelName( LIB_COMMON_getLogLevel( module ) ) );
+   }
+   return true;
+}
+
+/**
+ * @brief Format a line of a command, and hand it over to the sink, where a line longer than the buffer is truncated.
+ */
+static void printLine( LIB_COMMON_LineFunction print, void* context, const char* format, ... )
+{
+   if ( print == nullptr )
+   {
+      return;
+   }
+
+   char line[64];
+   va_list args;
+   va_start( args, format );
+   (void)vsnprintf( line, sizeof( line ), format, args );
+   va_end( args );
+   print( context, line );
+}
+
+/**
+ * @brief Compare two strings case-insensitively, as strcasecmp is not available everywhere.
+ */
+static bool equalsIgnoreCase( const char* a, const char* b )
+{
+   while ( ( *a != '\0' ) && ( tolower( static_cast<unsigned char>( *a ) ) == tolower( static_cast<unsigned char>( *b ) ) ) )
+   {
+      a++;
+      b++;
+   }
+   return ( *a == '\0' ) && ( *b == '\0' );
+}
+
+/**
+ * @brief Set the frequency of the cycle counter, and enable it on the target.
+ *
+ * @param cyclesPerSecond the core clock in Hz
+ */
+void LIB_COMMON_initTimestamp( uint32_t cyclesPerSecond )
+{
+#if defined (__ARM_ARCH_7M__) || defined (__ARM_ARCH_7EM__)
+   cyclesPerUs = ( cyclesPerSecond >= 1000000 ) ? ( cyclesPerSecond / 1000000 ) : 1;
+
+   *DEMCR = *DEMCR | DEMCR_TRCENA;
+   *DWT_CYCCNT = 0;
+   *DWT_CTRL = *DWT_CTRL | DWT_CTRL_CYCCNTENA;
+#else
+   PARAM_NOT_USED( cyclesPerSecond );
+#endif
+}
+
+/**
+ * @brief Get the cycle count, extended to 64 bits.
+ */
+uint64_t LIB_COMMON_getCycleCount( void )
+{
+#if defined (__ARM_ARCH_7M__) || defined (__ARM_ARCH_7EM__)
+   return cycleCounter.extend( []() { return *DWT_CYCCNT; } );
+#else
+   const auto now = std::chrono::steady_clock::now().time_since_epoch();
+   return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( now ).count() );
+#endif
+}
+
+/**
+ * @brief Get the time stamp in microseconds.
+ */
+uint64_t LIB_COMMON_getTimestampUs( void )
+{
+   return LIB_COMMON_getCycleCount() / cyclesPerUs;
+}
@@ -19,31 +19,231 @@ extern "C" {
 /************************************************ Includes *************************************************/    
 #include <stdio.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 
 /************************************************* Consts **************************************************/    
-#define USE_LOGGER
+#define USE_LOGGER                //!< USE_DEFERRED_LOGGER can be defined in the build on top of it, to send binary records instead of text
+
+//!< Log levels, where a message is logged if its level is less than or equal to the threshold
+#define LOG_LEVEL_NONE     0
+#define LOG_LEVEL_ERROR    1
+#define LOG_LEVEL_WARN     2
+#define LOG_LEVEL_INFO     3
+#define LOG_LEVEL_DEBUG    4
+#define LOG_LEVEL_TRACE    5
+
+//!< Messages above this level are compiled out, which can be overridden in the build, e.g., -DLOG_LEVEL_COMPILE=LOG_LEVEL_INFO
+#if !defined (LOG_LEVEL_COMPILE)
+#define LOG_LEVEL_COMPILE  LOG_LEVEL_DEBUG
+#endif
+
+//!< Initial runtime threshold of every module, which can be changed with LIB_COMMON_setLogLevel()
+#if !defined (LOG_LEVEL_RUNTIME)
+#define LOG_LEVEL_RUNTIME  LOG_LEVEL_INFO
+#endif
+
+//!< Module of the log messages in a file, which the file can define before any include to have its own runtime threshold
+#if !defined (LOG_MODULE)
+#define LOG_MODULE         LOG_MODULE_APP
+#endif
+
+/************************************************* Types ***************************************************/    
+/**
+ * @brief Modules having their own runtime thresholds of the log level
+ */
+typedef enum
+{
+   LOG_MODULE_APP,               //!< Default for the files not defining LOG_MODULE
+   LOG_MODULE_CLI,
+   LOG_MODULE_MESSAGE_PASSER,
+   LOG_MODULE_SERIAL_WIFI,
+   LOG_MODULE_TCPIP,
+   LOG_MODULE_MQTT,
+   LOG_MODULE_COUNT
+} eLogModule;
+
+/**
+ * @brief Sink of the lines printed by a command, given without the end of the line, e.g., to the CLI session the command is entered in.
+ */
+typedef void (*LIB_COMMON_LineFunction)( void* context, const char* line );
 
 /************************************************* Macros **************************************************/    
 #define PARAM_NOT_USED(x) (void)(x)
 
-#if defined (USE_LOGGER)
+#if defined (USE_LOGGER) && defined (USE_DEFERRED_LOGGER) && defined (__cplusplus)
+#define LOGGING( format, ... ) LIB_COMMON_logDeferred( lib::LogRecord::formatId( format ), ##__VA_ARGS__ )
+#elif defined (USE_LOGGER)
 #define LOGGING( format, ... ) printf( "%08ld: " format "\r\n", LIB_COMMON_getTickMS(), ##__VA_ARGS__ )
 #else 
 #define LOGGING( format, ... )
 #endif
 
+/**
+ * @brief Log a message at a level, if the level is enabled for the module of the file at runtime.
+ * @details LOG_ERROR..LOG_TRACE above LOG_LEVEL_COMPILE expand to nothing, so neither code is generated nor the arguments are evaluated for them.
+ *          The message is tagged with its level on the way, so that the logger can filter it per sink.
+ */
+#define LOG_AT( level, format, ... ) \
+   do \
+   { \
+      if ( LIB_COMMON_isLogEnabled( LOG_MODULE, level ) ) \
+      { \
+         LIB_COMMON_tagLogLevel( level ); \
+         LOGGING( format, ##__VA_ARGS__ ); \
+         LIB_COMMON_tagLogLevel( LOG_LEVEL_NONE ); \
+      } \
+   } while ( 0 )
+
+#if defined (USE_LOGGER) && ( LOG_LEVEL_COMPILE >= LOG_LEVEL_ERROR )
+#define LOG_ERROR( format, ... ) LOG_AT( LOG_LEVEL_ERROR, format, ##__VA_ARGS__ )
+#else
+#define LOG_ERROR( format, ... ) do { } while ( 0 )
+#endif
+
+#if defined (USE_LOGGER) && ( LOG_LEVEL_COMPILE >= LOG_LEVEL_WARN )
+#define LOG_WARN( format, ... ) LOG_AT( LOG_LEVEL_WARN, format, ##__VA_ARGS__ )
+#else
+#define LOG_WARN( format, ... ) do { } while ( 0 )
+#endif
+
+#if defined (USE_LOGGER) && ( LOG_LEVEL_COMPILE >= LOG_LEVEL_INFO )
+#define LOG_INFO( format, ... ) LOG_AT( LOG_LEVEL_INFO, format, ##__VA_ARGS__ )
+#else
+#define LOG_INFO( format, ... ) do { } while ( 0 )
+#endif
+
+#if defined (USE_LOGGER) && ( LOG_LEVEL_COMPILE >= LOG_LEVEL_DEBUG )
+#define LOG_DEBUG( format, ... ) LOG_AT( LOG_LEVEL_DEBUG, format, ##__VA_ARGS__ )
+#else
+#define LOG_DEBUG( format, ... ) do { } while ( 0 )
+#endif
+
+#if defined (USE_LOGGER) && ( LOG_LEVEL_COMPILE >= LOG_LEVEL_TRACE )
+#define LOG_TRACE( format, ... ) LOG_AT( LOG_LEVEL_TRACE, format, ##__VA_ARGS__ )
+#else
+#define LOG_TRACE( format, ... ) do { } while ( 0 )
+#endif
+
+/**
+ * @brief Log a structured event, i.e., LOG_KV( "event", "key1", value1, "key2", value2, ... ), as a binary record regardless of USE_DEFERRED_LOGGER.
+ * @details The event name and the keys must be string literals, which are left to scripts/log_decoder.py to find in the source code,
+ *          and only the values are encoded, e.g., integers as varints and strings with their lengths.
+ */
+#if defined (USE_LOGGER) && defined (__cplusplus)
+#define LOG_KV( event, ... ) LIB_COMMON_logKv( lib::KvRecord::eventId( event ), ##__VA_ARGS__ )
+#else
+#define LOG_KV( event, ... )
+#endif
+
 #define ZERO_BUFFER( buf ) memset( buf, 0, sizeof( buf ) )
 
+/******************************************** Global Variables *********************************************/    
+extern uint8_t LIB_COMMON_logThresholds[LOG_MODULE_COUNT];     //!< Runtime thresholds of the modules, defined in lib_common.cpp
+
 /******************************************* Function Declarations *****************************************/    
 /**
  * @brief Get the current tick count
  * @note The implementation must be provieded on the application side for this, and this allows utilzing the LOGGING macro even in the library code.
+ *       It must be callable from the interrupt context as well, since the library uses it to time stamp events in interrupt handlers, e.g., Tx completion.
  * 
  * @return uint32_t a tick count in milliseconds
  */
 uint32_t LIB_COMMON_getTickMS( void );
 
+/**
+ * @brief Set the frequency of the cycle counter, i.e., the core clock, which enables the counter on the target.
+ * @note This must be called before the time stamps are taken, and it has no effect on the host, where the counter runs at 1 GHz.
+ * 
+ * @param cyclesPerSecond the core clock in Hz, e.g., SystemCoreClock
+ */
+void     LIB_COMMON_initTimestamp   ( uint32_t cyclesPerSecond );
+
+/**
+ * @brief Get the cycle count, extended to 64 bits.
+ * @note It's the DWT cycle counter on Cortex-M, and a steady clock in ns on the host.
+ *       It can be called in the interrupt context as well, and on the target it must be called at least once every half period of the 32-bit counter.
+ */
+uint64_t LIB_COMMON_getCycleCount   ( void );
+
+/**
+ * @brief Get the time stamp in microseconds since the cycle counter is enabled, for measuring the latency between events finer than a tick.
+ */
+uint64_t LIB_COMMON_getTimestampUs  ( void );
+
+/**
+ * @brief Tag the messages the calling task logs from now on with a level, where LOG_LEVEL_NONE is for those not logged at a level, e.g., with LOGGING.
+ * @note The implementation must be provided on the application side for this, which may do nothing if the logger doesn't filter by the level.
+ *       It's called around every message of LOG_ERROR..LOG_TRACE, in the interrupt context as well.
+ * 
+ * @param level the level
+ */
+void LIB_COMMON_tagLogLevel( uint8_t level );
+
+/**
+ * @brief Write a binary log record to the log sink
+ * @note The implementation must be provided on the application side when USE_DEFERRED_LOGGER is defined or LOG_KV is used.
+ *       The record has to be written as a whole, as it can only be decoded as a whole on the host.
+ * 
+ * @param record pointer to the record, encoded by lib::LogRecord
+ * @param length length of the record
+ */
+void LIB_COMMON_writeLogRecord( const uint8_t* record, size_t length );
+
+void        LIB_COMMON_setLogLevel        ( eLogModule module, uint8_t level );
+uint8_t     LIB_COMMON_getLogLevel        ( eLogModule module );
+const char* LIB_COMMON_getLogModuleName   ( eLogModule module );
+const char* LIB_COMMON_getLogLevelName    ( uint8_t level );
+bool        LIB_COMMON_findLogModule      ( const char* name, eLogModule* module );
+bool        LIB_COMMON_findLogLevel       ( const char* name, uint8_t* level );
+bool        LIB_COMMON_commandLogLevel    ( int argc, char* argv[], LIB_COMMON_LineFunction print, void* context );
+
+/**
+ * @brief Check if a level is enabled for a module at runtime.
+ * @note It's inline as it's evaluated on every LOG_* call compiled in.
+ */
+static inline bool LIB_COMMON_isLogEnabled( eLogModule module, uint8_t level )
+{
+   return level <= LIB_COMMON_logThresholds[module];
+}
+
 #if defined (__cplusplus)
 }
 #endif
+
+#if defined (USE_LOGGER) && defined (USE_DEFERRED_LOGGER) && defined (__cplusplus)
+#include "log_record.h"
+
+/**
+ * @brief Log a message in the deferred mode, where the record is encoded in binary without formatting, and formatted on the host.
+ * 
+ * @param id ID of the format string
+ * @param args the arguments of the format string
+ */
+template<typename... Args>
+inline void LIB_COMMON_logDeferred( uint32_t id, Args... args )
+{
+   uint8_t record[lib::LogRecord::MAX_RECORD_SIZE];
+   const auto length = lib::LogRecord::encode( record, sizeof( record ), id, static_cast<uint32_t>( LIB_COMMON_getTimestampUs() ), args... );
+   LIB_COMMON_writeLogRecord( record, length );
+}
+#endif
+
+#if defined (USE_LOGGER) && defined (__cplusplus)
+#include "kv_record.h"
+
+/**
+ * @brief Log a structured event, whose record is encoded with the values of the fields only.
+ * 
+ * @param id ID of the event name
+ * @param fields the keys and the values of the fields, in turn
+ */
+template<typename... Fields>
+inline void LIB_COMMON_logKv( uint32_t id, Fields... fields )
+{
+   uint8_t record[lib::KvRecord::MAX_RECORD_SIZE];
+   const auto length = lib::KvRecord::encode( record, sizeof( record ), id, static_cast<uint32_t>( LIB_COMMON_getTimestampUs() ), fields... );
+   LIB_COMMON_writeLogRecord( record, length );
+}
+#endif
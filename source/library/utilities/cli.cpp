@@ -23,28 +23,70 @@ namespace lib
  * @param buffer pointer to a buffer that will hold incoming characters
  * @param sizeBuffer size of the buffer
  * @param delimiter character used to delimit commands
- * @param commands array of command entries
+ * @param commands array of command entries, sorted by the names, e.g., by makeCommandTable()
  * @param numCommands number of commands in the array
  * @param semaphore semaphore used for signaling new command lines
+ * @param separators characters separating the arguments
+ * @param maxLineLength maximum length of a line excluding the delimiter, beyond which it's truncated
  */
-CLI::CLI( char buffer[], uint32_t sizeBuffer, const char* delimiter, CommandEntry commands[], size_t numCommands, lib::ISemaphore& semaphore )
+CLI::CLI( char buffer[], uint32_t sizeBuffer, const char* delimiter, const CommandEntry commands[], size_t numCommands, lib::ISemaphore& semaphore,
+          const char* separators /* = " \t" */, uint32_t maxLineLength /* = DEFAULT_MAX_LINE_LENGTH */ )
+ : CLI( buffer, sizeBuffer, &semaphore, delimiter, commands, numCommands, separators, maxLineLength )
+{ }
+
+/**
+ * @brief Construct a new CLI::CLI object without any input of its own, e.g., for a CLI server whose sessions assemble the lines.
+ * @details Neither the ring buffer nor the semaphore is needed, so getNewCommandLine() never gets a line and putCharIntoBuffer() ignores the input.
+ *
+ * @param delimiter character used to delimit commands
+ * @param commands array of command entries, sorted by the names, e.g., by makeCommandTable()
+ * @param numCommands number of commands in the array
+ * @param separators characters separating the arguments
+ */
+CLI::CLI( const char* delimiter, const CommandEntry commands[], size_t numCommands, const char* separators /* = " \t" */ )
+ : CLI( nullptr, 0, nullptr, delimiter, commands, numCommands, separators, DEFAULT_MAX_LINE_LENGTH )
+{ }
+
+/**
+ * @brief Construct a new CLI::CLI object, which the others delegate to.
+ */
+CLI::CLI( char buffer[], uint32_t sizeBuffer, lib::ISemaphore* semaphore, const char* delimiter, const CommandEntry commands[], size_t numCommands,
+          const char* separators, uint32_t maxLineLength )
  : m_ringBuffer( buffer, sizeBuffer )
  , m_delimiterStr( delimiter )
+ , m_delimiterLength( strlen( delimiter ) )
+ , m_delimiterEnd( delimiter[ m_delimiterLength - 1 ] )
+ , m_separators( separators )
  , m_commandTable( commands )
  , m_numCommands( numCommands )
  , m_semaphore( semaphore )
-{
-   m_delimiterEnd = m_delimiterStr[ strlen( m_delimiterStr ) - 1 ];
-}
+   //!< The delimiter but its last character is received as a part of the line, and it's removed once the line is taken
+ , m_lineAssembler( maxLineLength + static_cast<uint32_t>( m_delimiterLength ) - 1 )
+{ }
 
 /**
  * @brief Initialize the CLI
+ * @details The command table is checked once here, as a table not built by makeCommandTable() may not be sorted.
  * 
  * @return ErrorCode 
  */
 ErrorCode CLI::initialize( )
 {
-   auto result = m_semaphore.initialize( 1, 0 );
+   for ( size_t i = 1; i < m_numCommands; i++ )
+   {
+      if ( strcmp( m_commandTable[i - 1].commandName, m_commandTable[i].commandName ) >= 0 )
+      {
+         return LibErrorCodes::eCLI_COMMAND_TABLE_UNSORTED;
+      }
+   }
+
+   if ( m_semaphore == nullptr )
+   {
+      return LibErrorCodes::eOK;
+   }
+
+   //!< Every line takes at least its end in the ring buffer
+   auto result = m_semaphore->initialize( m_ringBuffer.size(), 0 );
    if ( result != LibErrorCodes::eOK )
    {
       return result;
@@ -56,121 +98,251 @@ ErrorCode CLI::initialize( )
 /**
  * @brief Get a new command line from the user
  * @details This function is intended to be called in a separate thread to wait a new command line input ending with the delimiter.
- *          If received, the command line is stored in the provided buffer.
+ *          If received, the command line is stored in the provided buffer without the delimiter, and null-terminated.
+ *          Only one line is taken at a time, so the next one is left for the next call even if it's already received.
+ *
+ * @param buffer buffer the line is copied into
+ * @param sizeBuffer size of the buffer, including the null
+ * @param timeout_ms time to wait for a line
+ * @return ErrorCode eOK, eCLI_NO_COMMAND if no line is received in time or the CLI has no input, or eCLI_LINE_TOO_LONG along with the line truncated,
+ *                   if it was truncated on receiving, or if it doesn't fit in the buffer
  */
 ErrorCode CLI::getNewCommandLine( char* buffer, uint32_t sizeBuffer, uint32_t timeout_ms /* = 3000 */ )
 {
-   if ( m_semaphore.get( timeout_ms ) != LibErrorCodes::eOK )
+   if ( ( m_semaphore == nullptr ) || ( m_semaphore->get( timeout_ms ) != LibErrorCodes::eOK ) )
    {
       return LibErrorCodes::eCLI_NO_COMMAND;
    }
 
+   uint32_t length = 0;
+   bool isTooLong = false;
    char oneChar;
-   while ( ( m_ringBuffer.pop( oneChar ) == LibErrorCodes::eOK ) && 
-           ( sizeBuffer-- ) )
+   while ( m_ringBuffer.pop( oneChar ) == LibErrorCodes::eOK )
    {
-      *buffer++ = oneChar;
-      if ( oneChar == m_delimiterEnd )
+      if ( ( oneChar == LINE_END ) || ( oneChar == LINE_TRUNCATED ) )
       {
+         isTooLong = isTooLong || ( oneChar == LINE_TRUNCATED );
          break;
       }
+
+      //!< The rest of a line not fitting is taken out anyway, so that it's not taken as the next line
+      if ( length + 1 < sizeBuffer )
+      {
+         buffer[length++] = oneChar;
+      }
+      else
+      {
+         isTooLong = true;
+      }
    }
 
-   return LibErrorCodes::eOK;
+   const uint32_t lengthPrefix = static_cast<uint32_t>( m_delimiterLength ) - 1;
+   if ( ( length >= lengthPrefix ) && ( strncmp( buffer + length - lengthPrefix, m_delimiterStr, lengthPrefix ) == 0 ) )
+   {
+      length -= lengthPrefix;
+   }
+
+   if ( sizeBuffer > 0 )
+   {
+      buffer[length] = '\0';
+   }
+
+   return isTooLong ? LibErrorCodes::eCLI_LINE_TOO_LONG : LibErrorCodes::eOK;
 }
 
 /**
  * @brief Process the user input
  * @details This function tries to get the input string tokenized into command and arguments,
- *          and then look for a command table whose command is matched with the command in the input.
+ *          and then look up the command table for the command in the input.
  *          If found, the corresponding function is executed.
  *
  * @param input pointer to the user input string
+ * @return ErrorCode eOK, including an empty line, the error of the tokenization or eCLI_UNKNOWN_COMMAND, where nothing is executed,
+ *                   or the error the command set with setCommandError()
  */
-void CLI::processInput( char* input )
+ErrorCode CLI::processInput( char* input )
 {
    char* argv[MAX_ARGS];
-   const auto argc = tokenize( input, argv, MAX_ARGS );
-   if (argc == 0)
+   int argc = 0;
+   const auto result = tokenize( input, argv, MAX_ARGS, argc );
+   if ( result != LibErrorCodes::eOK )
    {
-      return;
+      return result;
    }
 
-   char* command = argv[0];
+   if ( argc == 0 )
+   {
+      return LibErrorCodes::eOK;
+   }
 
-   for ( unsigned i = 0; i < m_numCommands; i++ )
+   const auto* entry = findCommand( m_commandTable, m_numCommands, argv[0] );
+   if ( entry == nullptr )
    {
-      if ( strcmp( m_commandTable[i].commandName, command ) == 0 )
+      return LibErrorCodes::eCLI_UNKNOWN_COMMAND;
+   }
+
+   m_commandError.store( LibErrorCodes::eOK, std::memory_order_relaxed );
+   entry->function( argc, argv );
+   return m_commandError.exchange( LibErrorCodes::eOK, std::memory_order_relaxed );
+}
+
+/**
+ * @brief Find a command in a command table with a binary search
+ *
+ * @param commands array of command entries, sorted by the names
+ * @param numCommands number of commands in the array
+ * @param name name of the command
+ * @return const CommandEntry* the command entry, or nullptr if not found
+ */
+const CLI::CommandEntry* CLI::findCommand( const CommandEntry commands[], size_t numCommands, const char* name )
+{
+   size_t low = 0;
+   size_t high = numCommands;
+   while ( low < high )
+   {
+      const size_t middle = low + ( high - low ) / 2;
+      const int order = strcmp( commands[middle].commandName, name );
+      if ( order == 0 )
       {
-         m_commandTable[i].function( argc, argv );
-         return;
+         return &commands[middle];
+      }
+
+      if ( order < 0 )
+      {
+         low = middle + 1;
+      }
+      else
+      {
+         high = middle;
       }
    }
+   return nullptr;
 }
 
 /**
  * @brief Tokenize the input string into command and arguments
+ * @details The input is scanned once, and the arguments are written in place, terminated by a null each, which ends up no longer than the input.
+ *          The arguments are separated by any number of the separators, and the input ends at a null or at the delimiter.
+ *          Within quotes, either " or ', the separators are part of the argument, and a backslash takes the next character as it is, even a quote.
  *
- * @param input pointer to the input string
+ * @param input pointer to the input string, which is modified
  * @param argv array to hold the tokenized arguments
  * @param maxArgs maximum number of arguments
- * @return int number of arguments parsed
+ * @param argc number of arguments parsed, up to maxArgs
+ * @return ErrorCode eOK, or eCLI_TOO_MANY_ARGS or eCLI_UNTERMINATED_QUOTE, along with the arguments parsed so far
  */
-int CLI::tokenize( char* input, char* argv[], int maxArgs )
+ErrorCode CLI::tokenize( char* input, char* argv[], int maxArgs, int& argc )
 {
-   int argc = 0;
+   enum class eState
+   {
+      SEPARATOR,     //!< Between the arguments
+      TOKEN,         //!< In an argument
+      QUOTED,        //!< In an argument, within quotes
+   };
 
-   //!< Parse the command and the arguments
-   while ( ( *input != '\0' ) && ( argc < maxArgs ) )
+   auto state = eState::SEPARATOR;
+   char quote = '\0';
+   char* output = input;
+   argc = 0;
+
+   for ( const char* next = input; ; next++ )
    {
-      //!< Skip leading spaces
-      while ( *input == ' ' )
+      if ( isLineEnd( next ) )
       {
-         input++;
+         *output = '\0';
+         return ( state == eState::QUOTED ) ? LibErrorCodes::eCLI_UNTERMINATED_QUOTE : LibErrorCodes::eOK;
       }
 
-      if ( *input == '\0' )
+      char c = *next;
+      if ( ( state != eState::QUOTED ) && ( strchr( m_separators, c ) != nullptr ) )
       {
-         break;
+         if ( state == eState::TOKEN )
+         {
+            *output++ = '\0';
+            state = eState::SEPARATOR;
+         }
+         continue;
       }
 
-      //!< Find the next space
-      auto* token = strchr( input, ' ' );
-      if ( token == nullptr )
+      if ( state == eState::SEPARATOR )
       {
-         //!< Last argument
-         argv[argc++] = input;
-
-         //!< Replace delimiter with null terminator, if found.
-         auto* end = strstr( input, m_delimiterStr );
-         if ( end != nullptr )
+         if ( argc == maxArgs )
          {
-            *end = '\0';
+            return LibErrorCodes::eCLI_TOO_MANY_ARGS;
          }
-         break;
+         argv[argc++] = output;
+         state = eState::TOKEN;
       }
 
-      //!< Null-terminate the argument
-      *token = '\0';
-      argv[argc++] = input;
-      input = token + 1;
+      if ( ( c == '\\' ) && !isLineEnd( next + 1 ) )
+      {
+         c = *++next;
+      }
+      else if ( ( state == eState::TOKEN ) && ( ( c == '"' ) || ( c == '\'' ) ) )
+      {
+         quote = c;
+         state = eState::QUOTED;
+         continue;
+      }
+      else if ( ( state == eState::QUOTED ) && ( c == quote ) )
+      {
+         state = eState::TOKEN;
+         continue;
+      }
+
+      *output++ = c;
    }
+}
 
-   return argc;
+/**
+ * @brief Check if the input ends at the given position, i.e., at a null or at the delimiter
+ *
+ * @param input pointer to the position in the input string
+ * @return true if the input ends there
+ */
+bool CLI::isLineEnd( const char* input ) const
+{
+   return ( *input == '\0' ) || ( ( *input == m_delimiterStr[0] ) && ( strncmp( input, m_delimiterStr, m_delimiterLength ) == 0 ) );
 }
 
 /**
  * @brief Put a character into the CLI buffer
  * @details This function is intended to be called in the interrupt context, as indicated, whenever a new character is received.
+ *          A character of the line is kept only if a slot is left for the end of the line after it, so that a line is always ended once started.
+ *          Once a line is truncated by LineAssembler, the rest of it is dropped until the delimiter, even if the ring buffer has room again by then.
+ *          The character is ignored if the CLI has no input of its own.
  *
  * @param c character to be added to the buffer
  */
 void CLI::putCharIntoBuffer( char c )
 {
-   auto result = m_ringBuffer.push(c);
-   if ( ( result == LibErrorCodes::eOK ) && ( c == m_delimiterEnd ) )
+   //!< The markers can't be a part of a line, as they would end it in the ring buffer
+   if ( ( m_semaphore == nullptr ) || ( ( c != m_delimiterEnd ) && ( ( c == LINE_END ) || ( c == LINE_TRUNCATED ) ) ) )
    {
-      m_semaphore.putISR();
+      return;
    }
+
+   const bool hasRoom = ( m_ringBuffer.size() - m_ringBuffer.count() ) >= 2;
+   const auto action = m_lineAssembler.put( c == m_delimiterEnd, hasRoom );
+   if ( action == LineAssembler::eAction::KEEP )
+   {
+      (void)m_ringBuffer.push( c );
+      return;
+   }
+
+   if ( action == LineAssembler::eAction::DROP )
+   {
+      return;
+   }
+
+   //!< Only a line with nothing kept can fail here, so nothing is left behind to be merged into the next line
+   const char end = ( action == LineAssembler::eAction::END_TRUNCATED ) ? LINE_TRUNCATED : LINE_END;
+   if ( m_ringBuffer.push( end ) != LibErrorCodes::eOK )
+   {
+      m_droppedLines.fetch_add( 1, std::memory_order_relaxed );
+      return;
+   }
+
+   m_semaphore->putISR();
 }
 } /* namespace lib */
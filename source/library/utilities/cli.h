@@ -4,6 +4,17 @@
  * @brief Command Line Interface (CLI) module for processing user commands.
  * @details This module provides functionalities to read, parse, and execute commands.
  *          This is a singleton class as there will be only one CLI instance in the system.
+ *          The command table is sorted by the command names, so that a command is looked up with a binary search.
+ *          It's meant to be built with makeCommandTable(), which sorts it and rejects duplicate names at compile time, so that it stays in flash.
+ *          A command line is split into the arguments in a single pass, in place, where an argument with separators in it is quoted with " or ',
+ *          and a backslash takes the next character as it is, e.g., wifi "AT+CWJAP=\"my ssid\",\"pass\"".
+ *          The characters received are assembled into lines in the ring buffer, where every line completed is a record of its own ending with a marker,
+ *          and the semaphore counts the lines, so that lines arriving back to back, e.g., pasted at once, are taken one by one and never merged.
+ *          A line longer than the maximum, or one not fitting in the ring buffer, is truncated and marked so, as a slot is always kept for its end,
+ *          and a line which can't even be ended since the ring buffer is full is dropped as a whole and counted.
+ *          The truncation follows LineAssembler, as CliSession does, so that a line too long is told the same way whichever input it comes from.
+ *          A CLI whose lines are assembled elsewhere, e.g., by the sessions of a CLI server, is built without the ring buffer and the semaphore,
+ *          in which case it only executes the lines given to processInput().
  *  
  * @author Sungsu Kim
  * @copyright 2025 Sungsu Kim
@@ -16,10 +27,14 @@
 
 /************************************************ Includes **************************************************/ 
 #include "ring_buffer.h"
+#include "line_assembler.h"
 #include "semaphore_interface.h"
 #include "error_codes_lib.h"
 #include <stdint.h>
 #include <stddef.h>
+#include <array>
+#include <atomic>
+#include <string_view>
 
 namespace lib
 {
@@ -28,12 +43,21 @@ class CLI final
 {
 public:
    //!< Constants
-   constexpr static uint32_t MAX_COMMANDS = 10;
-   constexpr static uint32_t MAX_ARGS     = 5;     //!< including the command part
+   constexpr static uint32_t MAX_ARGS                 = 8;     //!< including the command part
+   constexpr static uint32_t DEFAULT_MAX_LINE_LENGTH  = 127;   //!< excluding the delimiter, which fits a line buffer of 128 bytes with the null
 
    //!< Alias for command function pointer
    using CommandFunction = void (*)( int, char*[] );
 
+   /**
+    * @brief Where a command is executed when the lines are submitted to a command executor, e.g., BasicCommandExecutor.
+    */
+   enum class eExecution : uint8_t
+   {
+      INLINE,                                      //!< In the task submitting the line, for the quick ones, e.g., cancelling a job
+      ASYNC,                                       //!< In a worker task, for the ones which may block, so that the console stays responsive
+   };
+
    /**
     * @brief Command entry structure
     */
@@ -41,17 +65,31 @@ public:
    {
       const char* commandName;                     //!< Name of the command
       CommandFunction function;                    //!< Pointer to the command function
+      eExecution execution{ eExecution::INLINE };  //!< Ignored by processInput(), which executes every command inline
    } ;
 
    ~CLI() = default;
 
    static CLI&    getInstance          ( );        //!< Singleton instance accessor. The implementation should be in a separate file, e.g., config_cli.cpp, not in cpp.cpp.
 
+   template<size_t N>
+   static consteval std::array<CommandEntry, N> makeCommandTable( const CommandEntry ( &commands )[N] );
+   static const CommandEntry* findCommand( const CommandEntry commands[], size_t numCommands, const char* name );
+   const CommandEntry*        findCommand( const char* name ) const { return findCommand( m_commandTable, m_numCommands, name ); }
+
    ErrorCode      initialize           ( );
    ErrorCode      getNewCommandLine    ( char* buffer, uint32_t sizeBuffer, uint32_t timeout_ms = 3000 );
-   void           processInput         ( char* input );
-   int            tokenize             ( char* input, char* argv[], int maxArgs );
+   ErrorCode      processInput         ( char* input );
+   ErrorCode      tokenize             ( char* input, char* argv[], int maxArgs, int& argc );
    void           putCharIntoBuffer    ( char c );
+   uint32_t       getDroppedLines      ( ) const   { return m_droppedLines.load( std::memory_order_relaxed ); }
+   RingBuffer<char>& getRingBuffer     ( )         { return m_ringBuffer; }     //!< For monitoring, e.g., with RingBufferStats
+
+   /**
+    * @brief Fail the command being executed by processInput(), which returns the error instead of eOK, e.g., to stop a batch.
+    * @note This is meant for the commands executed inline, as the one executed in another task at the same time would be blamed for it.
+    */
+   void           setCommandError      ( ErrorCode error )    { m_commandError.store( error, std::memory_order_relaxed ); }
 
    //!< disable copy and move constructors
    CLI( const CLI& ) = delete;
@@ -60,15 +98,67 @@ public:
    CLI& operator=( CLI&& ) = delete;
 
 private:
-   //!< Constructor
-   CLI( char buffer[], uint32_t sizeBuffer, const char* delimiter, CommandEntry commands[], size_t numCommands, lib::ISemaphore& semaphore );
+   //!< Constructors, with the input received character by character, e.g., from a UART interrupt, or without any input of its own
+   CLI( char buffer[], uint32_t sizeBuffer, const char* delimiter, const CommandEntry commands[], size_t numCommands, lib::ISemaphore& semaphore,
+        const char* separators = " \t", uint32_t maxLineLength = DEFAULT_MAX_LINE_LENGTH );
+   CLI( const char* delimiter, const CommandEntry commands[], size_t numCommands, const char* separators = " \t" );
+   CLI( char buffer[], uint32_t sizeBuffer, lib::ISemaphore* semaphore, const char* delimiter, const CommandEntry commands[], size_t numCommands,
+        const char* separators, uint32_t maxLineLength );
+
+   //!< Markers ending a line in the ring buffer, which are dropped when received
+   constexpr static char LINE_END         = '\0';
+   constexpr static char LINE_TRUNCATED   = '\x18';     //!< ASCII CAN
+
+   bool           isLineEnd            ( const char* input ) const;
+
+   static void duplicateCommand( );        //!< Not constexpr on purpose, so that a call to it fails the compilation
 
    lib::RingBuffer<char>   m_ringBuffer;           //!< buffer to hold all the incoming characters
    const char*             m_delimiterStr;         //!< A config. parameter to decide a new command line
+   size_t                  m_delimiterLength;
    char                    m_delimiterEnd;
+   const char*             m_separators;           //!< Characters separating the arguments, e.g., " \t"
    const CommandEntry     *m_commandTable;
    const size_t            m_numCommands{ 0 };
    
-   lib::ISemaphore&        m_semaphore;            //!< to signal there's a new command line
+   lib::ISemaphore*        m_semaphore;            //!< Counts the lines completed in the ring buffer, or nullptr without any input
+   LineAssembler           m_lineAssembler;        //!< Used only by putCharIntoBuffer(), where the maximum includes the delimiter but its last character
+   std::atomic<uint32_t>   m_droppedLines{ 0 };
+   std::atomic<ErrorCode>  m_commandError{ LibErrorCodes::eOK };     //!< Set by the command being executed by processInput()
 };
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Build a command table sorted by the command names at compile time, e.g.,
+ *        static constexpr auto commands = lib::CLI::makeCommandTable( { { "test", commandTest }, { "wifi", commandWifi } } );
+ * @details The compilation fails if any name is given twice, as only one of them could ever be found.
+ *
+ * @param commands the command entries in any order
+ * @return std::array<CommandEntry, N> the command entries sorted by their names
+ */
+template<size_t N>
+consteval std::array<CLI::CommandEntry, N> CLI::makeCommandTable( const CommandEntry ( &commands )[N] )
+{
+   std::array<CommandEntry, N> table{};
+   for ( size_t i = 0; i < N; i++ )
+   {
+      //!< Insertion sort, as the table is small and it's sorted only once, by the compiler
+      size_t j = i;
+      while ( ( j > 0 ) && ( std::string_view{ commands[i].commandName } < std::string_view{ table[j - 1].commandName } ) )
+      {
+         table[j] = table[j - 1];
+         j--;
+      }
+      table[j] = commands[i];
+   }
+
+   for ( size_t i = 1; i < N; i++ )
+   {
+      if ( std::string_view{ table[i - 1].commandName } == std::string_view{ table[i].commandName } )
+      {
+         duplicateCommand();
+      }
+   }
+   return table;
+}
 } /* namespace lib */
\ No newline at end of file
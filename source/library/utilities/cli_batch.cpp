@@ -0,0 +1,187 @@
+/************************************************************************************************************
+ *
+ * @file cli_batch.cpp
+ * @brief Implementation of the batch of the CLI, i.e., the line assembly of a script and the execution of its lines
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-21
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "cli_batch.h"
+#include <string.h>
+
+namespace lib
+{
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Constructor
+ *
+ * @param cli the CLI executing the lines
+ * @param lineBuffer buffer the lines fed are assembled in, where they are tokenized as well
+ * @param sizeLineBuffer size of the line buffer, including the null, where a longer line fails with eCLI_LINE_TOO_LONG
+ * @param handler the handler of the result of every line executed, or nullptr for none
+ * @param context the context given to the handler
+ */
+CliBatch::CliBatch( CLI& cli, char lineBuffer[], size_t sizeLineBuffer, ResultHandler handler /* = nullptr */, void* context /* = nullptr */ )
+: m_cli{ cli }
+, m_line{ lineBuffer }
+, m_sizeLine{ sizeLineBuffer }
+, m_handler{ handler }
+, m_context{ context }
+{ }
+
+/**
+ * @brief Start a batch, which clears the summary of the previous one.
+ *
+ * @param isStopOnError true to skip the lines after the first failure
+ */
+void CliBatch::start( bool isStopOnError )
+{
+   m_summary = {};
+   m_length = 0;
+   m_isTooLong = false;
+   m_isStopOnError = isStopOnError;
+}
+
+/**
+ * @brief Feed a chunk of the script, where every line completed by it is executed right away.
+ *
+ * @param data pointer to the chunk, which can end in the middle of a line
+ * @param length length of the chunk
+ */
+void CliBatch::feed( const char* data, size_t length )
+{
+   for ( size_t i = 0; i < length; i++ )
+   {
+      const char c = data[i];
+      if ( c == '\n' )
+      {
+         endLine();
+         continue;
+      }
+
+      if ( c == '\r' )
+      {
+         continue;
+      }
+
+      if ( m_length + 1 < m_sizeLine )
+      {
+         m_line[m_length++] = c;
+      }
+      else
+      {
+         m_isTooLong = true;
+      }
+   }
+}
+
+/**
+ * @brief Execute a line of the script, unless it's blank, a comment, or stopped on error.
+ *
+ * @param line the line, null-terminated, which is tokenized in place
+ * @return ErrorCode the result of CLI::processInput(), or eOK if not executed
+ */
+ErrorCode CliBatch::executeLine( char* line )
+{
+   m_summary.lines++;
+
+   const char* first = line + strspn( line, " \t" );
+   if ( ( *first == '\0' ) || ( *first == '#' ) )
+   {
+      return LibErrorCodes::eOK;
+   }
+
+   if ( isStopped() )
+   {
+      m_summary.skipped++;
+      return LibErrorCodes::eOK;
+   }
+
+   m_summary.executed++;
+   const auto result = m_cli.processInput( line );
+   report( result );
+   return result;
+}
+
+/**
+ * @brief Execute the line fed so far, e.g., the last one of a script without the end of the line.
+ */
+void CliBatch::finish( )
+{
+   if ( ( m_length > 0 ) || m_isTooLong )
+   {
+      endLine();
+   }
+}
+
+/**
+ * @brief Execute a script at once, e.g., one stored in flash, with a line buffer on the stack.
+ *
+ * @param cli the CLI executing the lines
+ * @param script the script, null-terminated, which is not modified
+ * @param isStopOnError true to skip the lines after the first failure
+ * @param handler the handler of the result of every line executed, or nullptr for none
+ * @param context the context given to the handler
+ * @return Summary the summary of the batch
+ */
+CliBatch::Summary CliBatch::run( CLI& cli, const char* script, bool isStopOnError, ResultHandler handler /* = nullptr */, void* context /* = nullptr */ )
+{
+   char line[LINE_SIZE];
+   CliBatch batch{ cli, line, sizeof( line ), handler, context };
+   batch.start( isStopOnError );
+   batch.feed( script, strlen( script ) );
+   batch.finish();
+   return batch.getSummary();
+}
+
+/**
+ * @brief End the line fed so far, which is executed, or fails if it's too long, or is just counted if it's blank.
+ */
+void CliBatch::endLine( )
+{
+   if ( !m_isTooLong )
+   {
+      m_line[m_length] = '\0';
+      (void)executeLine( m_line );
+   }
+   else
+   {
+      m_summary.lines++;
+      if ( isStopped() )
+      {
+         m_summary.skipped++;
+      }
+      else
+      {
+         report( LibErrorCodes::eCLI_LINE_TOO_LONG );
+      }
+   }
+
+   m_length = 0;
+   m_isTooLong = false;
+}
+
+/**
+ * @brief Count the result of a line, and report it to the handler.
+ *
+ * @param result the result of the line
+ */
+void CliBatch::report( ErrorCode result )
+{
+   if ( ( result != LibErrorCodes::eOK ) && ( m_summary.failed++ == 0 ) )
+   {
+      m_summary.firstFailedLine = m_summary.lines;
+      m_summary.firstError = result;
+   }
+
+   if ( m_handler != nullptr )
+   {
+      m_handler( m_context, m_summary.lines, result );
+   }
+}
+} /* namespace lib */
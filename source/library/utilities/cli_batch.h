@@ -0,0 +1,84 @@
+/************************************************************************************************************
+ *
+ * @file cli_batch.h
+ * @brief Batch of the CLI, which executes a multi-line script back to back, e.g., to provision a device.
+ * @details A script is either stored in flash and executed at once with run(), or streamed in chunks with feed(), e.g., as it's received,
+ *          and every line of it is executed with CLI::processInput() as soon as it's complete, without waiting for anything in between.
+ *          A line ends at '\n', where a '\r' before it is ignored, and a blank line or a comment, i.e., a line starting with '#', is skipped.
+ *          The result of every line executed is reported to the result handler along with its line number, so that a failure can be located.
+ *          With stop-on-error, the lines after the first failure are skipped, as they usually depend on it.
+ *
+ *          Usage: start() -> feed() for every chunk, or executeLine() for every line -> finish() -> getSummary()
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-21
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "cli.h"
+#include "error_codes_lib.h"
+#include <stdint.h>
+#include <stddef.h>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+class CliBatch
+{
+public:
+   constexpr static size_t LINE_SIZE = 128;     //!< Longest line of a script executed by run(), including the null
+
+   //!< Alias for the handler of the result of every line executed
+   using ResultHandler = void (*)( void* context, uint32_t lineNumber, ErrorCode result );
+
+   /**
+    * @brief Summary of a batch, e.g., to be reported once it's done.
+    */
+   struct Summary
+   {
+      uint32_t    lines{ 0 };                      //!< Lines seen, including the blank ones and the comments
+      uint32_t    executed{ 0 };
+      uint32_t    failed{ 0 };
+      uint32_t    skipped{ 0 };                    //!< Lines not executed since stopped on error
+      uint32_t    firstFailedLine{ 0 };            //!< 1-based, or 0 if none failed
+      ErrorCode   firstError{ LibErrorCodes::eOK };
+   };
+
+   CliBatch( CLI& cli, char lineBuffer[], size_t sizeLineBuffer, ResultHandler handler = nullptr, void* context = nullptr );
+   ~CliBatch() = default;
+
+   //!< Disable copy and move operations
+   CliBatch( const CliBatch& ) = delete;
+   CliBatch& operator=( const CliBatch& ) = delete;
+   CliBatch( CliBatch&& ) = delete;
+   CliBatch& operator=( CliBatch&& ) = delete;
+
+   void           start          ( bool isStopOnError );
+   void           feed           ( const char* data, size_t length );
+   ErrorCode      executeLine    ( char* line );
+   void           finish         ( );
+
+   bool           isStopped      ( ) const   { return m_isStopOnError && ( m_summary.failed > 0 ); }
+   const Summary& getSummary     ( ) const   { return m_summary; }
+
+   static Summary run            ( CLI& cli, const char* script, bool isStopOnError, ResultHandler handler = nullptr, void* context = nullptr );
+
+private:
+   void           endLine        ( );
+   void           report         ( ErrorCode result );
+
+   CLI&           m_cli;
+   char*          m_line;
+   size_t         m_sizeLine;
+   size_t         m_length{ 0 };             //!< Length of the line being assembled by feed()
+   bool           m_isTooLong{ false };      //!< The line being assembled by feed() doesn't fit, and it fails once complete
+   bool           m_isStopOnError{ false };
+   ResultHandler  m_handler;
+   void*          m_context;
+   Summary        m_summary{};
+};
+} /* namespace lib */
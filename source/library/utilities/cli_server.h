@@ -0,0 +1,306 @@
+/************************************************************************************************************
+ *
+ * @file cli_server.h
+ * @brief CLI server, which serves a few sessions of the CLI concurrently, e.g., the UART and the TCP connections, in a single task.
+ * @details The transports push the bytes received into their sessions and call notifyReceived(), which wakes up the serving task.
+ *          It goes over every session, executes the lines received in the order received, and flushes the output of each session once done with it.
+ *          A line is handed over to the line handler if given, e.g., to submit it to a command executor, or executed with CLI::processInput() otherwise,
+ *          and an error of it is printed on its session.
+ *
+ *          The output of a command is routed with print() to the session which the line came from, as long as it's called in the serving task.
+ *          Called in any other task, e.g., by a command executed by a worker of the command executor, the session is looked up with the session lookup
+ *          if given, e.g., BasicCommandExecutor::getCurrentSession(), and the line is written and flushed under the lock, which the serving task holds
+ *          while serving a session, so that the output of both never interleaves. Without a session, e.g., once it's closed, it's printed with printf, i.e., logged.
+ *
+ *          Usage: initialize() -> addSession() for every session -> run() in the serving task.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "cli.h"
+#include "cli_session.h"
+#include "lockguard.h"
+#include "rtos_concepts.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <atomic>
+
+/************************************************* Types ****************************************************/
+namespace lib
+{
+/**
+ * @brief Default sizes of a CLI server, which an application overrides by deriving from it.
+ */
+struct CliServerConfig
+{
+   constexpr static size_t    MAX_SESSIONS   = 4;
+   constexpr static uint32_t  TIMEOUT_MS     = 1000;    //!< Wait time of the serving task for any input, after which it just checks the sessions again
+};
+
+/**
+ * @brief CLI server class template, see the file description.
+ *
+ * @tparam Lock Type of the lockable satisfying Lockable, e.g., ILockable or a final implementation of it
+ * @tparam Sem Type of the semaphore satisfying CountingSemaphore, e.g., ISemaphore or a final implementation of it
+ * @tparam Port Type providing TaskId and currentTask() of the RTOS, e.g., LoggerPortFreeRTOS
+ * @tparam Config Type providing the sizes, e.g., CliServerConfig
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config = CliServerConfig>
+class BasicCliServer
+{
+public:
+   //!< Alias for the handler of the lines, which returns the error of a line
+   using LineHandler = ErrorCode (*)( char* line );
+
+   //!< Alias for the lookup of the session of a command executed in another task, e.g., BasicCommandExecutor::getCurrentSession()
+   using SessionLookup = CliSession* (*)( );
+
+   BasicCliServer( CLI& cli, Lock& lockable, Sem& semReceived, LineHandler handler = nullptr, SessionLookup lookup = nullptr )
+   : m_cli( cli )
+   , m_lockable( lockable )
+   , m_semReceived( semReceived )
+   , m_handler( handler )
+   , m_lookup( lookup )
+   { }
+
+   ~BasicCliServer()
+   { }
+
+   //!< Disable copy and move operations
+   BasicCliServer( const BasicCliServer& ) = delete;
+   BasicCliServer& operator=( const BasicCliServer& ) = delete;
+   BasicCliServer( BasicCliServer&& ) = delete;
+   BasicCliServer& operator=( BasicCliServer&& ) = delete;
+
+   ErrorCode   initialize        ( );
+   ErrorCode   addSession        ( CliSession& session );
+
+   //!< For the transports, once they've pushed the bytes received
+   void        notifyReceived    ( )         { m_semReceived.put(); }
+   void        notifyReceivedISR ( )         { m_semReceived.putISR(); }
+
+   //!< For the commands
+   void        print             ( const char* format, ... );
+   CliSession* getCurrentSession ( ) const;
+
+   //!< For the serving task
+   void        run               ( );
+   void        runOnce           ( uint32_t timeout_ms );
+
+private:
+   void        serve             ( CliSession& session );
+
+   CLI&                             m_cli;
+   Lock&                            m_lockable;               //!< Guards the output of the sessions, against the commands executed in other tasks
+   Sem&                             m_semReceived;
+   LineHandler                      m_handler;
+   SessionLookup                    m_lookup;
+   CliSession*                      m_sessions[Config::MAX_SESSIONS]{};
+   std::atomic<size_t>              m_numSessions{ 0 };       //!< Published after the session is stored
+   CliSession*                      m_current{ nullptr };     //!< The session of the line being executed, used only by the serving task
+   std::atomic<typename Port::TaskId> m_servingTask{};
+};
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Initialize the CLI server.
+ *
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+ErrorCode BasicCliServer<Lock, Sem, Port, Config>::initialize()
+{
+   const auto result = m_lockable.initialize();
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   //!< A single count is enough, as every session is checked on every wake-up
+   return m_semReceived.initialize( 1, 0 );
+}
+
+/**
+ * @brief Add a session to be served, which stays for good.
+ *
+ * @param session the session
+ * @return ErrorCode eOK, or eCLI_TOO_MANY_SESSIONS
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+ErrorCode BasicCliServer<Lock, Sem, Port, Config>::addSession( CliSession& session )
+{
+   const auto index = m_numSessions.load( std::memory_order_relaxed );
+   if ( index >= Config::MAX_SESSIONS )
+   {
+      return LibErrorCodes::eCLI_TOO_MANY_SESSIONS;
+   }
+
+   m_sessions[index] = &session;
+   m_numSessions.store( index + 1, std::memory_order_release );
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Print a formatted line on the session of the command being executed, which is terminated with "\r\n" as a log message is.
+ * @details Called in another task, the line is flushed right away, as the serving task flushes the session only when it has received.
+ *          It's printed with printf instead, if the session of the command is not found, or it's no longer open.
+ *
+ * @param format the format of printf
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+void BasicCliServer<Lock, Sem, Port, Config>::print( const char* format, ... )
+{
+   va_list args;
+   va_start( args, format );
+
+   const bool isServing = ( Port::currentTask() == m_servingTask.load( std::memory_order_acquire ) );
+   auto* session = getCurrentSession();
+   bool isPrinted = false;
+   if ( isServing )
+   {
+      if ( session != nullptr )
+      {
+         session->printV( format, args );
+         isPrinted = true;
+      }
+   }
+   else if ( session != nullptr )
+   {
+      lib::lock_guard guard( m_lockable );
+      if ( session->getState() == CliSession::eState::OPEN )
+      {
+         session->printV( format, args );
+         session->flush();
+         isPrinted = true;
+      }
+   }
+
+   if ( !isPrinted )
+   {
+      char buffer[CliSession::PRINT_BUFFER_SIZE];
+      (void)vsnprintf( buffer, sizeof( buffer ), format, args );
+      printf( "%s\r\n", buffer );
+   }
+
+   va_end( args );
+}
+
+/**
+ * @brief Get the session of the command being executed.
+ *
+ * @return CliSession* the session, or nullptr if not called by a command, or its session is not found in another task
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+CliSession* BasicCliServer<Lock, Sem, Port, Config>::getCurrentSession() const
+{
+   if ( Port::currentTask() != m_servingTask.load( std::memory_order_acquire ) )
+   {
+      return ( m_lookup != nullptr ) ? m_lookup() : nullptr;
+   }
+   return m_current;
+}
+
+/**
+ * @brief Run the serving task, which never returns.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+void BasicCliServer<Lock, Sem, Port, Config>::run()
+{
+   for ( ;; )
+   {
+      runOnce( Config::TIMEOUT_MS );
+   }
+}
+
+/**
+ * @brief Wait for any input, and serve every session once.
+ *
+ * @param timeout_ms the wait time for any input
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+void BasicCliServer<Lock, Sem, Port, Config>::runOnce( uint32_t timeout_ms )
+{
+   m_servingTask.store( Port::currentTask(), std::memory_order_release );
+
+   //!< Served on timeout as well, e.g., for a session closed without any input
+   (void)m_semReceived.get( timeout_ms );
+
+   const auto count = m_numSessions.load( std::memory_order_acquire );
+   for ( size_t i = 0; i < count; i++ )
+   {
+      serve( *m_sessions[i] );
+   }
+}
+
+/**
+ * @brief Execute the lines received by a session, and flush its output.
+ *
+ * @param session the session
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+void BasicCliServer<Lock, Sem, Port, Config>::serve( CliSession& session )
+{
+   lib::lock_guard guard( m_lockable );
+
+   const auto state = session.getState();
+   if ( state == CliSession::eState::CLOSING )
+   {
+      session.reset();
+      return;
+   }
+
+   if ( state != CliSession::eState::OPEN )
+   {
+      return;
+   }
+
+   //!< Greeted with the prompt, even if the first line is already received
+   bool isOutput = session.takeOpened();
+   if ( isOutput )
+   {
+      session.showPrompt();
+   }
+
+   bool isLine = false;
+   char* line = nullptr;
+   for ( ;; )
+   {
+      auto result = session.getLine( line );
+      if ( result == LibErrorCodes::eCLI_NO_COMMAND )
+      {
+         break;
+      }
+
+      if ( result == LibErrorCodes::eOK )
+      {
+         m_current = &session;
+         result = ( m_handler != nullptr ) ? m_handler( line ) : m_cli.processInput( line );
+         m_current = nullptr;
+      }
+
+      if ( result != LibErrorCodes::eOK )
+      {
+         session.print( "ERROR: 0x%08lx", static_cast<unsigned long>( result ) );
+      }
+      isLine = true;
+   }
+
+   if ( isLine )
+   {
+      session.showPrompt();
+   }
+
+   if ( isOutput || isLine )
+   {
+      session.flush();
+   }
+}
+} /* namespace lib */
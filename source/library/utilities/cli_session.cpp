@@ -0,0 +1,197 @@
+/************************************************************************************************************
+ *
+ * @file cli_session.cpp
+ * @brief Implementation of the session of the CLI, i.e., the line assembly of its input and the formatting of its output
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "cli_session.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace lib
+{
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Constructor
+ *
+ * @param name name of the session, e.g., "uart" or "tcp0"
+ * @param transport the transport the output is sent over
+ * @param rxBuffer buffer of the bytes received, which holds them until the serving task gets to them
+ * @param sizeRxBuffer size of the receive buffer
+ * @param lineBuffer buffer the lines are assembled in
+ * @param sizeLineBuffer size of the line buffer, including the null, where a longer line is truncated
+ * @param prompt the prompt shown when opened and after every line, or nullptr for none, e.g., for the UART shared with the logger
+ */
+CliSession::CliSession( const char* name, ICliTransport& transport, char rxBuffer[], uint32_t sizeRxBuffer, char lineBuffer[], size_t sizeLineBuffer,
+                        const char* prompt /* = nullptr */ )
+: m_name{ name }
+, m_transport{ transport }
+, m_rxBuffer{ rxBuffer, sizeRxBuffer }
+, m_line{ lineBuffer }
+, m_lineAssembler{ static_cast<uint32_t>( sizeLineBuffer - 1 ) }
+, m_prompt{ prompt }
+{ }
+
+/**
+ * @brief Open the session, e.g., once a TCP connection is accepted.
+ *
+ * @return true if opened, or false if it's still open or not yet reset since closed
+ */
+bool CliSession::open( )
+{
+   auto expected = eState::FREE;
+   if ( !m_state.compare_exchange_strong( expected, eState::OPEN, std::memory_order_acq_rel ) )
+   {
+      return false;
+   }
+
+   m_isOpened.store( true, std::memory_order_release );
+   return true;
+}
+
+/**
+ * @brief Close the session, e.g., once the TCP connection is closed, which the serving task resets afterwards.
+ */
+void CliSession::close( )
+{
+   auto expected = eState::OPEN;
+   (void)m_state.compare_exchange_strong( expected, eState::CLOSING, std::memory_order_acq_rel );
+}
+
+/**
+ * @brief Push the bytes received into the receive buffer, as many as fit.
+ * @note This is called by a single task or ISR, i.e., the one receiving for the transport.
+ *
+ * @param data pointer to the bytes received
+ * @param length number of the bytes
+ * @return size_t number of the bytes pushed, which the transport may use to hold back the rest, e.g., with the TCP window
+ */
+size_t CliSession::receive( const char* data, size_t length )
+{
+   if ( getState() != eState::OPEN )
+   {
+      return 0;
+   }
+
+   uint32_t count = 0;
+   m_rxBuffer.pushBulk( data, static_cast<uint32_t>( length ), &count );
+   return count;
+}
+
+/**
+ * @brief Get the next line received, which stays valid until the next call.
+ * @details The line is null-terminated without its end, and the telnet commands and the nulls, e.g., of "\r\0", are left out of it.
+ *          A line longer than the line buffer is truncated, and what fits is delivered once its end is received.
+ *
+ * @param line the line, if eOK or eCLI_LINE_TOO_LONG
+ * @return ErrorCode eOK, eCLI_NO_COMMAND if no full line is received yet, or eCLI_LINE_TOO_LONG along with the line truncated
+ */
+ErrorCode CliSession::getLine( char*& line )
+{
+   char c = 0;
+   while ( m_rxBuffer.pop( c ) == LibErrorCodes::eOK )
+   {
+      if ( m_telnetSkip > 0 )
+      {
+         m_telnetSkip--;
+         continue;
+      }
+
+      if ( static_cast<uint8_t>( c ) == TELNET_IAC )
+      {
+         m_telnetSkip = 2;
+         continue;
+      }
+
+      if ( c == '\0' )
+      {
+         continue;
+      }
+
+      const auto length = m_lineAssembler.getLength();
+      const auto action = m_lineAssembler.put( ( c == '\r' ) || ( c == '\n' ) );
+      if ( action == LineAssembler::eAction::KEEP )
+      {
+         m_line[length] = c;
+      }
+      else if ( action != LineAssembler::eAction::DROP )
+      {
+         m_line[length] = '\0';
+         line = m_line;
+         return ( action == LineAssembler::eAction::END_TRUNCATED ) ? LibErrorCodes::eCLI_LINE_TOO_LONG : LibErrorCodes::eOK;
+      }
+   }
+
+   return LibErrorCodes::eCLI_NO_COMMAND;
+}
+
+/**
+ * @brief Reset a closed session, which frees it to be opened again.
+ * @note This is called by the serving task, once the transport doesn't push any more.
+ */
+void CliSession::reset( )
+{
+   if ( getState() != eState::CLOSING )
+   {
+      return;
+   }
+
+   m_rxBuffer.clear();
+   m_lineAssembler.reset();
+   m_telnetSkip = 0;
+   m_isOpened.store( false, std::memory_order_relaxed );
+   m_state.store( eState::FREE, std::memory_order_release );
+}
+
+/**
+ * @brief Print a formatted line, which is terminated with "\r\n" as a log message is.
+ *
+ * @param format the format of printf
+ */
+void CliSession::print( const char* format, ... )
+{
+   va_list args;
+   va_start( args, format );
+   printV( format, args );
+   va_end( args );
+}
+
+/**
+ * @brief Print a formatted line with a va_list, see print().
+ *
+ * @param format the format of printf
+ * @param args the arguments of the format
+ */
+void CliSession::printV( const char* format, va_list args )
+{
+   char buffer[PRINT_BUFFER_SIZE];
+   const int length = vsnprintf( buffer, sizeof( buffer ) - 2, format, args );
+   if ( length < 0 )
+   {
+      return;
+   }
+
+   size_t count = ( static_cast<size_t>( length ) < ( sizeof( buffer ) - 2 ) ) ? static_cast<size_t>( length ) : ( sizeof( buffer ) - 3 );
+   buffer[count++] = '\r';
+   buffer[count++] = '\n';
+   m_transport.write( buffer, count );
+}
+
+/**
+ * @brief Show the prompt, if the session has one.
+ */
+void CliSession::showPrompt( )
+{
+   if ( m_prompt != nullptr )
+   {
+      m_transport.write( m_prompt, strlen( m_prompt ) );
+   }
+}
+} /* namespace lib */
@@ -0,0 +1,116 @@
+/************************************************************************************************************
+ *
+ * @file cli_session.h
+ * @brief Session of the CLI, i.e., a console connected over a transport, e.g., the UART or a TCP connection.
+ * @details Every session has its own receive buffer and line buffer, so that a few of them can be served concurrently without mixing their input,
+ *          and its own transport, which the output of the commands it executes is routed to.
+ *          The bytes received are pushed by the transport, e.g., in the lwIP thread, and the lines are assembled by the task serving the sessions,
+ *          where a line ends at '\r' or '\n', and an empty one, e.g., the second half of "\r\n", is skipped.
+ *          A line too long is truncated as LineAssembler decides, the same as the input of CLI, and it's delivered as it's kept with eCLI_LINE_TOO_LONG.
+ *          The option negotiation of telnet, i.e., IAC and the two bytes following it, is skipped as well, so that a telnet client can be used as it is.
+ *
+ *          The state is shared by both sides: the transport opens and closes a session, and the serving task resets a closed one,
+ *          after which it's free to be opened again, e.g., for the next TCP connection.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "ring_buffer.h"
+#include "line_assembler.h"
+#include "error_codes_lib.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <atomic>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+/**
+ * @brief Transport of a session, which sends the output of the CLI, e.g., over the UART or a TCP connection.
+ */
+class ICliTransport
+{
+public:
+   ICliTransport() = default;
+   virtual ~ICliTransport() = default;
+
+   //!< Disable copy and move operations
+   ICliTransport( const ICliTransport& ) = delete;
+   ICliTransport& operator=( const ICliTransport& ) = delete;
+   ICliTransport( ICliTransport&& ) = delete;
+   ICliTransport& operator=( ICliTransport&& ) = delete;
+
+   /**
+    * @brief Add the output to the batch, which may hand the batch over once it's full.
+    * @note This is called only by the task serving the sessions.
+    */
+   virtual void write         ( const char* data, size_t length ) = 0;
+
+   /**
+    * @brief Hand the batch over, e.g., start the transmission, which is called once a line is done.
+    */
+   virtual void flush         ( ) = 0;
+};
+
+class CliSession
+{
+public:
+   constexpr static size_t    PRINT_BUFFER_SIZE = 128;      //!< Longest output of print(), which is cut to fit
+   constexpr static uint8_t   TELNET_IAC        = 0xFF;     //!< "Interpret as command" of telnet, followed by the command and the option
+
+   enum class eState : uint8_t
+   {
+      FREE,                //!< Not connected, and ready to be opened
+      OPEN,
+      CLOSING,             //!< Closed by the transport, and not yet reset by the serving task
+   };
+
+   CliSession( const char* name, ICliTransport& transport, char rxBuffer[], uint32_t sizeRxBuffer, char lineBuffer[], size_t sizeLineBuffer,
+               const char* prompt = nullptr );
+   ~CliSession() = default;
+
+   //!< Disable copy and move operations
+   CliSession( const CliSession& ) = delete;
+   CliSession& operator=( const CliSession& ) = delete;
+   CliSession( CliSession&& ) = delete;
+   CliSession& operator=( CliSession&& ) = delete;
+
+   //!< For the transport, on the receiving side
+   bool        open           ( );
+   void        close          ( );
+   size_t      receive        ( const char* data, size_t length );
+   uint32_t    getSpace       ( ) const   { return m_rxBuffer.size() - m_rxBuffer.count(); }
+
+   //!< For the task serving the sessions
+   ErrorCode   getLine        ( char*& line );
+   bool        takeOpened     ( )         { return m_isOpened.exchange( false, std::memory_order_acquire ); }
+   void        reset          ( );
+   void        write          ( const char* data, size_t length )    { m_transport.write( data, length ); }
+   void        print          ( const char* format, ... );
+   void        printV         ( const char* format, va_list args );
+   void        showPrompt     ( );
+   void        flush          ( )         { m_transport.flush(); }
+
+   const char* getName        ( ) const   { return m_name; }
+   eState      getState       ( ) const   { return m_state.load( std::memory_order_acquire ); }
+   RingBuffer<char>& getRxBuffer ( )      { return m_rxBuffer; }     //!< For monitoring, e.g., with RingBufferStats
+
+private:
+   const char*             m_name;
+   ICliTransport&          m_transport;
+   RingBuffer<char>        m_rxBuffer;             //!< Pushed by the transport, and popped by the serving task
+   char*                   m_line;
+   LineAssembler           m_lineAssembler;        //!< Up to the size of the line buffer but the null
+   uint8_t                 m_telnetSkip{ 0 };      //!< Bytes of a telnet command still to be skipped
+   const char*             m_prompt;
+   std::atomic<eState>     m_state{ eState::FREE };
+   std::atomic<bool>       m_isOpened{ false };    //!< Opened since the serving task last checked, e.g., to greet it with the prompt
+};
+} /* namespace lib */
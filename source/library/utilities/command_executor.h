@@ -0,0 +1,538 @@
+/************************************************************************************************************
+ *
+ * @file command_executor.h
+ * @brief Command executor, which runs the CLI commands marked eExecution::ASYNC in a pool of worker tasks, so that the console stays responsive.
+ * @details The task receiving the lines, e.g., the CLI task, hands every line over with submit(), which tokenizes a copy of it right away,
+ *          so that an error, e.g., an unknown command, is reported at once. A command marked eExecution::INLINE is executed then and there,
+ *          while the others are queued as jobs in a fixed number of slots, and executed in the order submitted by the worker tasks calling runWorker().
+ *          A job keeps its status until its slot is taken by another, so that it can be looked up with getJob() or listed with getJobs().
+ *          A queued job is cancelled at once, whereas a running one is only asked to stop, which it sees with isCancelRequested().
+ *          A job keeps the session its line came from, which getCurrentSession() looks up for the job running, e.g., to print on it.
+ *
+ *          Usage: initialize() -> runWorker() in each worker task -> submit() in the CLI task for every line received.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-19
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "lib_common.h"
+#include "cli.h"
+#include "cli_session.h"
+#include "lockguard.h"
+#include "rtos_concepts.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+
+/************************************************* Types ****************************************************/
+namespace lib
+{
+/**
+ * @brief Types shared by every command executor, regardless of its template parameters.
+ */
+class CommandExecutorBase
+{
+public:
+   enum class eJobStatus : uint8_t
+   {
+      FREE,             //!< Never used
+      QUEUED,
+      RUNNING,
+      DONE,
+      CANCELLED,        //!< Cancelled while queued, or stopped on request while running
+      RESERVED,         //!< Taken by a submitter, which is filling it in, and not a job yet
+   };
+
+   /**
+    * @brief Snapshot of a job, e.g., for the 'jobs' command.
+    */
+   struct JobInfo
+   {
+      uint32_t    id{ 0 };
+      eJobStatus  status{ eJobStatus::FREE };
+      char        command[16]{};       //!< The command name, cut to fit
+      uint32_t    submittedMs{ 0 };
+      uint32_t    startedMs{ 0 };
+      uint32_t    finishedMs{ 0 };
+   };
+
+   static const char* getStatusName( eJobStatus status )
+   {
+      static const char* const NAMES[] = { "free", "queued", "running", "done", "cancelled", "reserved" };
+      return NAMES[static_cast<size_t>( status )];
+   }
+};
+
+/**
+ * @brief Default sizes of a command executor, which an application overrides by deriving from it.
+ */
+struct CommandExecutorConfig
+{
+   constexpr static size_t    NUM_JOBS             = 4;       //!< Jobs queued, running or kept for their status
+   constexpr static size_t    LINE_SIZE            = 128;     //!< Longest line of a job, including the null
+   constexpr static uint32_t  WORKER_TIMEOUT_MS    = 1000;    //!< Wait time of a worker task for a job, after which it just waits again
+};
+
+/**
+ * @brief Command executor class template, see the file description.
+ *
+ * @tparam Lock Type of the lockable satisfying Lockable, e.g., ILockable or a final implementation of it
+ * @tparam Sem Type of the semaphore satisfying CountingSemaphore, e.g., ISemaphore or a final implementation of it
+ * @tparam Port Type providing TaskId and currentTask() of the RTOS, e.g., LoggerPortFreeRTOS
+ * @tparam Config Type providing the sizes, e.g., CommandExecutorConfig
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config = CommandExecutorConfig>
+class BasicCommandExecutor : public CommandExecutorBase
+{
+public:
+   BasicCommandExecutor( CLI& cli, Lock& lockable, Sem& semJobQueued )
+   : m_cli( cli )
+   , m_lockable( lockable )
+   , m_semJobQueued( semJobQueued )
+   { }
+
+   ~BasicCommandExecutor()
+   { }
+
+   //!< Disable copy and move operations
+   BasicCommandExecutor( const BasicCommandExecutor& ) = delete;
+   BasicCommandExecutor& operator=( const BasicCommandExecutor& ) = delete;
+   BasicCommandExecutor( BasicCommandExecutor&& ) = delete;
+   BasicCommandExecutor& operator=( BasicCommandExecutor&& ) = delete;
+
+   ErrorCode   initialize        ( );
+
+   //!< For the task receiving the lines
+   ErrorCode   submit            ( const char* line, uint32_t* jobId = nullptr, CliSession* session = nullptr );
+
+   //!< For any task, e.g., the commands listing or cancelling the jobs
+   ErrorCode   cancel            ( uint32_t jobId );
+   ErrorCode   getJob            ( uint32_t jobId, JobInfo& info );
+   size_t      getJobs           ( JobInfo infos[], size_t maxInfos );
+   bool        isCancelRequested ( );
+   CliSession* getCurrentSession ( );
+
+   //!< For the worker tasks
+   void        runWorker         ( );
+   bool        runWorkerOnce     ( uint32_t timeout_ms );
+
+private:
+   struct Job
+   {
+      uint32_t                   id{ 0 };
+      eJobStatus                 status{ eJobStatus::FREE };
+      std::atomic<bool>          cancelRequested{ false };
+      typename Port::TaskId      worker{};
+      const CLI::CommandEntry*   entry{ nullptr };
+      CliSession*                session{ nullptr };        //!< The session the line came from, if any
+      int                        argc{ 0 };
+      char*                      argv[CLI::MAX_ARGS]{};
+      char                       line[Config::LINE_SIZE]{};
+      uint32_t                   submittedMs{ 0 };
+      uint32_t                   startedMs{ 0 };
+      uint32_t                   finishedMs{ 0 };
+   };
+
+   ErrorCode   parse             ( const char* line, char buffer[], char* argv[], int& argc, const CLI::CommandEntry*& entry );
+   Job*        takeSlot          ( );
+   Job*        claimJob          ( );
+   Job*        findJob           ( uint32_t jobId );
+   Job*        findRunning       ( );
+   static void fillInfo          ( const Job& job, JobInfo& info );
+
+   CLI&                 m_cli;
+   Lock&                m_lockable;          //!< Guards the status of the jobs
+   Sem&                 m_semJobQueued;      //!< Counts the jobs queued
+   Job                  m_jobs[Config::NUM_JOBS];
+   uint32_t             m_nextId{ 1 };
+   char                 m_inlineLine[Config::LINE_SIZE]{};     //!< Used only by the task submitting the lines
+};
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Initialize the command executor.
+ *
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+ErrorCode BasicCommandExecutor<Lock, Sem, Port, Config>::initialize()
+{
+   auto result = m_lockable.initialize();
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   return m_semJobQueued.initialize( Config::NUM_JOBS, 0 );
+}
+
+/**
+ * @brief Submit a command line, which is executed inline or queued as a job depending on its command.
+ * @note This must be called by a single task, e.g., the CLI task, as an inline command is parsed in a buffer of the executor.
+ *
+ * @param line the command line, terminated by a null or by the delimiter of the CLI, which is copied so that it can be reused right away
+ * @param jobId the id of the job queued, or 0 if the command is executed inline
+ * @param session the session the line came from, which the job keeps for getCurrentSession()
+ * @return ErrorCode eOK, the error of the tokenization, eCLI_UNKNOWN_COMMAND, eCLI_LINE_TOO_LONG, or eCLI_EXECUTOR_BUSY if every slot is taken by an unfinished job
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+ErrorCode BasicCommandExecutor<Lock, Sem, Port, Config>::submit( const char* line, uint32_t* jobId /* = nullptr */, CliSession* session /* = nullptr */ )
+{
+   if ( jobId != nullptr )
+   {
+      *jobId = 0;
+   }
+
+   char* argv[CLI::MAX_ARGS];
+   int argc = 0;
+   const CLI::CommandEntry* entry = nullptr;
+   auto result = parse( line, m_inlineLine, argv, argc, entry );
+   if ( ( result != LibErrorCodes::eOK ) || ( entry == nullptr ) )
+   {
+      return result;
+   }
+
+   if ( entry->execution == CLI::eExecution::INLINE )
+   {
+      entry->function( argc, argv );
+      return LibErrorCodes::eOK;
+   }
+
+   Job* job = nullptr;
+   {
+      lib::lock_guard guard( m_lockable );
+      job = takeSlot();
+      if ( job == nullptr )
+      {
+         return LibErrorCodes::eCLI_EXECUTOR_BUSY;
+      }
+   }
+
+   //!< The slot is owned by this task until it's queued, and the line is tokenized again in it, as the arguments have to point into it
+   (void)parse( line, job->line, job->argv, job->argc, job->entry );
+   job->session = session;
+   job->cancelRequested.store( false, std::memory_order_relaxed );
+   job->submittedMs = LIB_COMMON_getTickMS();
+   job->startedMs = 0;
+   job->finishedMs = 0;
+   {
+      lib::lock_guard guard( m_lockable );
+      job->id = m_nextId++;
+      m_nextId += ( m_nextId == 0 ) ? 1 : 0;
+      job->status = eJobStatus::QUEUED;
+      if ( jobId != nullptr )
+      {
+         *jobId = job->id;
+      }
+   }
+
+   m_semJobQueued.put();
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Cancel a job, which is done at once if it's queued, or asked to stop if it's running.
+ *
+ * @param jobId the id of the job
+ * @return ErrorCode eOK, eCLI_JOB_NOT_FOUND, or eCLI_JOB_FINISHED
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+ErrorCode BasicCommandExecutor<Lock, Sem, Port, Config>::cancel( uint32_t jobId )
+{
+   lib::lock_guard guard( m_lockable );
+   auto* job = findJob( jobId );
+   if ( job == nullptr )
+   {
+      return LibErrorCodes::eCLI_JOB_NOT_FOUND;
+   }
+
+   if ( job->status == eJobStatus::QUEUED )
+   {
+      //!< The semaphore stays signaled, and the worker taking it just finds no job
+      job->status = eJobStatus::CANCELLED;
+      job->finishedMs = LIB_COMMON_getTickMS();
+      return LibErrorCodes::eOK;
+   }
+
+   if ( job->status == eJobStatus::RUNNING )
+   {
+      job->cancelRequested.store( true, std::memory_order_relaxed );
+      return LibErrorCodes::eOK;
+   }
+
+   return LibErrorCodes::eCLI_JOB_FINISHED;
+}
+
+/**
+ * @brief Get the snapshot of a job.
+ *
+ * @param jobId the id of the job
+ * @param info the snapshot
+ * @return ErrorCode eOK, or eCLI_JOB_NOT_FOUND if its slot is taken by another already
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+ErrorCode BasicCommandExecutor<Lock, Sem, Port, Config>::getJob( uint32_t jobId, JobInfo& info )
+{
+   lib::lock_guard guard( m_lockable );
+   const auto* job = findJob( jobId );
+   if ( job == nullptr )
+   {
+      return LibErrorCodes::eCLI_JOB_NOT_FOUND;
+   }
+
+   fillInfo( *job, info );
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Get the snapshots of all jobs ever used, in the order of the slots.
+ * @details They're copied under the lock, so that the caller can print them without holding back the workers.
+ *
+ * @param infos array of the snapshots
+ * @param maxInfos size of the array
+ * @return size_t the number of the snapshots
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+size_t BasicCommandExecutor<Lock, Sem, Port, Config>::getJobs( JobInfo infos[], size_t maxInfos )
+{
+   lib::lock_guard guard( m_lockable );
+   size_t count = 0;
+   for ( const auto& job : m_jobs )
+   {
+      const bool isJob = ( job.status != eJobStatus::FREE ) && ( job.status != eJobStatus::RESERVED );
+      if ( isJob && ( count < maxInfos ) )
+      {
+         fillInfo( job, infos[count++] );
+      }
+   }
+   return count;
+}
+
+/**
+ * @brief Check if the job running in the calling task is asked to stop, which a long running command polls to return early.
+ *
+ * @return true if asked to stop, or false if not, including when the calling task is not a worker running a job
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+bool BasicCommandExecutor<Lock, Sem, Port, Config>::isCancelRequested()
+{
+   lib::lock_guard guard( m_lockable );
+   const auto* job = findRunning();
+   return ( job != nullptr ) ? job->cancelRequested.load( std::memory_order_relaxed ) : false;
+}
+
+/**
+ * @brief Get the session of the job running in the calling task, e.g., to print the output of a command on it.
+ *
+ * @return CliSession* the session given to submit(), or nullptr if none, including when the calling task is not a worker running a job
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+CliSession* BasicCommandExecutor<Lock, Sem, Port, Config>::getCurrentSession()
+{
+   lib::lock_guard guard( m_lockable );
+   const auto* job = findRunning();
+   return ( job != nullptr ) ? job->session : nullptr;
+}
+
+/**
+ * @brief Run a worker task, which never returns.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+void BasicCommandExecutor<Lock, Sem, Port, Config>::runWorker()
+{
+   for(;;)
+   {
+      (void)runWorkerOnce( Config::WORKER_TIMEOUT_MS );
+   }
+}
+
+/**
+ * @brief Wait for a job, and execute it, which is a single round of a worker task.
+ *
+ * @param timeout_ms wait time for a job
+ * @return true if a job is executed
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+bool BasicCommandExecutor<Lock, Sem, Port, Config>::runWorkerOnce( uint32_t timeout_ms )
+{
+   if ( m_semJobQueued.get( timeout_ms ) != LibErrorCodes::eOK )
+   {
+      return false;
+   }
+
+   Job* job = nullptr;
+   {
+      lib::lock_guard guard( m_lockable );
+      job = claimJob();
+      if ( job == nullptr )
+      {
+         return false;     //!< Cancelled while queued
+      }
+   }
+
+   job->entry->function( job->argc, job->argv );
+
+   lib::lock_guard guard( m_lockable );
+   job->status = job->cancelRequested.load( std::memory_order_relaxed ) ? eJobStatus::CANCELLED : eJobStatus::DONE;
+   job->finishedMs = LIB_COMMON_getTickMS();
+   return true;
+}
+
+/**
+ * @brief Copy a line into a buffer, tokenize it there, and find its command.
+ *
+ * @param line the command line
+ * @param buffer the buffer, of Config::LINE_SIZE
+ * @param argv the arguments, of CLI::MAX_ARGS
+ * @param argc the number of the arguments
+ * @param entry the command, or nullptr for an empty line
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+ErrorCode BasicCommandExecutor<Lock, Sem, Port, Config>::parse( const char* line, char buffer[], char* argv[], int& argc, const CLI::CommandEntry*& entry )
+{
+   entry = nullptr;
+   argc = 0;
+
+   const size_t length = strnlen( line, Config::LINE_SIZE );
+   if ( length == Config::LINE_SIZE )
+   {
+      return LibErrorCodes::eCLI_LINE_TOO_LONG;
+   }
+   memcpy( buffer, line, length + 1 );
+
+   const auto result = m_cli.tokenize( buffer, argv, CLI::MAX_ARGS, argc );
+   if ( ( result != LibErrorCodes::eOK ) || ( argc == 0 ) )
+   {
+      return result;
+   }
+
+   entry = m_cli.findCommand( argv[0] );
+   return ( entry != nullptr ) ? LibErrorCodes::eOK : LibErrorCodes::eCLI_UNKNOWN_COMMAND;
+}
+
+/**
+ * @brief Take a slot for a new job, i.e., one never used, or the one finished first.
+ * @note This must be called under the lock.
+ *
+ * @return Job* the slot, marked RESERVED until it's queued so that no other takes it nor lists it, or nullptr if every slot has an unfinished job
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+auto BasicCommandExecutor<Lock, Sem, Port, Config>::takeSlot() -> Job*
+{
+   Job* slot = nullptr;
+   for ( auto& job : m_jobs )
+   {
+      if ( job.status == eJobStatus::FREE )
+      {
+         slot = &job;
+         break;
+      }
+
+      const bool isFinished = ( job.status == eJobStatus::DONE ) || ( job.status == eJobStatus::CANCELLED );
+      if ( isFinished && ( ( slot == nullptr ) || ( static_cast<int32_t>( job.id - slot->id ) < 0 ) ) )
+      {
+         slot = &job;
+      }
+   }
+
+   if ( slot != nullptr )
+   {
+      slot->id = 0;
+      slot->status = eJobStatus::RESERVED;
+      slot->worker = typename Port::TaskId{};
+   }
+   return slot;
+}
+
+/**
+ * @brief Claim the job queued first for the calling worker task.
+ * @note This must be called under the lock.
+ *
+ * @return Job* the job, marked RUNNING, or nullptr if there's none
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+auto BasicCommandExecutor<Lock, Sem, Port, Config>::claimJob() -> Job*
+{
+   Job* oldest = nullptr;
+   for ( auto& job : m_jobs )
+   {
+      if ( ( job.status == eJobStatus::QUEUED ) && ( ( oldest == nullptr ) || ( static_cast<int32_t>( job.id - oldest->id ) < 0 ) ) )
+      {
+         oldest = &job;
+      }
+   }
+
+   if ( oldest != nullptr )
+   {
+      oldest->status = eJobStatus::RUNNING;
+      oldest->worker = Port::currentTask();
+      oldest->startedMs = LIB_COMMON_getTickMS();
+   }
+   return oldest;
+}
+
+/**
+ * @brief Find a job by its id.
+ * @note This must be called under the lock.
+ *
+ * @param jobId the id of the job
+ * @return Job* the job, or nullptr if not found
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+auto BasicCommandExecutor<Lock, Sem, Port, Config>::findJob( uint32_t jobId ) -> Job*
+{
+   for ( auto& job : m_jobs )
+   {
+      if ( ( jobId != 0 ) && ( job.id == jobId ) && ( job.status != eJobStatus::FREE ) && ( job.status != eJobStatus::RESERVED ) )
+      {
+         return &job;
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * @brief Find the job running in the calling task.
+ * @note This must be called under the lock.
+ *
+ * @return Job* the job, or nullptr if the calling task is not a worker running a job
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+auto BasicCommandExecutor<Lock, Sem, Port, Config>::findRunning() -> Job*
+{
+   const auto self = Port::currentTask();
+   for ( auto& job : m_jobs )
+   {
+      if ( ( job.status == eJobStatus::RUNNING ) && ( job.worker == self ) )
+      {
+         return &job;
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * @brief Fill the snapshot of a job.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Port, typename Config>
+void BasicCommandExecutor<Lock, Sem, Port, Config>::fillInfo( const Job& job, JobInfo& info )
+{
+   info.id = job.id;
+   info.status = job.status;
+   info.submittedMs = job.submittedMs;
+   info.startedMs = job.startedMs;
+   info.finishedMs = job.finishedMs;
+
+   const char* name = ( job.argc > 0 ) ? job.argv[0] : "";
+   const size_t length = strnlen( name, sizeof( info.command ) - 1 );
+   memcpy( info.command, name, length );
+   info.command[length] = '\0';
+}
+} /* namespace lib */
@@ -0,0 +1,67 @@
+/************************************************************************************************************
+ *
+ * @file counter_extender.h
+ * @brief Extension of a free-running 32-bit counter, e.g., the DWT cycle counter, to 64 bits.
+ * @details The extender keeps the number of half periods the counter has gone through, whose lowest bit must match the top bit of the counter.
+ *          Once they don't match, the counter has entered the next half period, and the number is advanced with a compare-and-swap,
+ *          so that it's safe to be called from tasks and interrupt handlers concurrently without locking.
+ *          It must be called at least once every half period, e.g., every 11.9 s for a 180 MHz cycle counter,
+ *          which the logger takes care of by reading it every time its task wakes up.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-14
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include <stdint.h>
+#include <atomic>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+class CounterExtender
+{
+public:
+   CounterExtender() = default;
+   ~CounterExtender() = default;
+
+   //!< Disable copy and move operations
+   CounterExtender( const CounterExtender& ) = delete;
+   CounterExtender& operator=( const CounterExtender& ) = delete;
+   CounterExtender( CounterExtender&& ) = delete;
+   CounterExtender& operator=( CounterExtender&& ) = delete;
+
+   /**
+    * @brief Read the counter, extended to 64 bits.
+    * @note The counter is read after the number of half periods is loaded, so that the counter is never behind it.
+    *
+    * @tparam Read type of the function reading the counter
+    * @param read the function reading the counter
+    * @return uint64_t the extended counter
+    */
+   template<typename Read>
+   uint64_t extend( Read read )
+   {
+      auto halves = m_halves.load( std::memory_order_acquire );
+      const uint32_t counter = read();
+
+      if ( ( halves & 1u ) != ( counter >> 31 ) )
+      {
+         //!< It's advanced by either this or the one preempted here, but only once
+         auto expected = halves;
+         (void)m_halves.compare_exchange_strong( expected, halves + 1, std::memory_order_acq_rel );
+         halves++;
+      }
+
+      return ( static_cast<uint64_t>( halves >> 1 ) << 32 ) | counter;
+   }
+
+private:
+   std::atomic<uint32_t> m_halves{ 0 };    //!< The number of half periods of the counter
+};
+} /* namespace lib */
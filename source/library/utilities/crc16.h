@@ -0,0 +1,97 @@
+/************************************************************************************************************
+ *
+ * @file crc16.h
+ * @brief CRC-16/CCITT-FALSE calculation
+ * @details Polynomial 0x1021, initial value 0xFFFF, no reflection and no final XOR.
+ *          The lookup table is generated at compile time so that it can be placed in flash.
+ *          As there is no final XOR, running the CRC over the data followed by its CRC in big-endian order yields zero,
+ *          which allows a receiver to check a frame in a single pass without knowing where the data ends.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-06
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+class Crc16
+{
+public:
+   constexpr static uint16_t INITIAL_VALUE = 0xFFFF;
+   constexpr static uint16_t POLYNOMIAL    = 0x1021;
+
+   /**
+    * @brief Update the CRC with a single byte.
+    *
+    * @param crc the current CRC value
+    * @param data the byte to be added
+    * @return uint16_t the updated CRC value
+    */
+   static constexpr uint16_t update( uint16_t crc, uint8_t data );
+
+   /**
+    * @brief Update the CRC with a block of bytes.
+    *
+    * @param crc the current CRC value
+    * @param data pointer to the bytes to be added
+    * @param length number of bytes
+    * @return uint16_t the updated CRC value
+    */
+   static constexpr uint16_t update( uint16_t crc, const uint8_t* data, size_t length )
+   {
+      for ( size_t i = 0; i < length; i++ )
+      {
+         crc = update( crc, data[i] );
+      }
+      return crc;
+   }
+
+   /**
+    * @brief Calculate the CRC of a block of bytes.
+    */
+   static constexpr uint16_t calculate( const uint8_t* data, size_t length )
+   {
+      return update( INITIAL_VALUE, data, length );
+   }
+
+private:
+   struct Table
+   {
+      uint16_t entries[256];
+   };
+
+   static constexpr Table makeTable( )
+   {
+      Table table{};
+      for ( uint32_t i = 0; i < 256; i++ )
+      {
+         uint16_t crc = static_cast<uint16_t>( i << 8 );
+         for ( int bit = 0; bit < 8; bit++ )
+         {
+            crc = ( crc & 0x8000 ) ? static_cast<uint16_t>( ( crc << 1 ) ^ POLYNOMIAL ) : static_cast<uint16_t>( crc << 1 );
+         }
+         table.entries[i] = crc;
+      }
+      return table;
+   }
+
+   static const Table TABLE;
+};
+
+//!< Defined out of the class as the table can only be generated once the class is complete.
+inline constexpr Crc16::Table Crc16::TABLE = Crc16::makeTable();
+
+constexpr uint16_t Crc16::update( uint16_t crc, uint8_t data )
+{
+   return static_cast<uint16_t>( ( crc << 8 ) ^ TABLE.entries[ ( ( crc >> 8 ) ^ data ) & 0xFF ] );
+}
+} /* namespace lib */
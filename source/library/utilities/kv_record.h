@@ -0,0 +1,258 @@
+/************************************************************************************************************
+ *
+ * @file kv_record.h
+ * @brief Binary log records of structured events, i.e., an event name with typed key/value fields.
+ * @details A record carries the ID of its event name, the time stamp and the values of its fields, but neither the name nor the keys,
+ *          which the host tool, i.e., scripts/log_decoder.py, finds in the LOG_KV calls in the source code, just as it does the format strings.
+ *          It shares the header with lib::LogRecord, so that the logger stores and frames both the same way,
+ *          and the byte following the time stamp, i.e., the number of arguments of a LogRecord which can never reach it, tells them apart.
+ *          The values are encoded as compactly as possible, so that an event is a fraction of the size of the same message formatted.
+ *
+ *          Record layout, in little-endian order:
+ *             | event ID (4) | time stamp in µs (4) | MARKER (1) | field 1 | ... | field N |
+ *          Every field, in the order of the keys, starts with its type, eFieldType, followed by its value:
+ *             - UINT                     : LEB128 varint
+ *             - SINT                     : LEB128 varint of the zigzag encoding, so that small negative numbers are short as well
+ *             - FLOAT, DOUBLE            : 4 and 8 bytes of the IEEE 754 representation
+ *             - FALSE, TRUE              : none
+ *             - STRING                   : length as a varint followed by the characters without the terminating null
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-15
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "log_record.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <bit>
+#include <type_traits>
+
+/************************************************* Types ****************************************************/
+namespace lib
+{
+/**
+ * @brief Encoder of the structured log records.
+ */
+class KvRecord
+{
+public:
+   constexpr static size_t  MAX_RECORD_SIZE   = LogRecord::MAX_RECORD_SIZE;     //!< Fields that don't fit in a record are dropped
+   constexpr static size_t  MAX_STRING_LENGTH = LogRecord::MAX_STRING_LENGTH;   //!< Longer strings are truncated
+   constexpr static size_t  HEADER_SIZE       = LogRecord::HEADER_SIZE;
+   constexpr static uint8_t MARKER            = 0xFF;
+   constexpr static size_t  MAX_VARINT_LENGTH = 10;
+
+   static_assert( ( MAX_RECORD_SIZE - HEADER_SIZE ) / 2 < MARKER, "A LogRecord must never have as many arguments as the marker" );
+   static_assert( MAX_STRING_LENGTH < 0x80, "The length of a string must fit in a single byte of a varint" );
+
+   enum class eFieldType : uint8_t
+   {
+      UINT = 1,
+      SINT,
+      FLOAT,
+      DOUBLE,
+      FALSE,
+      TRUE,
+      STRING
+   };
+
+   /**
+    * @brief Get the ID of an event name, which is the 32-bit FNV-1a hash of its characters as the ID of a format string.
+    */
+   consteval static uint32_t eventId( const char* event )
+   {
+      return LogRecord::formatId( event );
+   }
+
+   /**
+    * @brief Encode a structured log record into a buffer.
+    * @note The keys are taken only to pair them with the values in the call, and they're never encoded.
+    *
+    * @param buffer the buffer to write the record in
+    * @param sizeBuffer size of the buffer, which must be at least HEADER_SIZE
+    * @param id ID of the event name
+    * @param timestampUs time stamp of the record in microseconds, i.e., the lower 32 bits of LIB_COMMON_getTimestampUs()
+    * @param fields the keys and the values of the fields, in turn
+    * @return size_t length of the record, or 0 if the buffer is too small even for the header
+    */
+   template<typename... Fields>
+   static size_t encode( uint8_t buffer[], size_t sizeBuffer, uint32_t id, uint32_t timestampUs, Fields... fields )
+   {
+      static_assert( ( sizeof...( Fields ) % 2 ) == 0, "Every key must be followed by its value" );
+
+      if ( sizeBuffer < HEADER_SIZE )
+      {
+         return 0;
+      }
+
+      Writer writer{ buffer, sizeBuffer, HEADER_SIZE };
+      writer.putFields( fields... );
+
+      putWord( buffer, id );
+      putWord( buffer + 4, timestampUs );
+      buffer[8] = MARKER;
+      return writer.position;
+   }
+
+   /**
+    * @brief Encode a value as a LEB128 varint, i.e., 7 bits per byte from the lowest, with the top bit set on all bytes but the last.
+    *
+    * @param buffer the buffer to write the varint in, which must have MAX_VARINT_LENGTH bytes at least
+    * @param value the value
+    * @return size_t length of the varint
+    */
+   static size_t putVarint( uint8_t buffer[], uint64_t value )
+   {
+      size_t length = 0;
+      while ( value >= 0x80 )
+      {
+         buffer[length++] = static_cast<uint8_t>( value | 0x80 );
+         value >>= 7;
+      }
+      buffer[length++] = static_cast<uint8_t>( value );
+      return length;
+   }
+
+   /**
+    * @brief Map a signed value to an unsigned one, where the ones closer to zero are the smaller, i.e., 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+    */
+   constexpr static uint64_t zigzag( int64_t value )
+   {
+      return ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 );
+   }
+
+private:
+   struct Writer
+   {
+      uint8_t* buffer;
+      size_t   size;
+      size_t   position;
+      bool     full{ false };    //!< Once a field doesn't fit, the following ones are dropped as well to keep their order
+
+      void putFields( )
+      { }
+
+      template<typename Key, typename Value, typename... Rest>
+      void putFields( Key key, Value value, Rest... rest )
+      {
+         static_assert( std::is_convertible_v<Key, const char*>, "A key must be a string literal" );
+         (void)key;
+
+         (void)putField( value );
+         putFields( rest... );
+      }
+
+      bool putVarint( eFieldType type, uint64_t value )
+      {
+         uint8_t varint[MAX_VARINT_LENGTH];
+         const size_t length = KvRecord::putVarint( varint, value );
+         return putBytes( type, varint, length );
+      }
+
+      bool putBytes( eFieldType type, const uint8_t* bytes, size_t length )
+      {
+         full = full || ( ( size - position ) < ( 1 + length ) );
+         if ( full )
+         {
+            return false;
+         }
+
+         buffer[position++] = static_cast<uint8_t>( type );
+         if ( length > 0 )
+         {
+            memcpy( &buffer[position], bytes, length );
+            position += length;
+         }
+         return true;
+      }
+
+      bool putString( const char* string )
+      {
+         if ( string == nullptr )
+         {
+            string = "(null)";
+         }
+
+         //!< The string is truncated to the space left rather than dropped, as its head is usually the informative part
+         full = full || ( ( size - position ) < 2 );
+         if ( full )
+         {
+            return false;
+         }
+         const size_t maxLength = ( MAX_STRING_LENGTH < ( size - position - 2 ) ) ? MAX_STRING_LENGTH : ( size - position - 2 );
+         size_t length = 0;
+         while ( ( length < maxLength ) && ( string[length] != '\0' ) )
+         {
+            length++;
+         }
+
+         //!< A single byte of the length is enough as MAX_STRING_LENGTH is less than 0x80
+         buffer[position++] = static_cast<uint8_t>( eFieldType::STRING );
+         buffer[position++] = static_cast<uint8_t>( length );
+         memcpy( &buffer[position], string, length );
+         position += length;
+         return true;
+      }
+
+      template<typename T>
+      bool putField( T value )
+      {
+         if constexpr ( std::is_same_v<T, const char*> || std::is_same_v<T, char*> )
+         {
+            return putString( value );
+         }
+         else if constexpr ( std::is_same_v<T, bool> )
+         {
+            return putBytes( value ? eFieldType::TRUE : eFieldType::FALSE, nullptr, 0 );
+         }
+         else if constexpr ( std::is_enum_v<T> )
+         {
+            return putField( static_cast<std::underlying_type_t<T>>( value ) );
+         }
+         else if constexpr ( std::is_same_v<T, float> )
+         {
+            const auto bits = std::bit_cast<uint32_t>( value );
+            const uint8_t bytes[] = { static_cast<uint8_t>( bits ), static_cast<uint8_t>( bits >> 8 ), static_cast<uint8_t>( bits >> 16 ), static_cast<uint8_t>( bits >> 24 ) };
+            return putBytes( eFieldType::FLOAT, bytes, sizeof( bytes ) );
+         }
+         else if constexpr ( std::is_floating_point_v<T> )
+         {
+            const auto bits = std::bit_cast<uint64_t>( static_cast<double>( value ) );
+            uint8_t bytes[8];
+            for ( size_t i = 0; i < sizeof( bytes ); i++ )
+            {
+               bytes[i] = static_cast<uint8_t>( bits >> ( 8 * i ) );
+            }
+            return putBytes( eFieldType::DOUBLE, bytes, sizeof( bytes ) );
+         }
+         else if constexpr ( std::is_integral_v<T> && std::is_signed_v<T> )
+         {
+            return putVarint( eFieldType::SINT, zigzag( static_cast<int64_t>( value ) ) );
+         }
+         else if constexpr ( std::is_integral_v<T> )
+         {
+            return putVarint( eFieldType::UINT, static_cast<uint64_t>( value ) );
+         }
+         else
+         {
+            static_assert( sizeof( T ) == 0, "The type cannot be logged as a field" );
+            return false;
+         }
+      }
+   };
+
+   static void putWord( uint8_t* buffer, uint32_t value )
+   {
+      buffer[0] = static_cast<uint8_t>( value );
+      buffer[1] = static_cast<uint8_t>( value >> 8 );
+      buffer[2] = static_cast<uint8_t>( value >> 16 );
+      buffer[3] = static_cast<uint8_t>( value >> 24 );
+   }
+};
+} /* namespace lib */
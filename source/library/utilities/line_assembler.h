@@ -0,0 +1,87 @@
+/************************************************************************************************************
+ *
+ * @file line_assembler.h
+ * @brief Policy of assembling the characters received into lines, which every input of the CLI follows.
+ * @details The assembler only decides what is done with a character, and the caller keeps the characters, e.g., in a ring buffer or a line buffer.
+ *          A line longer than the maximum, or one the caller has no room for, is truncated: what is kept so far is delivered with a mark,
+ *          and the rest of it is dropped until its end, even if there's room again by then, so that the rest is never taken as a line of its own.
+ *          An empty line, e.g., the second half of "\r\n", is skipped.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-25
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include <stdint.h>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+class LineAssembler
+{
+public:
+   /**
+    * @brief What the caller does with the character given to put().
+    */
+   enum class eAction : uint8_t
+   {
+      DROP,                //!< Not a part of any line, e.g., the rest of a line truncated, or the end of an empty one
+      KEEP,                //!< Kept as the next character of the line, at getLength() - 1
+      END,                 //!< The end of the line, which is delivered as it is
+      END_TRUNCATED,       //!< The end of the line, which is delivered truncated, e.g., with eCLI_LINE_TOO_LONG
+   };
+
+   explicit LineAssembler( uint32_t maxLength ) : m_maxLength{ maxLength } { }
+
+   /**
+    * @brief Take the next character of the input.
+    *
+    * @param isEnd true if the character ends a line, e.g., '\r' or '\n'
+    * @param hasRoom false if the caller can't keep one more character, e.g., as the ring buffer is full
+    * @return eAction what is done with the character
+    */
+   eAction put( bool isEnd, bool hasRoom = true )
+   {
+      if ( isEnd )
+      {
+         if ( ( m_length == 0 ) && !m_isTruncated )
+         {
+            return eAction::DROP;
+         }
+
+         const auto action = m_isTruncated ? eAction::END_TRUNCATED : eAction::END;
+         reset();
+         return action;
+      }
+
+      if ( m_isTruncated )
+      {
+         return eAction::DROP;
+      }
+
+      if ( ( m_length >= m_maxLength ) || !hasRoom )
+      {
+         m_isTruncated = true;
+         return eAction::DROP;
+      }
+
+      m_length++;
+      return eAction::KEEP;
+   }
+
+   //!< Start over, e.g., for a new connection
+   void        reset          ( )         { m_length = 0; m_isTruncated = false; }
+
+   uint32_t    getLength      ( ) const   { return m_length; }      //!< Characters kept of the line being assembled
+   uint32_t    getMaxLength   ( ) const   { return m_maxLength; }
+
+private:
+   uint32_t    m_maxLength;
+   uint32_t    m_length{ 0 };
+   bool        m_isTruncated{ false };
+};
+} /* namespace lib */
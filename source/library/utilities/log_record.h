@@ -0,0 +1,203 @@
+/************************************************************************************************************
+ *
+ * @file log_record.h
+ * @brief Binary log records for the deferred logging, i.e., the formatting is deferred to the host.
+ * @details Instead of formatting a message on the target, a record carries the ID of its format string, the time stamp and the raw arguments.
+ *          The ID is the FNV-1a hash of the format string, calculated at compile time, so the string itself is neither sent nor needed on the target.
+ *          The host tool, i.e., scripts/log_decoder.py, finds the format strings in the source code, hashes them the same way, and formats the records.
+ *
+ *          Record layout, in little-endian order:
+ *             | format ID (4) | time stamp in µs (4) | number of arguments (1) | argument 1 | ... | argument N |
+ *          Every argument starts with its type, eArgType, followed by its value:
+ *             - INT32, UINT32            : 4 bytes
+ *             - INT64, UINT64, DOUBLE    : 8 bytes, where DOUBLE is the IEEE 754 representation
+ *             - POINTER                  : 8 bytes regardless of the pointer size of the target
+ *             - STRING                   : length (1) followed by the characters without the terminating null
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-11
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <bit>
+#include <type_traits>
+
+/************************************************* Types ****************************************************/
+namespace lib
+{
+/**
+ * @brief Encoder of the binary log records.
+ */
+class LogRecord
+{
+public:
+   constexpr static size_t MAX_RECORD_SIZE   = 64;    //!< Arguments that don't fit in a record are dropped
+   constexpr static size_t MAX_STRING_LENGTH = 32;    //!< Longer strings are truncated
+   constexpr static size_t HEADER_SIZE       = 9;
+
+   enum class eArgType : uint8_t
+   {
+      INT32 = 1,
+      UINT32,
+      INT64,
+      UINT64,
+      DOUBLE,
+      STRING,
+      POINTER
+   };
+
+   /**
+    * @brief Get the ID of a format string, which is the 32-bit FNV-1a hash of its characters.
+    * @note It's consteval so that no hashing is ever done on the target.
+    *
+    * @param format the format string
+    * @return uint32_t ID of the format string
+    */
+   consteval static uint32_t formatId( const char* format )
+   {
+      uint32_t hash = 2166136261u;
+      while ( *format != '\0' )
+      {
+         hash ^= static_cast<uint8_t>( *format++ );
+         hash *= 16777619u;
+      }
+      return hash;
+   }
+
+   /**
+    * @brief Encode a log record into a buffer.
+    *
+    * @param buffer the buffer to write the record in
+    * @param sizeBuffer size of the buffer, which must be at least HEADER_SIZE
+    * @param id ID of the format string
+    * @param timestampUs time stamp of the record in microseconds, i.e., the lower 32 bits of LIB_COMMON_getTimestampUs()
+    * @param args the arguments of the format string
+    * @return size_t length of the record, or 0 if the buffer is too small even for the header
+    */
+   template<typename... Args>
+   static size_t encode( uint8_t buffer[], size_t sizeBuffer, uint32_t id, uint32_t timestampUs, Args... args )
+   {
+      if ( sizeBuffer < HEADER_SIZE )
+      {
+         return 0;
+      }
+
+      Writer writer{ buffer, sizeBuffer, HEADER_SIZE };
+      uint8_t numArgs = 0;
+      ( ( numArgs += writer.putArg( args ) ? 1 : 0 ), ... );
+
+      putWord( buffer, id );
+      putWord( buffer + 4, timestampUs );
+      buffer[8] = numArgs;
+      return writer.position;
+   }
+
+private:
+   struct Writer
+   {
+      uint8_t* buffer;
+      size_t   size;
+      size_t   position;
+      bool     full{ false };    //!< Once an argument doesn't fit, the following ones are dropped as well to keep their order
+
+      bool reserve( size_t length )
+      {
+         full = full || ( ( size - position ) < length );
+         return !full;
+      }
+
+      bool putValue( eArgType type, uint64_t value, size_t length )
+      {
+         if ( !reserve( 1 + length ) )
+         {
+            return false;
+         }
+
+         buffer[position++] = static_cast<uint8_t>( type );
+         for ( size_t i = 0; i < length; i++ )
+         {
+            buffer[position++] = static_cast<uint8_t>( value >> ( 8 * i ) );
+         }
+         return true;
+      }
+
+      bool putString( const char* string )
+      {
+         if ( string == nullptr )
+         {
+            string = "(null)";
+         }
+
+         //!< The string is truncated to the space left rather than dropped, as its head is usually the informative part
+         if ( !reserve( 2 ) )
+         {
+            return false;
+         }
+         const size_t maxLength = ( MAX_STRING_LENGTH < ( size - position - 2 ) ) ? MAX_STRING_LENGTH : ( size - position - 2 );
+         size_t length = 0;
+         while ( ( length < maxLength ) && ( string[length] != '\0' ) )
+         {
+            length++;
+         }
+
+         buffer[position++] = static_cast<uint8_t>( eArgType::STRING );
+         buffer[position++] = static_cast<uint8_t>( length );
+         memcpy( &buffer[position], string, length );
+         position += length;
+         return true;
+      }
+
+      template<typename T>
+      bool putArg( T value )
+      {
+         if constexpr ( std::is_same_v<T, const char*> || std::is_same_v<T, char*> )
+         {
+            return putString( value );
+         }
+         else if constexpr ( std::is_pointer_v<T> || std::is_null_pointer_v<T> )
+         {
+            return putValue( eArgType::POINTER, reinterpret_cast<uintptr_t>( value ), 8 );
+         }
+         else if constexpr ( std::is_enum_v<T> )
+         {
+            return putArg( static_cast<std::underlying_type_t<T>>( value ) );
+         }
+         else if constexpr ( std::is_floating_point_v<T> )
+         {
+            return putValue( eArgType::DOUBLE, std::bit_cast<uint64_t>( static_cast<double>( value ) ), 8 );
+         }
+         else if constexpr ( std::is_integral_v<T> && ( sizeof( T ) <= 4 ) )
+         {
+            //!< Promoted as printf does, and sign-extended for the signed ones
+            return std::is_signed_v<T> ? putValue( eArgType::INT32, static_cast<uint32_t>( static_cast<int32_t>( value ) ), 4 )
+                                       : putValue( eArgType::UINT32, static_cast<uint32_t>( value ), 4 );
+         }
+         else if constexpr ( std::is_integral_v<T> && ( sizeof( T ) == 8 ) )
+         {
+            return std::is_signed_v<T> ? putValue( eArgType::INT64, static_cast<uint64_t>( value ), 8 )
+                                       : putValue( eArgType::UINT64, static_cast<uint64_t>( value ), 8 );
+         }
+         else
+         {
+            static_assert( sizeof( T ) == 0, "The type cannot be logged" );
+            return false;
+         }
+      }
+   };
+
+   static void putWord( uint8_t* buffer, uint32_t value )
+   {
+      buffer[0] = static_cast<uint8_t>( value );
+      buffer[1] = static_cast<uint8_t>( value >> 8 );
+      buffer[2] = static_cast<uint8_t>( value >> 16 );
+      buffer[3] = static_cast<uint8_t>( value >> 24 );
+   }
+};
+} /* namespace lib */
@@ -0,0 +1,106 @@
+/************************************************************************************************************
+ *
+ * @file log_sink.cpp
+ * @brief Implementation of the level filter and the rate limit common to the log sinks
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-16
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "log_sink.h"
+#include <stdio.h>
+
+namespace lib
+{
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Constructor
+ *
+ * @param name name of the sink, which is shown in the report of the messages dropped
+ * @param config the filter and the rate limit
+ */
+LogSink::LogSink( const char* name, const Config& config )
+: m_name{ name }
+, m_maxLevel{ ( config.maxLevel > LOG_LEVEL_TRACE ) ? static_cast<uint8_t>( LOG_LEVEL_TRACE ) : config.maxLevel }
+, m_bytesPerSecond{ config.bytesPerSecond }
+, m_burst{ static_cast<uint64_t>( ( config.burstBytes != 0 ) ? config.burstBytes : config.bytesPerSecond ) * 1000 }
+, m_tokens{ m_burst }
+{ }
+
+/**
+ * @brief Offer a message to the sink, which writes it unless it's filtered out by its level or dropped by the rate limit.
+ * @details The report of the messages dropped is written right before the message, and it's not charged to the rate limit.
+ *
+ * @param level level of the message, or LOG_LEVEL_NONE for the one not logged at a level
+ * @param data pointer to the message
+ * @param length length of the message
+ * @param nowMs the current tick in milliseconds
+ * @return true if the message is written
+ */
+bool LogSink::offer( uint8_t level, const uint8_t* data, size_t length, uint32_t nowMs )
+{
+   if ( level > getMaxLevel() )
+   {
+      return false;
+   }
+
+   if ( !takeTokens( length, nowMs ) )
+   {
+      m_droppedToReport++;
+      m_dropped.fetch_add( 1, std::memory_order_relaxed );
+      return false;
+   }
+
+   if ( m_droppedToReport > 0 )
+   {
+      char report[MAX_REPORT_LENGTH];
+      const int count = snprintf( report, sizeof( report ), "LOGGER: %lu messages dropped by %s\r\n", static_cast<unsigned long>( m_droppedToReport ), m_name );
+      if ( count > 0 )
+      {
+         write( reinterpret_cast<const uint8_t*>( report ), ( static_cast<size_t>( count ) < sizeof( report ) ) ? static_cast<size_t>( count ) : ( sizeof( report ) - 1 ) );
+      }
+      m_droppedToReport = 0;
+   }
+
+   write( data, length );
+   return true;
+}
+
+/**
+ * @brief Take the tokens for a message from the bucket, which is refilled by the time elapsed since the last call.
+ *
+ * @param length length of the message
+ * @param nowMs the current tick in milliseconds
+ * @return true if there are enough tokens, or there's no limit
+ */
+bool LogSink::takeTokens( size_t length, uint32_t nowMs )
+{
+   if ( m_bytesPerSecond == 0 )
+   {
+      return true;
+   }
+
+   if ( m_isRefilled )
+   {
+      //!< The difference is taken, so that the wrap-around of the tick doesn't matter
+      const uint64_t refill = static_cast<uint64_t>( nowMs - m_lastRefillMs ) * m_bytesPerSecond;
+      m_tokens = ( ( m_burst - m_tokens ) < refill ) ? m_burst : ( m_tokens + refill );
+   }
+   m_lastRefillMs = nowMs;
+   m_isRefilled = true;
+
+   //!< A message longer than the burst would never fit, so it needs the bucket full instead
+   const uint64_t needed = static_cast<uint64_t>( length ) * 1000;
+   const uint64_t cost = ( needed < m_burst ) ? needed : m_burst;
+   if ( m_tokens < cost )
+   {
+      return false;
+   }
+   m_tokens -= cost;
+   return true;
+}
+} /* namespace lib */
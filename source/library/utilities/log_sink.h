@@ -0,0 +1,207 @@
+/************************************************************************************************************
+ *
+ * @file log_sink.h
+ * @brief Destinations of the log messages, which the logging task fans every message out to.
+ * @details A sink is given the messages one by one as they're drained from the staging buffers, already formatted or framed,
+ *          and it filters them by their levels and limits the rate of the bytes on its own, so that a slow sink, e.g., the UART,
+ *          drops what it can't keep up with instead of holding back the faster ones, e.g., the network.
+ *          The messages dropped by a sink are reported on it with a line, right before the next message it accepts.
+ *          A sink batches the messages as it sees fit on write(), and hands the batch over on flush(), which is called once there is no more message for now.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-16
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "lib_common.h"
+#include "retained_log.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+class LogSink
+{
+public:
+   constexpr static size_t MAX_REPORT_LENGTH = 64;      //!< The "N messages dropped by <sink>" line
+
+   /**
+    * @brief Filter and rate limit of a sink.
+    */
+   struct Config
+   {
+      uint8_t  maxLevel{ LOG_LEVEL_TRACE };     //!< Messages above this level are filtered out, but those of LOGGING and printf, LOG_LEVEL_NONE, are never
+      uint32_t bytesPerSecond{ 0 };             //!< The rate the bytes are refilled at, or 0 for no limit
+      uint32_t burstBytes{ 0 };                 //!< The bytes that can be sent at once, or 0 for a second worth of them, where a longer message needs all of them
+   };
+
+   LogSink( const char* name, const Config& config );
+   virtual ~LogSink() = default;
+
+   //!< Disable copy and move operations
+   LogSink( const LogSink& ) = delete;
+   LogSink& operator=( const LogSink& ) = delete;
+   LogSink( LogSink&& ) = delete;
+   LogSink& operator=( LogSink&& ) = delete;
+
+   bool        offer          ( uint8_t level, const uint8_t* data, size_t length, uint32_t nowMs );
+
+   /**
+    * @brief Add a message to the batch, which may hand the batch over once it's full.
+    */
+   virtual void write         ( const uint8_t* data, size_t length ) = 0;
+
+   /**
+    * @brief Hand the batch over, e.g., start the transmission, unless the sink holds it back on purpose, which it tells with isPending().
+    */
+   virtual void flush         ( ) = 0;
+
+   /**
+    * @brief Check if the sink holds any data to be flushed later, for which the logging task has to wake up without any new message.
+    */
+   virtual bool isPending     ( ) const { return false; }
+
+   void        setMaxLevel    ( uint8_t level )    { m_maxLevel.store( ( level > LOG_LEVEL_TRACE ) ? LOG_LEVEL_TRACE : level, std::memory_order_relaxed ); }
+   uint8_t     getMaxLevel    ( ) const            { return m_maxLevel.load( std::memory_order_relaxed ); }
+   const char* getName        ( ) const            { return m_name; }
+   uint32_t    getDropped     ( ) const            { return m_dropped.load( std::memory_order_relaxed ); }
+
+private:
+   bool        takeTokens     ( size_t length, uint32_t nowMs );
+
+   const char*             m_name;
+   std::atomic<uint8_t>    m_maxLevel;             //!< Set by any task, e.g., the CLI
+   const uint32_t          m_bytesPerSecond;
+   const uint64_t          m_burst;                //!< In thousandths of a byte, as are the tokens, so that no fraction is lost on refilling
+   uint64_t                m_tokens;
+   uint32_t                m_lastRefillMs{ 0 };
+   bool                    m_isRefilled{ false };
+   uint32_t                m_droppedToReport{ 0 };
+   std::atomic<uint32_t>   m_dropped{ 0 };         //!< The total number of messages dropped by the rate limit
+};
+
+/**
+ * @brief Sink writing the messages to a serial device, double-buffered so that one buffer is filled while the other is being transmitted.
+ * @details The buffers are sent in place with sendOwned(), and a buffer is filled again only after its transmission is complete,
+ *          which the device tells by releasing it, e.g., from notifySendComplete() of lib::BasicSerialDevice.
+ *          If the transmission isn't complete within SEND_TIMEOUT_MS, the other buffer is still owned by the device, so the device isn't armed again,
+ *          and every buffer filled until the completion arrives is dropped and counted, rather than written under a live transfer.
+ *
+ * @tparam Device type of the serial device, e.g., lib::BasicSerialDevice, whose sendOwned() takes the release function and its context
+ * @tparam BufferSize size of each of the buffers
+ */
+template<typename Device, size_t BufferSize>
+class SerialLogSink final : public LogSink
+{
+public:
+   constexpr static uint32_t SEND_TIMEOUT_MS = 2000;
+
+   SerialLogSink( const char* name, const Config& config, Device& device )
+   : LogSink{ name, config }
+   , m_device{ device }
+   { }
+
+   /**
+    * @brief Copy the message into the buffer being filled, which is handed over every time it gets full.
+    */
+   void write( const uint8_t* data, size_t length ) override
+   {
+      while ( length > 0 )
+      {
+         const size_t count = ( length < ( BufferSize - m_count ) ) ? length : ( BufferSize - m_count );
+         memcpy( &m_buffers[m_fill][m_count], data, count );
+         m_count += count;
+         data += count;
+         length -= count;
+
+         if ( m_count == BufferSize )
+         {
+            flush();
+         }
+      }
+   }
+
+   /**
+    * @brief Hand the buffer being filled over, once the transmission of the other is complete.
+    */
+   void flush( ) override
+   {
+      if ( m_count == 0 )
+      {
+         return;
+      }
+
+      if ( m_isSending )
+      {
+         (void)m_device.waitSendComplete( SEND_TIMEOUT_MS );
+         m_isSending = false;
+      }
+
+      //!< The other buffer is still being transmitted after the timeout, so this one is dropped not to stall the other sinks
+      if ( m_isInFlight.load( std::memory_order_acquire ) )
+      {
+         m_droppedBuffers.fetch_add( 1, std::memory_order_relaxed );
+         m_count = 0;
+         return;
+      }
+
+      m_isInFlight.store( true, std::memory_order_relaxed );
+      m_isSending = ( m_device.sendOwned( m_buffers[m_fill], m_count, onReleased, this ) == LibErrorCodes::eOK );
+      if ( !m_isSending )
+      {
+         m_isInFlight.store( false, std::memory_order_relaxed );
+         m_droppedBuffers.fetch_add( 1, std::memory_order_relaxed );
+      }
+      m_fill ^= 1;
+      m_count = 0;
+   }
+
+   uint32_t    getDroppedBuffers ( ) const   { return m_droppedBuffers.load( std::memory_order_relaxed ); }
+
+private:
+   //!< Called by the device once the transmission is complete, e.g., in the interrupt context
+   static void onReleased( const uint8_t* data, void* context )
+   {
+      PARAM_NOT_USED( data );
+      static_cast<SerialLogSink*>( context )->m_isInFlight.store( false, std::memory_order_release );
+   }
+
+   Device&                 m_device;
+   uint8_t                 m_buffers[2][BufferSize];
+   size_t                  m_fill{ 0 };               //!< Index of the buffer being filled
+   size_t                  m_count{ 0 };              //!< The number of bytes in the buffer being filled
+   bool                    m_isSending{ false };      //!< Whether the device is armed with the other buffer, and not yet waited for
+   std::atomic<bool>       m_isInFlight{ false };     //!< Whether the other buffer is owned by the device, until it's released
+   std::atomic<uint32_t>   m_droppedBuffers{ 0 };     //!< Buffers dropped, as they couldn't be handed over
+};
+
+/**
+ * @brief Sink mirroring the messages into the retained log, so that the last ones before a reset are sent on the next boot.
+ */
+class RetainedLogSink final : public LogSink
+{
+public:
+   RetainedLogSink( const char* name, const Config& config, RetainedLog& retainedLog )
+   : LogSink{ name, config }
+   , m_retainedLog{ retainedLog }
+   { }
+
+   void write( const uint8_t* data, size_t length ) override
+   {
+      (void)m_retainedLog.append( data, length );
+   }
+
+   void flush( ) override
+   { }
+
+private:
+   RetainedLog& m_retainedLog;
+};
+} /* namespace lib */
@@ -0,0 +1,868 @@
+/************************************************************************************************************
+ *
+ * @file logger.h
+ * @brief Asynchronous logger, which takes the log messages from the tasks without blocking them, and fans them out to the sinks in its own task.
+ * @details Every task registered with registerTask() gets a lock-free staging buffer of its own, so that the tasks logging never block each other,
+ *          and the others share a staging buffer under the lock. The logging task merges the staging buffers by the time stamp of their entries.
+ *          A message is admitted to a staging buffer as a whole or not at all, and what happens when it doesn't fit is set by the overflow policy;
+ *          the messages dropped are counted, and reported with a "N messages dropped" line right before the next message admitted, i.e., where they were lost.
+ *          Every message drained is offered to the sinks, each of which filters the messages by the level they're tagged with, and limits its own rate,
+ *          so that a slow one never holds back the others.
+ *          Binary records, i.e., those of USE_DEFERRED_LOGGER and LOG_KV, are stored raw in the staging buffers, and framed with COBS and CRC16 on the way out,
+ *          so that the callers don't pay for it and scripts/log_decoder.py can tell them apart from any text written with printf.
+ *
+ *          The logger is a template over its policies, which are resolved at compile time:
+ *             - Lock and Sem, the lockable and the semaphore as in BasicSerialDevice, e.g., LockableFreeRTOS and Semaphore_FreeRTOS
+ *             - Sink, the type of the sinks, i.e., LogSink for any mix of them, or a final one, whose calls need no virtual dispatch, for a single kind
+ *             - Port, the hooks of the RTOS, e.g., LoggerPortFreeRTOS, which provides:
+ *                  TaskId, currentTask(), isInsideInterrupt(), delay( ms ) and getLevel(), i.e., the level the calling task tags its messages with
+ *             - Config, the sizes and the timeouts, e.g., LoggerConfig or a struct derived from it overriding some of them
+ *
+ *          Usage: initialize() -> registerTask() in each task, addSink() for each sink -> run() in the logging task,
+ *                 while write() and writeRecord() are called by the tasks logging, e.g., from _write() and LIB_COMMON_writeLogRecord().
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "lib_common.h"
+#include "lockguard.h"
+#include "rtos_concepts.h"
+#include "ring_buffer.h"
+#include "frame_codec.h"
+#include "log_record.h"
+#include "log_sink.h"
+#include "retained_log.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+
+/************************************************* Types ****************************************************/
+namespace lib
+{
+/**
+ * @brief Types and constants shared by every logger, regardless of its template parameters.
+ */
+class LoggerBase
+{
+public:
+   /**
+    * @brief What a producer does when its message doesn't fit in its staging buffer.
+    */
+   enum class eOverflowPolicy
+   {
+      BLOCK,            //!< Wait until the logging task makes room for it
+      DROP_NEWEST,      //!< Drop the message, which never blocks the producer
+      DROP_OLDEST,      //!< Have the logging task discard the oldest messages instead of sending them, and wait until they're gone
+   };
+
+   constexpr static size_t ENTRY_HEADER_SIZE  = 8;     //!< The time stamp (4), the type (1), the level (1) and the length (2) of an entry in a staging buffer
+   constexpr static size_t MAX_ENTRY_LENGTH   = UINT16_MAX;
+   constexpr static size_t MAX_DROPPED_LENGTH = 40;    //!< The "N messages dropped" line
+   constexpr static size_t REPORTED_OVERHEAD  = 2 * ENTRY_HEADER_SIZE + sizeof( uint32_t );   //!< An entry along with the report of the messages dropped before it
+   constexpr static size_t FRAME_SIZE         = FrameEncoder::maxEncodedSize( LogRecord::MAX_RECORD_SIZE ) + 1;   //!< A record framed, with the extra delimiter
+
+protected:
+   enum class eEntryType : uint8_t
+   {
+      TEXT,
+      RECORD,
+      DROPPED,          //!< The number of messages dropped before the next entry
+   };
+
+   /**
+    * @brief A staging buffer, which has a single producer, i.e., its task or the tasks serialized by the lock, and the logging task as its consumer.
+    * @details Every entry is the header followed by the data, and the header of the entry being drained is kept on the consumer side.
+    */
+   template<typename TaskId>
+   struct StagingBuffer
+   {
+      StagingBuffer( uint8_t* buffer, uint32_t size )
+      : ring{ buffer, size }
+      { }
+
+      RingBuffer<uint8_t>     ring;
+      TaskId                  owner{};               //!< Published by the number of the tasks registered
+      std::atomic<uint32_t>   dropped{ 0 };          //!< The number of messages dropped since the last report, counted by both sides
+      std::atomic<bool>       discardRequested{ false };   //!< Set by the producer under DROP_OLDEST
+
+      //!< Used only by the logging task
+      bool                    hasEntry{ false };
+      uint32_t                timestampUs{ 0 };
+      eEntryType              type{ eEntryType::TEXT };
+      uint8_t                 level{ LOG_LEVEL_NONE };
+      size_t                  remaining{ 0 };        //!< The number of bytes of the entry yet to be drained
+   };
+
+   template<typename TaskId, size_t Size>
+   struct StagingStorage : StagingBuffer<TaskId>
+   {
+      StagingStorage()
+      : StagingBuffer<TaskId>{ storage, Size }
+      { }
+
+      uint8_t storage[Size];
+   };
+};
+
+/**
+ * @brief Default sizes and timeouts of a logger, which an application overrides by deriving from it.
+ */
+struct LoggerConfig
+{
+   constexpr static size_t                      NUM_STAGING_BUFFERS  = 4;       //!< Staging buffers for the tasks registered with registerTask()
+   constexpr static size_t                      STAGING_BUFFER_SIZE  = 256;     //!< Size of every staging buffer for a registered task
+   constexpr static size_t                      SHARED_BUFFER_SIZE   = 512;     //!< Size of the staging buffer shared by the tasks not registered
+   constexpr static size_t                      MAX_SINKS            = 4;
+   constexpr static LoggerBase::eOverflowPolicy OVERFLOW_POLICY      = LoggerBase::eOverflowPolicy::DROP_NEWEST;
+   constexpr static uint32_t                    TIMEOUT_MS           = 10000;   //!< Less than the half period of the cycle counter, which has to be read at least that often
+   constexpr static uint32_t                    PENDING_TIMEOUT_MS   = 10;      //!< Wait time of the logging task while a sink holds data back
+   constexpr static uint32_t                    BLOCK_TIMEOUT_MS     = 1000;    //!< A producer waits for space no longer than this, so that a stalled sink can't hang it for good
+};
+
+/**
+ * @brief Logger class template, see the file description.
+ *
+ * @tparam Lock Type of the lockable satisfying Lockable, e.g., ILockable or a final implementation of it
+ * @tparam Sem Type of the semaphore satisfying CountingSemaphore, e.g., ISemaphore or a final implementation of it
+ * @tparam Sink Type of the sinks, i.e., LogSink or a class derived from it
+ * @tparam Port Type providing the hooks of the RTOS, e.g., LoggerPortFreeRTOS
+ * @tparam Config Type providing the sizes and the timeouts, e.g., LoggerConfig
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config = LoggerConfig>
+class BasicLogger : public LoggerBase
+{
+public:
+   static_assert( std::is_base_of_v<LogSink, Sink>, "A sink must be derived from LogSink" );
+   static_assert( Config::STAGING_BUFFER_SIZE >= REPORTED_OVERHEAD + LogRecord::MAX_RECORD_SIZE, "A staging buffer must be able to hold a record and its report" );
+   static_assert( Config::SHARED_BUFFER_SIZE >= REPORTED_OVERHEAD + LogRecord::MAX_RECORD_SIZE, "A staging buffer must be able to hold a record and its report" );
+
+   //!< The largest entry drained
+   constexpr static size_t ENTRY_BUFFER_SIZE = std::max( { Config::SHARED_BUFFER_SIZE, Config::STAGING_BUFFER_SIZE, FRAME_SIZE, MAX_DROPPED_LENGTH } );
+
+   BasicLogger( Lock& lockable, Sem& semLogAvailable )
+   : m_lockable( lockable )
+   , m_semLogAvailable( semLogAvailable )
+   { }
+
+   ~BasicLogger()
+   { }
+
+   //!< Disable copy and move operations
+   BasicLogger( const BasicLogger& ) = delete;
+   BasicLogger& operator=( const BasicLogger& ) = delete;
+   BasicLogger( BasicLogger&& ) = delete;
+   BasicLogger& operator=( BasicLogger&& ) = delete;
+
+   ErrorCode   initialize     ( );
+   bool        registerTask   ( );
+   bool        addSink        ( Sink& sink );
+
+   //!< For the tasks logging
+   void        write          ( const uint8_t* data, size_t length );
+   void        writeRecord    ( const uint8_t* record, size_t length );
+
+   //!< For the logging task
+   void        run            ( );
+   void        runOnce        ( );
+   void        sendRecovered  ( RetainedLog& retainedLog, LogSink& sink );
+
+   //!< For the fault handlers
+   void        saveOnCrash    ( LogSink& sink, const char* reason );
+
+private:
+   using Staging = StagingBuffer<typename Port::TaskId>;
+
+   void        pushLog           ( eEntryType type, const uint8_t* data, size_t length );
+   bool        admitEntry        ( Staging& staging, Lock* lockable, eEntryType type, uint8_t level, const uint8_t* data, size_t length );
+   bool        tryPush           ( Staging& staging, Lock* lockable, eEntryType type, uint8_t level, const uint8_t* data, size_t length );
+   bool        pushReported      ( Staging& staging, eEntryType type, uint8_t level, const uint8_t* data, size_t length );
+   bool        pushEntry         ( Staging& staging, eEntryType type, uint8_t level, const uint8_t* data, size_t length );
+   Staging*    findStagingBuffer ( );
+   Staging*    findOldestEntry   ( );
+   bool        loadHeader        ( Staging& staging );
+   void        discardOldest     ( Staging& staging );
+   bool        drainEntry        ( Staging& staging, uint8_t buffer[], size_t& length );
+   size_t      popEntry          ( uint8_t buffer[], uint8_t& level );
+   bool        dispatch          ( );
+
+   Lock&                                                                   m_lockable;          //!< Guards the shared staging buffer and the registration
+   Sem&                                                                    m_semLogAvailable;   //!< Signals the logging task
+   StagingStorage<typename Port::TaskId, Config::SHARED_BUFFER_SIZE>       m_sharedBuffer;      //!< Guarded by the lock, as it has multiple producers
+   StagingStorage<typename Port::TaskId, Config::STAGING_BUFFER_SIZE>      m_taskBuffers[Config::NUM_STAGING_BUFFERS];   //!< Lock-free, as each has its own task as the producer
+   std::atomic<size_t>                                                     m_numRegistered{ 0 };
+   Sink*                                                                   m_sinks[Config::MAX_SINKS]{};    //!< Only added, and published by m_numSinks
+   std::atomic<size_t>                                                     m_numSinks{ 0 };
+
+   uint8_t                                                                 m_recordBuffer[LogRecord::MAX_RECORD_SIZE];   //!< A record popped from a staging buffer to be framed
+   uint8_t                                                                 m_entryBuffer[ENTRY_BUFFER_SIZE];   //!< An entry drained as a whole, to be offered to every sink
+   uint8_t                                                                 m_crashBuffer[ENTRY_BUFFER_SIZE];   //!< The staging buffers are drained into this on a crash, as the entry buffer may be in use
+   Staging*                                                                m_current{ nullptr };   //!< The staging buffer whose entry is being drained, which is finished before any other
+
+   bool                                                                    m_isInitialized{ false };
+   bool                                                                    m_isPending{ false };   //!< Whether any sink holds data back
+   bool                                                                    m_isSaving{ false };
+};
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Initialize the logger, before which every message is dropped.
+ *
+ * @return ErrorCode
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+ErrorCode BasicLogger<Lock, Sem, Sink, Port, Config>::initialize()
+{
+   if ( m_isInitialized )
+   {
+      return LibErrorCodes::eOK;
+   }
+
+   auto result = m_lockable.initialize();
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   //!< It works as a counting semaphore
+   result = m_semLogAvailable.initialize( Config::SHARED_BUFFER_SIZE, 0 );
+   if ( result != LibErrorCodes::eOK )
+   {
+      return result;
+   }
+
+   m_isInitialized = true;
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Register the calling task for a staging buffer of its own.
+ * @details Once registered, the task logs without taking the lock, so it never blocks or is blocked by any other task logging.
+ *          A task not registered, or registered when all staging buffers are taken, logs through the shared staging buffer.
+ * @note This must be called in the task itself, after initialize().
+ *
+ * @return true if the task has its own staging buffer
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::registerTask()
+{
+   const auto self = Port::currentTask();
+
+   lib::lock_guard guard( m_lockable );
+   const auto count = m_numRegistered.load( std::memory_order_relaxed );
+   for ( size_t i = 0; i < count; i++ )
+   {
+      if ( m_taskBuffers[i].owner == self )
+      {
+         return true;
+      }
+   }
+
+   if ( count == Config::NUM_STAGING_BUFFERS )
+   {
+      return false;
+   }
+
+   m_taskBuffers[count].owner = self;
+   m_numRegistered.store( count + 1, std::memory_order_release );
+   return true;
+}
+
+/**
+ * @brief Add a sink, which every message logged from now on is offered to, e.g., the network once it's up.
+ * @note A sink can't be removed, so it must live as long as the logger.
+ *
+ * @param sink the sink
+ * @return true if added, or false if there are Config::MAX_SINKS already
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::addSink( Sink& sink )
+{
+   lib::lock_guard guard( m_lockable );
+   const auto count = m_numSinks.load( std::memory_order_relaxed );
+   if ( count == Config::MAX_SINKS )
+   {
+      return false;
+   }
+
+   m_sinks[count] = &sink;
+   m_numSinks.store( count + 1, std::memory_order_release );
+   m_semLogAvailable.put();     //!< It may hold data back already
+   return true;
+}
+
+/**
+ * @brief Write text to the staging buffer of the calling task, e.g., what printf writes.
+ *
+ * @param data pointer to the text, which doesn't have to be terminated by a null
+ * @param length length of the text
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::write( const uint8_t* data, size_t length )
+{
+   if ( length > 0 )
+   {
+      pushLog( eEntryType::TEXT, data, length );
+   }
+}
+
+/**
+ * @brief Write a binary log record to the staging buffer of the calling task.
+ * @details The record is stored raw, and framed later by the logging task.
+ *
+ * @param record pointer to the record
+ * @param length length of the record
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::writeRecord( const uint8_t* record, size_t length )
+{
+   if ( ( length == 0 ) || ( length > LogRecord::MAX_RECORD_SIZE ) )
+   {
+      return;
+   }
+
+   pushLog( eEntryType::RECORD, record, length );
+}
+
+/**
+ * @brief Run the logging task, which never returns.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::run()
+{
+   for(;;)
+   {
+      runOnce();
+   }
+}
+
+/**
+ * @brief Wait for the messages, and fan them out to the sinks, which is a single round of the logging task.
+ * @details Each sink batches the messages on its own, e.g., the UART fills one buffer while the other is being transmitted in the interrupt context,
+ *          so the logging task waits for a transmission only when the next buffer is full, not to pop and frame the data.
+ *          While a sink holds data back, e.g., to fill a datagram, the task wakes up every PENDING_TIMEOUT_MS to let it flush the data.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::runOnce()
+{
+   /* NOTE: It's possible that the it can try to pop more data once it gets signaled, but it shouldn't matter;
+            on the next round, it will just check again if there's more data available,
+            and if there's none, which means it popped all available data, it can just wait for next signal.*/
+   const bool isSignaled = ( m_semLogAvailable.get( m_isPending ? Config::PENDING_TIMEOUT_MS : Config::TIMEOUT_MS ) == LibErrorCodes::eOK ) || m_isPending;
+
+   //!< Read on every wake-up, even without any log, so that the wrap-around of the cycle counter is never missed
+   (void)LIB_COMMON_getTimestampUs();
+
+   if ( isSignaled )
+   {
+      m_isPending = dispatch();
+   }
+}
+
+/**
+ * @brief Send the logs recovered from the retained log, which are left by the previous run, before any other.
+ * @details The retained log is made empty if it doesn't hold a valid one, e.g., after a power-on.
+ *          The records are popped as many as fit in the entry buffer, and written to the sink, bypassing its filter and rate limit.
+ * @note This must be called in the logging task before run().
+ *
+ * @param retainedLog the retained log
+ * @param sink the sink, e.g., the UART
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::sendRecovered( RetainedLog& retainedLog, LogSink& sink )
+{
+   if ( !retainedLog.isValid() )
+   {
+      retainedLog.reset();
+      return;
+   }
+
+   if ( retainedLog.used() == 0 )
+   {
+      return;
+   }
+
+   static const char BEGIN[] = "\r\nLOGGER: ---- recovered from the last run ----\r\n";
+   static const char END[]   = "LOGGER: ---- end of the recovered logs ----\r\n";
+   sink.write( reinterpret_cast<const uint8_t*>( BEGIN ), sizeof( BEGIN ) - 1 );
+
+   size_t count = 0;
+   for (;;)
+   {
+      size_t length = 0;
+      const auto result = retainedLog.pop( &m_entryBuffer[count], ENTRY_BUFFER_SIZE - count, length );
+      count += length;
+
+      if ( ( result == LibErrorCodes::eRETAINED_LOG_EMPTY ) || ( ( result == LibErrorCodes::eRETAINED_LOG_TOO_LONG ) && ( count == 0 ) ) )
+      {
+         break;
+      }
+
+      if ( result == LibErrorCodes::eRETAINED_LOG_TOO_LONG )
+      {
+         sink.write( m_entryBuffer, count );
+         count = 0;
+      }
+   }
+
+   if ( count )
+   {
+      sink.write( m_entryBuffer, count );
+   }
+   sink.write( reinterpret_cast<const uint8_t*>( END ), sizeof( END ) - 1 );
+   sink.flush();
+}
+
+/**
+ * @brief Save the logs left in the staging buffers, along with the reason, to a sink on a crash, e.g., the retained log.
+ * @details This is called from the fault handlers, where nothing else runs any more, so the staging buffers are drained right here.
+ *          The entry being drained by the logging task, if it's the one crashed, may be lost, but the others are saved as a whole.
+ *
+ * @param sink the sink, e.g., a RetainedLogSink, whose logs are sent first on the next boot
+ * @param reason what happened, e.g., "hard fault"
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::saveOnCrash( LogSink& sink, const char* reason )
+{
+   if ( m_isSaving )
+   {
+      return;
+   }
+   m_isSaving = true;
+
+   uint8_t level = LOG_LEVEL_NONE;
+   size_t length = 0;
+   while ( ( length = popEntry( m_crashBuffer, level ) ) > 0 )
+   {
+      (void)sink.offer( level, m_crashBuffer, length, 0 );
+   }
+
+   static const char PREFIX[] = "LOGGER: crashed - ";
+   length = sizeof( PREFIX ) - 1;
+   memcpy( m_crashBuffer, PREFIX, length );
+   while ( ( reason != nullptr ) && ( *reason != '\0' ) && ( length < ( sizeof( m_crashBuffer ) - 2 ) ) )
+   {
+      m_crashBuffer[length++] = static_cast<uint8_t>( *reason++ );
+   }
+   m_crashBuffer[length++] = '\r';
+   m_crashBuffer[length++] = '\n';
+   sink.write( m_crashBuffer, length );
+   sink.flush();
+}
+
+/**
+ * @brief Push log data to the staging buffer of the calling task.
+ * @details A registered task pushes the data to its own staging buffer without locking,
+ *          while the others push the data to the shared staging buffer under the lock, which is taken only for each try, not while waiting for space.
+ *          A semaphore is released to notify the logging task regardless, as it may have the oldest messages to discard.
+ *          It's dropped in the interrupt context, where the task interrupted would end up with a second producer.
+ *
+ * @param type type of the log data
+ * @param data pointer to the log data
+ * @param length length of the log data
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::pushLog( eEntryType type, const uint8_t* data, size_t length )
+{
+   if ( !m_isInitialized || Port::isInsideInterrupt() )
+   {
+      return;
+   }
+
+   const auto level = Port::getLevel();
+   auto* staging = findStagingBuffer();
+   if ( staging != nullptr )
+   {
+      (void)admitEntry( *staging, nullptr, type, level, data, length );
+   }
+   else
+   {
+      (void)admitEntry( m_sharedBuffer, &m_lockable, type, level, data, length );
+   }
+
+   m_semLogAvailable.put();
+}
+
+/**
+ * @brief Admit an entry to a staging buffer, following the overflow policy if it doesn't fit.
+ * @details A message longer than the staging buffer could ever hold is cut to its capacity, as it would never be admitted otherwise,
+ *          where the capacity leaves room for the report of the messages dropped before it, which is pushed along with it.
+ *          The lock, if any, is released while waiting for space, so that the other producers, registerTask() and addSink() aren't held up.
+ *
+ * @param staging the staging buffer
+ * @param lockable the lock guarding the staging buffer, or nullptr if it has a single producer
+ * @param type type of the log data
+ * @param level level the log data is tagged with
+ * @param data pointer to the log data
+ * @param length length of the log data
+ * @return true if the entry is admitted, or false if it's dropped
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::admitEntry( Staging& staging, Lock* lockable, eEntryType type, uint8_t level, const uint8_t* data,
+                                                            size_t length )
+{
+   const size_t capacity = staging.ring.size() - REPORTED_OVERHEAD;
+   length = ( length < capacity ) ? length : capacity;
+   length = ( length < MAX_ENTRY_LENGTH ) ? length : MAX_ENTRY_LENGTH;
+
+   if ( tryPush( staging, lockable, type, level, data, length ) )
+   {
+      return true;
+   }
+
+   if constexpr ( Config::OVERFLOW_POLICY != eOverflowPolicy::DROP_NEWEST )
+   {
+      if constexpr ( Config::OVERFLOW_POLICY == eOverflowPolicy::DROP_OLDEST )
+      {
+         staging.discardRequested.store( true, std::memory_order_release );
+      }
+      m_semLogAvailable.put();
+
+      for ( uint32_t waited = 0; waited < Config::BLOCK_TIMEOUT_MS; waited++ )
+      {
+         Port::delay( 1 );
+         if ( tryPush( staging, lockable, type, level, data, length ) )
+         {
+            return true;
+         }
+      }
+   }
+
+   staging.dropped.fetch_add( 1, std::memory_order_relaxed );
+   return false;
+}
+
+/**
+ * @brief Try to push an entry once, see pushReported(), under the lock if the staging buffer has one.
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::tryPush( Staging& staging, Lock* lockable, eEntryType type, uint8_t level, const uint8_t* data, size_t length )
+{
+   if ( lockable == nullptr )
+   {
+      return pushReported( staging, type, level, data, length );
+   }
+
+   lib::lock_guard guard( *lockable );
+   return pushReported( staging, type, level, data, length );
+}
+
+/**
+ * @brief Push an entry to a staging buffer, preceded by the report of the messages dropped before it if any.
+ * @details The report is pushed only together with the entry, so that it never takes the room of the entry.
+ *
+ * @param staging the staging buffer
+ * @param type type of the log data
+ * @param level level the log data is tagged with
+ * @param data pointer to the log data
+ * @param length length of the log data
+ * @return true if the entry is pushed
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::pushReported( Staging& staging, eEntryType type, uint8_t level, const uint8_t* data, size_t length )
+{
+   const uint32_t dropped = staging.dropped.load( std::memory_order_relaxed );
+   if ( dropped == 0 )
+   {
+      return pushEntry( staging, type, level, data, length );
+   }
+
+   const uint8_t report[sizeof( dropped )] =
+   {
+      static_cast<uint8_t>( dropped ), static_cast<uint8_t>( dropped >> 8 ), static_cast<uint8_t>( dropped >> 16 ), static_cast<uint8_t>( dropped >> 24 ),
+   };
+   if ( ( REPORTED_OVERHEAD + length ) > ( staging.ring.size() - staging.ring.count() ) )
+   {
+      return false;
+   }
+
+   (void)pushEntry( staging, eEntryType::DROPPED, LOG_LEVEL_NONE, report, sizeof( report ) );
+   staging.dropped.fetch_sub( dropped, std::memory_order_relaxed );
+   return pushEntry( staging, type, level, data, length );
+}
+
+/**
+ * @brief Push an entry to a staging buffer as a whole, or not at all, so that no message is ever cut or spliced with the next one.
+ *
+ * @param staging the staging buffer
+ * @param type type of the log data
+ * @param level level the log data is tagged with
+ * @param data pointer to the log data
+ * @param length length of the log data
+ * @return true if the entry is pushed
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::pushEntry( Staging& staging, eEntryType type, uint8_t level, const uint8_t* data, size_t length )
+{
+   const size_t space = staging.ring.size() - staging.ring.count();
+   if ( ( ENTRY_HEADER_SIZE + length ) > space )
+   {
+      return false;
+   }
+
+   //!< In microseconds, so that the messages logged by different tasks within a tick are still merged in order
+   const auto timestampUs = static_cast<uint32_t>( LIB_COMMON_getTimestampUs() );
+   const uint8_t header[ENTRY_HEADER_SIZE] =
+   {
+      static_cast<uint8_t>( timestampUs ), static_cast<uint8_t>( timestampUs >> 8 ), static_cast<uint8_t>( timestampUs >> 16 ), static_cast<uint8_t>( timestampUs >> 24 ),
+      static_cast<uint8_t>( type ),
+      level,
+      static_cast<uint8_t>( length ), static_cast<uint8_t>( length >> 8 ),
+   };
+   uint32_t countWritten = 0;
+
+   staging.ring.pushBulk( header, sizeof( header ), &countWritten );
+   staging.ring.pushBulk( data, static_cast<uint32_t>( length ), &countWritten );
+   return true;
+}
+
+/**
+ * @brief Find the staging buffer of the calling task.
+ *
+ * @return Staging* the staging buffer, or nullptr if the task is not registered
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+auto BasicLogger<Lock, Sem, Sink, Port, Config>::findStagingBuffer() -> Staging*
+{
+   const auto self = Port::currentTask();
+   const auto count = m_numRegistered.load( std::memory_order_acquire );
+   for ( size_t i = 0; i < count; i++ )
+   {
+      if ( m_taskBuffers[i].owner == self )
+      {
+         return &m_taskBuffers[i];
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * @brief Find the staging buffer with the oldest entry, which merges the staging buffers by the time stamp.
+ * @details The header of the next entry of each staging buffer is popped once it's there, and kept until the entry is drained.
+ *          The shared staging buffer comes first on a tie, followed by the others in the order of the registration.
+ *
+ * @return Staging* the staging buffer, or nullptr if there is no entry
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+auto BasicLogger<Lock, Sem, Sink, Port, Config>::findOldestEntry() -> Staging*
+{
+   Staging* oldest = nullptr;
+   auto check = [&]( Staging& staging )
+   {
+      if ( staging.discardRequested.exchange( false, std::memory_order_acquire ) )
+      {
+         discardOldest( staging );
+      }
+
+      (void)loadHeader( staging );
+
+      //!< Compared by the difference, so that the wrap-around of the time stamp doesn't matter
+      if ( staging.hasEntry && ( ( oldest == nullptr ) || ( static_cast<int32_t>( staging.timestampUs - oldest->timestampUs ) < 0 ) ) )
+      {
+         oldest = &staging;
+      }
+   };
+
+   check( m_sharedBuffer );
+   const auto count = m_numRegistered.load( std::memory_order_acquire );
+   for ( size_t i = 0; i < count; i++ )
+   {
+      check( m_taskBuffers[i] );
+   }
+   return oldest;
+}
+
+/**
+ * @brief Pop the header of the next entry of a staging buffer, unless there's one already.
+ *
+ * @param staging the staging buffer
+ * @return true if there's an entry
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::loadHeader( Staging& staging )
+{
+   if ( !staging.hasEntry && ( staging.ring.count() >= ENTRY_HEADER_SIZE ) )
+   {
+      uint8_t header[ENTRY_HEADER_SIZE] = {0};
+      uint32_t countRead = 0;
+      staging.ring.popBulk( header, sizeof( header ), &countRead );
+
+      staging.timestampUs = header[0] | ( header[1] << 8 ) | ( header[2] << 16 ) | ( static_cast<uint32_t>( header[3] ) << 24 );
+      staging.type        = static_cast<eEntryType>( header[4] );
+      staging.level       = header[5];
+      staging.remaining   = header[6] | ( header[7] << 8 );
+      staging.hasEntry    = true;
+   }
+   return staging.hasEntry;
+}
+
+/**
+ * @brief Discard the oldest entries of a staging buffer until half of it is free, which is requested by its producer under DROP_OLDEST.
+ * @note This is called only between entries, so the entry discarded has never been drained in part.
+ *
+ * @param staging the staging buffer
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+void BasicLogger<Lock, Sem, Sink, Port, Config>::discardOldest( Staging& staging )
+{
+   while ( ( ( staging.ring.size() - staging.ring.count() ) < ( staging.ring.size() / 2 ) ) && loadHeader( staging ) )
+   {
+      //!< The entry is there as a whole, as its producer is the one waiting for the space
+      while ( staging.remaining > 0 )
+      {
+         uint32_t countRead = 0;
+         staging.ring.popBulk( m_recordBuffer, static_cast<uint32_t>( ( staging.remaining < sizeof( m_recordBuffer ) ) ? staging.remaining : sizeof( m_recordBuffer ) ), &countRead );
+         if ( countRead == 0 )
+         {
+            break;
+         }
+         staging.remaining -= countRead;
+      }
+
+      staging.hasEntry = ( staging.remaining != 0 );
+      if ( staging.hasEntry )
+      {
+         break;
+      }
+
+      //!< A report discarded is carried over to the next one
+      const uint32_t dropped = ( staging.type == eEntryType::DROPPED )
+                               ? m_recordBuffer[0] | ( m_recordBuffer[1] << 8 ) | ( m_recordBuffer[2] << 16 ) | ( static_cast<uint32_t>( m_recordBuffer[3] ) << 24 )
+                               : 1;
+      staging.dropped.fetch_add( dropped, std::memory_order_relaxed );
+   }
+}
+
+/**
+ * @brief Drain the current entry of a staging buffer as a whole into a buffer, once it's all there.
+ * @details Text is copied as it is, whereas a binary record is framed with COBS and CRC16, preceded by an extra delimiter,
+ *          so that any text before it ends up in a separate chunk on the host, and the number of messages dropped is turned into a line of text.
+ *          The data of an entry may not be all there yet if its producer is still pushing it, in which case it's drained on the next round.
+ *
+ * @param staging the staging buffer
+ * @param buffer the buffer, of ENTRY_BUFFER_SIZE
+ * @param length the length of the entry drained, which is 0 if it's dropped, e.g., a record which fails to be framed
+ * @return true if the entry is drained
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::drainEntry( Staging& staging, uint8_t buffer[], size_t& length )
+{
+   uint32_t countRead = 0;
+   length = 0;
+
+   if ( staging.ring.count() < staging.remaining )
+   {
+      return false;     //!< Not all there yet
+   }
+
+   if ( staging.type == eEntryType::TEXT )
+   {
+      staging.ring.popBulk( buffer, static_cast<uint32_t>( staging.remaining ), &countRead );
+      length = countRead;
+   }
+   else if ( staging.type == eEntryType::DROPPED )
+   {
+      uint8_t report[sizeof( uint32_t )] = {0};
+      staging.ring.popBulk( report, sizeof( report ), &countRead );
+
+      const uint32_t dropped = report[0] | ( report[1] << 8 ) | ( report[2] << 16 ) | ( static_cast<uint32_t>( report[3] ) << 24 );
+      const int count = snprintf( reinterpret_cast<char*>( buffer ), MAX_DROPPED_LENGTH, "LOGGER: %lu messages dropped\r\n", static_cast<unsigned long>( dropped ) );
+      length = ( count > 0 ) ? std::min( static_cast<size_t>( count ), MAX_DROPPED_LENGTH - 1 ) : 0;
+   }
+   else
+   {
+      staging.ring.popBulk( m_recordBuffer, static_cast<uint32_t>( staging.remaining ), &countRead );
+
+      FrameEncoder encoder{ &buffer[1], ENTRY_BUFFER_SIZE - 1 };
+      SerialDevice::TxSegment frame{};
+
+      encoder.begin();
+      (void)encoder.feed( m_recordBuffer, countRead );
+      if ( encoder.finish( frame ) == LibErrorCodes::eOK )
+      {
+         buffer[0] = FrameEncoder::DELIMITER;
+         length = 1 + frame.length;
+      }
+   }
+
+   staging.remaining = 0;
+   staging.hasEntry = false;
+   return true;
+}
+
+/**
+ * @brief Pop the oldest entry of the staging buffers into a buffer.
+ * @details An entry which is not all there yet is finished on the next call before any other, so that the entries stay in order.
+ *
+ * @param buffer the buffer, of ENTRY_BUFFER_SIZE
+ * @param level the level the entry is tagged with
+ * @return size_t the length of the entry, or 0 if there's none
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+size_t BasicLogger<Lock, Sem, Sink, Port, Config>::popEntry( uint8_t buffer[], uint8_t& level )
+{
+   for (;;)
+   {
+      if ( m_current == nullptr )
+      {
+         m_current = findOldestEntry();
+         if ( m_current == nullptr )
+         {
+            return 0;
+         }
+      }
+
+      size_t length = 0;
+      level = m_current->level;
+      if ( !drainEntry( *m_current, buffer, length ) )
+      {
+         return 0;
+      }
+      m_current = nullptr;
+
+      if ( length > 0 )
+      {
+         return length;
+      }
+   }
+}
+
+/**
+ * @brief Fan the entries of the staging buffers out to the sinks, and have them hand over what they've batched.
+ *
+ * @return true if any sink holds data back to be flushed later
+ */
+template<Lockable Lock, CountingSemaphore Sem, typename Sink, typename Port, typename Config>
+bool BasicLogger<Lock, Sem, Sink, Port, Config>::dispatch()
+{
+   const auto count = m_numSinks.load( std::memory_order_acquire );
+   uint8_t level = LOG_LEVEL_NONE;
+   size_t length = 0;
+
+   while ( ( length = popEntry( m_entryBuffer, level ) ) > 0 )
+   {
+      const auto nowMs = LIB_COMMON_getTickMS();
+      for ( size_t i = 0; i < count; i++ )
+      {
+         (void)m_sinks[i]->offer( level, m_entryBuffer, length, nowMs );
+      }
+   }
+
+   bool isPending = false;
+   for ( size_t i = 0; i < count; i++ )
+   {
+      m_sinks[i]->flush();
+      isPending = isPending || m_sinks[i]->isPending();
+   }
+   return isPending;
+}
+} /* namespace lib */
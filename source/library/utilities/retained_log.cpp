@@ -0,0 +1,255 @@
+/************************************************************************************************************
+ *
+ * @file retained_log.cpp
+ * @brief Implementation of the log records kept in a RAM area retained over a reset.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-13
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "retained_log.h"
+#include "crc16.h"
+#include <string.h>
+
+/******************************************* Function Declarations ******************************************/
+static uint32_t   getWord  ( const uint8_t* data );
+static void       putWord  ( uint8_t* data, uint32_t value );
+
+/******************************************* Function Definitions *******************************************/
+namespace lib
+{
+/**
+ * @brief Check if the area holds a log, i.e., the header is intact and consistent with the area.
+ */
+bool RetainedLog::isValid( ) const
+{
+   Header header{};
+   return loadHeader( header );
+}
+
+/**
+ * @brief Make the area an empty log, discarding whatever it holds.
+ */
+void RetainedLog::reset( )
+{
+   if ( m_capacity == 0 )
+   {
+      return;
+   }
+
+   storeHeader( Header{ 0, 0 } );
+}
+
+/**
+ * @brief Get the number of bytes taken by the records, including their overhead.
+ */
+size_t RetainedLog::used( ) const
+{
+   Header header{};
+   return loadHeader( header ) ? header.used : 0;
+}
+
+/**
+ * @brief Append a record, overwriting the oldest ones if there is no room for it.
+ * @details The area is made an empty log first if it doesn't hold a valid one.
+ *
+ * @param data pointer to the data of the record
+ * @param length length of the data
+ * @return ErrorCode eRETAINED_LOG_TOO_LONG if the record can never fit in the area
+ */
+ErrorCode RetainedLog::append( const uint8_t* data, size_t length )
+{
+   if ( ( data == nullptr ) || ( length == 0 ) || ( length > MAX_LENGTH ) || ( ( length + RECORD_OVERHEAD ) > m_capacity ) )
+   {
+      return LibErrorCodes::eRETAINED_LOG_TOO_LONG;
+   }
+
+   Header header{};
+   if ( !loadHeader( header ) )
+   {
+      reset();
+      header = Header{ 0, 0 };
+   }
+
+   //!< Make room by dropping the oldest records, and commit it before their bytes are overwritten
+   const size_t needed = length + RECORD_OVERHEAD;
+   if ( ( m_capacity - header.used ) < needed )
+   {
+      while ( ( m_capacity - header.used ) < needed )
+      {
+         uint8_t field[2] = {0};
+         read( header.head, field, sizeof( field ) );
+         const size_t size = ( field[0] | ( field[1] << 8 ) ) + RECORD_OVERHEAD;
+         if ( size > header.used )
+         {
+            header = Header{ 0, 0 };
+            break;
+         }
+         header.head = advance( header.head, size );
+         header.used -= static_cast<uint32_t>( size );
+      }
+      storeHeader( header );
+   }
+
+   const uint16_t crc = Crc16::calculate( data, length );
+   const uint8_t lengthField[2] = { static_cast<uint8_t>( length ), static_cast<uint8_t>( length >> 8 ) };
+   const uint8_t crcField[2] = { static_cast<uint8_t>( crc ), static_cast<uint8_t>( crc >> 8 ) };
+
+   auto tail = advance( header.head, header.used );
+   write( tail, lengthField, sizeof( lengthField ) );
+   tail = advance( tail, sizeof( lengthField ) );
+   write( tail, data, length );
+   tail = advance( tail, length );
+   write( tail, crcField, sizeof( crcField ) );
+
+   header.used += static_cast<uint32_t>( needed );
+   storeHeader( header );
+
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Pop the oldest record.
+ * @details A record failing its CRC check is popped as well, so that the ones following it can still be recovered.
+ *
+ * @param buffer the buffer to copy the data of the record into
+ * @param sizeBuffer size of the buffer
+ * @param length length of the data of the record
+ * @return ErrorCode eRETAINED_LOG_EMPTY if there is no record, which is the case for an area not holding a valid log,
+ *                   eRETAINED_LOG_CORRUPTED if the record fails its CRC check or the rest of the log is unreadable,
+ *                   eRETAINED_LOG_TOO_LONG if the record doesn't fit in the buffer, in which case it's left in the log
+ */
+ErrorCode RetainedLog::pop( uint8_t buffer[], size_t sizeBuffer, size_t& length )
+{
+   length = 0;
+
+   Header header{};
+   if ( !loadHeader( header ) || ( header.used == 0 ) )
+   {
+      return LibErrorCodes::eRETAINED_LOG_EMPTY;
+   }
+
+   uint8_t field[2] = {0};
+   read( header.head, field, sizeof( field ) );
+   const size_t lengthRecord = field[0] | ( field[1] << 8 );
+   if ( ( lengthRecord + RECORD_OVERHEAD ) > header.used )
+   {
+      reset();
+      return LibErrorCodes::eRETAINED_LOG_CORRUPTED;
+   }
+
+   if ( ( buffer == nullptr ) || ( lengthRecord > sizeBuffer ) )
+   {
+      return LibErrorCodes::eRETAINED_LOG_TOO_LONG;
+   }
+
+   auto position = advance( header.head, sizeof( field ) );
+   read( position, buffer, lengthRecord );
+   position = advance( position, lengthRecord );
+   read( position, field, sizeof( field ) );
+
+   header.head = advance( header.head, lengthRecord + RECORD_OVERHEAD );
+   header.used -= static_cast<uint32_t>( lengthRecord + RECORD_OVERHEAD );
+   storeHeader( header );
+
+   if ( Crc16::calculate( buffer, lengthRecord ) != static_cast<uint16_t>( field[0] | ( field[1] << 8 ) ) )
+   {
+      return LibErrorCodes::eRETAINED_LOG_CORRUPTED;
+   }
+
+   length = lengthRecord;
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Load the header, checking it against its CRC and the area.
+ *
+ * @param header the header loaded
+ * @return true if the header is valid
+ */
+bool RetainedLog::loadHeader( Header& header ) const
+{
+   if ( m_capacity == 0 )
+   {
+      return false;
+   }
+
+   const auto crc = static_cast<uint16_t>( m_area[16] | ( m_area[17] << 8 ) );
+   if ( ( getWord( &m_area[0] ) != MAGIC ) || ( getWord( &m_area[4] ) != m_capacity ) || ( Crc16::calculate( m_area, 16 ) != crc ) )
+   {
+      return false;
+   }
+
+   header.head = getWord( &m_area[8] );
+   header.used = getWord( &m_area[12] );
+   return ( header.head < m_capacity ) && ( header.used <= m_capacity );
+}
+
+/**
+ * @brief Store the header along with its CRC.
+ */
+void RetainedLog::storeHeader( const Header& header )
+{
+   putWord( &m_area[0], MAGIC );
+   putWord( &m_area[4], static_cast<uint32_t>( m_capacity ) );
+   putWord( &m_area[8], header.head );
+   putWord( &m_area[12], header.used );
+
+   const auto crc = Crc16::calculate( m_area, 16 );
+   m_area[16] = static_cast<uint8_t>( crc );
+   m_area[17] = static_cast<uint8_t>( crc >> 8 );
+   m_area[18] = 0;
+   m_area[19] = 0;
+}
+
+/**
+ * @brief Read bytes from the ring, wrapping around its end.
+ */
+void RetainedLog::read( uint32_t position, uint8_t* data, size_t length ) const
+{
+   const size_t first = ( length < ( m_capacity - position ) ) ? length : ( m_capacity - position );
+   memcpy( data, &m_area[HEADER_SIZE + position], first );
+   memcpy( data + first, &m_area[HEADER_SIZE], length - first );
+}
+
+/**
+ * @brief Write bytes to the ring, wrapping around its end.
+ */
+void RetainedLog::write( uint32_t position, const uint8_t* data, size_t length )
+{
+   const size_t first = ( length < ( m_capacity - position ) ) ? length : ( m_capacity - position );
+   memcpy( &m_area[HEADER_SIZE + position], data, first );
+   memcpy( &m_area[HEADER_SIZE], data + first, length - first );
+}
+
+/**
+ * @brief Advance a position in the ring, wrapping around its end.
+ */
+uint32_t RetainedLog::advance( uint32_t position, size_t length ) const
+{
+   return static_cast<uint32_t>( ( position + length ) % m_capacity );
+}
+} /* namespace lib */
+
+/**
+ * @brief Get a 32-bit word in little-endian order.
+ */
+static uint32_t getWord( const uint8_t* data )
+{
+   return data[0] | ( data[1] << 8 ) | ( data[2] << 16 ) | ( static_cast<uint32_t>( data[3] ) << 24 );
+}
+
+/**
+ * @brief Put a 32-bit word in little-endian order.
+ */
+static void putWord( uint8_t* data, uint32_t value )
+{
+   data[0] = static_cast<uint8_t>( value );
+   data[1] = static_cast<uint8_t>( value >> 8 );
+   data[2] = static_cast<uint8_t>( value >> 16 );
+   data[3] = static_cast<uint8_t>( value >> 24 );
+}
@@ -0,0 +1,84 @@
+/************************************************************************************************************
+ *
+ * @file retained_log.h
+ * @brief Log records kept in a RAM area retained over a reset, so that they can be recovered after a crash.
+ * @details The area is not touched by the startup code, so its contents survive a reset, but they are garbage after a power-on.
+ *          Therefore, it starts with a header carrying a magic number and a CRC16, which tell a log left by the previous run from garbage.
+ *
+ *          Area layout, in little-endian order:
+ *             | magic (4) | capacity (4) | head (4) | used (4) | CRC16 of the preceding fields (2) | reserved (2) | ring of records |
+ *          Every record in the ring, which may wrap around its end:
+ *             | length (2) | data | CRC16 of the data (2) |
+ *
+ *          The oldest records are overwritten to make room for a new one, and the header is updated before the data is written
+ *          and after it's written in full, so that a crash in the middle of an append loses the record but never the log.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-13
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "error_codes_lib.h"
+#include <stdint.h>
+#include <stddef.h>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+class RetainedLog
+{
+public:
+   constexpr static uint32_t MAGIC           = 0x474C5452;    //!< "RTLG"
+   constexpr static size_t   HEADER_SIZE     = 20;
+   constexpr static size_t   RECORD_OVERHEAD = 4;             //!< The length and the CRC of a record
+   constexpr static size_t   MAX_LENGTH      = UINT16_MAX;
+
+   /**
+    * @brief Construct over a retained area, which is left as it is so that the log of the previous run can be recovered.
+    *
+    * @param area the retained area, including the header
+    * @param sizeArea size of the area
+    */
+   RetainedLog( uint8_t area[], size_t sizeArea )
+   : m_area( area )
+   , m_capacity( ( ( area != nullptr ) && ( sizeArea > HEADER_SIZE ) ) ? ( sizeArea - HEADER_SIZE ) : 0 )
+   { }
+
+   ~RetainedLog() = default;
+
+   //!< Disable copy and move operations
+   RetainedLog( const RetainedLog& ) = delete;
+   RetainedLog& operator=( const RetainedLog& ) = delete;
+   RetainedLog( RetainedLog&& ) = delete;
+   RetainedLog& operator=( RetainedLog&& ) = delete;
+
+   bool        isValid        ( ) const;
+   void        reset          ( );
+   ErrorCode   append         ( const uint8_t* data, size_t length );
+   ErrorCode   pop            ( uint8_t buffer[], size_t sizeBuffer, size_t& length );
+   size_t      used           ( ) const;
+
+   inline size_t capacity     ( ) const { return m_capacity; }
+
+private:
+   struct Header
+   {
+      uint32_t head;
+      uint32_t used;
+   };
+
+   bool        loadHeader     ( Header& header ) const;
+   void        storeHeader    ( const Header& header );
+   void        read           ( uint32_t position, uint8_t* data, size_t length ) const;
+   void        write          ( uint32_t position, const uint8_t* data, size_t length );
+   uint32_t    advance        ( uint32_t position, size_t length ) const;
+
+   uint8_t*    m_area;
+   size_t      m_capacity;
+};
+} /* namespace lib */
@@ -13,12 +13,19 @@
 #include "error_codes_lib.h"
 #include <stdint.h>
 #include <string.h>
+#include <atomic>
 
 /******************************************** Types ************************************************/
 namespace lib
 {
 /**
  * @brief RingBuffer class template
+ * @details It's safe for a single producer and a single consumer running concurrently, e.g., a UART interrupt pushing and a thread popping, without locking.
+ *          The producer only writes the tail and the consumer only writes the head, and the count is derived from both,
+ *          so there is no shared read-modify-write that could be torn by the other side.
+ *          The indices run over twice the size of the buffer, so that a full buffer can be told from an empty one without wasting a slot.
+ *          The peak occupancy and the pushes rejected as full are counted by the producer, e.g., to be reported by a stats provider,
+ *          so that a buffer sized too small shows up before the data lost is noticed.
  * 
  * @tparam T Type of elements stored in the ring buffer
  */
@@ -41,9 +48,8 @@ public:
 
       m_buffer = buffer;
       m_size = size;
-      m_head = 0;
-      m_tail = 0;
-      m_count = 0;
+      m_head.store( 0, std::memory_order_relaxed );
+      m_tail.store( 0, std::memory_order_relaxed );
    }
 
    ~RingBuffer()
@@ -63,14 +69,23 @@ public:
     */
    ErrorCode push( const T& data )
    {
-      if ( isFull() )
+      const auto tail = m_tail.load( std::memory_order_relaxed );
+      const auto used = distance( m_head.load( std::memory_order_acquire ), tail );
+      if ( used == m_size )
       {
+         m_overflows.fetch_add( 1, std::memory_order_relaxed );
          return LibErrorCodes::eRING_BUFFER_FULL;
       }
 
-      m_buffer[m_tail] = data;
-      m_tail = ( m_tail + 1 ) % m_size;
-      m_count++;
+      if ( used >= m_peak.load( std::memory_order_relaxed ) )
+      {
+         m_peak.store( used + 1, std::memory_order_relaxed );
+      }
+
+      m_buffer[slot( tail )] = data;
+
+      //!< Publish the element only after it's written.
+      m_tail.store( next( tail ), std::memory_order_release );
 
       return LibErrorCodes::eOK;
    }
@@ -117,14 +132,16 @@ public:
     */
    ErrorCode pop( T& data )
    {
-      if ( isEmpty() )
+      const auto head = m_head.load( std::memory_order_relaxed );
+      if ( head == m_tail.load( std::memory_order_acquire ) )
       {
          return LibErrorCodes::eRING_BUFFER_EMPTY;
       }
 
-      data = m_buffer[m_head];
-      m_head = ( m_head + 1 ) % m_size;
-      m_count--;
+      data = m_buffer[slot( head )];
+
+      //!< Give the slot back only after the element is read.
+      m_head.store( next( head ), std::memory_order_release );
 
       return LibErrorCodes::eOK;
    }
@@ -148,11 +165,9 @@ public:
       }
 
       uint32_t count = 0;
-      while ( count < sizeBuffer && m_count > 0 )
+      while ( count < sizeBuffer && pop( data[count] ) == LibErrorCodes::eOK )
       {
-         data[count++] = m_buffer[m_head];
-         m_head = ( m_head + 1 ) % m_size;
-         m_count--;
+         count++;
       }
 
       if ( countRead != nullptr )
@@ -163,24 +178,44 @@ public:
 
    /**
     * @brief Clear the ring buffer
+    * @note This resets both indices, so it must not run concurrently with push().
     */
    void clear()
    {
-      m_head = m_tail = m_count = 0; 
+      m_head.store( 0, std::memory_order_relaxed );
+      m_tail.store( 0, std::memory_order_relaxed );
       memset( m_buffer, 0, m_size * sizeof(T) );
    }
 
    //!< Useful getters
-   inline bool       isEmpty  () const { return m_count == 0; }
-   inline bool       isFull   () const { return m_count == m_size; }
-   inline uint32_t   count    () const { return m_count; }
+   inline bool       isEmpty  () const { return count() == 0; }
+   inline bool       isFull   () const { return count() == m_size; }
+   inline uint32_t   count    () const { return distance( m_head.load( std::memory_order_acquire ), m_tail.load( std::memory_order_acquire ) ); }
    inline uint32_t   size     () const { return m_size; }
+   inline uint32_t   getPeak        () const { return m_peak.load( std::memory_order_relaxed ); }
+   inline uint32_t   getOverflows   () const { return m_overflows.load( std::memory_order_relaxed ); }
+
+   /**
+    * @brief Reset the peak occupancy to the current one, and the overflows to 0.
+    * @note It can run concurrently with push(), where a push at the same time may be missed in the statistics only.
+    */
+   void resetStatistics()
+   {
+      m_peak.store( count(), std::memory_order_relaxed );
+      m_overflows.store( 0, std::memory_order_relaxed );
+   }
 
 private:
-   T* m_buffer;            //!< Pointer to the buffer
-   uint32_t m_size;        //!< Size of the buffer
-   uint32_t m_head;        //!< Index of the head
-   uint32_t m_tail;        //!< Index of the tail
-   uint32_t m_count;       //!< Number of elements in the buffer
+   //!< Helpers for the indices running over [0, 2 * size)
+   inline uint32_t   slot     ( uint32_t index ) const { return ( index < m_size ) ? index : ( index - m_size ); }
+   inline uint32_t   next     ( uint32_t index ) const { return ( index + 1 == 2 * m_size ) ? 0 : ( index + 1 ); }
+   inline uint32_t   distance ( uint32_t head, uint32_t tail ) const { return ( tail >= head ) ? ( tail - head ) : ( tail + 2 * m_size - head ); }
+
+   T* m_buffer;                        //!< Pointer to the buffer
+   uint32_t m_size;                    //!< Size of the buffer
+   std::atomic<uint32_t> m_head{ 0 };  //!< Index of the head, written only by the consumer
+   std::atomic<uint32_t> m_tail{ 0 };  //!< Index of the tail, written only by the producer
+   std::atomic<uint32_t> m_peak{ 0 };        //!< Highest count seen on push
+   std::atomic<uint32_t> m_overflows{ 0 };   //!< Pushes rejected as full
 };
 } /* namespace lib */
@@ -0,0 +1,57 @@
+/************************************************************************************************************
+ *
+ * @file stats_registry.cpp
+ * @brief Implementation of the output of the stats providers
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-23
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************ Includes **************************************************/
+#include "stats_registry.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace lib
+{
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Get the name of a group of the stats providers
+ *
+ * @param group the group
+ * @return const char* the name
+ */
+const char* getStatsGroupName( eStatsGroup group )
+{
+   switch ( group )
+   {
+      case eStatsGroup::SYSTEM:     return "system";
+      case eStatsGroup::BUFFERS:    return "buffers";
+   }
+   return "unknown";
+}
+
+/**
+ * @brief Format a line, and hand it over to the sink, where a line longer than LINE_SIZE is truncated.
+ *
+ * @param format the format string, without the end of the line
+ * @param ... the arguments
+ */
+void StatsOutput::print( const char* format, ... )
+{
+   char line[LINE_SIZE];
+
+   va_list args;
+   va_start( args, format );
+   (void)vsnprintf( line, sizeof( line ), format, args );
+   va_end( args );
+
+   if ( m_function != nullptr )
+   {
+      m_function( m_context, line );
+   }
+}
+} /* namespace lib */
@@ -0,0 +1,273 @@
+/************************************************************************************************************
+ *
+ * @file stats_registry.h
+ * @brief Registry of the stats providers, which the components report their runtime statistics through, e.g., for the introspection commands.
+ * @details A component, or an adapter of it, implements IStatsProvider and is registered once at initialization under a unique name.
+ *          A report is printed line by line through StatsOutput, where every line is formatted into a small buffer on the stack and handed over
+ *          to the sink right away, so that no report is ever held as a whole, and the console is never blocked for longer than a line.
+ *          A provider takes a snapshot of its counters first, under its own lock if any, and formats them only afterwards,
+ *          so that the component being reported is held only for the copy.
+ *
+ *          Usage: registry.add( provider ) at initialization -> registry.report( "name", output ), or reportGroup() or reportAll()
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-23
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+#pragma once
+
+/************************************************ Includes **************************************************/
+#include "ring_buffer.h"
+#include "error_codes_lib.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace lib
+{
+/************************************************** Types ***************************************************/
+/**
+ * @brief Group of the stats providers, e.g., to report all the buffers at once.
+ */
+enum class eStatsGroup : uint8_t
+{
+   SYSTEM,        //!< Of the system, e.g., the tasks and the heap
+   BUFFERS,       //!< Of the buffers and the queues, e.g., the ring buffers and the message passers
+};
+
+const char* getStatsGroupName( eStatsGroup group );
+
+/**
+ * @brief Output of a report, which formats a line at a time and hands it over to the sink, e.g., the CLI session the command is entered in.
+ */
+class StatsOutput
+{
+public:
+   constexpr static size_t LINE_SIZE = 96;         //!< Longest line including the null, where a longer one is truncated
+
+   //!< Alias for the sink of the lines, which are given without the end of the line
+   using LineFunction = void (*)( void* context, const char* line );
+
+   explicit StatsOutput( LineFunction function, void* context = nullptr )
+   : m_function{ function }
+   , m_context{ context }
+   { }
+
+   void print( const char* format, ... );
+
+private:
+   LineFunction   m_function;
+   void*          m_context;
+};
+
+/**
+ * @brief Interface of a stats provider
+ */
+class IStatsProvider
+{
+public:
+   virtual ~IStatsProvider() = default;
+
+   virtual const char*  getName     ( ) const = 0;
+   virtual eStatsGroup  getGroup    ( ) const = 0;
+
+   /**
+    * @brief Report the statistics, a line per item, e.g., per task.
+    * @note It can be called by any task, and by more than one at the same time, e.g., from the commands executed by the worker tasks.
+    */
+   virtual void         report      ( StatsOutput& output ) = 0;
+
+   //!< Reset the counters if any, e.g., the peaks, to start measuring from now
+   virtual void         reset       ( ) { }
+};
+
+/**
+ * @brief Registry of the stats providers, looked up by their names.
+ * @details The registration is expected to be done at initialization, before any report; the registry is read-only afterwards,
+ *          so that the reports need no lock of their own.
+ *
+ * @tparam MaxProviders Maximum number of the providers
+ */
+template<size_t MaxProviders = 16>
+class StatsRegistry
+{
+public:
+   StatsRegistry() = default;
+   ~StatsRegistry() = default;
+
+   //!< Disable copy and move operations
+   StatsRegistry( const StatsRegistry& ) = delete;
+   StatsRegistry& operator=( const StatsRegistry& ) = delete;
+   StatsRegistry( StatsRegistry&& ) = delete;
+   StatsRegistry& operator=( StatsRegistry&& ) = delete;
+
+   ErrorCode         add            ( IStatsProvider& provider );
+   IStatsProvider*   find           ( const char* name ) const;
+   size_t            size           ( ) const   { return m_numProviders; }
+
+   void              list           ( StatsOutput& output ) const;
+   ErrorCode         report         ( const char* name, StatsOutput& output ) const;
+   void              reportGroup    ( eStatsGroup group, StatsOutput& output ) const;
+   void              reportAll      ( StatsOutput& output ) const;
+   void              resetAll       ( ) const;
+
+private:
+   IStatsProvider*   m_providers[MaxProviders]{};
+   size_t            m_numProviders{ 0 };
+};
+
+/**
+ * @brief Stats provider of a ring buffer, which reports its occupancy, its peak, and the pushes rejected as full.
+ *
+ * @tparam T Type of elements stored in the ring buffer
+ */
+template<typename T>
+class RingBufferStats final : public IStatsProvider
+{
+public:
+   RingBufferStats( const char* name, RingBuffer<T>& ring )
+   : m_name{ name }
+   , m_ring{ ring }
+   { }
+
+   const char*  getName     ( ) const override   { return m_name; }
+   eStatsGroup  getGroup    ( ) const override   { return eStatsGroup::BUFFERS; }
+   void         report      ( StatsOutput& output ) override;
+   void         reset       ( ) override         { m_ring.resetStatistics(); }
+
+private:
+   const char*       m_name;
+   RingBuffer<T>&    m_ring;
+};
+
+/******************************************* Function Definitions *******************************************/
+/**
+ * @brief Register a stats provider.
+ *
+ * @param provider the provider, which must outlive the registry
+ * @return ErrorCode eOK, or eSTATS_REGISTRY_FULL
+ */
+template<size_t MaxProviders>
+ErrorCode StatsRegistry<MaxProviders>::add( IStatsProvider& provider )
+{
+   if ( m_numProviders == MaxProviders )
+   {
+      return LibErrorCodes::eSTATS_REGISTRY_FULL;
+   }
+
+   m_providers[m_numProviders++] = &provider;
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Find a stats provider by its name.
+ *
+ * @param name the name
+ * @return IStatsProvider* the provider, or nullptr if not found
+ */
+template<size_t MaxProviders>
+IStatsProvider* StatsRegistry<MaxProviders>::find( const char* name ) const
+{
+   for ( size_t i = 0; i < m_numProviders; i++ )
+   {
+      if ( strcmp( m_providers[i]->getName(), name ) == 0 )
+      {
+         return m_providers[i];
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * @brief List the names of the stats providers along with their groups.
+ *
+ * @param output the output
+ */
+template<size_t MaxProviders>
+void StatsRegistry<MaxProviders>::list( StatsOutput& output ) const
+{
+   for ( size_t i = 0; i < m_numProviders; i++ )
+   {
+      output.print( "%-16s %s", m_providers[i]->getName(), getStatsGroupName( m_providers[i]->getGroup() ) );
+   }
+}
+
+/**
+ * @brief Report the statistics of a stats provider.
+ *
+ * @param name the name of the provider
+ * @param output the output
+ * @return ErrorCode eOK, or eSTATS_PROVIDER_NOT_FOUND
+ */
+template<size_t MaxProviders>
+ErrorCode StatsRegistry<MaxProviders>::report( const char* name, StatsOutput& output ) const
+{
+   auto* provider = find( name );
+   if ( provider == nullptr )
+   {
+      return LibErrorCodes::eSTATS_PROVIDER_NOT_FOUND;
+   }
+
+   provider->report( output );
+   return LibErrorCodes::eOK;
+}
+
+/**
+ * @brief Report the statistics of every stats provider of a group, in the order registered.
+ *
+ * @param group the group
+ * @param output the output
+ */
+template<size_t MaxProviders>
+void StatsRegistry<MaxProviders>::reportGroup( eStatsGroup group, StatsOutput& output ) const
+{
+   for ( size_t i = 0; i < m_numProviders; i++ )
+   {
+      if ( m_providers[i]->getGroup() == group )
+      {
+         m_providers[i]->report( output );
+      }
+   }
+}
+
+/**
+ * @brief Report the statistics of every stats provider, in the order registered.
+ *
+ * @param output the output
+ */
+template<size_t MaxProviders>
+void StatsRegistry<MaxProviders>::reportAll( StatsOutput& output ) const
+{
+   for ( size_t i = 0; i < m_numProviders; i++ )
+   {
+      m_providers[i]->report( output );
+   }
+}
+
+/**
+ * @brief Reset the counters of every stats provider.
+ */
+template<size_t MaxProviders>
+void StatsRegistry<MaxProviders>::resetAll( ) const
+{
+   for ( size_t i = 0; i < m_numProviders; i++ )
+   {
+      m_providers[i]->reset();
+   }
+}
+
+/**
+ * @brief Report the occupancy of the ring buffer, which is read without stopping its producer or its consumer.
+ *
+ * @param output the output
+ */
+template<typename T>
+void RingBufferStats<T>::report( StatsOutput& output )
+{
+   output.print( "%-16s used %lu/%lu, peak %lu, overflows %lu", m_name,
+                 static_cast<unsigned long>( m_ring.count() ), static_cast<unsigned long>( m_ring.size() ),
+                 static_cast<unsigned long>( m_ring.getPeak() ), static_cast<unsigned long>( m_ring.getOverflows() ) );
+}
+} /* namespace lib */
@@ -0,0 +1,407 @@
+# -*- coding: utf-8 -*-
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+# Types of the arguments, which must be in sync with lib::LogRecord::eArgType in log_record.h
+ARG_INT32   = 1
+ARG_UINT32  = 2
+ARG_INT64   = 3
+ARG_UINT64  = 4
+ARG_DOUBLE  = 5
+ARG_STRING  = 6
+ARG_POINTER = 7
+
+# Types of the fields, which must be in sync with lib::KvRecord::eFieldType in kv_record.h
+FIELD_UINT   = 1
+FIELD_SINT   = 2
+FIELD_FLOAT  = 3
+FIELD_DOUBLE = 4
+FIELD_FALSE  = 5
+FIELD_TRUE   = 6
+FIELD_STRING = 7
+
+HEADER_SIZE = 9
+KV_MARKER   = 0xFF
+SOURCE_EXTENSIONS = ( ".c", ".cpp", ".h", ".hpp" )
+
+# A LOGGING or LOG_* call followed by its format string, which may be split into several adjacent literals
+LOGGING_PATTERN = re.compile( r'\b(?:LOGGING|LOG_(?:ERROR|WARN|INFO|DEBUG|TRACE))\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)' )
+LITERAL_PATTERN = re.compile( r'"((?:[^"\\]|\\.)*)"' )
+# Length modifiers are meaningless in Python, and %p is not supported
+CONVERSION_PATTERN = re.compile( r'%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|j|z|t|L)?([diouxXeEfgGcsp%])' )
+# A LOG_KV call, whose arguments are split by split_arguments() as the values can be any expressions
+LOG_KV_PATTERN = re.compile( r'\bLOG_KV\s*\(' )
+
+def fnv1a( data ):
+   """
+   32-bit FNV-1a hash, the same as lib::LogRecord::formatId().
+   """
+   hash_value = 2166136261
+   for byte in data:
+      hash_value ^= byte
+      hash_value = ( hash_value * 16777619 ) & 0xFFFFFFFF
+   return hash_value
+
+def crc16( data ):
+   """
+   CRC16-CCITT with the initial value 0xFFFF, the same as lib::Crc16.
+   """
+   crc = 0xFFFF
+   for byte in data:
+      crc ^= byte << 8
+      for _ in range( 8 ):
+         crc = ( ( crc << 1 ) ^ 0x1021 ) if ( crc & 0x8000 ) else ( crc << 1 )
+         crc &= 0xFFFF
+   return crc
+
+def unescape( literal ):
+   """
+   Convert the escape sequences of a C string literal into the bytes the compiler produces.
+   """
+   return literal.encode( "latin-1" ).decode( "unicode_escape" ).encode( "latin-1" )
+
+def split_arguments( text, start ):
+   """
+   Split the arguments of a call from the character after its opening parenthesis, at the commas not nested in brackets or literals.
+   """
+   arguments = []
+   depth = 0
+   current = ""
+   index = start
+   while index < len( text ):
+      char = text[index]
+      if char in "\"'":
+         end = index + 1
+         while end < len( text ) and text[end] != char:
+            end += 2 if text[end] == "\\" else 1
+         current += text[index : end + 1]
+         index = end + 1
+         continue
+      if char in "([{":
+         depth += 1
+      elif char in ")]}":
+         if depth == 0:
+            arguments.append( current.strip() )
+            return arguments
+         depth -= 1
+      elif char == "," and depth == 0:
+         arguments.append( current.strip() )
+         current = ""
+         index += 1
+         continue
+      current += char
+      index += 1
+   return None
+
+def literal_value( argument ):
+   """
+   Get the bytes of an argument made of string literals, or None if it's not.
+   """
+   literals = LITERAL_PATTERN.findall( argument )
+   if not literals or LITERAL_PATTERN.sub( "", argument ).strip():
+      return None
+   return b"".join( unescape( literal ) for literal in literals )
+
+def load_formats( source_dirs ):
+   """
+   Find the format strings of all LOGGING and LOG_* calls, and the events of all LOG_KV calls, in the source code, keyed by their IDs.
+   An event is a tuple of its name and its keys.
+   """
+   formats = {}
+   events = {}
+   for source_dir in source_dirs:
+      for root, _, files in os.walk( source_dir ):
+         for name in files:
+            if not name.endswith( SOURCE_EXTENSIONS ):
+               continue
+            with open( os.path.join( root, name ), encoding="utf-8", errors="ignore" ) as f:
+               source = f.read()
+            for match in LOGGING_PATTERN.finditer( source ):
+               literals = LITERAL_PATTERN.findall( match.group( 1 ) )
+               fmt = b"".join( unescape( literal ) for literal in literals )
+               formats[ fnv1a( fmt ) ] = fmt.decode( "latin-1" )
+            for match in LOG_KV_PATTERN.finditer( source ):
+               arguments = split_arguments( source, match.end() )
+               if not arguments:
+                  continue
+               names = [ literal_value( argument ) for argument in [ arguments[0] ] + arguments[1::2] ]
+               if None in names:
+                  continue    # e.g., the definition of the macro itself
+               events[ fnv1a( names[0] ) ] = ( names[0].decode( "latin-1" ), [ key.decode( "latin-1" ) for key in names[1:] ] )
+   return formats, events
+
+def cobs_decode( data ):
+   """
+   Decode a COBS-encoded frame without its delimiter, or return None if it's malformed.
+   """
+   output = bytearray()
+   index = 0
+   while index < len( data ):
+      code = data[index]
+      if code == 0 or index + code > len( data ):
+         return None
+      output += data[index + 1 : index + code]
+      index += code
+      if code != 0xFF and index < len( data ):
+         output.append( 0 )
+   return bytes( output )
+
+def decode_frame( chunk ):
+   """
+   Get the record out of a frame, or None if the chunk is not a valid frame, e.g., text written with printf.
+   """
+   decoded = cobs_decode( chunk )
+   if decoded is None or len( decoded ) < HEADER_SIZE + 2:
+      return None
+   record, crc = decoded[:-2], struct.unpack( ">H", decoded[-2:] )[0]
+   if crc16( record ) != crc:
+      return None
+   return record
+
+def parse_args( record ):
+   """
+   Parse the arguments of a record into Python values.
+   """
+   values = []
+   index = HEADER_SIZE
+   for _ in range( record[8] ):
+      arg_type = record[index]
+      index += 1
+      if arg_type == ARG_INT32:
+         values.append( struct.unpack_from( "<i", record, index )[0] )
+         index += 4
+      elif arg_type == ARG_UINT32:
+         values.append( struct.unpack_from( "<I", record, index )[0] )
+         index += 4
+      elif arg_type == ARG_INT64:
+         values.append( struct.unpack_from( "<q", record, index )[0] )
+         index += 8
+      elif arg_type == ARG_UINT64:
+         values.append( struct.unpack_from( "<Q", record, index )[0] )
+         index += 8
+      elif arg_type == ARG_DOUBLE:
+         values.append( struct.unpack_from( "<d", record, index )[0] )
+         index += 8
+      elif arg_type == ARG_POINTER:
+         values.append( "0x%08x" % struct.unpack_from( "<Q", record, index )[0] )
+         index += 8
+      elif arg_type == ARG_STRING:
+         length = record[index]
+         values.append( record[index + 1 : index + 1 + length].decode( "latin-1" ) )
+         index += 1 + length
+      else:
+         break
+   return values
+
+class TimestampExtender:
+   """
+   Extend the 32-bit time stamps in microseconds, which wrap around every 71 minutes, assuming the records arrive in order.
+   """
+   def __init__( self ):
+      self.last = None
+      self.base = 0
+
+   def extend( self, timestamp_us ):
+      if self.last is not None and timestamp_us < self.last:
+         self.base += 1 << 32
+      self.last = timestamp_us
+      return self.base + timestamp_us
+
+def format_timestamp( timestamp_us ):
+   """
+   Format a time stamp in microseconds as milliseconds with a fraction, in line with the tick in ms of the text mode.
+   """
+   return "%08d.%03d" % divmod( timestamp_us, 1000 )
+
+def read_varint( record, index ):
+   """
+   Read a LEB128 varint, and return its value and the index after it.
+   """
+   value = 0
+   shift = 0
+   while index < len( record ):
+      byte = record[index]
+      index += 1
+      value |= ( byte & 0x7F ) << shift
+      shift += 7
+      if not byte & 0x80:
+         break
+   return value, index
+
+def parse_fields( record ):
+   """
+   Parse the fields of a structured record into Python values.
+   """
+   values = []
+   index = HEADER_SIZE
+   while index < len( record ):
+      field_type = record[index]
+      index += 1
+      if field_type == FIELD_UINT:
+         value, index = read_varint( record, index )
+      elif field_type == FIELD_SINT:
+         value, index = read_varint( record, index )
+         value = ( value >> 1 ) ^ -( value & 1 )
+      elif field_type == FIELD_FLOAT:
+         value = struct.unpack_from( "<f", record, index )[0]
+         index += 4
+      elif field_type == FIELD_DOUBLE:
+         value = struct.unpack_from( "<d", record, index )[0]
+         index += 8
+      elif field_type in ( FIELD_FALSE, FIELD_TRUE ):
+         value = field_type == FIELD_TRUE
+      elif field_type == FIELD_STRING:
+         length, index = read_varint( record, index )
+         value = record[index : index + length].decode( "latin-1" )
+         index += length
+      else:
+         break
+      values.append( value )
+   return values
+
+def is_kv_record( record ):
+   """
+   Tell a structured record from a deferred one, by the marker in place of the number of arguments.
+   """
+   return record[8] == KV_MARKER
+
+def kv_to_dict( record, events, timestamp_us ):
+   """
+   Convert a structured record into a dictionary of its time stamp, event name and fields, where the fields dropped on the target are left out.
+   """
+   event_id = struct.unpack_from( "<I", record, 0 )[0]
+   values = parse_fields( record )
+   entry = { "ts_us": timestamp_us }
+   if event_id in events:
+      name, keys = events[event_id]
+      entry["event"] = name
+      entry.update( zip( keys, values ) )
+   else:
+      entry["event"] = "0x%08x" % event_id
+      entry["values"] = values
+   return entry
+
+def format_kv_record( record, events, timestamp_us ):
+   """
+   Format a structured record as text, i.e., the event name followed by key=value pairs.
+   """
+   entry = kv_to_dict( record, events, timestamp_us )
+   fields = " ".join( "%s=%s" % ( key, json.dumps( value ) ) for key, value in entry.items() if key not in ( "ts_us", "event" ) )
+   return "%s: %s %s" % ( format_timestamp( timestamp_us ), entry["event"], fields )
+
+def format_record( record, formats, timestamp_us=None ):
+   """
+   Format a record in the same way as the text mode of LOGGING, with the time stamp extended by the caller if given.
+   """
+   record_us = struct.unpack_from( "<I", record, 4 )[0]
+   timestamp = format_timestamp( record_us if timestamp_us is None else timestamp_us )
+   return "%s: %s" % ( timestamp, format_message( record, formats ) )
+
+def format_message( record, formats ):
+   """
+   Format the message of a record, without the time stamp.
+   """
+   format_id = struct.unpack_from( "<I", record, 0 )[0]
+   values = parse_args( record )
+   fmt = formats.get( format_id )
+   if fmt is None:
+      return "<unknown format 0x%08x> %s" % ( format_id, " ".join( str( value ) for value in values ) )
+
+   # Each conversion is applied on its own, so that a mismatch or an argument dropped on the target, shown as '?', spoils only itself
+   parts = []
+   last = 0
+   arg_index = 0
+   for match in CONVERSION_PATTERN.finditer( fmt ):
+      parts.append( fmt[last : match.start()] )
+      last = match.end()
+      flags, conversion = match.group( 1 ), match.group( 2 )
+      if conversion == "%":
+         parts.append( "%" )
+         continue
+      value = values[arg_index] if arg_index < len( values ) else "?"
+      arg_index += 1
+      if conversion == "p" or isinstance( value, str ):
+         conversion = "s"
+      try:
+         parts.append( ( "%" + flags + conversion ) % value )
+      except ( TypeError, ValueError, OverflowError ):
+         parts.append( str( value ) )
+   parts.append( fmt[last:] )
+   return "".join( parts )
+
+def decode_stream( read, formats, events, output, as_json=False ):
+   """
+   Split the stream on the frame delimiter, and print the records and any text in between as they arrive,
+   either as text or as JSON lines, where the text in between is given as it is under "text".
+   """
+   pending = b""
+   extender = TimestampExtender()
+   while True:
+      data = read()
+      if not data:
+         break
+      pending += data
+      *chunks, pending = pending.split( b"\x00" )
+      for chunk in chunks:
+         if not chunk:
+            continue
+         record = decode_frame( chunk )
+         if record is None:
+            text = chunk.decode( "latin-1" )
+            if not as_json:
+               output.write( text )
+            elif text.strip():
+               print( json.dumps( { "text": text.strip() } ), file=output )
+            continue
+
+         timestamp_us = extender.extend( struct.unpack_from( "<I", record, 4 )[0] )
+         if is_kv_record( record ):
+            if as_json:
+               print( json.dumps( kv_to_dict( record, events, timestamp_us ) ), file=output )
+            else:
+               print( format_kv_record( record, events, timestamp_us ), file=output )
+         elif as_json:
+            print( json.dumps( { "ts_us": timestamp_us, "message": format_message( record, formats ) } ), file=output )
+         else:
+            print( format_record( record, formats, timestamp_us ), file=output )
+      output.flush()
+   if pending:
+      if not as_json:
+         output.write( pending.decode( "latin-1" ) )
+      elif pending.strip():
+         print( json.dumps( { "text": pending.decode( "latin-1" ).strip() } ), file=output )
+
+def main():
+   """
+   A host tool that decodes the binary log records sent by the target built with USE_DEFERRED_LOGGER, and the structured ones of LOG_KV.
+   """
+   script_dir = os.path.dirname( os.path.abspath( __file__ ) )
+   parser = argparse.ArgumentParser( description="Decoder of the deferred log records." )
+   parser.add_argument( "--source", type=str, action="append", help="Source directory to look for the format strings in, which can be repeated (default: the source tree)." )
+   parser.add_argument( "--port", type=str, help="Serial port to read from (e.g., /dev/ttyACM0), which requires pyserial." )
+   parser.add_argument( "--baudrate", type=int, default=115200, help="Baud rate of the serial port." )
+   parser.add_argument( "--file", type=str, help="Captured stream to read from, instead of the standard input." )
+   parser.add_argument( "--json", action="store_true", help="Print JSON lines, e.g., for the log collectors, instead of text." )
+
+   args = parser.parse_args()
+
+   formats, events = load_formats( args.source or [ os.path.dirname( script_dir ) ] )
+   print( f"{len( formats )} format strings and {len( events )} events loaded.", file=sys.stderr )
+
+   if args.port:
+      import serial
+      with serial.Serial( args.port, args.baudrate ) as port:
+         decode_stream( lambda: port.read( port.in_waiting or 1 ), formats, events, sys.stdout, args.json )
+   elif args.file:
+      with open( args.file, "rb" ) as f:
+         decode_stream( lambda: f.read( 4096 ), formats, events, sys.stdout, args.json )
+   else:
+      decode_stream( lambda: sys.stdin.buffer.read1( 4096 ), formats, events, sys.stdout, args.json )
+
+if __name__ == "__main__":
+   main()
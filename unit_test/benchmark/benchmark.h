@@ -0,0 +1,126 @@
+/************************************************************************************************************
+ *
+ * @file benchmark.h
+ * @brief Minimal helpers for host benchmarks of the library modules.
+ * @details Benchmarks are built as separate executables next to the unit tests, and they are not registered to CTest
+ *          so that the test runs stay fast. Run them manually from the build directory, preferably with a Release build.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-06
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************** Includes ************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#define BENCH_HAS_TSC
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#define BENCH_HAS_TSC
+#endif
+
+namespace bench
+{
+/************************************************** Types ***************************************************/
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Run a function a number of times and measure the elapsed time.
+ *
+ * @param iterations number of times to run the function
+ * @param function the function to be measured
+ * @return double the elapsed time in seconds
+ */
+template<typename Function>
+double measureSeconds( uint64_t iterations, Function&& function )
+{
+   const auto started = Clock::now();
+   for ( uint64_t i = 0; i < iterations; i++ )
+   {
+      function();
+   }
+   return std::chrono::duration<double>( Clock::now() - started ).count();
+}
+
+/**
+ * @brief Print a throughput result in MB/s.
+ */
+inline void reportThroughput( const char* name, uint64_t bytes, double seconds )
+{
+   printf( "%-40s %10.2f MB/s\n", name, ( static_cast<double>( bytes ) / ( 1024.0 * 1024.0 ) ) / seconds );
+}
+
+/**
+ * @brief Print a per-operation cost in nanoseconds.
+ */
+inline void reportPerOperation( const char* name, uint64_t operations, double seconds )
+{
+   printf( "%-40s %10.2f ns/op\n", name, ( seconds * 1e9 ) / static_cast<double>( operations ) );
+}
+
+/**
+ * @brief Read the cycle counter, i.e., the time stamp counter on x86, or nanoseconds from the steady clock elsewhere.
+ * @note The TSC runs at a constant rate on modern CPUs, which may differ from the core clock, so use it to compare results on the same machine.
+ */
+inline uint64_t readCycles( )
+{
+#if defined( BENCH_HAS_TSC )
+   return __rdtsc();
+#else
+   return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now().time_since_epoch() ).count() );
+#endif
+}
+
+/**
+ * @brief Run a function a number of times and measure the elapsed cycles.
+ *
+ * @param iterations number of times to run the function
+ * @param function the function to be measured
+ * @return double the average number of cycles per run
+ */
+template<typename Function>
+double measureCycles( uint64_t iterations, Function&& function )
+{
+   const auto started = readCycles();
+   for ( uint64_t i = 0; i < iterations; i++ )
+   {
+      function();
+   }
+   return static_cast<double>( readCycles() - started ) / static_cast<double>( iterations );
+}
+
+/**
+ * @brief Print a per-operation cost in cycles.
+ */
+inline void reportCycles( const char* name, double cyclesPerOperation )
+{
+#if defined( BENCH_HAS_TSC )
+   printf( "%-40s %10.2f cycles/op\n", name, cyclesPerOperation );
+#else
+   printf( "%-40s %10.2f ns/op\n", name, cyclesPerOperation );
+#endif
+}
+
+/**
+ * @brief Keep the compiler from optimizing away a scalar value computed in a benchmark.
+ * @details An empty asm statement taking the value is opaque to the compiler, so the value must be computed, without any store to memory.
+ */
+template<typename T>
+inline void doNotOptimize( T value )
+{
+#if defined( _MSC_VER )
+   [[maybe_unused]] static volatile T sink;
+   sink = value;
+#else
+   asm volatile( "" : : "g"( value ) : "memory" );
+#endif
+}
+} /* namespace bench */
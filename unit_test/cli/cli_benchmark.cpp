@@ -0,0 +1,100 @@
+/************************************************************************************************************
+ *
+ * @file cli_benchmark.cpp
+ * @brief Host benchmark of the command lookup of the CLI against the size of the command table
+ * @details The binary search of CLI::findCommand() over the sorted table is compared with a linear walk with strcmp over the same table,
+ *          which is how the commands used to be looked up. Every command is looked up in turn, along with a name which is not in the table.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-18
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "cli.h"
+#include "benchmark.h"
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+/************************************************** Consts **************************************************/
+constexpr uint64_t ITERATIONS     = 2000000;
+constexpr size_t   MAX_COMMANDS   = 512;
+constexpr size_t   NAME_LENGTH    = 12;
+
+/*********************************************** Local Variables *********************************************/
+static char names[MAX_COMMANDS + 1][NAME_LENGTH];
+
+/*********************************************** Function Definitions ****************************************/
+static void doNothing( int argc, char* argv[] )
+{
+   ( void )argc;
+   ( void )argv;
+}
+
+static const lib::CLI::CommandEntry* findLinear( const lib::CLI::CommandEntry commands[], size_t numCommands, const char* name )
+{
+   for ( size_t i = 0; i < numCommands; i++ )
+   {
+      if ( strcmp( commands[i].commandName, name ) == 0 )
+      {
+         return &commands[i];
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * @brief Measure the cycles per lookup of a table of the given size, with both of the lookups.
+ */
+static void runBenchmark( size_t numCommands )
+{
+   //!< Built at runtime here, as the size varies, and sorted as makeCommandTable() does at compile time
+   std::vector<lib::CLI::CommandEntry> commands;
+   for ( size_t i = 0; i < numCommands; i++ )
+   {
+      commands.push_back( { names[i], doNothing } );
+   }
+   std::sort( commands.begin(), commands.end(), []( const auto& a, const auto& b ) { return strcmp( a.commandName, b.commandName ) < 0; } );
+
+   size_t next = 0;
+   auto nextName = [&]()
+   {
+      next = ( next == numCommands ) ? 0 : ( next + 1 );
+      return names[( next == numCommands ) ? MAX_COMMANDS : next];
+   };
+
+   const auto linearCycles = bench::measureCycles( ITERATIONS, [&]()
+   {
+      bench::doNotOptimize( findLinear( commands.data(), commands.size(), nextName() ) );
+   } );
+
+   const auto binaryCycles = bench::measureCycles( ITERATIONS, [&]()
+   {
+      bench::doNotOptimize( lib::CLI::findCommand( commands.data(), commands.size(), nextName() ) );
+   } );
+
+   char label[64];
+   snprintf( label, sizeof( label ), "%zu commands: linear strcmp", numCommands );
+   bench::reportCycles( label, linearCycles );
+   snprintf( label, sizeof( label ), "%zu commands: binary search", numCommands );
+   bench::reportCycles( label, binaryCycles );
+}
+
+int main( )
+{
+   //!< Names sharing a prefix, as the commands of a diagnostic build tend to
+   for ( size_t i = 0; i < MAX_COMMANDS; i++ )
+   {
+      snprintf( names[i], sizeof( names[i] ), "diag%03zu", i );
+   }
+   snprintf( names[MAX_COMMANDS], sizeof( names[MAX_COMMANDS] ), "unknown" );
+
+   for ( size_t numCommands : { 4, 16, 64, 256, 512 } )
+   {
+      runBenchmark( numCommands );
+   }
+   return 0;
+}
@@ -13,17 +13,32 @@
  /************************************************** Includes ************************************************/
 #include "ring_buffer.h"
 #include "cli.h"
-#include "mock_Semaphore.h"
+#include "mock_semaphore.h"
 #include <gtest/gtest.h>
+#include <string>
 
 /*********************************************** Global Variables ********************************************/
 SemaphoreMock* g_mockSemaphore;
 
 /*********************************************** Local Variables *********************************************/
-static lib::CLI::CommandEntry cliCommands[] =
+static std::string executed;        //!< The commands executed with their arguments
+
+static void recordCommand( int argc, char* argv[] )
 {
-   { "test", []( int argc, char* argv[] ) {} },
-};
+   for ( int i = 0; i < argc; i++ )
+   {
+      executed += ( i == 0 ) ? "" : " ";
+      executed += argv[i];
+   }
+}
+
+static constexpr auto cliCommands = lib::CLI::makeCommandTable(
+{
+   { "test", recordCommand },
+   { "loglevel", recordCommand },
+   { "wifi", recordCommand },
+   { "serialstats", recordCommand },
+} );
 
 /*********************************************** Function Definitions ****************************************/
 namespace lib
@@ -32,7 +47,7 @@ namespace lib
 CLI& CLI::getInstance()
 {
    static char buffer[128];
-   static lib::CLI instance{ buffer, sizeof( buffer ), "\r\n", cliCommands, sizeof(cliCommands) / sizeof(cliCommands[0]), *g_mockSemaphore};
+   static lib::CLI instance{ buffer, sizeof( buffer ), "\r\n", cliCommands.data(), cliCommands.size(), *g_mockSemaphore};
    return instance;
 }
 }
@@ -44,6 +59,7 @@ protected:
    void SetUp() override
    { 
 		g_mockSemaphore = &m_semaphoreMock;
+      executed.clear();
    }
 
    void TearDown() override
@@ -64,7 +80,8 @@ TEST_F( CliTest, test_tokenize_works_properly )
    auto& cli = lib::CLI::getInstance();
 
    char* argv[10];
-   int argc = cli.tokenize( str, argv, 10 );
+   int argc = 0;
+   EXPECT_EQ( cli.tokenize( str, argv, 10, argc ), LibErrorCodes::eOK );
 
    EXPECT_EQ( argc, 5 );
    EXPECT_STREQ( argv[0], "command" );
@@ -95,3 +112,215 @@ TEST_F( CliTest, test_putting_characters_and_getting_new_lines_work_properly )
    memset( bufferNewCommand, 0, sizeof( bufferNewCommand ) );
    cli.getNewCommandLine( bufferNewCommand, sizeof( bufferNewCommand ) );
 }
+
+TEST_F( CliTest, test_command_table_is_sorted_at_compile_time )
+{
+   static_assert( std::string_view{ cliCommands[0].commandName } == "loglevel" );
+   static_assert( std::string_view{ cliCommands[3].commandName } == "wifi" );
+
+   for ( size_t i = 1; i < cliCommands.size(); i++ )
+   {
+      EXPECT_LT( strcmp( cliCommands[i - 1].commandName, cliCommands[i].commandName ), 0 );
+   }
+}
+
+TEST_F( CliTest, test_find_command_looks_up_every_entry )
+{
+   for ( const auto& entry : cliCommands )
+   {
+      EXPECT_EQ( lib::CLI::findCommand( cliCommands.data(), cliCommands.size(), entry.commandName ), &entry );
+   }
+
+   EXPECT_EQ( lib::CLI::findCommand( cliCommands.data(), cliCommands.size(), "aaa" ), nullptr );
+   EXPECT_EQ( lib::CLI::findCommand( cliCommands.data(), cliCommands.size(), "tes" ), nullptr );
+   EXPECT_EQ( lib::CLI::findCommand( cliCommands.data(), cliCommands.size(), "zzz" ), nullptr );
+   EXPECT_EQ( lib::CLI::findCommand( cliCommands.data(), 0, "test" ), nullptr );
+}
+
+TEST_F( CliTest, test_process_input_executes_matched_command )
+{
+   auto& cli = lib::CLI::getInstance();
+
+   char input[] = "wifi AT\r\n";
+   EXPECT_EQ( cli.processInput( input ), LibErrorCodes::eOK );
+   EXPECT_EQ( executed, "wifi AT" );
+
+   executed.clear();
+   char unknown[] = "unknown arg\r\n";
+   EXPECT_EQ( cli.processInput( unknown ), LibErrorCodes::eCLI_UNKNOWN_COMMAND );
+   EXPECT_EQ( executed, "" );
+
+   char empty[] = "  \r\n";
+   EXPECT_EQ( cli.processInput( empty ), LibErrorCodes::eOK );
+}
+
+TEST_F( CliTest, test_initialize_accepts_sorted_table )
+{
+   auto& cli = lib::CLI::getInstance();
+
+   EXPECT_CALL( m_semaphoreMock, initialize( ::testing::_, ::testing::_ ) ).WillOnce( ::testing::Return( LibErrorCodes::eOK ) );
+   EXPECT_EQ( cli.initialize(), LibErrorCodes::eOK );
+}
+
+TEST_F( CliTest, test_tokenize_keeps_quoted_separators )
+{
+   char str[] = "wifi \"AT+CWJAP=\\\"my ssid\\\",\\\"pass word\\\"\" 'single  quoted'\r\n";
+   auto& cli = lib::CLI::getInstance();
+
+   char* argv[lib::CLI::MAX_ARGS];
+   int argc = 0;
+   EXPECT_EQ( cli.tokenize( str, argv, lib::CLI::MAX_ARGS, argc ), LibErrorCodes::eOK );
+
+   ASSERT_EQ( argc, 3 );
+   EXPECT_STREQ( argv[0], "wifi" );
+   EXPECT_STREQ( argv[1], "AT+CWJAP=\"my ssid\",\"pass word\"" );
+   EXPECT_STREQ( argv[2], "single  quoted" );
+}
+
+TEST_F( CliTest, test_tokenize_collapses_tabs_and_spaces )
+{
+   char str[] = "\t cmd \t a\t\tb  \r\n";
+   auto& cli = lib::CLI::getInstance();
+
+   char* argv[lib::CLI::MAX_ARGS];
+   int argc = 0;
+   EXPECT_EQ( cli.tokenize( str, argv, lib::CLI::MAX_ARGS, argc ), LibErrorCodes::eOK );
+
+   ASSERT_EQ( argc, 3 );
+   EXPECT_STREQ( argv[0], "cmd" );
+   EXPECT_STREQ( argv[1], "a" );
+   EXPECT_STREQ( argv[2], "b" );
+}
+
+TEST_F( CliTest, test_tokenize_takes_escaped_and_empty_arguments )
+{
+   char str[] = "cmd a\\ b \"\" x\"y z\"w\r\n";
+   auto& cli = lib::CLI::getInstance();
+
+   char* argv[lib::CLI::MAX_ARGS];
+   int argc = 0;
+   EXPECT_EQ( cli.tokenize( str, argv, lib::CLI::MAX_ARGS, argc ), LibErrorCodes::eOK );
+
+   ASSERT_EQ( argc, 4 );
+   EXPECT_STREQ( argv[1], "a b" );
+   EXPECT_STREQ( argv[2], "" );
+   EXPECT_STREQ( argv[3], "xy zw" );
+}
+
+TEST_F( CliTest, test_tokenize_reports_overflow_and_unterminated_quote )
+{
+   auto& cli = lib::CLI::getInstance();
+   char* argv[3];
+   int argc = 0;
+
+   char tooMany[] = "a b c d\r\n";
+   EXPECT_EQ( cli.tokenize( tooMany, argv, 3, argc ), LibErrorCodes::eCLI_TOO_MANY_ARGS );
+   ASSERT_EQ( argc, 3 );
+   EXPECT_STREQ( argv[2], "c" );
+
+   char unterminated[] = "a \"b c\r\n";
+   EXPECT_EQ( cli.tokenize( unterminated, argv, 3, argc ), LibErrorCodes::eCLI_UNTERMINATED_QUOTE );
+   ASSERT_EQ( argc, 2 );
+   EXPECT_STREQ( argv[1], "b c" );
+}
+
+TEST_F( CliTest, test_lines_pasted_at_once_are_taken_one_by_one )
+{
+   auto& cli = lib::CLI::getInstance();
+
+   const std::string pasted = "test a\r\nloglevel all info\r\n\r\ntest \"b c\"\r\n";
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 4 );
+   for ( const char c : pasted )
+   {
+      cli.putCharIntoBuffer( c );
+   }
+
+   EXPECT_CALL( m_semaphoreMock, get( ::testing::_ ) ).Times( 4 ).WillRepeatedly( ::testing::Return( LibErrorCodes::eOK ) );
+   char line[64];
+   const char* expected[] = { "test a", "loglevel all info", "", "test \"b c\"" };
+   for ( const char* text : expected )
+   {
+      memset( line, 'x', sizeof( line ) );
+      EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eOK );
+      EXPECT_STREQ( line, text );
+   }
+}
+
+TEST_F( CliTest, test_line_not_fitting_is_truncated_and_next_line_is_kept )
+{
+   auto& cli = lib::CLI::getInstance();
+
+   const std::string pasted = "test abcdef\r\ntest 1\r\n";
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 2 );
+   for ( const char c : pasted )
+   {
+      cli.putCharIntoBuffer( c );
+   }
+
+   EXPECT_CALL( m_semaphoreMock, get( ::testing::_ ) ).Times( 2 ).WillRepeatedly( ::testing::Return( LibErrorCodes::eOK ) );
+   char line[8];
+   EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eCLI_LINE_TOO_LONG );
+   EXPECT_STREQ( line, "test ab" );
+   EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "test 1" );
+}
+
+TEST_F( CliTest, test_line_longer_than_maximum_is_truncated_on_receiving )
+{
+   auto& cli = lib::CLI::getInstance();
+
+   const std::string tooLong = "test " + std::string( lib::CLI::DEFAULT_MAX_LINE_LENGTH, 'a' ) + "\r\n";
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 2 );
+   for ( const char c : tooLong )
+   {
+      cli.putCharIntoBuffer( c );
+   }
+
+   EXPECT_CALL( m_semaphoreMock, get( ::testing::_ ) ).Times( 2 ).WillRepeatedly( ::testing::Return( LibErrorCodes::eOK ) );
+   char line[256];
+   EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eCLI_LINE_TOO_LONG );
+   EXPECT_LE( strlen( line ), lib::CLI::DEFAULT_MAX_LINE_LENGTH );
+   EXPECT_EQ( strncmp( line, "test aaaa", 9 ), 0 );
+
+   for ( const char c : std::string( "test 2\r\n" ) )
+   {
+      cli.putCharIntoBuffer( c );
+   }
+   EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "test 2" );
+}
+
+TEST_F( CliTest, test_full_buffer_drops_whole_lines_without_merging_them )
+{
+   auto& cli = lib::CLI::getInstance();
+   const auto droppedBefore = cli.getDroppedLines();
+
+   //!< 3 lines of 41 bytes each with their ends, where the 4th one fits only partly in the 128 bytes, and the 5th one doesn't fit at all
+   const std::string fullLine = "test " + std::string( 34, 'b' ) + "\r\n";
+   const std::string pasted = fullLine + fullLine + fullLine + "test zzzz\r\n" + "test 5\r\n";
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 4 );
+   for ( const char c : pasted )
+   {
+      cli.putCharIntoBuffer( c );
+   }
+   EXPECT_EQ( cli.getDroppedLines(), droppedBefore + 1 );
+
+   EXPECT_CALL( m_semaphoreMock, get( ::testing::_ ) ).Times( 5 ).WillRepeatedly( ::testing::Return( LibErrorCodes::eOK ) );
+   char line[64];
+   for ( int i = 0; i < 3; i++ )
+   {
+      EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eOK );
+      EXPECT_EQ( std::string( line ), fullLine.substr( 0, fullLine.size() - 2 ) );
+   }
+   EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eCLI_LINE_TOO_LONG );
+   EXPECT_STREQ( line, "test" );
+
+   //!< Once drained, the next line is taken as it is
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 1 );
+   for ( const char c : std::string( "test 6\r\n" ) )
+   {
+      cli.putCharIntoBuffer( c );
+   }
+   EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ) ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "test 6" );
+}
@@ -0,0 +1,148 @@
+/************************************************************************************************************
+ *
+ * @file cli_batch_benchmark.cpp
+ * @brief Host benchmark of the commands per second of a provisioning script, line by line over the CLI task against a batch
+ * @details Line by line, every line is put into the CLI byte by byte as the UART interrupt does, and taken with getNewCommandLine() and executed,
+ *          with and without the sleep which the CLI task used to take after every line. The batch executes the same script at once with run(),
+ *          and streamed in chunks with feed(), e.g., as it's received over TCP.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-21
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "cli_batch.h"
+#include "semaphore_std.h"
+#include "benchmark.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+/************************************************** Consts **************************************************/
+constexpr size_t   NUM_LINES            = 1000;
+constexpr uint64_t ITERATIONS           = 100;
+constexpr size_t   NUM_SLEEPING_LINES   = 50;       //!< Fewer, as every line takes the sleep
+constexpr uint32_t SLEEP_MS             = 10;       //!< The osDelay() after every line of the CLI task
+constexpr size_t   CHUNK_SIZE           = 64;
+
+/*********************************************** Local Variables *********************************************/
+static uint64_t commandsExecuted{ 0 };
+
+/*********************************************** Function Definitions ****************************************/
+static void countCommand( int argc, char* argv[] )
+{
+   bench::doNotOptimize( argv[argc - 1] );
+   commandsExecuted++;
+}
+
+static constexpr auto cliCommands = lib::CLI::makeCommandTable(
+{
+   { "config", countCommand },
+   { "loglevel", countCommand },
+   { "set", countCommand },
+} );
+
+namespace lib
+{
+//!< Singleton instance accessor
+CLI& CLI::getInstance()
+{
+   static char buffer[256];
+   static lib::Semaphore_Std semaphore;
+   static lib::CLI instance{ buffer, sizeof( buffer ), "\r\n", cliCommands.data(), cliCommands.size(), semaphore };
+   return instance;
+}
+}
+
+/**
+ * @brief Build a script of the given lines, as a provisioning script looks like.
+ */
+static std::string makeScript( size_t numLines )
+{
+   std::string script;
+   char line[64];
+   for ( size_t i = 0; i < numLines; i++ )
+   {
+      snprintf( line, sizeof( line ), "set key%03zu \"value %zu\"\r\n", i, i );
+      script += line;
+   }
+   return script;
+}
+
+/**
+ * @brief Execute a script line by line, as the CLI task does, where every line is received before the next one is sent.
+ */
+static void runLineByLine( const std::string& script, uint32_t sleep_ms )
+{
+   auto& cli = lib::CLI::getInstance();
+   char buffer[128];
+
+   size_t start = 0;
+   while ( start < script.size() )
+   {
+      const size_t end = script.find( '\n', start ) + 1;
+      for ( size_t i = start; i < end; i++ )
+      {
+         cli.putCharIntoBuffer( script[i] );
+      }
+      start = end;
+
+      memset( buffer, 0, sizeof( buffer ) );
+      if ( cli.getNewCommandLine( buffer, sizeof( buffer ) - 1, 0 ) == LibErrorCodes::eOK )
+      {
+         (void)cli.processInput( buffer );
+      }
+
+      if ( sleep_ms > 0 )
+      {
+         std::this_thread::sleep_for( std::chrono::milliseconds( sleep_ms ) );
+      }
+   }
+}
+
+static void report( const char* name, uint64_t commands, double seconds )
+{
+   printf( "%-40s %10.0f commands/s\n", name, static_cast<double>( commands ) / seconds );
+}
+
+int main( )
+{
+   auto& cli = lib::CLI::getInstance();
+   (void)cli.initialize();
+
+   const auto script = makeScript( NUM_LINES );
+   const auto shortScript = makeScript( NUM_SLEEPING_LINES );
+
+   commandsExecuted = 0;
+   auto seconds = bench::measureSeconds( 1, [&]() { runLineByLine( shortScript, SLEEP_MS ); } );
+   report( "line by line, 10 ms sleep per line", commandsExecuted, seconds );
+
+   commandsExecuted = 0;
+   seconds = bench::measureSeconds( ITERATIONS, [&]() { runLineByLine( script, 0 ); } );
+   report( "line by line, no sleep", commandsExecuted, seconds );
+
+   commandsExecuted = 0;
+   seconds = bench::measureSeconds( ITERATIONS, [&]() { bench::doNotOptimize( lib::CliBatch::run( cli, script.c_str(), true ).executed ); } );
+   report( "batch, run() from flash", commandsExecuted, seconds );
+
+   char line[lib::CliBatch::LINE_SIZE];
+   lib::CliBatch batch{ cli, line, sizeof( line ) };
+   commandsExecuted = 0;
+   seconds = bench::measureSeconds( ITERATIONS, [&]()
+   {
+      batch.start( true );
+      for ( size_t offset = 0; offset < script.size(); offset += CHUNK_SIZE )
+      {
+         batch.feed( script.data() + offset, std::min( CHUNK_SIZE, script.size() - offset ) );
+      }
+      batch.finish();
+   } );
+   report( "batch, feed() in 64 B chunks", commandsExecuted, seconds );
+   return 0;
+}
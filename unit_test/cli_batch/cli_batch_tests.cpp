@@ -0,0 +1,203 @@
+/************************************************************************************************************
+ *
+ * @file cli_batch_tests.cpp
+ * @brief Unit tests for the CliBatch class
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-21
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "cli_batch.h"
+#include "semaphore_std.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+/************************************************** Consts **************************************************/
+constexpr ErrorCode COMMAND_FAILED = 0x1234;
+
+/*********************************************** Local Variables *********************************************/
+static std::vector<std::string>                       executed;     //!< The commands executed with their arguments, in order
+static std::vector<std::pair<uint32_t, ErrorCode>>    results;      //!< The results reported, with their line numbers
+
+/*********************************************** Function Definitions ****************************************/
+static void recordCommand( int argc, char* argv[] )
+{
+   std::string line;
+   for ( int i = 0; i < argc; i++ )
+   {
+      line += ( i == 0 ) ? "" : " ";
+      line += argv[i];
+   }
+   executed.push_back( line );
+}
+
+//!< Fails the line, as a command finding its arguments wrong does
+static void failCommand( int argc, char* argv[] )
+{
+   recordCommand( argc, argv );
+   lib::CLI::getInstance().setCommandError( COMMAND_FAILED );
+}
+
+static void recordResult( void* context, uint32_t lineNumber, ErrorCode result )
+{
+   ( void )context;
+   results.emplace_back( lineNumber, result );
+}
+
+static constexpr auto cliCommands = lib::CLI::makeCommandTable(
+{
+   { "set", recordCommand },
+   { "fail", failCommand },
+} );
+
+namespace lib
+{
+//!< Singleton instance accessor
+CLI& CLI::getInstance()
+{
+   static char buffer[64];
+   static lib::Semaphore_Std semaphore;
+   static lib::CLI instance{ buffer, sizeof( buffer ), "\r\n", cliCommands.data(), cliCommands.size(), semaphore };
+   return instance;
+}
+}
+
+/************************************************** Test Fixture ********************************************/
+class CliBatchTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      executed.clear();
+      results.clear();
+   }
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( CliBatchTest, test_command_error_is_returned_once )
+{
+   auto& cli = lib::CLI::getInstance();
+   char line[32];
+
+   snprintf( line, sizeof( line ), "fail now" );
+   EXPECT_EQ( cli.processInput( line ), COMMAND_FAILED );
+   snprintf( line, sizeof( line ), "set after" );
+   EXPECT_EQ( cli.processInput( line ), LibErrorCodes::eOK );
+}
+
+TEST_F( CliBatchTest, test_runs_script_in_order_and_reports_every_line )
+{
+   const char* script =
+      "# provisioning\n"
+      "set a 1\r\n"
+      "\n"
+      "   \n"
+      "set \"b c\" 2\n"
+      "  # indented comment\n"
+      "set d";
+
+   const auto summary = lib::CliBatch::run( lib::CLI::getInstance(), script, true, recordResult );
+
+   ASSERT_EQ( executed.size(), 3u );
+   EXPECT_EQ( executed[0], "set a 1" );
+   EXPECT_EQ( executed[1], "set b c 2" );
+   EXPECT_EQ( executed[2], "set d" );
+
+   //!< The line numbers match the script, blank lines and comments included
+   const std::vector<std::pair<uint32_t, ErrorCode>> expected{ { 2, LibErrorCodes::eOK }, { 5, LibErrorCodes::eOK }, { 7, LibErrorCodes::eOK } };
+   EXPECT_EQ( results, expected );
+   EXPECT_EQ( summary.lines, 7u );
+   EXPECT_EQ( summary.executed, 3u );
+   EXPECT_EQ( summary.failed, 0u );
+   EXPECT_EQ( summary.firstFailedLine, 0u );
+}
+
+TEST_F( CliBatchTest, test_stops_on_first_error )
+{
+   const char* script =
+      "set 1\n"
+      "unknown\n"
+      "set 2\n"
+      "fail\n";
+
+   const auto summary = lib::CliBatch::run( lib::CLI::getInstance(), script, true, recordResult );
+
+   ASSERT_EQ( executed.size(), 1u );
+   EXPECT_EQ( summary.executed, 2u );
+   EXPECT_EQ( summary.failed, 1u );
+   EXPECT_EQ( summary.skipped, 2u );
+   EXPECT_EQ( summary.firstFailedLine, 2u );
+   EXPECT_EQ( summary.firstError, LibErrorCodes::eCLI_UNKNOWN_COMMAND );
+   EXPECT_EQ( results.size(), 2u );
+}
+
+TEST_F( CliBatchTest, test_continues_after_errors_unless_asked_to_stop )
+{
+   const char* script =
+      "set 1\n"
+      "fail\n"
+      "set \"open\n"
+      "set 2\n";
+
+   const auto summary = lib::CliBatch::run( lib::CLI::getInstance(), script, false, recordResult );
+
+   ASSERT_EQ( executed.size(), 3u );
+   EXPECT_EQ( executed[2], "set 2" );
+   EXPECT_EQ( summary.executed, 4u );
+   EXPECT_EQ( summary.failed, 2u );
+   EXPECT_EQ( summary.skipped, 0u );
+   EXPECT_EQ( summary.firstFailedLine, 2u );
+   EXPECT_EQ( summary.firstError, COMMAND_FAILED );
+
+   const std::vector<std::pair<uint32_t, ErrorCode>> expected{ { 1, LibErrorCodes::eOK }, { 2, COMMAND_FAILED },
+                                                               { 3, LibErrorCodes::eCLI_UNTERMINATED_QUOTE }, { 4, LibErrorCodes::eOK } };
+   EXPECT_EQ( results, expected );
+}
+
+TEST_F( CliBatchTest, test_executes_streamed_script_as_lines_complete )
+{
+   const std::string script = "set 1\r\nset 22\r\n# skip\r\nset 333\r\nset 4444";
+   char line[32];
+   lib::CliBatch batch{ lib::CLI::getInstance(), line, sizeof( line ), recordResult };
+
+   //!< Any chunk size gives the same, as the lines are assembled across the chunks
+   for ( size_t chunk = 1; chunk <= 8; chunk++ )
+   {
+      executed.clear();
+      batch.start( true );
+      for ( size_t offset = 0; offset < script.size(); offset += chunk )
+      {
+         batch.feed( script.data() + offset, std::min( chunk, script.size() - offset ) );
+      }
+      EXPECT_EQ( executed.size(), 3u );
+
+      batch.finish();
+      ASSERT_EQ( executed.size(), 4u );
+      EXPECT_EQ( executed[3], "set 4444" );
+      EXPECT_EQ( batch.getSummary().lines, 5u );
+      EXPECT_EQ( batch.getSummary().executed, 4u );
+   }
+}
+
+TEST_F( CliBatchTest, test_fails_line_too_long )
+{
+   char line[8];
+   lib::CliBatch batch{ lib::CLI::getInstance(), line, sizeof( line ), recordResult };
+   batch.start( true );
+
+   const std::string script = "set 1\nset 1234567\nset 2\n";
+   batch.feed( script.data(), script.size() );
+   batch.finish();
+
+   ASSERT_EQ( executed.size(), 1u );
+   EXPECT_TRUE( batch.isStopped() );
+   EXPECT_EQ( batch.getSummary().firstFailedLine, 2u );
+   EXPECT_EQ( batch.getSummary().firstError, LibErrorCodes::eCLI_LINE_TOO_LONG );
+   EXPECT_EQ( batch.getSummary().skipped, 1u );
+}
@@ -0,0 +1,438 @@
+/************************************************************************************************************
+ *
+ * @file cli_server_tests.cpp
+ * @brief Unit tests for the CliSession class and the BasicCliServer class template, over an in-memory transport, along with a command executor
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "cli_server.h"
+#include "command_executor.h"
+#include "lockable_std.h"
+#include "semaphore_std.h"
+#include "logger_port_std.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/************************************************** Types ***************************************************/
+struct TestServerConfig : lib::CliServerConfig
+{
+   constexpr static size_t MAX_SESSIONS = 2;
+};
+
+using TestServer   = lib::BasicCliServer<lib::LockableStd, lib::Semaphore_Std, lib::LoggerPortStd, TestServerConfig>;
+using TestExecutor = lib::BasicCommandExecutor<lib::LockableStd, lib::Semaphore_Std, lib::LoggerPortStd>;
+
+/**
+ * @brief Transport keeping the output in memory, as it's flushed.
+ */
+class MemoryCliTransport final : public lib::ICliTransport
+{
+public:
+   void write( const char* data, size_t length ) override
+   {
+      std::lock_guard<std::mutex> guard( m_mutex );
+      m_pending.append( data, length );
+   }
+
+   void flush( ) override
+   {
+      std::lock_guard<std::mutex> guard( m_mutex );
+      m_output += m_pending;
+      m_pending.clear();
+      m_flushes++;
+   }
+
+   std::string getOutput( )
+   {
+      std::lock_guard<std::mutex> guard( m_mutex );
+      return m_output;
+   }
+
+   size_t getFlushes( )
+   {
+      std::lock_guard<std::mutex> guard( m_mutex );
+      return m_flushes;
+   }
+
+private:
+   std::mutex     m_mutex;
+   std::string    m_pending;
+   std::string    m_output;
+   size_t         m_flushes{ 0 };
+};
+
+/**
+ * @brief Session with its own buffers, as a connection of a transport has.
+ */
+template<size_t RX_SIZE = 64, size_t LINE_SIZE = 32>
+struct TestSession
+{
+   explicit TestSession( const char* name, const char* prompt = nullptr )
+   : session{ name, transport, rxBuffer, RX_SIZE, line, LINE_SIZE, prompt }
+   { }
+
+   size_t receive( const std::string& input )
+   {
+      return session.receive( input.data(), input.size() );
+   }
+
+   MemoryCliTransport   transport;
+   char                 rxBuffer[RX_SIZE]{};
+   char                 line[LINE_SIZE]{};
+   lib::CliSession      session;
+};
+
+/*********************************************** Local Variables *********************************************/
+static TestServer*   currentServer{ nullptr };
+static TestExecutor* currentExecutor{ nullptr };
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Stub of the tick source which is provided by the application on target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   const auto now = std::chrono::steady_clock::now().time_since_epoch();
+   return static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::milliseconds>( now ).count() );
+}
+
+//!< Prints the arguments back, on the session the line came from
+static void echoCommand( int argc, char* argv[] )
+{
+   std::string line;
+   for ( int i = 1; i < argc; i++ )
+   {
+      line += ( i == 1 ) ? "" : " ";
+      line += argv[i];
+   }
+   currentServer->print( "%s", line.c_str() );
+}
+
+//!< Prints from another task, as a command executed by a worker does
+static void otherTaskCommand( int argc, char* argv[] )
+{
+   ( void )argc;
+   ( void )argv;
+   std::thread worker( []() { EXPECT_EQ( currentServer->getCurrentSession(), nullptr ); } );
+   worker.join();
+}
+
+//!< Queues the line to the executor, as the line handler of an application does
+static ErrorCode submitLine( char* line )
+{
+   return currentExecutor->submit( line, nullptr, currentServer->getCurrentSession() );
+}
+
+//!< Looks up the session of the job running, as the session lookup of an application does
+static lib::CliSession* getJobSession( )
+{
+   return currentExecutor->getCurrentSession();
+}
+
+static constexpr auto cliCommands = lib::CLI::makeCommandTable(
+{
+   { "echo", echoCommand },
+   { "other", otherTaskCommand },
+   { "later", echoCommand, lib::CLI::eExecution::ASYNC },
+} );
+
+namespace lib
+{
+//!< Singleton instance accessor, without any input of its own as the sessions assemble the lines
+CLI& CLI::getInstance()
+{
+   static lib::CLI instance{ "\r\n", cliCommands.data(), cliCommands.size() };
+   return instance;
+}
+}
+
+/************************************************** Test Fixture ********************************************/
+class CliServerTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      ASSERT_EQ( lib::CLI::getInstance().initialize(), LibErrorCodes::eOK );
+      m_server = std::make_unique<TestServer>( lib::CLI::getInstance(), m_lockable, m_semaphore );
+      currentServer = m_server.get();
+      ASSERT_EQ( m_server->initialize(), LibErrorCodes::eOK );
+   }
+
+   void TearDown() override
+   {
+      currentServer = nullptr;
+   }
+
+   lib::LockableStd              m_lockable;
+   lib::Semaphore_Std            m_semaphore;
+   std::unique_ptr<TestServer>   m_server;
+};
+
+/************************************************** Tests ***************************************************/
+TEST( CliSessionTest, test_assembles_lines_across_chunks )
+{
+   TestSession<> test( "test" );
+   char* line = nullptr;
+
+   //!< Nothing is received before opened
+   EXPECT_EQ( test.receive( "lost\r\n" ), 0u );
+   EXPECT_TRUE( test.session.open() );
+   EXPECT_FALSE( test.session.open() );
+
+   EXPECT_EQ( test.receive( "ec" ), 2u );
+   EXPECT_EQ( test.session.getLine( line ), LibErrorCodes::eCLI_NO_COMMAND );
+   EXPECT_EQ( test.receive( "ho 1\r\n\r\necho 2\necho 3\r" ), 22u );
+
+   ASSERT_EQ( test.session.getLine( line ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "echo 1" );
+   ASSERT_EQ( test.session.getLine( line ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "echo 2" );
+   ASSERT_EQ( test.session.getLine( line ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "echo 3" );
+   EXPECT_EQ( test.session.getLine( line ), LibErrorCodes::eCLI_NO_COMMAND );
+}
+
+TEST( CliSessionTest, test_skips_telnet_commands_and_nulls )
+{
+   TestSession<> test( "test" );
+   char* line = nullptr;
+   ASSERT_TRUE( test.session.open() );
+
+   //!< IAC WILL NAWS and IAC DO SUPPRESS-GO-AHEAD, as a telnet client sends on connection, and "\r\0" as the end of a line
+   const std::string input( "\xFF\xFB\x1F\xFF\xFD\x03" "echo x\r\0", 14 );
+   EXPECT_EQ( test.receive( input ), input.size() );
+
+   ASSERT_EQ( test.session.getLine( line ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "echo x" );
+   EXPECT_EQ( test.session.getLine( line ), LibErrorCodes::eCLI_NO_COMMAND );
+}
+
+TEST( CliSessionTest, test_truncates_line_too_long_and_holds_back_overflow )
+{
+   TestSession<16, 8> test( "test" );
+   char* line = nullptr;
+   ASSERT_TRUE( test.session.open() );
+
+   //!< Only what fits is taken, so that the transport holds back the rest
+   EXPECT_EQ( test.receive( "0123456789abcdefXYZ" ), 16u );
+   EXPECT_EQ( test.session.getSpace(), 0u );
+   EXPECT_EQ( test.session.getLine( line ), LibErrorCodes::eCLI_NO_COMMAND );
+   EXPECT_EQ( test.receive( "\r\nok\r\n" ), 6u );
+
+   //!< What fits is delivered, and the rest is dropped rather than taken as a line of its own
+   ASSERT_EQ( test.session.getLine( line ), LibErrorCodes::eCLI_LINE_TOO_LONG );
+   EXPECT_STREQ( line, "0123456" );
+   ASSERT_EQ( test.session.getLine( line ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "ok" );
+}
+
+TEST( CliSessionTest, test_reopens_only_after_reset )
+{
+   TestSession<> test( "test" );
+   char* line = nullptr;
+   ASSERT_TRUE( test.session.open() );
+   EXPECT_TRUE( test.session.takeOpened() );
+   EXPECT_FALSE( test.session.takeOpened() );
+   EXPECT_EQ( test.receive( "half a li" ), 9u );
+
+   test.session.close();
+   EXPECT_EQ( test.session.getState(), lib::CliSession::eState::CLOSING );
+   EXPECT_FALSE( test.session.open() );
+   EXPECT_EQ( test.receive( "more" ), 0u );
+
+   test.session.reset();
+   EXPECT_EQ( test.session.getState(), lib::CliSession::eState::FREE );
+   ASSERT_TRUE( test.session.open() );
+
+   //!< Nothing of the previous connection is left over
+   EXPECT_EQ( test.receive( "ne\r\n" ), 4u );
+   ASSERT_EQ( test.session.getLine( line ), LibErrorCodes::eOK );
+   EXPECT_STREQ( line, "ne" );
+}
+
+TEST_F( CliServerTest, test_cli_without_input_gets_no_line )
+{
+   auto& cli = lib::CLI::getInstance();
+   char line[16];
+   cli.putCharIntoBuffer( 'x' );
+   cli.putCharIntoBuffer( '\n' );
+   EXPECT_EQ( cli.getNewCommandLine( line, sizeof( line ), 0 ), LibErrorCodes::eCLI_NO_COMMAND );
+   EXPECT_EQ( cli.getRingBuffer().size(), 0u );
+}
+
+TEST_F( CliServerTest, test_routes_output_to_session_of_line )
+{
+   TestSession<> uart( "uart" );
+   TestSession<> tcp( "tcp", "> " );
+   ASSERT_EQ( m_server->addSession( uart.session ), LibErrorCodes::eOK );
+   ASSERT_EQ( m_server->addSession( tcp.session ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_server->addSession( tcp.session ), LibErrorCodes::eCLI_TOO_MANY_SESSIONS );
+   ASSERT_TRUE( uart.session.open() );
+   ASSERT_TRUE( tcp.session.open() );
+
+   (void)uart.receive( "echo from uart\r\n" );
+   (void)tcp.receive( "echo \"from tcp\"\r\necho again\r\n" );
+   m_server->notifyReceived();
+   m_server->runOnce( 0 );
+
+   EXPECT_EQ( uart.transport.getOutput(), "from uart\r\n" );
+   EXPECT_EQ( tcp.transport.getOutput(), "> from tcp\r\nagain\r\n> " );
+   EXPECT_EQ( tcp.transport.getFlushes(), 1u );
+
+   //!< Nothing is flushed without any input
+   m_server->runOnce( 0 );
+   EXPECT_EQ( uart.transport.getFlushes(), 1u );
+   EXPECT_EQ( m_server->getCurrentSession(), nullptr );
+}
+
+TEST_F( CliServerTest, test_prints_errors_on_session )
+{
+   TestSession<64, 12> tcp( "tcp" );
+   ASSERT_EQ( m_server->addSession( tcp.session ), LibErrorCodes::eOK );
+   ASSERT_TRUE( tcp.session.open() );
+
+   (void)tcp.receive( "unknown\r\necho \"open\r\nway too long\r\n" );
+   m_server->runOnce( 0 );
+
+   char expected[128];
+   snprintf( expected, sizeof( expected ), "ERROR: 0x%08lx\r\nERROR: 0x%08lx\r\nERROR: 0x%08lx\r\n",
+             static_cast<unsigned long>( LibErrorCodes::eCLI_UNKNOWN_COMMAND ), static_cast<unsigned long>( LibErrorCodes::eCLI_UNTERMINATED_QUOTE ),
+             static_cast<unsigned long>( LibErrorCodes::eCLI_LINE_TOO_LONG ) );
+   EXPECT_EQ( tcp.transport.getOutput(), expected );
+}
+
+TEST_F( CliServerTest, test_does_not_route_output_of_other_tasks )
+{
+   TestSession<> tcp( "tcp" );
+   ASSERT_EQ( m_server->addSession( tcp.session ), LibErrorCodes::eOK );
+   ASSERT_TRUE( tcp.session.open() );
+
+   (void)tcp.receive( "other\r\n" );
+   m_server->runOnce( 0 );
+   EXPECT_EQ( tcp.transport.getOutput(), "" );
+}
+
+TEST_F( CliServerTest, test_routes_output_of_job_to_session_of_line )
+{
+   lib::LockableStd executorLockable;
+   lib::Semaphore_Std semJobQueued;
+   TestExecutor executor{ lib::CLI::getInstance(), executorLockable, semJobQueued };
+   ASSERT_EQ( executor.initialize(), LibErrorCodes::eOK );
+   currentExecutor = &executor;
+
+   lib::LockableStd lockable;
+   lib::Semaphore_Std semaphore;
+   TestServer server{ lib::CLI::getInstance(), lockable, semaphore, submitLine, getJobSession };
+   currentServer = &server;
+   ASSERT_EQ( server.initialize(), LibErrorCodes::eOK );
+
+   TestSession<> uart( "uart" );
+   TestSession<> tcp( "tcp", "> " );
+   ASSERT_EQ( server.addSession( uart.session ), LibErrorCodes::eOK );
+   ASSERT_EQ( server.addSession( tcp.session ), LibErrorCodes::eOK );
+   ASSERT_TRUE( uart.session.open() );
+   ASSERT_TRUE( tcp.session.open() );
+
+   (void)tcp.receive( "later from tcp\r\n" );
+   server.runOnce( 0 );
+   EXPECT_EQ( tcp.transport.getOutput(), "> > " );
+
+   //!< Printed by the worker on the session of the line, and flushed right away
+   std::thread worker( [&]() { EXPECT_TRUE( executor.runWorkerOnce( 1000 ) ); } );
+   worker.join();
+   EXPECT_EQ( tcp.transport.getOutput(), "> > from tcp\r\n" );
+   EXPECT_EQ( uart.transport.getOutput(), "" );
+
+   //!< Printed with printf once the session is closed
+   (void)tcp.receive( "later lost\r\n" );
+   server.runOnce( 0 );
+   tcp.session.close();
+   std::thread late( [&]() { EXPECT_TRUE( executor.runWorkerOnce( 1000 ) ); } );
+   late.join();
+   EXPECT_EQ( tcp.transport.getOutput(), "> > from tcp\r\n> " );
+
+   currentExecutor = nullptr;
+}
+
+TEST_F( CliServerTest, test_resets_closed_session_for_next_connection )
+{
+   TestSession<> tcp( "tcp", "> " );
+   ASSERT_EQ( m_server->addSession( tcp.session ), LibErrorCodes::eOK );
+   ASSERT_TRUE( tcp.session.open() );
+   (void)tcp.receive( "echo 1" );
+   tcp.session.close();
+
+   m_server->runOnce( 0 );
+   EXPECT_EQ( tcp.session.getState(), lib::CliSession::eState::FREE );
+   EXPECT_EQ( tcp.transport.getOutput(), "" );
+
+   //!< The next connection is greeted with the prompt
+   ASSERT_TRUE( tcp.session.open() );
+   m_server->runOnce( 0 );
+   EXPECT_EQ( tcp.transport.getOutput(), "> " );
+}
+
+TEST_F( CliServerTest, test_serves_sessions_receiving_concurrently )
+{
+   constexpr int NUM_LINES = 200;
+   TestSession<256, 32> first( "first" );
+   TestSession<256, 32> second( "second" );
+   ASSERT_EQ( m_server->addSession( first.session ), LibErrorCodes::eOK );
+   ASSERT_EQ( m_server->addSession( second.session ), LibErrorCodes::eOK );
+   ASSERT_TRUE( first.session.open() );
+   ASSERT_TRUE( second.session.open() );
+
+   std::atomic<int> producersDone{ 0 };
+   auto produce = [&]( TestSession<256, 32>& test, const char* name )
+   {
+      for ( int i = 0; i < NUM_LINES; i++ )
+      {
+         const std::string line = std::string( "echo " ) + name + " " + std::to_string( i ) + "\r\n";
+         size_t offset = 0;
+         while ( offset < line.size() )
+         {
+            //!< Held back until there is room, as the TCP window does
+            offset += test.session.receive( line.data() + offset, line.size() - offset );
+            m_server->notifyReceived();
+            std::this_thread::yield();
+         }
+      }
+      producersDone++;
+   };
+
+   std::thread serving( [&]()
+   {
+      while ( ( producersDone.load() < 2 ) || ( first.session.getSpace() < 256 ) || ( second.session.getSpace() < 256 ) )
+      {
+         m_server->runOnce( 1 );
+      }
+      m_server->runOnce( 0 );
+   } );
+   std::thread firstProducer( produce, std::ref( first ), "a" );
+   std::thread secondProducer( produce, std::ref( second ), "b" );
+   firstProducer.join();
+   secondProducer.join();
+   serving.join();
+
+   std::string expectedFirst;
+   std::string expectedSecond;
+   for ( int i = 0; i < NUM_LINES; i++ )
+   {
+      expectedFirst += "a " + std::to_string( i ) + "\r\n";
+      expectedSecond += "b " + std::to_string( i ) + "\r\n";
+   }
+   EXPECT_EQ( first.transport.getOutput(), expectedFirst );
+   EXPECT_EQ( second.transport.getOutput(), expectedSecond );
+}
@@ -0,0 +1,281 @@
+/************************************************************************************************************
+ *
+ * @file command_executor_tests.cpp
+ * @brief Unit tests for the BasicCommandExecutor class template over the C++ standard library
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-19
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "command_executor.h"
+#include "lockable_std.h"
+#include "semaphore_std.h"
+#include "logger_port_std.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/************************************************** Types ***************************************************/
+struct TestExecutorConfig : lib::CommandExecutorConfig
+{
+   constexpr static size_t NUM_JOBS  = 2;
+   constexpr static size_t LINE_SIZE = 32;
+};
+
+using TestExecutor = lib::BasicCommandExecutor<lib::LockableStd, lib::Semaphore_Std, lib::LoggerPortStd, TestExecutorConfig>;
+
+/*********************************************** Local Variables *********************************************/
+static std::mutex                mutexExecuted;
+static std::vector<std::string>  executed;               //!< The commands executed with their arguments, in order
+static std::atomic<bool>         isSlowReleased{ false };
+static std::atomic<bool>         isSlowRunning{ false };
+static TestExecutor*             currentExecutor{ nullptr };
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Stub of the tick source which is provided by the application on target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   const auto now = std::chrono::steady_clock::now().time_since_epoch();
+   return static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::milliseconds>( now ).count() );
+}
+
+static void recordCommand( int argc, char* argv[] )
+{
+   std::string line;
+   for ( int i = 0; i < argc; i++ )
+   {
+      line += ( i == 0 ) ? "" : " ";
+      line += argv[i];
+   }
+
+   std::lock_guard<std::mutex> guard( mutexExecuted );
+   executed.push_back( line );
+}
+
+//!< Blocks until released or cancelled, as a command waiting for a response does
+static void slowCommand( int argc, char* argv[] )
+{
+   isSlowRunning.store( true );
+   while ( !isSlowReleased.load() && !currentExecutor->isCancelRequested() )
+   {
+      std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+   }
+   recordCommand( argc, argv );
+   isSlowRunning.store( false );
+}
+
+static constexpr auto cliCommands = lib::CLI::makeCommandTable(
+{
+   { "echo", recordCommand },
+   { "record", recordCommand, lib::CLI::eExecution::ASYNC },
+   { "slow", slowCommand, lib::CLI::eExecution::ASYNC },
+} );
+
+namespace lib
+{
+//!< Singleton instance accessor
+CLI& CLI::getInstance()
+{
+   static char buffer[128];
+   static lib::Semaphore_Std semaphore;
+   static lib::CLI instance{ buffer, sizeof( buffer ), "\r\n", cliCommands.data(), cliCommands.size(), semaphore };
+   return instance;
+}
+}
+
+/************************************************** Test Fixture ********************************************/
+class CommandExecutorTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      executed.clear();
+      isSlowReleased.store( false );
+      isSlowRunning.store( false );
+      m_executor = std::make_unique<TestExecutor>( lib::CLI::getInstance(), m_lockable, m_semaphore );
+      currentExecutor = m_executor.get();
+      ASSERT_EQ( m_executor->initialize(), LibErrorCodes::eOK );
+   }
+
+   void TearDown() override
+   {
+      isSlowReleased.store( true );
+      for ( auto& worker : m_workers )
+      {
+         worker.join();
+      }
+      currentExecutor = nullptr;
+   }
+
+public:
+   //!< A worker task, which runs until the test ends
+   void startWorker( )
+   {
+      m_workers.emplace_back( [this]()
+      {
+         while ( !isSlowReleased.load() )
+         {
+            (void)m_executor->runWorkerOnce( 1 );
+         }
+      } );
+   }
+
+   static void waitFor( const std::atomic<bool>& flag )
+   {
+      while ( !flag.load() )
+      {
+         std::this_thread::yield();
+      }
+   }
+
+   lib::CommandExecutorBase::eJobStatus getStatus( uint32_t jobId )
+   {
+      lib::CommandExecutorBase::JobInfo info;
+      EXPECT_EQ( m_executor->getJob( jobId, info ), LibErrorCodes::eOK );
+      return info.status;
+   }
+
+   lib::LockableStd                 m_lockable;
+   lib::Semaphore_Std               m_semaphore;
+   std::unique_ptr<TestExecutor>    m_executor;
+   std::vector<std::thread>         m_workers;
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( CommandExecutorTest, test_executes_inline_command_in_submit )
+{
+   uint32_t jobId = 99;
+   EXPECT_EQ( m_executor->submit( "echo hello\r\n", &jobId ), LibErrorCodes::eOK );
+
+   EXPECT_EQ( jobId, 0u );
+   ASSERT_EQ( executed.size(), 1u );
+   EXPECT_EQ( executed[0], "echo hello" );
+}
+
+TEST_F( CommandExecutorTest, test_reports_errors_at_submit )
+{
+   EXPECT_EQ( m_executor->submit( "unknown\r\n" ), LibErrorCodes::eCLI_UNKNOWN_COMMAND );
+   EXPECT_EQ( m_executor->submit( "echo \"open\r\n" ), LibErrorCodes::eCLI_UNTERMINATED_QUOTE );
+   EXPECT_EQ( m_executor->submit( std::string( TestExecutorConfig::LINE_SIZE, 'x' ).c_str() ), LibErrorCodes::eCLI_LINE_TOO_LONG );
+   EXPECT_EQ( m_executor->submit( "  \r\n" ), LibErrorCodes::eOK );
+   EXPECT_TRUE( executed.empty() );
+}
+
+TEST_F( CommandExecutorTest, test_runs_async_commands_in_order_on_worker )
+{
+   char line[TestExecutorConfig::LINE_SIZE];
+   uint32_t first = 0;
+   uint32_t second = 0;
+
+   //!< The line is copied, so the caller reuses its buffer right away
+   snprintf( line, sizeof( line ), "record \"a b\"\r\n" );
+   EXPECT_EQ( m_executor->submit( line, &first ), LibErrorCodes::eOK );
+   snprintf( line, sizeof( line ), "record c\r\n" );
+   EXPECT_EQ( m_executor->submit( line, &second ), LibErrorCodes::eOK );
+   EXPECT_NE( first, 0u );
+   EXPECT_NE( first, second );
+   EXPECT_TRUE( executed.empty() );
+   EXPECT_EQ( getStatus( first ), lib::CommandExecutorBase::eJobStatus::QUEUED );
+
+   EXPECT_TRUE( m_executor->runWorkerOnce( 0 ) );
+   EXPECT_TRUE( m_executor->runWorkerOnce( 0 ) );
+   EXPECT_FALSE( m_executor->runWorkerOnce( 0 ) );
+
+   ASSERT_EQ( executed.size(), 2u );
+   EXPECT_EQ( executed[0], "record a b" );
+   EXPECT_EQ( executed[1], "record c" );
+   EXPECT_EQ( getStatus( first ), lib::CommandExecutorBase::eJobStatus::DONE );
+   EXPECT_EQ( getStatus( second ), lib::CommandExecutorBase::eJobStatus::DONE );
+}
+
+TEST_F( CommandExecutorTest, test_rejects_when_busy_and_reuses_finished_slots )
+{
+   uint32_t first = 0;
+   uint32_t second = 0;
+   uint32_t third = 0;
+   EXPECT_EQ( m_executor->submit( "record 1\r\n", &first ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_executor->submit( "record 2\r\n", &second ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_executor->submit( "record 3\r\n", &third ), LibErrorCodes::eCLI_EXECUTOR_BUSY );
+
+   //!< Inline commands never need a slot
+   EXPECT_EQ( m_executor->submit( "echo still here\r\n" ), LibErrorCodes::eOK );
+
+   EXPECT_TRUE( m_executor->runWorkerOnce( 0 ) );
+   EXPECT_EQ( m_executor->submit( "record 3\r\n", &third ), LibErrorCodes::eOK );
+
+   lib::CommandExecutorBase::JobInfo info;
+   EXPECT_EQ( m_executor->getJob( first, info ), LibErrorCodes::eCLI_JOB_NOT_FOUND );
+   EXPECT_EQ( m_executor->getJob( third, info ), LibErrorCodes::eOK );
+   EXPECT_STREQ( info.command, "record" );
+
+   lib::CommandExecutorBase::JobInfo jobs[TestExecutorConfig::NUM_JOBS];
+   EXPECT_EQ( m_executor->getJobs( jobs, TestExecutorConfig::NUM_JOBS ), 2u );
+}
+
+TEST_F( CommandExecutorTest, test_cancels_queued_job )
+{
+   uint32_t jobId = 0;
+   EXPECT_EQ( m_executor->submit( "record 1\r\n", &jobId ), LibErrorCodes::eOK );
+
+   EXPECT_EQ( m_executor->cancel( jobId ), LibErrorCodes::eOK );
+   EXPECT_EQ( getStatus( jobId ), lib::CommandExecutorBase::eJobStatus::CANCELLED );
+   EXPECT_EQ( m_executor->cancel( jobId ), LibErrorCodes::eCLI_JOB_FINISHED );
+   EXPECT_EQ( m_executor->cancel( 12345 ), LibErrorCodes::eCLI_JOB_NOT_FOUND );
+
+   EXPECT_FALSE( m_executor->runWorkerOnce( 0 ) );
+   EXPECT_TRUE( executed.empty() );
+}
+
+TEST_F( CommandExecutorTest, test_asks_running_job_to_stop )
+{
+   startWorker();
+
+   uint32_t jobId = 0;
+   EXPECT_EQ( m_executor->submit( "slow\r\n", &jobId ), LibErrorCodes::eOK );
+   waitFor( isSlowRunning );
+   EXPECT_EQ( getStatus( jobId ), lib::CommandExecutorBase::eJobStatus::RUNNING );
+   EXPECT_FALSE( m_executor->isCancelRequested() );      //!< Not a worker
+
+   EXPECT_EQ( m_executor->cancel( jobId ), LibErrorCodes::eOK );
+   while ( getStatus( jobId ) == lib::CommandExecutorBase::eJobStatus::RUNNING )
+   {
+      std::this_thread::yield();
+   }
+   EXPECT_EQ( getStatus( jobId ), lib::CommandExecutorBase::eJobStatus::CANCELLED );
+}
+
+TEST_F( CommandExecutorTest, test_stays_responsive_while_job_blocks )
+{
+   startWorker();
+
+   uint32_t jobId = 0;
+   EXPECT_EQ( m_executor->submit( "slow\r\n", &jobId ), LibErrorCodes::eOK );
+   waitFor( isSlowRunning );
+
+   //!< Executed right away, while the slow one still runs
+   EXPECT_EQ( m_executor->submit( "echo 1\r\n" ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_executor->submit( "echo 2\r\n" ), LibErrorCodes::eOK );
+   {
+      std::lock_guard<std::mutex> guard( mutexExecuted );
+      ASSERT_EQ( executed.size(), 2u );
+      EXPECT_EQ( executed[1], "echo 2" );
+   }
+
+   isSlowReleased.store( true );
+   while ( getStatus( jobId ) == lib::CommandExecutorBase::eJobStatus::RUNNING )
+   {
+      std::this_thread::yield();
+   }
+   EXPECT_EQ( getStatus( jobId ), lib::CommandExecutorBase::eJobStatus::DONE );
+}
@@ -0,0 +1,78 @@
+/************************************************************************************************************
+ *
+ * @file counter_extender_tests.cpp
+ * @brief Unit tests for the CounterExtender class
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-14
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "counter_extender.h"
+#include <gtest/gtest.h>
+
+/************************************************** Test Fixture ********************************************/
+class CounterExtenderTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      m_counter = 0;
+   }
+
+   void TearDown() override
+   { }
+
+public:
+   uint64_t read( uint32_t counter )
+   {
+      m_counter = counter;
+      return m_extender.extend( [this]() { return m_counter; } );
+   }
+
+   lib::CounterExtender m_extender;
+   uint32_t             m_counter{ 0 };
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( CounterExtenderTest, test_first_period_as_is )
+{
+   EXPECT_EQ( read( 0 ), 0u );
+   EXPECT_EQ( read( 1000 ), 1000u );
+   EXPECT_EQ( read( 0x80000000u ), 0x80000000u );
+   EXPECT_EQ( read( 0xFFFFFFFFu ), 0xFFFFFFFFu );
+}
+
+TEST_F( CounterExtenderTest, test_wrap_around_extends )
+{
+   (void)read( 0x40000000u );
+   (void)read( 0xC0000000u );
+   EXPECT_EQ( read( 0x00000010u ), 0x100000010ull );
+   EXPECT_EQ( read( 0x90000000u ), 0x190000000ull );
+   EXPECT_EQ( read( 0x00000000u ), 0x200000000ull );
+}
+
+TEST_F( CounterExtenderTest, test_read_twice_in_half_period_doesnt_advance )
+{
+   (void)read( 0x90000000u );
+   EXPECT_EQ( read( 0x90000001u ), 0x90000001ull );
+   EXPECT_EQ( read( 0xA0000000u ), 0xA0000000ull );
+}
+
+TEST_F( CounterExtenderTest, test_monotonic_when_read_every_quarter_period )
+{
+   uint64_t last = 0;
+   uint32_t counter = 0;
+   for ( int i = 0; i < 40; i++ )
+   {
+      counter += 0x3FFFFFFFu;
+      const auto extended = read( counter );
+      EXPECT_GT( extended, last );
+      EXPECT_EQ( static_cast<uint32_t>( extended ), counter );
+      last = extended;
+   }
+   EXPECT_EQ( last, 40ull * 0x3FFFFFFFu );
+}
@@ -0,0 +1,74 @@
+/************************************************************************************************************
+ *
+ * @file frame_codec_benchmark.cpp
+ * @brief Host benchmark of the encoding and decoding throughput of the frame codec
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-06
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "frame_codec.h"
+#include "benchmark.h"
+#include <cstdlib>
+#include <vector>
+
+/************************************************** Consts **************************************************/
+constexpr size_t   PAYLOAD_SIZES[] = { 16, 64, 256, 1024 };
+constexpr uint64_t TOTAL_BYTES     = 64ULL * 1024 * 1024;
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Benchmark a payload size with the given payload pattern.
+ */
+static void runBenchmark( const char* patternName, size_t payloadSize, uint8_t zeroRatioPercent )
+{
+   std::vector<uint8_t> payload( payloadSize );
+   srand( 1 );
+   for ( auto& byte : payload )
+   {
+      byte = ( static_cast<uint8_t>( rand() % 100 ) < zeroRatioPercent ) ? 0 : static_cast<uint8_t>( 1 + rand() % 255 );
+   }
+
+   std::vector<uint8_t> encodeBuffer( lib::FrameEncoder::maxEncodedSize( payloadSize ) );
+   std::vector<uint8_t> decodeBuffer( payloadSize + lib::FrameEncoder::CRC_SIZE );
+   lib::FrameEncoder encoder{ encodeBuffer.data(), encodeBuffer.size() };
+   lib::FrameDecoder decoder{ decodeBuffer.data(), decodeBuffer.size() };
+   lib::SerialDevice::TxSegment frame{};
+
+   const uint64_t iterations = TOTAL_BYTES / payloadSize;
+
+   const auto encodeSeconds = bench::measureSeconds( iterations, [&]()
+   {
+      encoder.begin();
+      (void)encoder.feed( payload.data(), payload.size() );
+      (void)encoder.finish( frame );
+      bench::doNotOptimize( frame.length );
+   } );
+
+   const auto decodeSeconds = bench::measureSeconds( iterations, [&]()
+   {
+      size_t consumed = 0;
+      const auto result = decoder.decode( frame.data, frame.length, consumed );
+      bench::doNotOptimize( result );
+   } );
+
+   char name[64];
+   snprintf( name, sizeof( name ), "encode %5zu B, %s", payloadSize, patternName );
+   bench::reportThroughput( name, iterations * payloadSize, encodeSeconds );
+   snprintf( name, sizeof( name ), "decode %5zu B, %s", payloadSize, patternName );
+   bench::reportThroughput( name, iterations * payloadSize, decodeSeconds );
+}
+
+int main( )
+{
+   for ( const auto size : PAYLOAD_SIZES )
+   {
+      runBenchmark( "no zeros", size, 0 );
+      runBenchmark( "25% zeros", size, 25 );
+   }
+   return 0;
+}
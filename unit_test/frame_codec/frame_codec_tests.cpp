@@ -0,0 +1,228 @@
+/************************************************************************************************************
+ *
+ * @file frame_codec_tests.cpp
+ * @brief Unit tests for the FrameEncoder and FrameDecoder classes
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-06
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "frame_codec.h"
+#include "crc16.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+/************************************************** Test Fixture ********************************************/
+class FrameCodecTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   { }
+
+   void TearDown() override
+   { }
+
+public:
+   static constexpr size_t BUFFER_SIZE = 1024;
+
+   uint8_t m_encodeBuffer[BUFFER_SIZE] = {};
+   uint8_t m_decodeBuffer[BUFFER_SIZE] = {};
+
+   std::vector<uint8_t> encode( const std::vector<uint8_t>& payload )
+   {
+      lib::FrameEncoder encoder{ m_encodeBuffer, sizeof( m_encodeBuffer ) };
+      lib::SerialDevice::TxSegment frame{};
+
+      encoder.begin();
+      EXPECT_EQ( encoder.feed( payload.data(), payload.size() ), LibErrorCodes::eOK );
+      EXPECT_EQ( encoder.finish( frame ), LibErrorCodes::eOK );
+
+      return std::vector<uint8_t>( frame.data, frame.data + frame.length );
+   }
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( FrameCodecTest, test_crc16_matches_reference_value )
+{
+   const uint8_t data[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+   EXPECT_EQ( lib::Crc16::calculate( data, sizeof( data ) ), 0x29B1 );
+}
+
+TEST_F( FrameCodecTest, test_encoded_frame_has_no_zero_but_the_delimiter )
+{
+   const std::vector<uint8_t> payload = { 0x00, 0x11, 0x00, 0x00, 0x22, 0x33, 0x00 };
+   const auto encoded = encode( payload );
+
+   ASSERT_FALSE( encoded.empty() );
+   EXPECT_EQ( encoded.back(), lib::FrameEncoder::DELIMITER );
+   for ( size_t i = 0; i + 1 < encoded.size(); i++ )
+   {
+      EXPECT_NE( encoded[i], 0x00 );
+   }
+   EXPECT_LE( encoded.size(), lib::FrameEncoder::maxEncodedSize( payload.size() ) );
+}
+
+TEST_F( FrameCodecTest, test_round_trip_works_for_various_payloads )
+{
+   std::vector<std::vector<uint8_t>> payloads =
+   {
+      { },
+      { 0x00 },
+      { 0x01 },
+      { 0x00, 0x00, 0x00 },
+      std::vector<uint8_t>( 253, 0xAB ),
+      std::vector<uint8_t>( 254, 0xAB ),
+      std::vector<uint8_t>( 255, 0xAB ),
+      std::vector<uint8_t>( 600, 0x00 ),
+   };
+
+   std::vector<uint8_t> mixed( 700 );
+   for ( size_t i = 0; i < mixed.size(); i++ )
+   {
+      mixed[i] = static_cast<uint8_t>( ( i * 37 ) % 7 );
+   }
+   payloads.push_back( mixed );
+
+   for ( const auto& payload : payloads )
+   {
+      const auto encoded = encode( payload );
+      EXPECT_LE( encoded.size(), lib::FrameEncoder::maxEncodedSize( payload.size() ) );
+
+      lib::FrameDecoder decoder{ m_decodeBuffer, sizeof( m_decodeBuffer ) };
+      size_t consumed = 0;
+      auto result = decoder.decode( encoded.data(), encoded.size(), consumed );
+
+      ASSERT_EQ( result, LibErrorCodes::eOK ) << "payload size: " << payload.size();
+      EXPECT_EQ( consumed, encoded.size() );
+      ASSERT_EQ( decoder.frameLength(), payload.size() );
+      EXPECT_TRUE( std::equal( payload.begin(), payload.end(), decoder.frame() ) );
+   }
+}
+
+TEST_F( FrameCodecTest, test_encoder_accepts_segments )
+{
+   const uint8_t header[]  = { 0x01, 0x00 };
+   const uint8_t payload[] = { 0x10, 0x20, 0x00, 0x30 };
+   const uint8_t trailer[] = { 0xFF };
+   const lib::SerialDevice::TxSegment segments[] = { { header, sizeof( header ) }, { payload, sizeof( payload ) }, { trailer, sizeof( trailer ) } };
+
+   lib::FrameEncoder encoder{ m_encodeBuffer, sizeof( m_encodeBuffer ) };
+   lib::SerialDevice::TxSegment frame{};
+   encoder.begin();
+   EXPECT_EQ( encoder.feed( segments, 3 ), LibErrorCodes::eOK );
+   EXPECT_EQ( encoder.finish( frame ), LibErrorCodes::eOK );
+   EXPECT_EQ( frame.data, m_encodeBuffer );
+
+   const std::vector<uint8_t> concatenated = { 0x01, 0x00, 0x10, 0x20, 0x00, 0x30, 0xFF };
+   const auto expected = encode( concatenated );
+   ASSERT_EQ( frame.length, expected.size() );
+   EXPECT_TRUE( std::equal( expected.begin(), expected.end(), frame.data ) );
+}
+
+TEST_F( FrameCodecTest, test_decoder_works_byte_by_byte_across_frames )
+{
+   const std::vector<uint8_t> first  = { 0x01, 0x02, 0x00, 0x03 };
+   const std::vector<uint8_t> second = { 0x00, 0x00, 0xFE };
+
+   auto stream = encode( first );
+   const auto encodedSecond = encode( second );
+   stream.insert( stream.begin(), 0x00 );    //!< a leading delimiter is ignored
+   stream.insert( stream.end(), encodedSecond.begin(), encodedSecond.end() );
+
+   lib::FrameDecoder decoder{ m_decodeBuffer, sizeof( m_decodeBuffer ) };
+   std::vector<std::vector<uint8_t>> frames;
+
+   for ( const auto byte : stream )
+   {
+      size_t consumed = 0;
+      if ( decoder.decode( &byte, 1, consumed ) == LibErrorCodes::eOK )
+      {
+         frames.emplace_back( decoder.frame(), decoder.frame() + decoder.frameLength() );
+      }
+      EXPECT_EQ( consumed, 1 );
+   }
+
+   ASSERT_EQ( frames.size(), 2 );
+   EXPECT_EQ( frames[0], first );
+   EXPECT_EQ( frames[1], second );
+}
+
+TEST_F( FrameCodecTest, test_decoder_stops_at_each_frame_in_a_chunk )
+{
+   const std::vector<uint8_t> first  = { 0xAA };
+   const std::vector<uint8_t> second = { 0xBB, 0xCC };
+
+   auto stream = encode( first );
+   const auto encodedSecond = encode( second );
+   const auto firstLength = stream.size();
+   stream.insert( stream.end(), encodedSecond.begin(), encodedSecond.end() );
+
+   lib::FrameDecoder decoder{ m_decodeBuffer, sizeof( m_decodeBuffer ) };
+   size_t consumed = 0;
+
+   EXPECT_EQ( decoder.decode( stream.data(), stream.size(), consumed ), LibErrorCodes::eOK );
+   EXPECT_EQ( consumed, firstLength );
+   EXPECT_EQ( decoder.frameLength(), first.size() );
+
+   size_t offset = consumed;
+   EXPECT_EQ( decoder.decode( stream.data() + offset, stream.size() - offset, consumed ), LibErrorCodes::eOK );
+   EXPECT_EQ( offset + consumed, stream.size() );
+   EXPECT_EQ( decoder.frameLength(), second.size() );
+}
+
+TEST_F( FrameCodecTest, test_decoder_detects_corruption_and_resynchronizes )
+{
+   const std::vector<uint8_t> payload = { 0x10, 0x20, 0x30, 0x40 };
+
+   auto corrupted = encode( payload );
+   corrupted[2] ^= 0x01;
+
+   const auto valid = encode( payload );
+   auto stream = corrupted;
+   stream.insert( stream.end(), valid.begin(), valid.end() );
+
+   lib::FrameDecoder decoder{ m_decodeBuffer, sizeof( m_decodeBuffer ) };
+   size_t consumed = 0;
+
+   EXPECT_EQ( decoder.decode( stream.data(), stream.size(), consumed ), LibErrorCodes::eFRAME_CRC_MISMATCH );
+   EXPECT_EQ( consumed, corrupted.size() );
+
+   const size_t offset = consumed;
+   EXPECT_EQ( decoder.decode( stream.data() + offset, stream.size() - offset, consumed ), LibErrorCodes::eOK );
+   EXPECT_EQ( decoder.frameLength(), payload.size() );
+}
+
+TEST_F( FrameCodecTest, test_decoder_reports_truncated_frames )
+{
+   const std::vector<uint8_t> payload( 10, 0x55 );
+   auto encoded = encode( payload );
+
+   //!< Drop a few bytes in the middle of the block so that the delimiter arrives too early.
+   encoded.erase( encoded.begin() + 3, encoded.begin() + 6 );
+
+   lib::FrameDecoder decoder{ m_decodeBuffer, sizeof( m_decodeBuffer ) };
+   size_t consumed = 0;
+   EXPECT_EQ( decoder.decode( encoded.data(), encoded.size(), consumed ), LibErrorCodes::eFRAME_INVALID_ENCODING );
+}
+
+TEST_F( FrameCodecTest, test_buffer_too_small_is_reported )
+{
+   const std::vector<uint8_t> payload( 32, 0x01 );
+
+   uint8_t smallBuffer[16];
+   lib::FrameEncoder encoder{ smallBuffer, sizeof( smallBuffer ) };
+   lib::SerialDevice::TxSegment frame{};
+   encoder.begin();
+   EXPECT_EQ( encoder.feed( payload.data(), payload.size() ), LibErrorCodes::eFRAME_BUFFER_TOO_SMALL );
+   EXPECT_EQ( encoder.finish( frame ), LibErrorCodes::eFRAME_BUFFER_TOO_SMALL );
+
+   const auto encoded = encode( payload );
+   lib::FrameDecoder decoder{ smallBuffer, sizeof( smallBuffer ) };
+   size_t consumed = 0;
+   EXPECT_EQ( decoder.decode( encoded.data(), encoded.size(), consumed ), LibErrorCodes::eFRAME_BUFFER_TOO_SMALL );
+   EXPECT_EQ( consumed, encoded.size() );
+}
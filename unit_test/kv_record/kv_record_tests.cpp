@@ -0,0 +1,128 @@
+/************************************************************************************************************
+ *
+ * @file kv_record_tests.cpp
+ * @brief Unit tests for the KvRecord class
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-15
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "kv_record.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+/************************************************** Test Fixture ********************************************/
+class KvRecordTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   { }
+
+   void TearDown() override
+   { }
+
+public:
+   using eFieldType = lib::KvRecord::eFieldType;
+
+   uint8_t m_buffer[lib::KvRecord::MAX_RECORD_SIZE] = {};
+
+   template<typename... Fields>
+   std::vector<uint8_t> encode( Fields... fields )
+   {
+      const auto length = lib::KvRecord::encode( m_buffer, sizeof( m_buffer ), 0x11223344, 0xAABBCCDD, fields... );
+      return std::vector<uint8_t>( m_buffer, m_buffer + length );
+   }
+
+   static std::vector<uint8_t> header( )
+   {
+      return { 0x44, 0x33, 0x22, 0x11, 0xDD, 0xCC, 0xBB, 0xAA, lib::KvRecord::MARKER };
+   }
+
+   static std::vector<uint8_t> record( const std::vector<uint8_t>& fields )
+   {
+      auto bytes = header();
+      bytes.insert( bytes.end(), fields.begin(), fields.end() );
+      return bytes;
+   }
+
+   static std::vector<uint8_t> varint( uint64_t value )
+   {
+      uint8_t buffer[lib::KvRecord::MAX_VARINT_LENGTH];
+      const auto length = lib::KvRecord::putVarint( buffer, value );
+      return std::vector<uint8_t>( buffer, buffer + length );
+   }
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( KvRecordTest, test_event_id_is_fnv1a_of_event_name )
+{
+   static_assert( lib::KvRecord::eventId( "foobar" ) == 0xBF9CF968u );
+}
+
+TEST_F( KvRecordTest, test_encodes_header_with_marker )
+{
+   EXPECT_EQ( encode(), header() );
+}
+
+TEST_F( KvRecordTest, test_encodes_varints )
+{
+   EXPECT_EQ( varint( 0 ), ( std::vector<uint8_t>{ 0x00 } ) );
+   EXPECT_EQ( varint( 127 ), ( std::vector<uint8_t>{ 0x7F } ) );
+   EXPECT_EQ( varint( 128 ), ( std::vector<uint8_t>{ 0x80, 0x01 } ) );
+   EXPECT_EQ( varint( 300 ), ( std::vector<uint8_t>{ 0xAC, 0x02 } ) );
+   EXPECT_EQ( varint( UINT64_MAX ).size(), lib::KvRecord::MAX_VARINT_LENGTH );
+}
+
+TEST_F( KvRecordTest, test_encodes_signed_with_zigzag )
+{
+   static_assert( lib::KvRecord::zigzag( 0 ) == 0 );
+   static_assert( lib::KvRecord::zigzag( -1 ) == 1 );
+   static_assert( lib::KvRecord::zigzag( 1 ) == 2 );
+   static_assert( lib::KvRecord::zigzag( INT64_MIN ) == UINT64_MAX );
+
+   EXPECT_EQ( encode( "a", -2, "b", 200u, "c", static_cast<uint8_t>( 5 ) ),
+              record( { static_cast<uint8_t>( eFieldType::SINT ), 0x03,
+                        static_cast<uint8_t>( eFieldType::UINT ), 0xC8, 0x01,
+                        static_cast<uint8_t>( eFieldType::UINT ), 0x05 } ) );
+}
+
+TEST_F( KvRecordTest, test_encodes_bool_float_and_double )
+{
+   EXPECT_EQ( encode( "t", true, "f", false, "x", 1.0f, "y", 1.0 ),
+              record( { static_cast<uint8_t>( eFieldType::TRUE ),
+                        static_cast<uint8_t>( eFieldType::FALSE ),
+                        static_cast<uint8_t>( eFieldType::FLOAT ), 0x00, 0x00, 0x80, 0x3F,
+                        static_cast<uint8_t>( eFieldType::DOUBLE ), 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F } ) );
+}
+
+TEST_F( KvRecordTest, test_encodes_strings_with_length )
+{
+   char data[8] = "abc";
+   const char* nothing = nullptr;
+
+   EXPECT_EQ( encode( "data", data, "none", nothing ),
+              record( { static_cast<uint8_t>( eFieldType::STRING ), 3, 'a', 'b', 'c',
+                        static_cast<uint8_t>( eFieldType::STRING ), 6, '(', 'n', 'u', 'l', 'l', ')' } ) );
+}
+
+TEST_F( KvRecordTest, test_drops_fields_that_do_not_fit )
+{
+   const std::string longString( lib::KvRecord::MAX_STRING_LENGTH, 'x' );
+   const auto bytes = encode( "a", longString.c_str(), "b", longString.c_str(), "c", 1 );
+
+   //!< The second string is truncated to the space left, and the last field is dropped
+   EXPECT_EQ( bytes.size(), lib::KvRecord::MAX_RECORD_SIZE );
+   EXPECT_EQ( bytes[lib::KvRecord::HEADER_SIZE + 1], lib::KvRecord::MAX_STRING_LENGTH );
+   EXPECT_EQ( bytes[lib::KvRecord::HEADER_SIZE + 2 + lib::KvRecord::MAX_STRING_LENGTH], static_cast<uint8_t>( eFieldType::STRING ) );
+}
+
+TEST_F( KvRecordTest, test_fails_if_buffer_cannot_hold_header )
+{
+   uint8_t buffer[lib::KvRecord::HEADER_SIZE - 1];
+   EXPECT_EQ( lib::KvRecord::encode( buffer, sizeof( buffer ), 1, 2, "a", 1 ), 0u );
+}
@@ -0,0 +1,183 @@
+/************************************************************************************************************
+ *
+ * @file lib_common_tests.cpp
+ * @brief Unit tests for the log levels of lib_common
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#define LOG_MODULE           LOG_MODULE_CLI
+#define LOG_LEVEL_COMPILE    LOG_LEVEL_INFO
+#include "lib_common.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+/************************************************** Test Fixture ********************************************/
+class LibCommonTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      for ( int i = 0; i < LOG_MODULE_COUNT; i++ )
+      {
+         LIB_COMMON_setLogLevel( static_cast<eLogModule>( i ), LOG_LEVEL_RUNTIME );
+      }
+      m_evaluated = 0;
+   }
+
+   void TearDown() override
+   { }
+
+public:
+   static inline int m_evaluated = 0;
+
+   //!< Counts how many times the arguments of the log messages are evaluated
+   static int argument( )
+   {
+      return ++m_evaluated;
+   }
+};
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Stub of the tick source which is provided by the application on target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   return 0;
+}
+
+/**
+ * @brief Stub of the level tagging which is provided by the application on target.
+ */
+extern "C" void LIB_COMMON_tagLogLevel( uint8_t level )
+{
+   PARAM_NOT_USED( level );
+}
+
+/************************************************** Tests ***************************************************/
+TEST_F( LibCommonTest, ThresholdsStartAtRuntimeDefault )
+{
+   for ( int i = 0; i < LOG_MODULE_COUNT; i++ )
+   {
+      EXPECT_EQ( LIB_COMMON_getLogLevel( static_cast<eLogModule>( i ) ), LOG_LEVEL_RUNTIME );
+   }
+}
+
+TEST_F( LibCommonTest, SetsThresholdPerModule )
+{
+   LIB_COMMON_setLogLevel( LOG_MODULE_SERIAL_WIFI, LOG_LEVEL_TRACE );
+   LIB_COMMON_setLogLevel( LOG_MODULE_MQTT, LOG_LEVEL_NONE );
+
+   EXPECT_EQ( LIB_COMMON_getLogLevel( LOG_MODULE_SERIAL_WIFI ), LOG_LEVEL_TRACE );
+   EXPECT_EQ( LIB_COMMON_getLogLevel( LOG_MODULE_MQTT ), LOG_LEVEL_NONE );
+   EXPECT_EQ( LIB_COMMON_getLogLevel( LOG_MODULE_CLI ), LOG_LEVEL_RUNTIME );
+
+   EXPECT_TRUE( LIB_COMMON_isLogEnabled( LOG_MODULE_SERIAL_WIFI, LOG_LEVEL_TRACE ) );
+   EXPECT_FALSE( LIB_COMMON_isLogEnabled( LOG_MODULE_MQTT, LOG_LEVEL_ERROR ) );
+}
+
+TEST_F( LibCommonTest, ClampsThresholdToTrace )
+{
+   LIB_COMMON_setLogLevel( LOG_MODULE_APP, 200 );
+
+   EXPECT_EQ( LIB_COMMON_getLogLevel( LOG_MODULE_APP ), LOG_LEVEL_TRACE );
+}
+
+TEST_F( LibCommonTest, FindsModulesAndLevelsByName )
+{
+   eLogModule module = LOG_MODULE_APP;
+   uint8_t level = LOG_LEVEL_NONE;
+
+   EXPECT_TRUE( LIB_COMMON_findLogModule( "WiFi", &module ) );
+   EXPECT_EQ( module, LOG_MODULE_SERIAL_WIFI );
+   EXPECT_TRUE( LIB_COMMON_findLogLevel( "debug", &level ) );
+   EXPECT_EQ( level, LOG_LEVEL_DEBUG );
+
+   EXPECT_FALSE( LIB_COMMON_findLogModule( "wif", &module ) );
+   EXPECT_FALSE( LIB_COMMON_findLogLevel( "verbose", &level ) );
+
+   EXPECT_STREQ( LIB_COMMON_getLogModuleName( LOG_MODULE_MQTT ), "mqtt" );
+   EXPECT_STREQ( LIB_COMMON_getLogLevelName( LOG_LEVEL_WARN ), "warn" );
+}
+
+TEST_F( LibCommonTest, ProcessesLogLevelCommand )
+{
+   std::vector<std::string> lines;
+   const auto record = []( void* context, const char* line ) { static_cast<std::vector<std::string>*>( context )->emplace_back( line ); };
+
+   char command[] = "loglevel";
+   char module[] = "wifi";
+   char level[] = "debug";
+   char* argv[] = { command, module, level };
+
+   EXPECT_TRUE( LIB_COMMON_commandLogLevel( 3, argv, record, &lines ) );
+   EXPECT_EQ( LIB_COMMON_getLogLevel( LOG_MODULE_SERIAL_WIFI ), LOG_LEVEL_DEBUG );
+   ASSERT_EQ( lines.size(), static_cast<size_t>( LOG_MODULE_COUNT ) );
+   EXPECT_EQ( lines[LOG_MODULE_SERIAL_WIFI], "CLI: [wifi] debug" );
+
+   //!< Invalid arguments leave the levels as they are
+   lines.clear();
+   char unknown[] = "verbose";
+   argv[2] = unknown;
+   EXPECT_FALSE( LIB_COMMON_commandLogLevel( 3, argv, record, &lines ) );
+   EXPECT_FALSE( LIB_COMMON_commandLogLevel( 2, argv, record, &lines ) );
+   EXPECT_EQ( LIB_COMMON_getLogLevel( LOG_MODULE_SERIAL_WIFI ), LOG_LEVEL_DEBUG );
+   ASSERT_EQ( lines.size(), 2u );
+   EXPECT_EQ( lines[0], "CLI: unknown log level [verbose]" );
+
+   char all[] = "all";
+   char error[] = "error";
+   argv[1] = all;
+   argv[2] = error;
+   EXPECT_TRUE( LIB_COMMON_commandLogLevel( 3, argv, nullptr, nullptr ) );
+   EXPECT_EQ( LIB_COMMON_getLogLevel( LOG_MODULE_MQTT ), LOG_LEVEL_ERROR );
+}
+
+TEST_F( LibCommonTest, EvaluatesArgumentsOnlyIfEnabledAtRuntime )
+{
+   LIB_COMMON_setLogLevel( LOG_MODULE_CLI, LOG_LEVEL_WARN );
+
+   LOG_WARN( "warn %d", argument() );
+   LOG_INFO( "info %d", argument() );
+   EXPECT_EQ( m_evaluated, 1 );
+
+   LIB_COMMON_setLogLevel( LOG_MODULE_CLI, LOG_LEVEL_INFO );
+
+   LOG_INFO( "info %d", argument() );
+   EXPECT_EQ( m_evaluated, 2 );
+}
+
+TEST_F( LibCommonTest, CompilesOutLevelsAboveCompileThreshold )
+{
+   LIB_COMMON_setLogLevel( LOG_MODULE_CLI, LOG_LEVEL_TRACE );
+
+   LOG_DEBUG( "debug %d", argument() );
+   LOG_TRACE( "trace %d", argument() );
+   EXPECT_EQ( m_evaluated, 0 );
+
+   LOG_ERROR( "error %d", argument() );
+   EXPECT_EQ( m_evaluated, 1 );
+}
+
+TEST_F( LibCommonTest, TimestampsAreMonotonicInMicroseconds )
+{
+   LIB_COMMON_initTimestamp( 180000000 );
+
+   const auto cycles = LIB_COMMON_getCycleCount();
+   const auto first = LIB_COMMON_getTimestampUs();
+   std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+   const auto second = LIB_COMMON_getTimestampUs();
+
+   EXPECT_GE( first, cycles / 1000 );
+   EXPECT_GE( second - first, 2000u );
+   EXPECT_LT( second - first, 2000000u );
+}
@@ -0,0 +1,89 @@
+/************************************************************************************************************
+ *
+ * @file log_record_benchmark.cpp
+ * @brief Host benchmark of the cost of a LOGGING call, formatted as text on the target versus deferred as a binary record
+ * @details The text path is what printf does on the calling task before the logger gets the message, i.e., formatting the time stamp and the message.
+ *          The deferred path is what LIB_COMMON_logDeferred does on the calling task, i.e., encoding the record,
+ *          whereas the framing is done later by the logging task, which is measured separately.
+ *          The bytes on the wire are reported as well, as the UART time is usually the bottleneck of logging,
+ *          along with the same values logged as a structured event with LOG_KV.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-11
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "log_record.h"
+#include "kv_record.h"
+#include "frame_codec.h"
+#include "benchmark.h"
+
+/************************************************** Consts **************************************************/
+constexpr uint64_t ITERATIONS = 1000000;
+
+#define FORMAT "SerialWifi: Send Async.(%d) [%s]"
+
+/*********************************************** Function Definitions ****************************************/
+int main( )
+{
+   static char text[128];
+   static uint8_t record[lib::LogRecord::MAX_RECORD_SIZE];
+   static uint8_t frameBuffer[1 + lib::FrameEncoder::maxEncodedSize( lib::LogRecord::MAX_RECORD_SIZE )];
+
+   const char* message = "AT+CIPSEND=0,12";
+   uint32_t tick_ms = 0;
+   size_t textLength = 0;
+   size_t frameLength = 0;
+
+   const auto textCycles = bench::measureCycles( ITERATIONS, [&]()
+   {
+      const auto length = snprintf( text, sizeof( text ), "%08ld: " FORMAT "\r\n", static_cast<long>( tick_ms++ ), 15, message );
+      textLength = static_cast<size_t>( length );
+      bench::doNotOptimize( text[0] );
+   } );
+
+   size_t recordLength = 0;
+   const auto encodeCycles = bench::measureCycles( ITERATIONS, [&]()
+   {
+      recordLength = lib::LogRecord::encode( record, sizeof( record ), lib::LogRecord::formatId( FORMAT ), tick_ms++, 15, message );
+      bench::doNotOptimize( record[0] );
+   } );
+
+   auto frame = [&]( size_t length )
+   {
+      frameBuffer[0] = lib::FrameEncoder::DELIMITER;
+      lib::FrameEncoder encoder{ &frameBuffer[1], sizeof( frameBuffer ) - 1 };
+      lib::SerialDevice::TxSegment segment{};
+      encoder.begin();
+      (void)encoder.feed( record, length );
+      (void)encoder.finish( segment );
+      bench::doNotOptimize( frameBuffer[0] );
+      return 1 + segment.length;
+   };
+
+   const auto frameCycles = bench::measureCycles( ITERATIONS, [&]()
+   {
+      frameLength = frame( recordLength );
+   } );
+
+   size_t kvLength = 0;
+   const auto kvCycles = bench::measureCycles( ITERATIONS, [&]()
+   {
+      kvLength = lib::KvRecord::encode( record, sizeof( record ), lib::KvRecord::eventId( "wifi.send_async" ), tick_ms++, "linkId", 15, "data", message );
+      bench::doNotOptimize( record[0] );
+   } );
+   const auto kvFrameLength = frame( kvLength );
+
+   bench::reportCycles( "text: snprintf (caller)", textCycles );
+   bench::reportCycles( "deferred: encode (caller)", encodeCycles );
+   bench::reportCycles( "deferred: frame (logging task)", frameCycles );
+   bench::reportCycles( "structured: encode (caller)", kvCycles );
+   printf( "%-40s %10zu bytes\n", "text: on the wire", textLength );
+   printf( "%-40s %10zu bytes\n", "deferred: on the wire", frameLength );
+   printf( "%-40s %10zu bytes\n", "structured: on the wire", kvFrameLength );
+
+   return 0;
+}
@@ -0,0 +1,125 @@
+/************************************************************************************************************
+ *
+ * @file log_record_tests.cpp
+ * @brief Unit tests for the LogRecord class
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-11
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "log_record.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+/************************************************** Test Fixture ********************************************/
+class LogRecordTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   { }
+
+   void TearDown() override
+   { }
+
+public:
+   using eArgType = lib::LogRecord::eArgType;
+
+   uint8_t m_buffer[lib::LogRecord::MAX_RECORD_SIZE] = {};
+
+   template<typename... Args>
+   std::vector<uint8_t> encode( Args... args )
+   {
+      const auto length = lib::LogRecord::encode( m_buffer, sizeof( m_buffer ), 0x11223344, 0xAABBCCDD, args... );
+      return std::vector<uint8_t>( m_buffer, m_buffer + length );
+   }
+
+   static std::vector<uint8_t> header( uint8_t numArgs )
+   {
+      return { 0x44, 0x33, 0x22, 0x11, 0xDD, 0xCC, 0xBB, 0xAA, numArgs };
+   }
+
+   static void append( std::vector<uint8_t>& record, const std::vector<uint8_t>& bytes )
+   {
+      record.insert( record.end(), bytes.begin(), bytes.end() );
+   }
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( LogRecordTest, FormatIdIsFnv1aOfFormatString )
+{
+   static_assert( lib::LogRecord::formatId( "" ) == 0x811C9DC5u );
+   static_assert( lib::LogRecord::formatId( "a" ) == 0xE40C292Cu );
+   static_assert( lib::LogRecord::formatId( "foobar" ) == 0xBF9CF968u );
+   static_assert( lib::LogRecord::formatId( "CLI: Task Started..." ) != lib::LogRecord::formatId( "CLI: Task Started.." ) );
+}
+
+TEST_F( LogRecordTest, EncodesHeaderWithoutArguments )
+{
+   EXPECT_EQ( encode(), header( 0 ) );
+}
+
+TEST_F( LogRecordTest, EncodesIntegersAsPrintfPromotesThem )
+{
+   auto expected = header( 5 );
+   append( expected, { static_cast<uint8_t>( eArgType::INT32 ),  0xFF, 0xFF, 0xFF, 0xFF } );
+   append( expected, { static_cast<uint8_t>( eArgType::UINT32 ), 0xFE, 0x00, 0x00, 0x00 } );
+   append( expected, { static_cast<uint8_t>( eArgType::UINT32 ), 0x78, 0x56, 0x34, 0x12 } );
+   append( expected, { static_cast<uint8_t>( eArgType::INT64 ),  0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF } );
+   append( expected, { static_cast<uint8_t>( eArgType::UINT32 ), 0x01, 0x00, 0x00, 0x00 } );
+
+   EXPECT_EQ( encode( static_cast<int8_t>( -1 ), static_cast<uint8_t>( 0xFE ), 0x12345678u, static_cast<int64_t>( -2 ), true ), expected );
+}
+
+TEST_F( LogRecordTest, EncodesDoubleAndPointer )
+{
+   const auto* pointer = reinterpret_cast<const void*>( static_cast<uintptr_t>( 0x40004800 ) );
+
+   auto expected = header( 2 );
+   append( expected, { static_cast<uint8_t>( eArgType::DOUBLE ), 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F } );
+   append( expected, { static_cast<uint8_t>( eArgType::POINTER ), 0x00, 0x48, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00 } );
+
+   EXPECT_EQ( encode( 1.5f, pointer ), expected );
+}
+
+TEST_F( LogRecordTest, EncodesStringsWithoutTerminator )
+{
+   char name[8] = "wifi";
+   const char* nullString = nullptr;
+
+   auto expected = header( 3 );
+   append( expected, { static_cast<uint8_t>( eArgType::STRING ), 2, 'O', 'K' } );
+   append( expected, { static_cast<uint8_t>( eArgType::STRING ), 4, 'w', 'i', 'f', 'i' } );
+   append( expected, { static_cast<uint8_t>( eArgType::STRING ), 6, '(', 'n', 'u', 'l', 'l', ')' } );
+
+   EXPECT_EQ( encode( "OK", name, nullString ), expected );
+}
+
+TEST_F( LogRecordTest, TruncatesLongStrings )
+{
+   const std::string longString( 100, 'x' );
+
+   const auto record = encode( longString.c_str() );
+
+   ASSERT_EQ( record.size(), lib::LogRecord::HEADER_SIZE + 2 + lib::LogRecord::MAX_STRING_LENGTH );
+   EXPECT_EQ( record[lib::LogRecord::HEADER_SIZE + 1], lib::LogRecord::MAX_STRING_LENGTH );
+}
+
+TEST_F( LogRecordTest, DropsArgumentsThatDoNotFit )
+{
+   //!< 9 bytes of header and 6 x 9 bytes of arguments fill 63 bytes, so the 7th argument and the ones after it are dropped
+   const auto record = encode( 1ull, 2ull, 3ull, 4ull, 5ull, 6ull, 7u, "str" );
+
+   ASSERT_EQ( record.size(), lib::LogRecord::HEADER_SIZE + 6 * 9 );
+   EXPECT_EQ( record[8], 6 );
+}
+
+TEST_F( LogRecordTest, FailsIfBufferCannotHoldHeader )
+{
+   uint8_t buffer[lib::LogRecord::HEADER_SIZE - 1];
+
+   EXPECT_EQ( lib::LogRecord::encode( buffer, sizeof( buffer ), 0, 0, 1 ), 0u );
+}
@@ -0,0 +1,261 @@
+/************************************************************************************************************
+ *
+ * @file log_sink_tests.cpp
+ * @brief Unit tests for the LogSink class and the sinks of the library
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-16
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "log_sink.h"
+#include "memory_log_sink.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+/************************************************** Types ***************************************************/
+/**
+ * @brief Fake serial device, which records the buffers handed over, and completes the transmission when waited for unless it's stalled.
+ */
+struct FakeSerialDevice
+{
+   using ReleaseFunction = void(*)( const uint8_t* data, void* context );
+
+   ErrorCode sendOwned( const uint8_t* data, size_t length, ReleaseFunction releaseFunction, void* context )
+   {
+      if ( isSending )
+      {
+         return LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE;
+      }
+      isSending = true;
+      release = releaseFunction;
+      releaseContext = context;
+      sent.emplace_back( reinterpret_cast<const char*>( data ), length );
+      buffers.push_back( data );
+      return LibErrorCodes::eOK;
+   }
+
+   ErrorCode waitSendComplete( uint32_t timeout_ms )
+   {
+      PARAM_NOT_USED( timeout_ms );
+      isSending = false;
+      waits++;
+      if ( isStalled )
+      {
+         return LibErrorCodes::eSEMAPHORE_GET_TIME_OUT;
+      }
+      complete();
+      return LibErrorCodes::eOK;
+   }
+
+   //!< The completion of the transmission, as notifySendComplete() does
+   void complete( )
+   {
+      if ( release != nullptr )
+      {
+         const auto function = release;
+         release = nullptr;
+         function( buffers.back(), releaseContext );
+      }
+   }
+
+   std::vector<std::string>      sent;
+   std::vector<const uint8_t*>   buffers;
+   size_t                        waits{ 0 };
+   bool                          isSending{ false };
+   bool                          isStalled{ false };
+   ReleaseFunction               release{ nullptr };
+   void*                         releaseContext{ nullptr };
+};
+
+/************************************************** Test Fixture ********************************************/
+class LogSinkTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   { }
+
+   void TearDown() override
+   { }
+
+public:
+   static bool offer( lib::LogSink& sink, uint8_t level, const std::string& message, uint32_t nowMs = 0 )
+   {
+      return sink.offer( level, reinterpret_cast<const uint8_t*>( message.data() ), message.size(), nowMs );
+   }
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( LogSinkTest, test_filters_by_level )
+{
+   MemoryLogSink sink{ "memory", { .maxLevel = LOG_LEVEL_WARN } };
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_ERROR, "e" ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_WARN, "w" ) );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, "i" ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_NONE, "n" ) );
+
+   EXPECT_EQ( sink.captured(), "ewn" );
+   EXPECT_EQ( sink.getDropped(), 0u );     //!< Filtered, not dropped
+}
+
+TEST_F( LogSinkTest, test_sets_level_at_runtime )
+{
+   MemoryLogSink sink;
+   EXPECT_EQ( sink.getMaxLevel(), LOG_LEVEL_TRACE );
+
+   sink.setMaxLevel( LOG_LEVEL_ERROR );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_WARN, "w" ) );
+
+   sink.setMaxLevel( 100 );
+   EXPECT_EQ( sink.getMaxLevel(), LOG_LEVEL_TRACE );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_TRACE, "t" ) );
+}
+
+TEST_F( LogSinkTest, test_unlimited_without_rate )
+{
+   MemoryLogSink sink;
+   const std::string message( 1000, 'x' );
+   for ( int i = 0; i < 100; i++ )
+   {
+      EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, message ) );
+   }
+   EXPECT_EQ( sink.getDropped(), 0u );
+}
+
+TEST_F( LogSinkTest, test_drops_over_rate_and_refills_over_time )
+{
+   MemoryLogSink sink{ "memory", { .bytesPerSecond = 1000, .burstBytes = 10 } };
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "12345", 0 ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "12345", 0 ) );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, "1", 0 ) );
+
+   //!< 1 byte per millisecond
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, "12345", 4 ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "12345", 5 ) );
+
+   //!< Never more than the burst
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "1234567890", 100000 ) );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, "1", 100000 ) );
+   EXPECT_EQ( sink.getDropped(), 3u );
+}
+
+TEST_F( LogSinkTest, test_reports_dropped_before_next_message )
+{
+   MemoryLogSink sink{ "uart", { .bytesPerSecond = 1000, .burstBytes = 4 } };
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "abcd", 0 ) );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, "efgh", 0 ) );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, "ijkl", 1 ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "mnop", 10 ) );
+
+   ASSERT_EQ( sink.m_writes.size(), 3u );
+   EXPECT_EQ( sink.m_writes[1], "LOGGER: 2 messages dropped by uart\r\n" );
+   EXPECT_EQ( sink.m_writes[2], "mnop" );
+}
+
+TEST_F( LogSinkTest, test_takes_message_longer_than_burst_when_full )
+{
+   MemoryLogSink sink{ "memory", { .bytesPerSecond = 1000, .burstBytes = 4 } };
+   const std::string message( 10, 'x' );
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, message, 0 ) );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, message, 3 ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, message, 8 ) );
+}
+
+TEST_F( LogSinkTest, test_rate_survives_tick_wrap_around )
+{
+   MemoryLogSink sink{ "memory", { .bytesPerSecond = 1000, .burstBytes = 4 } };
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "abcd", UINT32_MAX - 1 ) );
+   EXPECT_FALSE( offer( sink, LOG_LEVEL_INFO, "abcd", UINT32_MAX ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "abcd", 2 ) );
+}
+
+TEST_F( LogSinkTest, test_serial_sink_double_buffers )
+{
+   FakeSerialDevice device;
+   lib::SerialLogSink<FakeSerialDevice, 8> sink{ "uart", {}, device };
+
+   //!< The first buffer is handed over as soon as it's full, and the rest waits for the flush
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "0123456789" ) );
+   ASSERT_EQ( device.sent.size(), 1u );
+   EXPECT_EQ( device.sent[0], "01234567" );
+   EXPECT_EQ( device.waits, 0u );
+
+   //!< The second one waits for the completion of the first
+   sink.flush();
+   ASSERT_EQ( device.sent.size(), 2u );
+   EXPECT_EQ( device.sent[1], "89" );
+   EXPECT_EQ( device.waits, 1u );
+   EXPECT_NE( device.buffers[0], device.buffers[1] );
+
+   //!< Nothing to hand over
+   sink.flush();
+   EXPECT_EQ( device.sent.size(), 2u );
+}
+
+TEST_F( LogSinkTest, test_serial_sink_keeps_buffer_in_flight_after_timeout )
+{
+   FakeSerialDevice device;
+   lib::SerialLogSink<FakeSerialDevice, 8> sink{ "uart", {}, device };
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "01234567" ) );
+   ASSERT_EQ( device.sent.size(), 1u );
+
+   //!< The first buffer isn't released in time, so the device isn't armed again until it is
+   device.isStalled = true;
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "lost" ) );
+   sink.flush();
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "lost" ) );
+   sink.flush();
+   EXPECT_EQ( device.sent.size(), 1u );
+   EXPECT_EQ( device.waits, 1u );
+   EXPECT_EQ( sink.getDroppedBuffers(), 2u );
+
+   device.isStalled = false;
+   device.complete();
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "next" ) );
+   sink.flush();
+   ASSERT_EQ( device.sent.size(), 2u );
+   EXPECT_EQ( device.sent[1], "next" );
+}
+
+TEST_F( LogSinkTest, test_retained_sink_appends_messages )
+{
+   uint8_t area[lib::RetainedLog::HEADER_SIZE + 64] = {};
+   lib::RetainedLog retainedLog{ area, sizeof( area ) };
+   retainedLog.reset();
+   lib::RetainedLogSink sink{ "retained", {}, retainedLog };
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "hello" ) );
+
+   uint8_t buffer[16] = {};
+   size_t length = 0;
+   EXPECT_EQ( retainedLog.pop( buffer, sizeof( buffer ), length ), LibErrorCodes::eOK );
+   EXPECT_EQ( std::string( reinterpret_cast<char*>( buffer ), length ), "hello" );
+}
+
+TEST_F( LogSinkTest, test_memory_sink_captures_batches )
+{
+   MemoryLogSink sink;
+
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "a" ) );
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "b" ) );
+   sink.flush();
+   EXPECT_TRUE( offer( sink, LOG_LEVEL_INFO, "c" ) );
+
+   ASSERT_EQ( sink.m_batches.size(), 1u );
+   EXPECT_EQ( sink.m_batches[0], "ab" );
+   EXPECT_EQ( sink.captured(), "abc" );
+   EXPECT_FALSE( sink.isPending() );
+
+   sink.m_holdBatch = true;
+   EXPECT_TRUE( sink.isPending() );
+}
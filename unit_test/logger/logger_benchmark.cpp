@@ -0,0 +1,186 @@
+/************************************************************************************************************
+ *
+ * @file logger_benchmark.cpp
+ * @brief Host benchmark of BasicLogger, i.e., the cost of a message to the task logging it and to the logging task, and the throughput of both
+ * @details The sinks only count the bytes, so that the cost of the logger itself is measured.
+ *          The cycles per message of the logging task are measured over LogSink, whose calls go through the vtable,
+ *          and over a final sink, whose calls are resolved at compile time.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "logger.h"
+#include "lockable_std.h"
+#include "semaphore_std.h"
+#include "logger_port_std.h"
+#include "benchmark.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/************************************************** Consts **************************************************/
+constexpr uint64_t ITERATIONS       = 200000;
+constexpr size_t   MESSAGE_LENGTH   = 64;
+constexpr size_t   NUM_PRODUCERS    = 4;
+constexpr size_t   BATCH            = 16;       //!< Messages written before the logging task drains them, in the single-threaded measurement
+
+/************************************************** Types ***************************************************/
+struct BenchLoggerConfig : lib::LoggerConfig
+{
+   constexpr static size_t                            NUM_STAGING_BUFFERS  = NUM_PRODUCERS;
+   constexpr static size_t                            STAGING_BUFFER_SIZE  = 4096;
+   constexpr static size_t                            SHARED_BUFFER_SIZE   = 4096;
+   constexpr static lib::LoggerBase::eOverflowPolicy  OVERFLOW_POLICY      = lib::LoggerBase::eOverflowPolicy::BLOCK;
+   constexpr static uint32_t                          TIMEOUT_MS           = 1;
+};
+
+class CountingLogSink final : public lib::LogSink
+{
+public:
+   CountingLogSink()
+   : lib::LogSink{ "counting", {} }
+   { }
+
+   void write( const uint8_t* data, size_t length ) override
+   {
+      bench::doNotOptimize( data );
+      m_bytes.fetch_add( length, std::memory_order_relaxed );
+   }
+
+   void flush( ) override
+   { }
+
+   std::atomic<uint64_t> m_bytes{ 0 };
+};
+
+template<typename Sink>
+using BenchLogger = lib::BasicLogger<lib::LockableStd, lib::Semaphore_Std, Sink, lib::LoggerPortStd, BenchLoggerConfig>;
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Stub of the tick source which is provided by the application on target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   return 0;
+}
+
+/**
+ * @brief Measure the cycles per message of writing a batch of them and draining it in the same thread, so that nothing waits.
+ */
+template<typename Sink>
+static void runSingleThreaded( const char* name, bool isRegistered )
+{
+   lib::LockableStd lockable;
+   lib::Semaphore_Std semaphore;
+   CountingLogSink sink;
+   auto logger = std::make_unique<BenchLogger<Sink>>( lockable, semaphore );
+   (void)logger->initialize();
+   (void)logger->addSink( sink );
+   if ( isRegistered )
+   {
+      (void)logger->registerTask();
+   }
+   logger->runOnce();
+
+   uint8_t message[MESSAGE_LENGTH];
+   memset( message, 'x', sizeof( message ) );
+
+   const auto writeCycles = bench::measureCycles( ITERATIONS / BATCH, [&]()
+   {
+      for ( size_t i = 0; i < BATCH; i++ )
+      {
+         logger->write( message, sizeof( message ) );
+      }
+      logger->runOnce();
+   } ) / BATCH;
+
+   char label[80];
+   snprintf( label, sizeof( label ), "%s, %s: write + drain per message", name, isRegistered ? "registered" : "shared" );
+   bench::reportCycles( label, writeCycles );
+}
+
+/**
+ * @brief Measure the throughput of the producers writing concurrently while the logging task drains their messages.
+ */
+static void runThroughput( bool isRegistered )
+{
+   lib::LockableStd lockable;
+   lib::Semaphore_Std semaphore;
+   CountingLogSink sink;
+   auto logger = std::make_unique<BenchLogger<lib::LogSink>>( lockable, semaphore );
+   (void)logger->initialize();
+   (void)logger->addSink( sink );
+
+   const uint64_t perProducer = ITERATIONS / NUM_PRODUCERS;
+   const uint64_t totalBytes = perProducer * NUM_PRODUCERS * MESSAGE_LENGTH;
+   std::atomic<bool> isDone{ false };
+
+   std::thread loggingTask( [&]()
+   {
+      while ( !isDone.load( std::memory_order_relaxed ) )
+      {
+         logger->runOnce();
+      }
+   } );
+
+   const auto seconds = bench::measureSeconds( 1, [&]()
+   {
+      std::vector<std::thread> producers;
+      for ( size_t p = 0; p < NUM_PRODUCERS; p++ )
+      {
+         producers.emplace_back( [&]()
+         {
+            if ( isRegistered )
+            {
+               (void)logger->registerTask();
+            }
+
+            uint8_t message[MESSAGE_LENGTH];
+            memset( message, 'x', sizeof( message ) );
+            for ( uint64_t i = 0; i < perProducer; i++ )
+            {
+               logger->write( message, sizeof( message ) );
+            }
+         } );
+      }
+
+      for ( auto& producer : producers )
+      {
+         producer.join();
+      }
+
+      while ( sink.m_bytes.load( std::memory_order_relaxed ) < totalBytes )
+      {
+         std::this_thread::yield();
+      }
+   } );
+
+   isDone.store( true );
+   loggingTask.join();
+
+   char label[80];
+   snprintf( label, sizeof( label ), "%zu producers, %s", NUM_PRODUCERS, isRegistered ? "registered" : "shared" );
+   bench::reportThroughput( label, totalBytes, seconds );
+   snprintf( label, sizeof( label ), "%zu producers, %s, messages", NUM_PRODUCERS, isRegistered ? "registered" : "shared" );
+   bench::reportPerOperation( label, perProducer * NUM_PRODUCERS, seconds );
+}
+
+int main( )
+{
+   runSingleThreaded<lib::LogSink>( "virtual sink", false );
+   runSingleThreaded<lib::LogSink>( "virtual sink", true );
+   runSingleThreaded<CountingLogSink>( "final sink", false );
+   runSingleThreaded<CountingLogSink>( "final sink", true );
+
+   runThroughput( false );
+   runThroughput( true );
+   return 0;
+}
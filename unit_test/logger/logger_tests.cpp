@@ -0,0 +1,463 @@
+/************************************************************************************************************
+ *
+ * @file logger_tests.cpp
+ * @brief Unit tests for the BasicLogger class template over the C++ standard library
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-17
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "logger.h"
+#include "lockable_std.h"
+#include "semaphore_std.h"
+#include "logger_port_std.h"
+#include "memory_log_sink.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+/************************************************** Types ***************************************************/
+/**
+ * @brief Small buffers and short timeouts, so that the tests fill the buffers and never wait long.
+ */
+struct TestLoggerConfig : lib::LoggerConfig
+{
+   constexpr static size_t   NUM_STAGING_BUFFERS  = 2;
+   constexpr static size_t   STAGING_BUFFER_SIZE  = 128;
+   constexpr static size_t   SHARED_BUFFER_SIZE   = 128;
+   constexpr static size_t   MAX_SINKS            = 2;
+   constexpr static uint32_t TIMEOUT_MS           = 10;
+   constexpr static uint32_t PENDING_TIMEOUT_MS   = 1;
+};
+
+struct BlockingLoggerConfig : TestLoggerConfig
+{
+   constexpr static lib::LoggerBase::eOverflowPolicy OVERFLOW_POLICY = lib::LoggerBase::eOverflowPolicy::BLOCK;
+};
+
+struct DropOldestLoggerConfig : TestLoggerConfig
+{
+   constexpr static lib::LoggerBase::eOverflowPolicy OVERFLOW_POLICY = lib::LoggerBase::eOverflowPolicy::DROP_OLDEST;
+};
+
+/**
+ * @brief Sink holding its batch back until the second flush, as the UDP sink does to fill a datagram.
+ */
+class HoldingLogSink : public MemoryLogSink
+{
+public:
+   void flush( ) override
+   {
+      if ( !m_batch.empty() && ( ++m_heldFlushes < 2 ) )
+      {
+         return;
+      }
+      m_heldFlushes = 0;
+      MemoryLogSink::flush();
+   }
+
+   bool isPending( ) const override
+   {
+      return !m_batch.empty();
+   }
+
+   size_t m_heldFlushes{ 0 };
+};
+
+template<typename Config, typename Sink = lib::LogSink>
+using TestLoggerOf = lib::BasicLogger<lib::LockableStd, lib::Semaphore_Std, Sink, lib::LoggerPortStd, Config>;
+using TestLogger   = TestLoggerOf<TestLoggerConfig>;
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Stub of the tick source which is provided by the application on target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   const auto now = std::chrono::steady_clock::now().time_since_epoch();
+   return static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::milliseconds>( now ).count() );
+}
+
+/**
+ * @brief Stub of the level tagging which is provided by the application on target.
+ */
+extern "C" void LIB_COMMON_tagLogLevel( uint8_t level )
+{
+   lib::LoggerPortStd::setLevel( level );
+}
+
+/************************************************** Test Fixture ********************************************/
+class LoggerTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      lib::LoggerPortStd::setLevel( LOG_LEVEL_NONE );
+      lib::LoggerPortStd::setInsideInterrupt( false );
+      m_logger = std::make_unique<TestLogger>( m_lockable, m_semaphore );
+   }
+
+   void TearDown() override
+   { }
+
+public:
+   template<typename Logger>
+   static void write( Logger& logger, const std::string& message )
+   {
+      logger.write( reinterpret_cast<const uint8_t*>( message.data() ), message.size() );
+   }
+
+   lib::LockableStd              m_lockable;
+   lib::Semaphore_Std            m_semaphore;
+   std::unique_ptr<TestLogger>   m_logger;
+   MemoryLogSink                 m_sink;
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( LoggerTest, test_drops_messages_before_initialize )
+{
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+   write( *m_logger, "lost" );
+
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   write( *m_logger, "kept" );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), "kept" );
+}
+
+TEST_F( LoggerTest, test_fans_out_to_every_sink )
+{
+   MemoryLogSink second{ "second" };
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+   ASSERT_TRUE( m_logger->addSink( second ) );
+
+   write( *m_logger, "hello\r\n" );
+   write( *m_logger, "world\r\n" );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), "hello\r\nworld\r\n" );
+   EXPECT_EQ( second.captured(), "hello\r\nworld\r\n" );
+   ASSERT_EQ( m_sink.m_batches.size(), 1u );      //!< Flushed once, after all the messages
+}
+
+TEST_F( LoggerTest, test_rejects_sinks_over_max )
+{
+   MemoryLogSink second;
+   MemoryLogSink third;
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+
+   EXPECT_TRUE( m_logger->addSink( m_sink ) );
+   EXPECT_TRUE( m_logger->addSink( second ) );
+   EXPECT_FALSE( m_logger->addSink( third ) );
+}
+
+TEST_F( LoggerTest, test_filters_by_tagged_level_per_sink )
+{
+   MemoryLogSink errors{ "errors", { .maxLevel = LOG_LEVEL_ERROR } };
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+   ASSERT_TRUE( m_logger->addSink( errors ) );
+
+   lib::LoggerPortStd::setLevel( LOG_LEVEL_ERROR );
+   write( *m_logger, "e" );
+   lib::LoggerPortStd::setLevel( LOG_LEVEL_DEBUG );
+   write( *m_logger, "d" );
+   lib::LoggerPortStd::setLevel( LOG_LEVEL_NONE );
+   write( *m_logger, "n" );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), "edn" );
+   EXPECT_EQ( errors.captured(), "en" );
+}
+
+TEST_F( LoggerTest, test_merges_tasks_by_timestamp )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+   ASSERT_TRUE( m_logger->registerTask() );
+
+   //!< The other thread isn't registered, so it logs through the shared staging buffer
+   write( *m_logger, "a" );
+   lib::LoggerPortStd::delay( 1 );
+   std::thread other( [&]() { write( *m_logger, "b" ); } );
+   other.join();
+   lib::LoggerPortStd::delay( 1 );
+   write( *m_logger, "c" );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), "abc" );
+}
+
+TEST_F( LoggerTest, test_registers_tasks_up_to_staging_buffers )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+
+   EXPECT_TRUE( m_logger->registerTask() );
+   EXPECT_TRUE( m_logger->registerTask() );     //!< Registered already
+
+   //!< The second one is kept alive, as the id of a thread ended may be reused
+   std::atomic<bool> isRegistered{ false };
+   std::atomic<bool> isDone{ false };
+   bool second = false;
+   bool third = true;
+   std::thread secondTask( [&]()
+   {
+      second = m_logger->registerTask();
+      isRegistered.store( true );
+      while ( !isDone.load() )
+      {
+         std::this_thread::yield();
+      }
+   } );
+   while ( !isRegistered.load() )
+   {
+      std::this_thread::yield();
+   }
+   std::thread( [&]() { third = m_logger->registerTask(); } ).join();
+   isDone.store( true );
+   secondTask.join();
+
+   EXPECT_TRUE( second );
+   EXPECT_FALSE( third );
+}
+
+TEST_F( LoggerTest, test_reports_dropped_messages_where_they_were_lost )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+
+   const std::string message( 50, 'x' );
+   write( *m_logger, message );
+   write( *m_logger, message );
+   write( *m_logger, "dropped" );
+   write( *m_logger, "dropped" );
+   m_logger->runOnce();
+   write( *m_logger, "next" );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), message + message + "LOGGER: 2 messages dropped\r\n" + "next" );
+}
+
+TEST_F( LoggerTest, test_cuts_message_longer_than_staging_buffer )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+
+   write( *m_logger, std::string( 1000, 'x' ) );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), std::string( TestLoggerConfig::SHARED_BUFFER_SIZE - lib::LoggerBase::REPORTED_OVERHEAD, 'x' ) );
+}
+
+TEST_F( LoggerTest, test_admits_longest_message_along_with_dropped_report )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+
+   const std::string message( 100, 'x' );
+   write( *m_logger, message );
+   write( *m_logger, std::string( 30, 'd' ) );
+   m_logger->runOnce();
+
+   //!< Into the staging buffer emptied, along with the report, however long it is
+   const std::string longest( TestLoggerConfig::SHARED_BUFFER_SIZE - lib::LoggerBase::REPORTED_OVERHEAD, 'y' );
+   write( *m_logger, std::string( 1000, 'y' ) );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), message + "LOGGER: 1 messages dropped\r\n" + longest );
+}
+
+TEST_F( LoggerTest, test_frames_binary_records )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+
+   const uint8_t record[] = { 1, 2, 3, 0, 5, 6, 7, 8, 9, 10 };
+   m_logger->writeRecord( record, sizeof( record ) );
+   m_logger->runOnce();
+
+   const auto output = m_sink.captured();
+   ASSERT_GT( output.size(), 1u );
+   EXPECT_EQ( static_cast<uint8_t>( output[0] ), lib::FrameEncoder::DELIMITER );
+
+   uint8_t decoded[lib::LogRecord::MAX_RECORD_SIZE + 2] = {};
+   lib::FrameDecoder decoder{ decoded, sizeof( decoded ) };
+   size_t consumed = 0;
+   ASSERT_EQ( decoder.decode( reinterpret_cast<const uint8_t*>( output.data() ) + 1, output.size() - 1, consumed ), LibErrorCodes::eOK );
+   ASSERT_EQ( decoder.frameLength(), sizeof( record ) );
+   EXPECT_EQ( memcmp( decoder.frame(), record, sizeof( record ) ), 0 );
+}
+
+TEST_F( LoggerTest, test_drops_messages_in_interrupt_context )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( m_sink ) );
+
+   lib::LoggerPortStd::setInsideInterrupt( true );
+   write( *m_logger, "isr" );
+   lib::LoggerPortStd::setInsideInterrupt( false );
+   write( *m_logger, "task" );
+   m_logger->runOnce();
+
+   EXPECT_EQ( m_sink.captured(), "task" );
+}
+
+TEST_F( LoggerTest, test_flushes_pending_sink_without_messages )
+{
+   HoldingLogSink sink;
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( m_logger->addSink( sink ) );
+   m_logger->runOnce();       //!< Signaled by addSink()
+
+   write( *m_logger, "held" );
+   m_logger->runOnce();
+   EXPECT_TRUE( sink.m_batches.empty() );
+
+   //!< Woken up by the pending timeout, without any new message
+   m_logger->runOnce();
+   ASSERT_EQ( sink.m_batches.size(), 1u );
+   EXPECT_EQ( sink.m_batches[0], "held" );
+}
+
+TEST_F( LoggerTest, test_blocks_producer_until_logging_task_makes_room )
+{
+   lib::LockableStd lockable;
+   lib::Semaphore_Std semaphore;
+   auto logger = std::make_unique<TestLoggerOf<BlockingLoggerConfig>>( lockable, semaphore );
+   ASSERT_EQ( logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( logger->addSink( m_sink ) );
+
+   std::atomic<bool> isDone{ false };
+   std::thread loggingTask( [&]()
+   {
+      while ( !isDone.load() )
+      {
+         logger->runOnce();
+      }
+      logger->runOnce();
+   } );
+
+   std::string expected;
+   for ( int i = 0; i < 100; i++ )
+   {
+      const auto message = std::to_string( i ) + std::string( 20, '-' );
+      write( *logger, message );
+      expected += message;
+   }
+   isDone.store( true );
+   loggingTask.join();
+
+   EXPECT_EQ( m_sink.captured(), expected );
+}
+
+TEST_F( LoggerTest, test_releases_lock_while_producer_waits_for_space )
+{
+   lib::LockableStd lockable;
+   lib::Semaphore_Std semaphore;
+   auto logger = std::make_unique<TestLoggerOf<BlockingLoggerConfig>>( lockable, semaphore );
+   ASSERT_EQ( logger->initialize(), LibErrorCodes::eOK );
+   write( *logger, std::string( 100, 'x' ) );
+
+   //!< Without the logging task, the producer waits up to BLOCK_TIMEOUT_MS, while the others can still take the lock
+   std::thread producer( [&]() { write( *logger, "waiting" ); } );
+   std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+
+   const auto started = std::chrono::steady_clock::now();
+   EXPECT_TRUE( logger->addSink( m_sink ) );
+   EXPECT_TRUE( logger->registerTask() );
+   const auto elapsed = std::chrono::steady_clock::now() - started;
+   producer.join();
+
+   EXPECT_LT( elapsed, std::chrono::milliseconds( BlockingLoggerConfig::BLOCK_TIMEOUT_MS / 2 ) );
+}
+
+TEST_F( LoggerTest, test_discards_oldest_messages_for_the_newest )
+{
+   lib::LockableStd lockable;
+   lib::Semaphore_Std semaphore;
+   auto logger = std::make_unique<TestLoggerOf<DropOldestLoggerConfig>>( lockable, semaphore );
+   ASSERT_EQ( logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( logger->addSink( m_sink ) );
+
+   const std::string message( 50, 'x' );
+   write( *logger, "old1" + message );
+   write( *logger, "old2" + message );
+
+   //!< The producer waits until the logging task discards the oldest for it
+   std::thread producer( [&]() { write( *logger, "new" ); } );
+   std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+   logger->runOnce();
+   producer.join();
+   write( *logger, "after" );
+   for ( int i = 0; i < 5; i++ )
+   {
+      logger->runOnce();
+   }
+
+   //!< The oldest is gone, and its loss is reported where it was
+   const auto output = m_sink.captured();
+   EXPECT_EQ( output.find( "old1" ), std::string::npos );
+   EXPECT_NE( output.find( "old2" ), std::string::npos );
+   EXPECT_NE( output.find( "LOGGER: 1 messages dropped\r\n" ), std::string::npos );
+   EXPECT_NE( output.find( "new" ), std::string::npos );
+   EXPECT_NE( output.find( "after" ), std::string::npos );
+}
+
+TEST_F( LoggerTest, test_saves_staging_buffers_on_crash )
+{
+   ASSERT_EQ( m_logger->initialize(), LibErrorCodes::eOK );
+
+   write( *m_logger, "last words\r\n" );
+   m_logger->saveOnCrash( m_sink, "hard fault" );
+   m_logger->saveOnCrash( m_sink, "again" );       //!< Saved only once
+
+   EXPECT_EQ( m_sink.captured(), "last words\r\nLOGGER: crashed - hard fault\r\n" );
+}
+
+TEST_F( LoggerTest, test_sends_recovered_logs_first )
+{
+   uint8_t area[lib::RetainedLog::HEADER_SIZE + 128] = {};
+   lib::RetainedLog retainedLog{ area, sizeof( area ) };
+   retainedLog.reset();
+   const std::string previous = "before reset\r\n";
+   ASSERT_EQ( retainedLog.append( reinterpret_cast<const uint8_t*>( previous.data() ), previous.size() ), LibErrorCodes::eOK );
+
+   m_logger->sendRecovered( retainedLog, m_sink );
+
+   EXPECT_EQ( m_sink.captured(), "\r\nLOGGER: ---- recovered from the last run ----\r\n"
+                                 "before reset\r\n"
+                                 "LOGGER: ---- end of the recovered logs ----\r\n" );
+   EXPECT_EQ( retainedLog.used(), 0u );
+}
+
+TEST_F( LoggerTest, test_calls_final_sink_type )
+{
+   uint8_t area[lib::RetainedLog::HEADER_SIZE + 128] = {};
+   lib::RetainedLog retainedLog{ area, sizeof( area ) };
+   retainedLog.reset();
+   lib::RetainedLogSink sink{ "retained", {}, retainedLog };
+
+   lib::LockableStd lockable;
+   lib::Semaphore_Std semaphore;
+   auto logger = std::make_unique<TestLoggerOf<TestLoggerConfig, lib::RetainedLogSink>>( lockable, semaphore );
+   ASSERT_EQ( logger->initialize(), LibErrorCodes::eOK );
+   ASSERT_TRUE( logger->addSink( sink ) );
+
+   write( *logger, "retained" );
+   logger->runOnce();
+
+   uint8_t buffer[16] = {};
+   size_t length = 0;
+   ASSERT_EQ( retainedLog.pop( buffer, sizeof( buffer ), length ), LibErrorCodes::eOK );
+   EXPECT_EQ( std::string( reinterpret_cast<char*>( buffer ), length ), "retained" );
+}
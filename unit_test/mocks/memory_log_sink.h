@@ -0,0 +1,65 @@
+/************************************************************************************************************
+ * 
+ * @file memory_log_sink.h
+ * @brief This file contains a log sink capturing the messages into memory, for the host tests of the logger and the sinks.
+ * 
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-16
+ * @version 1.0
+ * 
+ ************************************************************************************************************/
+
+#pragma once
+
+//************************************************** Includes ************************************************
+#include "log_sink.h"
+#include <string>
+#include <vector>
+
+//**************************************************** Types *************************************************
+class MemoryLogSink : public lib::LogSink
+{
+public:
+   MemoryLogSink( const char* name = "memory", const Config& config = {} )
+   : lib::LogSink{ name, config }
+   { }
+
+   void write( const uint8_t* data, size_t length ) override
+   {
+      m_batch.append( reinterpret_cast<const char*>( data ), length );
+      m_writes.emplace_back( reinterpret_cast<const char*>( data ), length );
+   }
+
+   void flush( ) override
+   {
+      if ( !m_batch.empty() )
+      {
+         m_batches.push_back( m_batch );
+         m_batch.clear();
+      }
+      m_flushes++;
+   }
+
+   bool isPending( ) const override
+   {
+      return m_holdBatch && !m_batch.empty();
+   }
+
+   //!< Everything written, whether it's flushed or not
+   std::string captured( ) const
+   {
+      std::string all;
+      for ( const auto& batch : m_batches )
+      {
+         all += batch;
+      }
+      return all + m_batch;
+   }
+
+   std::vector<std::string>   m_writes;            //!< Every call of write()
+   std::vector<std::string>   m_batches;           //!< Every batch handed over on flush()
+   std::string                m_batch;             //!< The batch being filled
+   size_t                     m_flushes{ 0 };
+   bool                       m_holdBatch{ false };   //!< Whether it reports the batch being filled as pending
+};
@@ -0,0 +1,177 @@
+/************************************************************************************************************
+ *
+ * @file retained_log_tests.cpp
+ * @brief Unit tests for the RetainedLog class
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-13
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "retained_log.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+/************************************************** Test Fixture ********************************************/
+class RetainedLogTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      //!< Garbage, as the retained area is after a power-on
+      for ( size_t i = 0; i < sizeof( m_area ); i++ )
+      {
+         m_area[i] = static_cast<uint8_t>( i * 37 + 11 );
+      }
+   }
+
+   void TearDown() override
+   { }
+
+public:
+   static constexpr size_t AREA_SIZE = lib::RetainedLog::HEADER_SIZE + 64;
+
+   uint8_t m_area[AREA_SIZE] = {};
+
+   static ErrorCode append( lib::RetainedLog& log, const std::string& text )
+   {
+      return log.append( reinterpret_cast<const uint8_t*>( text.data() ), text.size() );
+   }
+
+   //!< Pops all records, as the next boot does, skipping the corrupted ones
+   static std::vector<std::string> recover( lib::RetainedLog& log )
+   {
+      std::vector<std::string> records;
+      uint8_t buffer[AREA_SIZE] = {};
+      size_t length = 0;
+
+      ErrorCode result;
+      while ( ( result = log.pop( buffer, sizeof( buffer ), length ) ) != LibErrorCodes::eRETAINED_LOG_EMPTY )
+      {
+         if ( result == LibErrorCodes::eOK )
+         {
+            records.emplace_back( reinterpret_cast<const char*>( buffer ), length );
+         }
+      }
+      return records;
+   }
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( RetainedLogTest, test_garbage_is_not_a_valid_log )
+{
+   lib::RetainedLog log{ m_area, sizeof( m_area ) };
+
+   EXPECT_FALSE( log.isValid() );
+   EXPECT_EQ( log.used(), 0u );
+   EXPECT_TRUE( recover( log ).empty() );
+
+   log.reset();
+   EXPECT_TRUE( log.isValid() );
+   EXPECT_EQ( log.capacity(), 64u );
+}
+
+TEST_F( RetainedLogTest, test_records_survive_a_reset_in_order )
+{
+   {
+      lib::RetainedLog log{ m_area, sizeof( m_area ) };
+      EXPECT_EQ( append( log, "first" ), LibErrorCodes::eOK );
+      EXPECT_EQ( append( log, "second" ), LibErrorCodes::eOK );
+      EXPECT_EQ( log.used(), 11u + 2 * lib::RetainedLog::RECORD_OVERHEAD );
+   }
+
+   //!< A new instance over the same area, as on the next boot
+   lib::RetainedLog log{ m_area, sizeof( m_area ) };
+   ASSERT_TRUE( log.isValid() );
+
+   const std::vector<std::string> expected = { "first", "second" };
+   EXPECT_EQ( recover( log ), expected );
+   EXPECT_EQ( log.used(), 0u );
+}
+
+TEST_F( RetainedLogTest, test_oldest_records_are_overwritten_across_the_end )
+{
+   lib::RetainedLog log{ m_area, sizeof( m_area ) };
+
+   for ( int i = 0; i < 20; i++ )
+   {
+      EXPECT_EQ( append( log, "record " + std::to_string( i ) ), LibErrorCodes::eOK );
+   }
+
+   //!< Each record takes 12 or 13 bytes, so the last 4 or 5 are kept
+   const auto records = recover( log );
+   ASSERT_GE( records.size(), 4u );
+   EXPECT_EQ( records.back(), "record 19" );
+   for ( size_t i = 0; i < records.size(); i++ )
+   {
+      EXPECT_EQ( records[i], "record " + std::to_string( 20 - records.size() + i ) );
+   }
+}
+
+TEST_F( RetainedLogTest, test_record_too_long_is_rejected )
+{
+   lib::RetainedLog log{ m_area, sizeof( m_area ) };
+   const std::string text( log.capacity() - lib::RetainedLog::RECORD_OVERHEAD + 1, 'x' );
+
+   EXPECT_EQ( append( log, text ), LibErrorCodes::eRETAINED_LOG_TOO_LONG );
+   EXPECT_EQ( append( log, text.substr( 1 ) ), LibErrorCodes::eOK );
+   EXPECT_EQ( log.used(), log.capacity() );
+}
+
+TEST_F( RetainedLogTest, test_record_not_fitting_in_buffer_is_kept )
+{
+   lib::RetainedLog log{ m_area, sizeof( m_area ) };
+   EXPECT_EQ( append( log, "0123456789" ), LibErrorCodes::eOK );
+
+   uint8_t buffer[4] = {};
+   size_t length = 0;
+   EXPECT_EQ( log.pop( buffer, sizeof( buffer ), length ), LibErrorCodes::eRETAINED_LOG_TOO_LONG );
+
+   const std::vector<std::string> expected = { "0123456789" };
+   EXPECT_EQ( recover( log ), expected );
+}
+
+TEST_F( RetainedLogTest, test_corrupted_record_is_skipped )
+{
+   lib::RetainedLog log{ m_area, sizeof( m_area ) };
+   EXPECT_EQ( append( log, "alpha" ), LibErrorCodes::eOK );
+   EXPECT_EQ( append( log, "beta" ), LibErrorCodes::eOK );
+   EXPECT_EQ( append( log, "gamma" ), LibErrorCodes::eOK );
+
+   //!< A bit flipped in the data of the second record
+   m_area[lib::RetainedLog::HEADER_SIZE + 9 + 2 + 1] ^= 0x01;
+
+   const std::vector<std::string> expected = { "alpha", "gamma" };
+   EXPECT_EQ( recover( log ), expected );
+}
+
+TEST_F( RetainedLogTest, test_corrupted_header_invalidates_the_log )
+{
+   lib::RetainedLog log{ m_area, sizeof( m_area ) };
+   EXPECT_EQ( append( log, "alpha" ), LibErrorCodes::eOK );
+
+   m_area[8] ^= 0x01;
+   EXPECT_FALSE( log.isValid() );
+   EXPECT_TRUE( recover( log ).empty() );
+
+   //!< Appending starts a new log
+   EXPECT_EQ( append( log, "beta" ), LibErrorCodes::eOK );
+   const std::vector<std::string> expected = { "beta" };
+   EXPECT_EQ( recover( log ), expected );
+}
+
+TEST_F( RetainedLogTest, test_log_of_different_size_is_not_valid )
+{
+   {
+      lib::RetainedLog log{ m_area, sizeof( m_area ) };
+      EXPECT_EQ( append( log, "alpha" ), LibErrorCodes::eOK );
+   }
+
+   //!< e.g., a log left by a firmware with a smaller area
+   lib::RetainedLog log{ m_area, sizeof( m_area ) - 8 };
+   EXPECT_FALSE( log.isValid() );
+}
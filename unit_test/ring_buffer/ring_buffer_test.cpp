@@ -81,3 +81,35 @@ TEST_F(RingBufferTest, test_bulk_operations)
    ring_buffer.popBulk(bufferForPop, sizeof(bufferForPop), &countRead);
    EXPECT_EQ(countRead, BULK_BUFFER_LENGTH);
 }
+
+TEST_F(RingBufferTest, test_statistics_track_peak_and_overflows)
+{
+   constexpr uint32_t LENGTH = 8;
+
+   uint8_t buffer[LENGTH] = {};
+   lib::RingBuffer<uint8_t> ring_buffer(buffer, LENGTH);
+
+   uint8_t data;
+   for (unsigned i = 0; i < 5; i++)
+   {
+      EXPECT_EQ(ring_buffer.push( i ), LibErrorCodes::eOK);
+   }
+   EXPECT_EQ(ring_buffer.pop( data ), LibErrorCodes::eOK);
+   EXPECT_EQ(ring_buffer.push( 0 ), LibErrorCodes::eOK);
+   EXPECT_EQ(ring_buffer.getPeak(), 5u);
+   EXPECT_EQ(ring_buffer.getOverflows(), 0u);
+
+   for (unsigned i = 0; i < LENGTH; i++)
+   {
+      (void)ring_buffer.push( i );
+   }
+   EXPECT_EQ(ring_buffer.getPeak(), LENGTH);
+   EXPECT_EQ(ring_buffer.getOverflows(), 5u);
+
+   //!< The peak restarts from the current count
+   EXPECT_EQ(ring_buffer.pop( data ), LibErrorCodes::eOK);
+   EXPECT_EQ(ring_buffer.pop( data ), LibErrorCodes::eOK);
+   ring_buffer.resetStatistics();
+   EXPECT_EQ(ring_buffer.getPeak(), LENGTH - 2);
+   EXPECT_EQ(ring_buffer.getOverflows(), 0u);
+}
@@ -0,0 +1,122 @@
+/************************************************************************************************************
+ *
+ * @file rtos_concepts_benchmark.cpp
+ * @brief Host benchmark of the RTOS primitives called through the interfaces against the policy types
+ * @details A critical section under lock_guard, and a semaphore given as from an ISR and taken, are measured with the lockable and the semaphore
+ *          bound to ILockable and ISemaphore, i.e., with virtual calls, and given as they are, i.e., called directly.
+ *          Trivial primitives show the cost of the dispatch only, and those of the standard library show how much of a real lock it is.
+ *          The interfaces are taken through a volatile pointer, so that the compiler can't see the type behind them and devirtualize the calls.
+ *          The critical sections are kept out of line, so that their code size can be compared, e.g., with nm --size-sort -C.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-24
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "lockguard.h"
+#include "lockable_std.h"
+#include "semaphore_std.h"
+#include "benchmark.h"
+
+/************************************************** Consts **************************************************/
+constexpr uint64_t ITERATIONS = 10000000;
+
+/************************************************** Types ***************************************************/
+class NullLockable final : public lib::ILockable
+{
+public:
+   ErrorCode initialize() override { return LibErrorCodes::eOK; }
+   void lock() override { }
+   bool try_lock( uint32_t timeout_ms ) override { ( void )timeout_ms; return true; }
+   void unlock() override { }
+};
+
+class NullSemaphore final : public lib::ISemaphore
+{
+public:
+   ErrorCode initialize( uint32_t maxCount, uint32_t initialCount ) override { ( void )maxCount; m_count = initialCount; return LibErrorCodes::eOK; }
+   void put( ) override { m_count++; }
+   void putISR( ) override { m_count++; }
+   ErrorCode get( uint32_t timeout_ms ) override
+   {
+      ( void )timeout_ms;
+      if ( m_count == 0 )
+      {
+         return LibErrorCodes::eSEMAPHORE_GET_TIME_OUT;
+      }
+      m_count--;
+      return LibErrorCodes::eOK;
+   }
+
+private:
+   uint32_t m_count{ 0 };
+};
+
+/*********************************************** Local Variables *********************************************/
+static uint32_t sharedCounter{ 0 };
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief A critical section as the library modules have, e.g., MessagePasser::new_message().
+ */
+template<lib::Lockable Lock>
+[[gnu::noinline]] void criticalSection( Lock& lockable )
+{
+   lib::lock_guard guard( lockable );
+   sharedCounter++;
+}
+
+/**
+ * @brief A semaphore given from an ISR and taken in a task, e.g., BasicSerialDevice::pushRxByte() and getRxByte().
+ */
+template<lib::CountingSemaphore Sem>
+[[gnu::noinline]] ErrorCode signalAndWait( Sem& semaphore )
+{
+   semaphore.putISR();
+   return semaphore.get( 0 );
+}
+
+/**
+ * @brief Get an interface which the compiler can't trace back to its implementation.
+ */
+template<typename Interface>
+static Interface& hide( Interface& object )
+{
+   Interface* volatile pointer = &object;
+   return *pointer;
+}
+
+template<typename Lock, typename Sem>
+static void runBenchmark( const char* name, Lock& lockable, Sem& semaphore )
+{
+   (void)lockable.initialize();
+   (void)semaphore.initialize( 1, 0 );
+
+   const auto lockCycles = bench::measureCycles( ITERATIONS, [&]() { criticalSection( lockable ); } );
+   const auto semaphoreCycles = bench::measureCycles( ITERATIONS, [&]() { bench::doNotOptimize( signalAndWait( semaphore ) ); } );
+
+   char label[64];
+   snprintf( label, sizeof( label ), "%s: lock_guard", name );
+   bench::reportCycles( label, lockCycles );
+   snprintf( label, sizeof( label ), "%s: putISR + get", name );
+   bench::reportCycles( label, semaphoreCycles );
+}
+
+int main( )
+{
+   NullLockable nullLockable;
+   NullSemaphore nullSemaphore;
+   runBenchmark( "null, virtual", hide<lib::ILockable>( nullLockable ), hide<lib::ISemaphore>( nullSemaphore ) );
+   runBenchmark( "null, policy", nullLockable, nullSemaphore );
+
+   lib::LockableStd stdLockable;
+   lib::Semaphore_Std stdSemaphore;
+   runBenchmark( "std, virtual", hide<lib::ILockable>( stdLockable ), hide<lib::ISemaphore>( stdSemaphore ) );
+   runBenchmark( "std, policy", stdLockable, stdSemaphore );
+
+   bench::doNotOptimize( sharedCounter );
+   return 0;
+}
@@ -0,0 +1,105 @@
+/************************************************************************************************************
+ *
+ * @file rtos_concepts_tests.cpp
+ * @brief Unit tests for the Lockable and CountingSemaphore concepts, and lock_guard instantiated with a policy type
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-24
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "rtos_concepts.h"
+#include "lockguard.h"
+#include "lockable_std.h"
+#include "semaphore_std.h"
+#include "mock_lockable.h"
+#include "mock_semaphore.h"
+#include <gtest/gtest.h>
+
+/************************************************** Types ***************************************************/
+//!< A lockable without any virtual function, as a policy type can be
+class CountingLockable
+{
+public:
+   ErrorCode initialize() { return LibErrorCodes::eOK; }
+   void lock() { m_numLocks++; }
+   bool try_lock( uint32_t timeout_ms ) { ( void )timeout_ms; return m_isFree ? ( m_numLocks++, true ) : false; }
+   void unlock() { m_numUnlocks++; }
+
+   bool  m_isFree{ true };
+   int   m_numLocks{ 0 };
+   int   m_numUnlocks{ 0 };
+};
+
+//!< Missing unlock()
+struct NotLockable
+{
+   ErrorCode initialize() { return LibErrorCodes::eOK; }
+   void lock() { }
+   bool try_lock( uint32_t timeout_ms ) { return timeout_ms > 0; }
+};
+
+//!< get() giving no result
+struct NotCountingSemaphore
+{
+   ErrorCode initialize( uint32_t maxCount, uint32_t initialCount ) { return ( maxCount >= initialCount ) ? LibErrorCodes::eOK : LibErrorCodes::eSEMAPHORE_INIT_FAILED; }
+   void put() { }
+   void putISR() { }
+   void get( uint32_t timeout_ms ) { ( void )timeout_ms; }
+};
+
+/************************************************** Tests ***************************************************/
+TEST( RtosConceptsTest, test_implementations_and_mocks_satisfy_concepts )
+{
+   static_assert( lib::Lockable<lib::LockableStd> );
+   static_assert( lib::Lockable<LockableMock> );
+   static_assert( lib::Lockable<CountingLockable> );
+   static_assert( lib::CountingSemaphore<lib::Semaphore_Std> );
+   static_assert( lib::CountingSemaphore<SemaphoreMock> );
+}
+
+TEST( RtosConceptsTest, test_incomplete_types_are_rejected )
+{
+   static_assert( !lib::Lockable<NotLockable> );
+   static_assert( !lib::CountingSemaphore<NotCountingSemaphore> );
+   static_assert( !lib::Lockable<lib::Semaphore_Std> );
+   static_assert( !lib::CountingSemaphore<lib::LockableStd> );
+}
+
+TEST( RtosConceptsTest, test_lock_guard_with_policy_type )
+{
+   CountingLockable lockable;
+   {
+      lib::lock_guard guard( lockable );
+      static_assert( std::is_same_v<decltype( guard ), lib::lock_guard<CountingLockable>> );
+      EXPECT_EQ( lockable.m_numLocks, 1 );
+      EXPECT_EQ( lockable.m_numUnlocks, 0 );
+      EXPECT_TRUE( guard.owns_lock() );
+   }
+   EXPECT_EQ( lockable.m_numUnlocks, 1 );
+
+   //!< Not unlocked when the lock is not taken within the timeout
+   lockable.m_isFree = false;
+   {
+      lib::lock_guard guard( lockable, 10 );
+      EXPECT_FALSE( guard.owns_lock() );
+   }
+   EXPECT_EQ( lockable.m_numLocks, 1 );
+   EXPECT_EQ( lockable.m_numUnlocks, 1 );
+}
+
+TEST( RtosConceptsTest, test_lock_guard_with_mock )
+{
+   LockableMock mock;
+   lib::ILockable& lockable = mock;
+   {
+      ::testing::InSequence sequence;
+      EXPECT_CALL( mock, try_lock( 100 ) ).WillOnce( ::testing::Return( true ) );
+      EXPECT_CALL( mock, unlock() ).Times( 1 );
+   }
+
+   lib::lock_guard guard( lockable, 100 );
+}
@@ -0,0 +1,138 @@
+/************************************************************************************************************
+ *
+ * @file serial_device_benchmark.cpp
+ * @brief Host benchmark of the cycles spent in the interrupt paths of SerialDevice, over the interfaces and over final types
+ * @details Trivial lock, semaphore and sender are used so that the cost of the device itself, including the calls to its hooks, is measured.
+ *          SerialDevice calls them through the vtables from its instance in serial_device.cpp, as the application does,
+ *          whereas BasicSerialDevice over the final types gets them resolved at compile time.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-09
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "serial_device.h"
+#include "benchmark.h"
+
+/************************************************** Consts **************************************************/
+constexpr uint64_t ITERATIONS     = 2000000;
+constexpr size_t   RX_BUFFER_SIZE = 256;
+
+/************************************************** Types ***************************************************/
+class NullLockable final : public lib::ILockable
+{
+public:
+   ErrorCode initialize() override { return LibErrorCodes::eOK; }
+   void lock() override { }
+   bool try_lock( uint32_t timeout_ms ) override { ( void )timeout_ms; return true; }
+   void unlock() override { }
+};
+
+class CountingSemaphoreStub final : public lib::ISemaphore
+{
+public:
+   ErrorCode initialize( uint32_t maxCount, uint32_t initialCount ) override { ( void )maxCount; m_count = initialCount; return LibErrorCodes::eOK; }
+   void put( ) override { m_count++; }
+   void putISR( ) override { m_count++; }
+   ErrorCode get( uint32_t timeout_ms ) override
+   {
+      ( void )timeout_ms;
+      if ( m_count == 0 )
+      {
+         return LibErrorCodes::eSEMAPHORE_GET_TIME_OUT;
+      }
+      m_count--;
+      return LibErrorCodes::eOK;
+   }
+
+private:
+   uint32_t m_count{ 0 };
+};
+
+struct NullSender
+{
+   void operator()( const uint8_t* data, size_t length ) const { ( void )data; ( void )length; }
+};
+
+using InlinedSerialDevice = lib::BasicSerialDevice<NullLockable, CountingSemaphoreStub, NullSender, RX_BUFFER_SIZE>;
+
+/*********************************************** Local Variables *********************************************/
+static uint8_t rxBuffer[RX_BUFFER_SIZE];
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Stub of the tick source which is provided by the application on target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   return 0;
+}
+
+static void sendNothing( const uint8_t* data, size_t length )
+{
+   ( void )data;
+   ( void )length;
+}
+
+/**
+ * @brief Measure the Rx interrupt path followed by the read in the thread, and the Tx-complete interrupts chaining a frame of segments.
+ */
+template<typename Device>
+static void runBenchmark( const char* name, Device& serialDevice )
+{
+   (void)serialDevice.initialize();
+
+   const auto rxCycles = bench::measureCycles( ITERATIONS, [&]()
+   {
+      uint8_t data = 0;
+      (void)serialDevice.pushRxByte( 0x55 );
+      (void)serialDevice.getRxByte( data, 0 );
+      bench::doNotOptimize( data );
+   } );
+
+   static const uint8_t segmentData[16] = {};
+   lib::SerialDeviceBase::TxSegment segments[lib::SerialDeviceBase::MAX_TX_SEGMENTS];
+   for ( auto& segment : segments )
+   {
+      segment = { segmentData, sizeof( segmentData ) };
+   }
+
+   const auto txCycles = bench::measureCycles( ITERATIONS / lib::SerialDeviceBase::MAX_TX_SEGMENTS, [&]()
+   {
+      (void)serialDevice.sendv( segments, lib::SerialDeviceBase::MAX_TX_SEGMENTS );
+      for ( size_t i = 0; i < lib::SerialDeviceBase::MAX_TX_SEGMENTS; i++ )
+      {
+         serialDevice.notifySendComplete();
+      }
+      (void)serialDevice.waitSendComplete( 0 );
+   } );
+
+   char label[64];
+   snprintf( label, sizeof( label ), "%s: Rx ISR + getRxByte", name );
+   bench::reportCycles( label, rxCycles );
+   snprintf( label, sizeof( label ), "%s: sendv + %zu Tx ISRs", name, lib::SerialDeviceBase::MAX_TX_SEGMENTS );
+   bench::reportCycles( label, txCycles );
+}
+
+int main( )
+{
+   NullLockable lockable;
+   CountingSemaphoreStub semTxComplete;
+   CountingSemaphoreStub semNewRxBytes;
+
+   //!< Bound to the interfaces, as the SerialDevice users see them
+   lib::ILockable& lockableInterface = lockable;
+   lib::ISemaphore& semTxCompleteInterface = semTxComplete;
+   lib::ISemaphore& semNewRxBytesInterface = semNewRxBytes;
+
+   lib::SerialDevice virtualDevice{ sendNothing, rxBuffer, sizeof( rxBuffer ), lockableInterface, semTxCompleteInterface, semNewRxBytesInterface };
+   runBenchmark( "virtual", virtualDevice );
+
+   InlinedSerialDevice inlinedDevice{ NullSender{}, lockable, semTxComplete, semNewRxBytes };
+   runBenchmark( "templated", inlinedDevice );
+
+   return 0;
+}
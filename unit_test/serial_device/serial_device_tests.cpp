@@ -16,6 +16,7 @@
 #include "mock_lockable.h"
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
 
 /*********************************************** Global Variables ********************************************/
 SemaphoreMock* g_mockSemaphore;
@@ -24,9 +25,20 @@ LockableMock* g_mockLockable;
 /*********************************************** Local Variables *********************************************/
 static uint8_t g_rxBuffer[128];
 static bool    g_senderCalled = false;
+static std::vector<lib::SerialDevice::TxSegment> g_segmentsSent;
+static uint32_t g_tick_ms = 0;
 
 /*********************************************** Function Definitions ****************************************/
 auto sender = []( const uint8_t* data, size_t length ) { ( void )data; ( void )length; g_senderCalled = true; };
+auto recordingSender = []( const uint8_t* data, size_t length ) { g_segmentsSent.push_back( { data, length } ); };
+
+/**
+ * @brief Stub of the tick source which is provided by the application on the target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   return g_tick_ms;
+}
 
 /************************************************** Test Fixture ********************************************/
 class SerialDeviceTest : public ::testing::Test
@@ -52,6 +64,19 @@ public:
    {
       return std::make_unique<lib::SerialDevice>( sender, g_rxBuffer, sizeof( g_rxBuffer ), m_lockableMock, m_semaphoreMock, m_semaphoreMock );
 	}
+
+   std::unique_ptr<lib::SerialDevice> getInitializedRecordingSerialDevice( )
+   {
+      auto serialDevice = std::make_unique<lib::SerialDevice>( recordingSender, g_rxBuffer, sizeof( g_rxBuffer ), m_lockableMock, m_semaphoreMock, m_semaphoreMock );
+
+      EXPECT_CALL( m_lockableMock, initialize() ).Times( 1 ).WillOnce( testing::Return( LibErrorCodes::eOK ) );
+      EXPECT_CALL( m_semaphoreMock, initialize( 1, 0 ) ).WillOnce( testing::Return( LibErrorCodes::eOK ) );
+      EXPECT_CALL( m_semaphoreMock, initialize( sizeof( g_rxBuffer ), 0 ) ).WillOnce( testing::Return( LibErrorCodes::eOK ) );
+      EXPECT_EQ( serialDevice->initialize(), LibErrorCodes::eOK );
+
+      g_segmentsSent.clear();
+      return serialDevice;
+   }
 };
 
 /************************************************** Tests ***************************************************/
@@ -244,4 +269,187 @@ TEST_F( SerialDeviceTest, test_flush_rx_buffer_succeeds )
    {
       EXPECT_EQ( byte, 0x00 );
 	}
-}
\ No newline at end of file
+}
+
+TEST_F( SerialDeviceTest, test_sendv_transmits_segments_in_sequence )
+{
+   auto serialDevice = getInitializedRecordingSerialDevice();
+
+   const uint8_t header[]  = { 0xAA, 0x55 };
+   const uint8_t payload[] = { 0x01, 0x02, 0x03 };
+   const uint8_t trailer[] = { '\r', '\n' };
+   const lib::SerialDevice::TxSegment segments[] = { { header, sizeof( header ) }, { payload, sizeof( payload ) }, { trailer, sizeof( trailer ) } };
+
+   EXPECT_CALL( m_lockableMock, lock() ).Times( 1 );
+   EXPECT_CALL( m_lockableMock, unlock() ).Times( 1 );
+
+   auto result = serialDevice->sendv( segments, 3 );
+   EXPECT_EQ( result, LibErrorCodes::eOK );
+   ASSERT_EQ( g_segmentsSent.size(), 1 );
+   EXPECT_EQ( g_segmentsSent[0].data, header );
+
+   //!< The waiting thread must not be signaled until the last segment is out.
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 0 );
+   serialDevice->notifySendComplete();
+   serialDevice->notifySendComplete();
+   testing::Mock::VerifyAndClearExpectations( &m_semaphoreMock );
+
+   ASSERT_EQ( g_segmentsSent.size(), 3 );
+   EXPECT_EQ( g_segmentsSent[1].data, payload );
+   EXPECT_EQ( g_segmentsSent[1].length, sizeof( payload ) );
+   EXPECT_EQ( g_segmentsSent[2].data, trailer );
+
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 1 );
+   serialDevice->notifySendComplete();
+   EXPECT_EQ( g_segmentsSent.size(), 3 );
+}
+
+TEST_F( SerialDeviceTest, test_sendv_sends_frames_larger_than_tx_buffer_in_place )
+{
+   auto serialDevice = getInitializedRecordingSerialDevice();
+
+   static uint8_t largePayload[lib::SerialDevice::TX_BUFFER_SIZE * 4] = { 0 };
+   const lib::SerialDevice::TxSegment segments[] = { { nullptr, 0 }, { largePayload, sizeof( largePayload ) } };
+
+   EXPECT_CALL( m_lockableMock, lock() ).Times( 1 );
+   EXPECT_CALL( m_lockableMock, unlock() ).Times( 1 );
+
+   auto result = serialDevice->sendv( segments, 2 );
+   EXPECT_EQ( result, LibErrorCodes::eOK );
+   ASSERT_EQ( g_segmentsSent.size(), 1 );
+   EXPECT_EQ( g_segmentsSent[0].data, largePayload );
+   EXPECT_EQ( g_segmentsSent[0].length, sizeof( largePayload ) );
+
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 1 );
+   serialDevice->notifySendComplete();
+}
+
+TEST_F( SerialDeviceTest, test_sendv_fails_for_invalid_segments )
+{
+   auto serialDevice = getInitializedRecordingSerialDevice();
+
+   const uint8_t data[] = { 0x01 };
+   lib::SerialDevice::TxSegment segments[lib::SerialDevice::MAX_TX_SEGMENTS + 1];
+   for ( auto& segment : segments )
+   {
+      segment = { data, sizeof( data ) };
+   }
+
+   EXPECT_CALL( m_lockableMock, lock() ).Times( 3 );
+   EXPECT_CALL( m_lockableMock, unlock() ).Times( 3 );
+
+   auto result = serialDevice->sendv( segments, lib::SerialDevice::MAX_TX_SEGMENTS + 1 );
+   EXPECT_EQ( result, LibErrorCodes::eSERIAL_DEVICE_TX_SEG_OVERFLOW );
+
+   const lib::SerialDevice::TxSegment emptySegments[] = { { data, 0 } };
+   result = serialDevice->sendv( emptySegments, 1 );
+   EXPECT_EQ( result, LibErrorCodes::eSERIAL_DEVICE_TX_MSG_EMPTY );
+
+   //!< Rejected rather than truncated by the 16-bit length of the HAL, and never read
+   const lib::SerialDevice::TxSegment longSegments[] = { { data, sizeof( data ) }, { data, lib::SerialDevice::MAX_SEGMENT_LENGTH + 1 } };
+   result = serialDevice->sendv( longSegments, 2 );
+   EXPECT_EQ( result, LibErrorCodes::eSERIAL_DEVICE_TX_MSG_TOO_LONG );
+   EXPECT_TRUE( g_segmentsSent.empty() );
+}
+
+TEST_F( SerialDeviceTest, test_send_owned_transmits_in_place_and_releases_on_completion )
+{
+   auto serialDevice = getInitializedRecordingSerialDevice();
+
+   static const uint8_t* releasedBuffer = nullptr;
+   static void*          releasedContext = nullptr;
+   auto release = []( const uint8_t* data, void* context ) { releasedBuffer = data; releasedContext = context; };
+
+   const uint8_t pooledBuffer[] = { 0x10, 0x20, 0x30 };
+   int context = 0;
+
+   EXPECT_CALL( m_lockableMock, lock() ).Times( 1 );
+   EXPECT_CALL( m_lockableMock, unlock() ).Times( 1 );
+
+   auto result = serialDevice->sendOwned( pooledBuffer, sizeof( pooledBuffer ), release, &context );
+   EXPECT_EQ( result, LibErrorCodes::eOK );
+   ASSERT_EQ( g_segmentsSent.size(), 1 );
+   EXPECT_EQ( g_segmentsSent[0].data, pooledBuffer );
+   EXPECT_EQ( releasedBuffer, nullptr );
+
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 1 );
+   serialDevice->notifySendComplete();
+
+   EXPECT_EQ( releasedBuffer, pooledBuffer );
+   EXPECT_EQ( releasedContext, &context );
+}
+
+TEST_F( SerialDeviceTest, test_send_owned_fails_if_already_sending )
+{
+   auto serialDevice = getInitializedRecordingSerialDevice();
+
+   const uint8_t data[] = { 0x01 };
+
+   EXPECT_CALL( m_lockableMock, lock() ).Times( 4 );
+   EXPECT_CALL( m_lockableMock, unlock() ).Times( 4 );
+
+   EXPECT_EQ( serialDevice->sendOwned( nullptr, 0, nullptr ), LibErrorCodes::eSERIAL_DEVICE_TX_MSG_EMPTY );
+   EXPECT_EQ( serialDevice->sendOwned( data, lib::SerialDevice::MAX_SEGMENT_LENGTH + 1, nullptr ), LibErrorCodes::eSERIAL_DEVICE_TX_MSG_TOO_LONG );
+   EXPECT_EQ( serialDevice->sendOwned( data, sizeof( data ), nullptr ), LibErrorCodes::eOK );
+   EXPECT_EQ( serialDevice->sendOwned( data, sizeof( data ), nullptr ), LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE );
+}
+
+TEST_F( SerialDeviceTest, test_statistics_count_tx_traffic_and_latency )
+{
+   g_tick_ms = 1000;
+   auto serialDevice = getInitializedRecordingSerialDevice();
+   EXPECT_EQ( serialDevice->getStatistics().sinceTick_ms, 1000 );
+
+   const uint8_t header[]  = { 0xAA, 0x55 };
+   const uint8_t payload[] = { 0x01, 0x02, 0x03 };
+   const lib::SerialDevice::TxSegment segments[] = { { header, sizeof( header ) }, { payload, sizeof( payload ) } };
+
+   EXPECT_CALL( m_lockableMock, lock() ).Times( 3 );
+   EXPECT_CALL( m_lockableMock, unlock() ).Times( 3 );
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( 2 );
+
+   EXPECT_EQ( serialDevice->sendv( segments, 2 ), LibErrorCodes::eOK );
+   EXPECT_EQ( serialDevice->sendAsync( payload, sizeof( payload ) ), LibErrorCodes::eSERIAL_DEVICE_SEND_ACTIVE );
+   g_tick_ms += 5;
+   serialDevice->notifySendComplete();
+   g_tick_ms += 7;
+   serialDevice->notifySendComplete();
+
+   uint32_t timeout = 100;
+   EXPECT_CALL( m_semaphoreMock, get( timeout ) ).WillOnce( testing::Return( LibErrorCodes::eOK ) ).WillOnce( testing::Return( LibErrorCodes::eSEMAPHORE_GET_TIME_OUT ) );
+   EXPECT_EQ( serialDevice->waitSendComplete( timeout ), LibErrorCodes::eOK );
+
+   EXPECT_EQ( serialDevice->sendAsync( payload, sizeof( payload ) ), LibErrorCodes::eOK );
+   g_tick_ms += 3;
+   serialDevice->notifySendComplete();
+   EXPECT_EQ( serialDevice->waitSendComplete( timeout ), LibErrorCodes::eSEMAPHORE_GET_TIME_OUT );
+
+   const auto statistics = serialDevice->getStatistics();
+   EXPECT_EQ( statistics.bytesOut, sizeof( header ) + sizeof( payload ) * 2 );
+   EXPECT_EQ( statistics.framesOut, 2 );
+   EXPECT_EQ( statistics.txBusy, 1 );
+   EXPECT_EQ( statistics.txTimeouts, 1 );
+   EXPECT_EQ( statistics.txLatencyLast_ms, 3 );
+   EXPECT_EQ( statistics.txLatencyMax_ms, 12 );
+   EXPECT_EQ( statistics.txLatencyTotal_ms, 15 );
+
+   serialDevice->resetStatistics();
+   EXPECT_EQ( serialDevice->getStatistics().framesOut, 0 );
+   EXPECT_EQ( serialDevice->getStatistics().sinceTick_ms, g_tick_ms );
+}
+
+TEST_F( SerialDeviceTest, test_statistics_count_rx_bytes_and_drops )
+{
+   auto serialDevice = getInitializedRecordingSerialDevice();
+
+   EXPECT_CALL( m_semaphoreMock, putISR() ).Times( sizeof( g_rxBuffer ) );
+
+   for ( size_t i = 0; i < sizeof( g_rxBuffer ) + 3; i++ )
+   {
+      (void)serialDevice->pushRxByte( static_cast<uint8_t>( i ) );
+   }
+
+   const auto statistics = serialDevice->getStatistics();
+   EXPECT_EQ( statistics.bytesIn, sizeof( g_rxBuffer ) );
+   EXPECT_EQ( statistics.rxDrops, 3 );
+}
@@ -0,0 +1,115 @@
+/************************************************************************************************************
+ *
+ * @file serial_device_registry_tests.cpp
+ * @brief Unit tests for the SerialDeviceRegistry class
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-10
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "serial_device_registry.h"
+#include <gtest/gtest.h>
+
+/************************************************** Consts **************************************************/
+//!< Addresses of the USART/UART registers of STM32F4, which are only used as keys and never dereferenced
+constexpr uintptr_t USART1_BASE = 0x40011000;
+constexpr uintptr_t USART2_BASE = 0x40004400;
+constexpr uintptr_t USART3_BASE = 0x40004800;
+constexpr uintptr_t UART4_BASE  = 0x40004C00;
+constexpr uintptr_t UART5_BASE  = 0x40005000;
+constexpr uintptr_t USART6_BASE = 0x40011400;
+constexpr uintptr_t UART7_BASE  = 0x40007800;
+constexpr uintptr_t UART8_BASE  = 0x40007C00;
+
+/************************************************** Test Fixture ********************************************/
+class SerialDeviceRegistryTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   { }
+
+   void TearDown() override
+   { }
+
+public:
+   struct FakeDevice
+   {
+      int id;
+   };
+
+   static const volatile void* key( uintptr_t address )
+   {
+      return reinterpret_cast<const volatile void*>( address );
+   }
+
+   lib::SerialDeviceRegistry<FakeDevice> m_registry;
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( SerialDeviceRegistryTest, FindsRegisteredDevices )
+{
+   FakeDevice device2{ 2 };
+   FakeDevice device3{ 3 };
+
+   EXPECT_EQ( m_registry.add( key( USART2_BASE ), device2 ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_registry.add( key( USART3_BASE ), device3 ), LibErrorCodes::eOK );
+
+   EXPECT_EQ( m_registry.find( key( USART2_BASE ) ), &device2 );
+   EXPECT_EQ( m_registry.find( key( USART3_BASE ) ), &device3 );
+}
+
+TEST_F( SerialDeviceRegistryTest, ReturnsNullForUnregisteredKey )
+{
+   FakeDevice device{ 1 };
+
+   EXPECT_EQ( m_registry.find( key( USART1_BASE ) ), nullptr );
+
+   EXPECT_EQ( m_registry.add( key( USART1_BASE ), device ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_registry.find( key( USART2_BASE ) ), nullptr );
+   //!< Same slot as USART1, but a different peripheral
+   EXPECT_EQ( m_registry.find( key( USART1_BASE + 32 * 1024 ) ), nullptr );
+}
+
+TEST_F( SerialDeviceRegistryTest, AllUartsOfStm32F4FallIntoDistinctSlots )
+{
+   const uintptr_t bases[] = { USART1_BASE, USART2_BASE, USART3_BASE, UART4_BASE, UART5_BASE, USART6_BASE, UART7_BASE, UART8_BASE };
+   FakeDevice devices[sizeof( bases ) / sizeof( bases[0] )];
+
+   for ( size_t i = 0; i < sizeof( bases ) / sizeof( bases[0] ); i++ )
+   {
+      devices[i].id = static_cast<int>( i );
+      EXPECT_EQ( m_registry.add( key( bases[i] ), devices[i] ), LibErrorCodes::eOK );
+   }
+
+   for ( size_t i = 0; i < sizeof( bases ) / sizeof( bases[0] ); i++ )
+   {
+      EXPECT_EQ( m_registry.find( key( bases[i] ) ), &devices[i] );
+   }
+}
+
+TEST_F( SerialDeviceRegistryTest, RejectsCollision )
+{
+   FakeDevice device1{ 1 };
+   FakeDevice device2{ 2 };
+
+   EXPECT_EQ( m_registry.add( key( USART1_BASE ), device1 ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_registry.add( key( USART1_BASE + 32 * 1024 ), device2 ), LibErrorCodes::eSERIAL_REGISTRY_COLLISION );
+
+   //!< The first registration is kept
+   EXPECT_EQ( m_registry.find( key( USART1_BASE ) ), &device1 );
+}
+
+TEST_F( SerialDeviceRegistryTest, ReplacesDeviceOfSameKey )
+{
+   FakeDevice device1{ 1 };
+   FakeDevice device2{ 2 };
+
+   EXPECT_EQ( m_registry.add( key( USART3_BASE ), device1 ), LibErrorCodes::eOK );
+   EXPECT_EQ( m_registry.add( key( USART3_BASE ), device2 ), LibErrorCodes::eOK );
+
+   EXPECT_EQ( m_registry.find( key( USART3_BASE ) ), &device2 );
+}
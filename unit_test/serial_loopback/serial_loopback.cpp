@@ -0,0 +1,132 @@
+/************************************************************************************************************
+ *
+ * @file serial_loopback.cpp
+ * @brief Implementation of the host-side loopback transport connecting two SerialDevice instances.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "serial_loopback.h"
+#include "lib_common.h"
+#include <chrono>
+
+/*********************************************** Local Variables *********************************************/
+SerialLoopback* SerialLoopback::s_instance = nullptr;
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Host implementation of the tick source, which is provided by the application on target.
+ */
+extern "C" uint32_t LIB_COMMON_getTickMS( void )
+{
+   static const auto started = std::chrono::steady_clock::now();
+   return static_cast<uint32_t>( std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - started ).count() );
+}
+
+SerialLoopback::SerialLoopback( bool flowControl /* = true */ )
+: m_flowControl( flowControl )
+{
+   s_instance = this;
+
+   (void)m_endA.device.initialize();
+   (void)m_endB.device.initialize();
+
+   m_endA.uart = std::thread( [this]() { runUart( m_endA, m_endB ); } );
+   m_endB.uart = std::thread( [this]() { runUart( m_endB, m_endA ); } );
+}
+
+SerialLoopback::~SerialLoopback()
+{
+   for ( auto* endpoint : { &m_endA, &m_endB } )
+   {
+      std::lock_guard<std::mutex> lock( endpoint->mutex );
+      m_stop = true;
+      endpoint->txRequested.notify_one();
+   }
+
+   m_endA.uart.join();
+   m_endB.uart.join();
+
+   s_instance = nullptr;
+}
+
+/**
+ * @brief Get the serial device at an end of the loopback.
+ */
+lib::SerialDevice& SerialLoopback::device( eLoopbackEnd end )
+{
+   return ( end == eLoopbackEnd::END_A ) ? m_endA.device : m_endB.device;
+}
+
+/**
+ * @brief SendFunction of the device at the end A.
+ */
+void SerialLoopback::sendA( const uint8_t* data, size_t length )
+{
+   requestSend( s_instance->m_endA, data, length );
+}
+
+/**
+ * @brief SendFunction of the device at the end B.
+ */
+void SerialLoopback::sendB( const uint8_t* data, size_t length )
+{
+   requestSend( s_instance->m_endB, data, length );
+}
+
+/**
+ * @brief Hand over a transmission to the simulated UART, which returns immediately like HAL_UART_Transmit_IT().
+ */
+void SerialLoopback::requestSend( Endpoint& endpoint, const uint8_t* data, size_t length )
+{
+   std::lock_guard<std::mutex> lock( endpoint.mutex );
+   endpoint.txData    = data;
+   endpoint.txLength  = length;
+   endpoint.txPending = true;
+   endpoint.txRequested.notify_one();
+}
+
+/**
+ * @brief Thread function of a simulated UART, which plays the role of the Rx interrupt of the peer and the Tx-complete interrupt of its own.
+ *
+ * @param self the endpoint transmitting
+ * @param peer the endpoint receiving
+ */
+void SerialLoopback::runUart( Endpoint& self, Endpoint& peer )
+{
+   while ( true )
+   {
+      const uint8_t* data = nullptr;
+      size_t length = 0;
+      {
+         std::unique_lock<std::mutex> lock( self.mutex );
+         self.txRequested.wait( lock, [&]() { return self.txPending || m_stop; } );
+         if ( m_stop )
+         {
+            return;
+         }
+
+         data   = self.txData;
+         length = self.txLength;
+         self.txPending = false;
+      }
+
+      for ( size_t i = 0; i < length; i++ )
+      {
+         //!< With flow control, a byte refused is offered again until there is room, like a transmitter held by CTS;
+         //!< note that the device still counts every refusal as an Rx drop.
+         while ( ( peer.device.pushRxByte( data[i] ) == LibErrorCodes::eRING_BUFFER_FULL ) && m_flowControl && !m_stop )
+         {
+            std::this_thread::yield();
+         }
+      }
+
+      //!< Called without the lock held, as it may chain the next segment through the SendFunction.
+      self.device.notifySendComplete();
+   }
+}
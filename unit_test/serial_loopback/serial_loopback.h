@@ -0,0 +1,98 @@
+/************************************************************************************************************
+ *
+ * @file serial_loopback.h
+ * @brief Host-side loopback transport connecting two SerialDevice instances.
+ * @details Each side has a simulated UART transmitter running in its own thread, which plays the role of the UART interrupts;
+ *          it pushes every byte handed over by the SendFunction into the Rx buffer of the peer device through pushRxByte(),
+ *          and then calls notifySendComplete() on its own device, just as the Rx and Tx-complete interrupts do on target.
+ *          The devices use the std-based lockable and semaphore, so the whole path runs with real threads and can be measured.
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+#pragma once
+
+/************************************************** Includes ************************************************/
+#include "serial_device.h"
+#include "lockable_std.h"
+#include "semaphore_std.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/************************************************** Types ***************************************************/
+/**
+ * @brief Enumeration of the ends of the loopback
+ */
+enum class eLoopbackEnd
+{
+   END_A,
+   END_B,
+};
+
+/**
+ * @brief Two serial devices connected to each other through simulated UARTs.
+ * @details As SendFunction is a plain function pointer without a context, only one instance can exist at a time.
+ */
+class SerialLoopback
+{
+public:
+   constexpr static size_t RX_BUFFER_SIZE = 1024;
+
+   /**
+    * @brief Construct the loopback and start the simulated UARTs.
+    *
+    * @param flowControl true to hold the transmitter while the peer's Rx buffer is full, like RTS/CTS,
+    *                    or false to drop the bytes, like an Rx overrun
+    */
+   explicit SerialLoopback( bool flowControl = true );
+   ~SerialLoopback();
+
+   //!< Disable copy and move operations
+   SerialLoopback( const SerialLoopback& ) = delete;
+   SerialLoopback& operator=( const SerialLoopback& ) = delete;
+   SerialLoopback( SerialLoopback&& ) = delete;
+   SerialLoopback& operator=( SerialLoopback&& ) = delete;
+
+   lib::SerialDevice& device( eLoopbackEnd end );
+
+private:
+   struct Endpoint
+   {
+      explicit Endpoint( lib::SerialDevice::SendFunction sender )
+      : device( sender, rxBuffer, sizeof( rxBuffer ), lockable, semTxComplete, semNewRxBytes )
+      { }
+
+      uint8_t                 rxBuffer[RX_BUFFER_SIZE] = {};
+      lib::LockableStd        lockable;
+      lib::Semaphore_Std      semTxComplete;
+      lib::Semaphore_Std      semNewRxBytes;
+      lib::SerialDevice       device;
+
+      //!< State of the simulated UART transmitter
+      std::mutex              mutex;
+      std::condition_variable txRequested;
+      const uint8_t*          txData{ nullptr };
+      size_t                  txLength{ 0 };
+      bool                    txPending{ false };
+      std::thread             uart;
+   };
+
+   static void sendA       ( const uint8_t* data, size_t length );
+   static void sendB       ( const uint8_t* data, size_t length );
+   static void requestSend ( Endpoint& endpoint, const uint8_t* data, size_t length );
+
+   void        runUart     ( Endpoint& self, Endpoint& peer );
+
+   static SerialLoopback*  s_instance;
+
+   Endpoint                m_endA{ sendA };
+   Endpoint                m_endB{ sendB };
+   bool                    m_flowControl;
+   std::atomic<bool>       m_stop{ false };
+};
@@ -0,0 +1,131 @@
+/************************************************************************************************************
+ *
+ * @file serial_loopback_benchmark.cpp
+ * @brief Host benchmark of the sustained throughput and the per-message latency of SerialDevice over the loopback
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+/************************************************** Includes ************************************************/
+#include "serial_loopback.h"
+#include "benchmark.h"
+#include <thread>
+#include <vector>
+
+/************************************************** Consts **************************************************/
+constexpr size_t   MESSAGE_SIZES[]  = { 16, 64, 256 };
+constexpr uint64_t TOTAL_BYTES      = 4ULL * 1024 * 1024;
+constexpr uint64_t NUM_ROUND_TRIPS  = 2000;
+constexpr uint32_t TIMEOUT_MS       = 2000;
+
+/*********************************************** Function Definitions ****************************************/
+/**
+ * @brief Receive a number of bytes, and return false if they don't arrive in time.
+ */
+static bool receive( lib::SerialDevice& serialDevice, uint8_t buffer[], size_t length )
+{
+   for ( size_t i = 0; i < length; i++ )
+   {
+      if ( serialDevice.getRxByte( buffer[i], TIMEOUT_MS ) != LibErrorCodes::eOK )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+/**
+ * @brief Measure the sustained throughput from A to B, with B draining its Rx buffer in another thread.
+ */
+static void runThroughput( size_t messageSize )
+{
+   SerialLoopback loopback;
+   auto& deviceA = loopback.device( eLoopbackEnd::END_A );
+   auto& deviceB = loopback.device( eLoopbackEnd::END_B );
+
+   const std::vector<uint8_t> message( messageSize, 0x5A );
+   const uint64_t numMessages = TOTAL_BYTES / messageSize;
+
+   std::thread receiver( [&]()
+   {
+      std::vector<uint8_t> buffer( messageSize );
+      for ( uint64_t i = 0; i < numMessages; i++ )
+      {
+         if ( !receive( deviceB, buffer.data(), buffer.size() ) )
+         {
+            printf( "receiver timed out\n" );
+            return;
+         }
+      }
+   } );
+
+   const auto seconds = bench::measureSeconds( numMessages, [&]()
+   {
+      (void)deviceA.sendWait( message.data(), message.size(), TIMEOUT_MS );
+   } );
+   receiver.join();
+
+   const auto statistics = deviceA.getStatistics();
+   char name[64];
+   snprintf( name, sizeof( name ), "throughput %4zu B messages", messageSize );
+   bench::reportThroughput( name, numMessages * messageSize, seconds );
+   printf( "   frames %lu, tx latency avg/max %lu/%lu ms\n",
+           static_cast<unsigned long>( statistics.framesOut ),
+           static_cast<unsigned long>( statistics.framesOut > 0 ? statistics.txLatencyTotal_ms / statistics.framesOut : 0 ),
+           static_cast<unsigned long>( statistics.txLatencyMax_ms ) );
+}
+
+/**
+ * @brief Measure the one-way latency per message as half of the round trip, where B echoes back every message from A.
+ */
+static void runLatency( size_t messageSize )
+{
+   SerialLoopback loopback;
+   auto& deviceA = loopback.device( eLoopbackEnd::END_A );
+   auto& deviceB = loopback.device( eLoopbackEnd::END_B );
+
+   std::thread echo( [&]()
+   {
+      std::vector<uint8_t> buffer( messageSize );
+      for ( uint64_t i = 0; i < NUM_ROUND_TRIPS; i++ )
+      {
+         if ( !receive( deviceB, buffer.data(), buffer.size() ) )
+         {
+            return;
+         }
+         (void)deviceB.sendWait( buffer.data(), buffer.size(), TIMEOUT_MS );
+      }
+   } );
+
+   const std::vector<uint8_t> message( messageSize, 0xA5 );
+   std::vector<uint8_t> reply( messageSize );
+
+   const auto seconds = bench::measureSeconds( NUM_ROUND_TRIPS, [&]()
+   {
+      (void)deviceA.sendWait( message.data(), message.size(), TIMEOUT_MS );
+      (void)receive( deviceA, reply.data(), reply.size() );
+   } );
+   echo.join();
+
+   char name[64];
+   snprintf( name, sizeof( name ), "one-way latency %4zu B messages", messageSize );
+   bench::reportPerOperation( name, NUM_ROUND_TRIPS * 2, seconds );
+}
+
+int main( )
+{
+   for ( const auto size : MESSAGE_SIZES )
+   {
+      runThroughput( size );
+   }
+
+   for ( const auto size : MESSAGE_SIZES )
+   {
+      runLatency( size );
+   }
+   return 0;
+}
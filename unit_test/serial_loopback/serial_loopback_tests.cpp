@@ -0,0 +1,171 @@
+/************************************************************************************************************
+ *
+ * @file serial_loopback_tests.cpp
+ * @brief Unit tests for SerialDevice running over the host loopback with real threads
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "serial_loopback.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+/************************************************** Consts **************************************************/
+constexpr uint32_t TIMEOUT_MS = 2000;
+
+/************************************************** Test Fixture ********************************************/
+class SerialLoopbackTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   { }
+
+   void TearDown() override
+   { }
+
+public:
+   static std::vector<uint8_t> makePattern( size_t length, uint8_t seed )
+   {
+      std::vector<uint8_t> pattern( length );
+      for ( size_t i = 0; i < length; i++ )
+      {
+         pattern[i] = static_cast<uint8_t>( seed + i * 7 );
+      }
+      return pattern;
+   }
+
+   static std::vector<uint8_t> receive( lib::SerialDevice& serialDevice, size_t length )
+   {
+      std::vector<uint8_t> received;
+      received.reserve( length );
+      while ( received.size() < length )
+      {
+         uint8_t byte = 0;
+         if ( serialDevice.getRxByte( byte, TIMEOUT_MS ) != LibErrorCodes::eOK )
+         {
+            break;
+         }
+         received.push_back( byte );
+      }
+      return received;
+   }
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( SerialLoopbackTest, test_semaphore_is_clamped_to_max_count )
+{
+   lib::Semaphore_Std semaphore;
+   EXPECT_EQ( semaphore.get( 0 ), LibErrorCodes::eSEMAPHORE_NOT_INITIALIZED );
+   EXPECT_EQ( semaphore.initialize( 2, 0 ), LibErrorCodes::eOK );
+
+   semaphore.put();
+   semaphore.putISR();
+   semaphore.put();
+
+   EXPECT_EQ( semaphore.get( 0 ), LibErrorCodes::eOK );
+   EXPECT_EQ( semaphore.get( 0 ), LibErrorCodes::eOK );
+   EXPECT_EQ( semaphore.get( 10 ), LibErrorCodes::eSEMAPHORE_GET_TIME_OUT );
+}
+
+TEST_F( SerialLoopbackTest, test_bytes_sent_are_received_by_the_peer )
+{
+   SerialLoopback loopback;
+   auto& deviceA = loopback.device( eLoopbackEnd::END_A );
+   auto& deviceB = loopback.device( eLoopbackEnd::END_B );
+
+   const auto message = makePattern( lib::SerialDevice::TX_BUFFER_SIZE, 1 );
+   EXPECT_EQ( deviceA.sendWait( message.data(), message.size(), TIMEOUT_MS ), LibErrorCodes::eOK );
+
+   EXPECT_EQ( receive( deviceB, message.size() ), message );
+}
+
+TEST_F( SerialLoopbackTest, test_segments_larger_than_rx_buffer_are_delivered_in_order )
+{
+   SerialLoopback loopback;
+   auto& deviceA = loopback.device( eLoopbackEnd::END_A );
+   auto& deviceB = loopback.device( eLoopbackEnd::END_B );
+
+   const auto header  = makePattern( 16, 100 );
+   const auto payload = makePattern( SerialLoopback::RX_BUFFER_SIZE * 3, 3 );
+   const lib::SerialDevice::TxSegment segments[] = { { header.data(), header.size() }, { payload.data(), payload.size() } };
+
+   std::vector<uint8_t> received;
+   std::thread receiver( [&]() { received = receive( deviceB, header.size() + payload.size() ); } );
+
+   EXPECT_EQ( deviceA.sendv( segments, 2 ), LibErrorCodes::eOK );
+   EXPECT_EQ( deviceA.waitSendComplete( TIMEOUT_MS ), LibErrorCodes::eOK );
+   receiver.join();
+
+   auto expected = header;
+   expected.insert( expected.end(), payload.begin(), payload.end() );
+   EXPECT_EQ( received, expected );
+}
+
+TEST_F( SerialLoopbackTest, test_both_directions_work_concurrently )
+{
+   constexpr size_t NUM_MESSAGES = 50;
+
+   SerialLoopback loopback;
+   auto& deviceA = loopback.device( eLoopbackEnd::END_A );
+   auto& deviceB = loopback.device( eLoopbackEnd::END_B );
+
+   const auto messageA = makePattern( 200, 11 );
+   const auto messageB = makePattern( 120, 22 );
+
+   std::vector<uint8_t> receivedByA;
+   std::vector<uint8_t> receivedByB;
+   std::thread receiverA( [&]() { receivedByA = receive( deviceA, messageB.size() * NUM_MESSAGES ); } );
+   std::thread receiverB( [&]() { receivedByB = receive( deviceB, messageA.size() * NUM_MESSAGES ); } );
+
+   std::thread senderB( [&]()
+   {
+      for ( size_t i = 0; i < NUM_MESSAGES; i++ )
+      {
+         EXPECT_EQ( deviceB.sendWait( messageB.data(), messageB.size(), TIMEOUT_MS ), LibErrorCodes::eOK );
+      }
+   } );
+
+   for ( size_t i = 0; i < NUM_MESSAGES; i++ )
+   {
+      EXPECT_EQ( deviceA.sendWait( messageA.data(), messageA.size(), TIMEOUT_MS ), LibErrorCodes::eOK );
+   }
+
+   senderB.join();
+   receiverA.join();
+   receiverB.join();
+
+   ASSERT_EQ( receivedByA.size(), messageB.size() * NUM_MESSAGES );
+   ASSERT_EQ( receivedByB.size(), messageA.size() * NUM_MESSAGES );
+   for ( size_t i = 0; i < NUM_MESSAGES; i++ )
+   {
+      EXPECT_TRUE( std::equal( messageB.begin(), messageB.end(), receivedByA.begin() + i * messageB.size() ) );
+      EXPECT_TRUE( std::equal( messageA.begin(), messageA.end(), receivedByB.begin() + i * messageA.size() ) );
+   }
+
+   EXPECT_EQ( deviceA.getStatistics().bytesOut, deviceB.getStatistics().bytesIn );
+   EXPECT_EQ( deviceA.getStatistics().framesOut, NUM_MESSAGES );
+}
+
+TEST_F( SerialLoopbackTest, test_overrun_drops_bytes_without_flow_control )
+{
+   SerialLoopback loopback{ false };
+   auto& deviceA = loopback.device( eLoopbackEnd::END_A );
+   auto& deviceB = loopback.device( eLoopbackEnd::END_B );
+
+   const auto payload = makePattern( SerialLoopback::RX_BUFFER_SIZE + 100, 5 );
+   const lib::SerialDevice::TxSegment segments[] = { { payload.data(), payload.size() } };
+
+   //!< Nobody reads on B, so the bytes beyond its Rx buffer are lost.
+   EXPECT_EQ( deviceA.sendv( segments, 1 ), LibErrorCodes::eOK );
+   EXPECT_EQ( deviceA.waitSendComplete( TIMEOUT_MS ), LibErrorCodes::eOK );
+
+   const auto statistics = deviceB.getStatistics();
+   EXPECT_EQ( statistics.bytesIn, SerialLoopback::RX_BUFFER_SIZE );
+   EXPECT_EQ( statistics.rxDrops, 100 );
+}
@@ -0,0 +1,163 @@
+/************************************************************************************************************
+ *
+ * @file stats_registry_tests.cpp
+ * @brief Unit tests for the StatsRegistry class and the RingBufferStats provider
+ *
+ * @author Sungsu Kim
+ * @copyright 2025 Sungsu Kim
+ * @date 2025-09-23
+ * @version 1.0
+ *
+ ************************************************************************************************************/
+
+ /************************************************** Includes ************************************************/
+#include "stats_registry.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+/*********************************************** Local Variables *********************************************/
+static std::vector<std::string> lines;       //!< The lines printed, in order
+
+/*********************************************** Function Definitions ****************************************/
+static void recordLine( void* context, const char* line )
+{
+   ( void )context;
+   lines.emplace_back( line );
+}
+
+/**
+ * @brief Stats provider reporting a fixed line, which counts its resets
+ */
+class FakeStats final : public lib::IStatsProvider
+{
+public:
+   FakeStats( const char* name, lib::eStatsGroup group )
+   : m_name{ name }
+   , m_group{ group }
+   { }
+
+   const char*       getName     ( ) const override   { return m_name; }
+   lib::eStatsGroup  getGroup    ( ) const override   { return m_group; }
+   void              report      ( lib::StatsOutput& output ) override   { output.print( "%s reported", m_name ); }
+   void              reset       ( ) override         { m_numResets++; }
+
+   int               m_numResets{ 0 };
+
+private:
+   const char*       m_name;
+   lib::eStatsGroup  m_group;
+};
+
+/************************************************** Test Fixture ********************************************/
+class StatsRegistryTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      lines.clear();
+   }
+
+   lib::StatsOutput output{ recordLine };
+};
+
+/************************************************** Tests ***************************************************/
+TEST_F( StatsRegistryTest, test_add_until_full )
+{
+   lib::StatsRegistry<2> registry;
+   FakeStats a{ "a", lib::eStatsGroup::SYSTEM };
+   FakeStats b{ "b", lib::eStatsGroup::SYSTEM };
+   FakeStats c{ "c", lib::eStatsGroup::SYSTEM };
+
+   EXPECT_EQ( registry.add( a ), LibErrorCodes::eOK );
+   EXPECT_EQ( registry.add( b ), LibErrorCodes::eOK );
+   EXPECT_EQ( registry.add( c ), LibErrorCodes::eSTATS_REGISTRY_FULL );
+   EXPECT_EQ( registry.size(), 2u );
+}
+
+TEST_F( StatsRegistryTest, test_report_by_name )
+{
+   lib::StatsRegistry<> registry;
+   FakeStats tasks{ "tasks", lib::eStatsGroup::SYSTEM };
+   FakeStats heap{ "heap", lib::eStatsGroup::SYSTEM };
+   (void)registry.add( tasks );
+   (void)registry.add( heap );
+
+   EXPECT_EQ( registry.find( "heap" ), &heap );
+   EXPECT_EQ( registry.find( "hea" ), nullptr );
+
+   EXPECT_EQ( registry.report( "heap", output ), LibErrorCodes::eOK );
+   EXPECT_EQ( registry.report( "unknown", output ), LibErrorCodes::eSTATS_PROVIDER_NOT_FOUND );
+   const std::vector<std::string> expected{ "heap reported" };
+   EXPECT_EQ( lines, expected );
+}
+
+TEST_F( StatsRegistryTest, test_report_group_in_order_registered )
+{
+   lib::StatsRegistry<> registry;
+   FakeStats rx{ "rx", lib::eStatsGroup::BUFFERS };
+   FakeStats tasks{ "tasks", lib::eStatsGroup::SYSTEM };
+   FakeStats tx{ "tx", lib::eStatsGroup::BUFFERS };
+   (void)registry.add( rx );
+   (void)registry.add( tasks );
+   (void)registry.add( tx );
+
+   registry.reportGroup( lib::eStatsGroup::BUFFERS, output );
+   const std::vector<std::string> buffers{ "rx reported", "tx reported" };
+   EXPECT_EQ( lines, buffers );
+
+   lines.clear();
+   registry.reportAll( output );
+   const std::vector<std::string> all{ "rx reported", "tasks reported", "tx reported" };
+   EXPECT_EQ( lines, all );
+
+   lines.clear();
+   registry.list( output );
+   ASSERT_EQ( lines.size(), 3u );
+   EXPECT_EQ( lines[1], "tasks            system" );
+}
+
+TEST_F( StatsRegistryTest, test_reset_all )
+{
+   lib::StatsRegistry<> registry;
+   FakeStats a{ "a", lib::eStatsGroup::SYSTEM };
+   FakeStats b{ "b", lib::eStatsGroup::BUFFERS };
+   (void)registry.add( a );
+   (void)registry.add( b );
+
+   registry.resetAll();
+   EXPECT_EQ( a.m_numResets, 1 );
+   EXPECT_EQ( b.m_numResets, 1 );
+}
+
+TEST_F( StatsRegistryTest, test_ring_buffer_stats )
+{
+   char buffer[4];
+   lib::RingBuffer<char> ring{ buffer, sizeof( buffer ) };
+   lib::RingBufferStats<char> stats{ "uart.rx", ring };
+
+   for ( char c : std::string( "abcdef" ) )
+   {
+      (void)ring.push( c );
+   }
+   char c = 0;
+   (void)ring.pop( c );
+
+   stats.report( output );
+   ASSERT_EQ( lines.size(), 1u );
+   EXPECT_EQ( lines[0], "uart.rx          used 3/4, peak 4, overflows 2" );
+
+   //!< The peak starts again from the occupancy now
+   stats.reset();
+   stats.report( output );
+   EXPECT_EQ( lines[1], "uart.rx          used 3/4, peak 3, overflows 0" );
+}
+
+TEST_F( StatsRegistryTest, test_long_line_is_truncated )
+{
+   const std::string name( 200, 'x' );
+   output.print( "%s", name.c_str() );
+
+   ASSERT_EQ( lines.size(), 1u );
+   EXPECT_EQ( lines[0], std::string( lib::StatsOutput::LINE_SIZE - 1, 'x' ) );
+}